@@ -0,0 +1,135 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for an isa item model that shows generated shaders, to benchmark the isa widgets with.
+//=============================================================================
+
+#include "isa_bench_item_model.h"
+
+IsaBenchItemModel::IsaBenchItemModel(bool use_arena)
+    : IsaItemModel()
+    , use_arena_(use_arena)
+{
+    SetStorageMode(use_arena_ ? StorageMode::kArena : StorageMode::kBlocks);
+}
+
+IsaBenchItemModel::~IsaBenchItemModel()
+{
+}
+
+void IsaBenchItemModel::UpdateData(void* data)
+{
+    const auto* blocks = static_cast<const std::vector<SourceBlock>*>(data);
+
+    beginResetModel();
+
+    blocks_.clear();
+    ClearRowStorage();
+
+    if (blocks != nullptr)
+    {
+        for (const auto& source_block : *blocks)
+        {
+            const bool is_comment_block = source_block.row_type == RowType::kComment;
+
+            if (use_arena_)
+            {
+                if (is_comment_block)
+                {
+                    AppendCommentBlock(source_block.line_number, source_block.text);
+                }
+                else
+                {
+                    AppendCodeBlock(source_block.line_number, source_block.text);
+                }
+
+                for (const auto& source_row : source_block.rows)
+                {
+                    if (source_row.row_type == RowType::kComment)
+                    {
+                        AppendComment(source_row.line_number, source_row.text);
+                    }
+                    else
+                    {
+                        AppendInstruction(source_row.line_number,
+                                          source_row.text,
+                                          source_row.operands,
+                                          source_row.pc_address,
+                                          source_row.binary_representation,
+                                          source_row.enabled);
+                    }
+                }
+
+                continue;
+            }
+
+            const int              position = static_cast<int>(blocks_.size());
+            std::shared_ptr<Block> block;
+
+            if (is_comment_block)
+            {
+                block = std::make_shared<CommentBlock>(position, source_block.line_number, source_block.text);
+            }
+            else
+            {
+                block = std::make_shared<InstructionBlock>(position, source_block.line_number, source_block.text);
+            }
+
+            block->instruction_lines.reserve(source_block.rows.size());
+
+            for (const auto& source_row : source_block.rows)
+            {
+                if (source_row.row_type == RowType::kComment)
+                {
+                    block->instruction_lines.push_back(std::make_shared<CommentRow>(source_row.line_number, source_row.text));
+                    continue;
+                }
+
+                auto instruction =
+                    std::make_shared<InstructionRow>(source_row.line_number, source_row.text, source_row.pc_address, source_row.binary_representation);
+
+                instruction->enabled = source_row.enabled;
+
+                ParseSelectableTokens(
+                    source_row.text, instruction->op_code_token, source_row.operands, instruction->operand_tokens, fixed_font_character_width_);
+
+                block->instruction_lines.push_back(std::move(instruction));
+            }
+
+            blocks_.push_back(std::move(block));
+        }
+    }
+
+    endResetModel();
+}
+
+size_t IsaBenchItemModel::ParseAllSelectableTokens(const std::vector<SourceBlock>& blocks) const
+{
+    size_t                          token_count = 0;
+    Token                           op_code_token;
+    std::vector<std::vector<Token>> operand_tokens;
+
+    for (const auto& block : blocks)
+    {
+        for (const auto& row : block.rows)
+        {
+            if (row.row_type == RowType::kComment)
+            {
+                continue;
+            }
+
+            op_code_token.Clear();
+            operand_tokens.clear();
+
+            ParseSelectableTokens(row.text, op_code_token, row.operands, operand_tokens, fixed_font_character_width_);
+
+            for (const auto& operand : operand_tokens)
+            {
+                token_count += operand.size();
+            }
+        }
+    }
+
+    return token_count;
+}
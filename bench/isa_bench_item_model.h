@@ -0,0 +1,72 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for an isa item model that shows generated shaders, to benchmark the isa widgets with.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_BENCH_ITEM_MODEL_H_
+#define QTISAGUI_ISA_BENCH_ITEM_MODEL_H_
+
+#include <vector>
+
+#include "qt_isa_gui/widgets/isa_item_model.h"
+
+/// @brief IsaBenchItemModel fills an isa item model the way an application's UpdateData would, and opens up the steps
+///        that follow it so they can be timed one by one.
+class IsaBenchItemModel final : public IsaItemModel
+{
+public:
+    /// @brief Constructor.
+    ///
+    /// @param [in] use_arena true to store rows with StorageMode::kArena, false to store them in blocks_.
+    explicit IsaBenchItemModel(bool use_arena);
+
+    /// @brief Destructor.
+    ~IsaBenchItemModel();
+
+    /// @brief Replace all rows of this model.
+    ///
+    /// Only stores and tokenizes the rows; call MapBranches and CacheSizeHints after, as an application would.
+    ///
+    /// @param [in] data A pointer to the const std::vector<IsaItemModel::SourceBlock> to show.
+    void UpdateData(void* data) Q_DECL_OVERRIDE;
+
+    /// @brief Tokenize every instruction of a shader without storing it.
+    ///
+    /// @param [in] blocks The blocks of the shader.
+    ///
+    /// @return The number of operand tokens, so the work can't be optimized away.
+    size_t ParseAllSelectableTokens(const std::vector<SourceBlock>& blocks) const;
+
+    /// @brief Replace all rows of this model, parsing only the blocks that changed; see IsaItemModel::UpdateBlocks.
+    ///
+    /// @param [in] blocks The blocks of the shader.
+    inline void UpdateChangedBlocks(const std::vector<SourceBlock>& blocks)
+    {
+        UpdateBlocks(blocks);
+    }
+
+    /// @brief Replace all rows of this model with the rows of a model cache file, or parse them and write the file once the
+    ///        update finishes if there is none yet; see IsaItemModel::BeginCachedUpdate.
+    ///
+    /// @param [in] blocks          The blocks of the shader.
+    /// @param [in] cache_directory The directory of the cache files.
+    ///
+    /// @return true if the rows were read from the cache file.
+    inline bool UpdateFromCache(const std::vector<SourceBlock>& blocks, const QString& cache_directory)
+    {
+        return BeginCachedUpdate(blocks, amdisa::GpuArchitecture::kRdna3, cache_directory);
+    }
+
+    /// @brief Map the branch instructions of this model to their code blocks.
+    inline void MapBranches()
+    {
+        MapBlocksToBranchInstructions();
+    }
+
+private:
+    bool use_arena_;  ///< true if rows are stored with StorageMode::kArena.
+};
+
+#endif  // QTISAGUI_ISA_BENCH_ITEM_MODEL_H_
@@ -0,0 +1,356 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Benchmarks of ingesting, searching and painting generated shaders with the isa widgets.
+//=============================================================================
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QFontDatabase>
+#include <QImage>
+#include <QLineEdit>
+#include <QScrollBar>
+#include <QSignalBlocker>
+#include <QTemporaryDir>
+
+#include "qt_isa_gui/widgets/isa_tree_view.h"
+#include "qt_isa_gui/widgets/isa_widget.h"
+
+#include "isa_bench_item_model.h"
+#include "isa_bench_results.h"
+#include "isa_bench_shader_generator.h"
+
+namespace
+{
+    // Text searched for; common and rare register names, an op code, labels, and text that is never found.
+    const std::array<const char*, 5> kSearchQueries = {"v0", "s[4:5]", "s_waitcnt", "label_", "no_such_text"};
+
+    // The size of the window frames are painted in.
+    const QSize kFrameSize(1920, 1080);
+
+    /// @brief Parse a comma separated list of integers.
+    ///
+    /// @param [in] text The list.
+    ///
+    /// @return The integers; values that are not integers are skipped.
+    std::vector<int> ParseIntegerList(const QString& text)
+    {
+        std::vector<int> values;
+
+        for (const QString& value_text : text.split(',', Qt::SkipEmptyParts))
+        {
+            bool      ok    = false;
+            const int value = value_text.trimmed().toInt(&ok);
+
+            if (ok)
+            {
+                values.push_back(value);
+            }
+        }
+
+        return values;
+    }
+
+    /// @brief Pick source indices of evenly spaced lines, to stand in for search matches.
+    ///
+    /// @param [in] model       The model.
+    /// @param [in] match_count The number of lines to pick; all lines if there are fewer.
+    ///
+    /// @return The first column index of every picked line.
+    std::set<QModelIndex> PickLines(IsaItemModel& model, int match_count)
+    {
+        std::set<QModelIndex> indices;
+
+        const int line_count = model.GetLineCount();
+
+        if (line_count == 0 || match_count <= 0)
+        {
+            return indices;
+        }
+
+        const double step = static_cast<double>(line_count) / static_cast<double>(std::min(match_count, line_count));
+
+        for (double line = 0; line < line_count && static_cast<int>(indices.size()) < match_count; line += step)
+        {
+            indices.insert(model.GetLineNumberModelIndex(static_cast<int>(line)));
+        }
+
+        return indices;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    // Paint without a display unless a platform is picked explicitly.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication application(argc, argv);
+    QApplication::setApplicationName("qt_isa_gui_bench");
+
+    IsaBenchShaderGenerator::Options generator_options;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks of ingesting, searching and painting generated shaders; results are written as json.");
+    parser.addHelpOption();
+
+    const QCommandLineOption blocks_option("blocks", "Number of blocks.", "count", QString::number(generator_options.block_count));
+    const QCommandLineOption min_rows_option(
+        "min-rows", "Fewest rows of a code block.", "count", QString::number(generator_options.min_block_instruction_count));
+    const QCommandLineOption max_rows_option("max-rows", "Most rows of a code block.", "count", QString::number(generator_options.max_block_instruction_count));
+    const QCommandLineOption comments_option(
+        "comment-density", "Chance that a row is a comment.", "chance", QString::number(generator_options.comment_density));
+    const QCommandLineOption comment_blocks_option(
+        "comment-block-density", "Chance that a block is a comment block.", "chance", QString::number(generator_options.comment_block_density));
+    const QCommandLineOption scalar_option(
+        "scalar-registers", "Number of scalar registers.", "count", QString::number(generator_options.scalar_register_count));
+    const QCommandLineOption vector_option(
+        "vector-registers", "Number of vector registers.", "count", QString::number(generator_options.vector_register_count));
+    const QCommandLineOption ranges_option(
+        "range-ratio", "Chance that a register operand is a range.", "chance", QString::number(generator_options.register_range_ratio));
+    const QCommandLineOption mix_option("mix", "Weights of vector alu, scalar alu, memory, branch and wait instructions.", "weights", "40,25,20,5,10");
+    const QCommandLineOption seed_option("seed", "Seed of the generated shader.", "seed", QString::number(generator_options.seed));
+    const QCommandLineOption iterations_option("iterations", "Runs of every benchmark.", "count", "10");
+    const QCommandLineOption matches_option("matches", "Numbers of scroll bar markers to benchmark.", "counts", "100,10000,100000");
+    const QCommandLineOption arena_option("arena", "Store rows contiguously instead of one object per row.");
+    const QCommandLineOption filter_proxy_option("filter-proxy", "Hide columns with the sorting and filtering proxy model instead of the column proxy model.");
+    const QCommandLineOption output_option("output", "Write the json results to a file instead of the standard output.", "path");
+
+    parser.addOptions({blocks_option,
+                       min_rows_option,
+                       max_rows_option,
+                       comments_option,
+                       comment_blocks_option,
+                       scalar_option,
+                       vector_option,
+                       ranges_option,
+                       mix_option,
+                       seed_option,
+                       iterations_option,
+                       matches_option,
+                       arena_option,
+                       filter_proxy_option,
+                       output_option});
+    parser.process(application);
+
+    generator_options.block_count                 = parser.value(blocks_option).toInt();
+    generator_options.min_block_instruction_count = parser.value(min_rows_option).toInt();
+    generator_options.max_block_instruction_count = parser.value(max_rows_option).toInt();
+    generator_options.comment_density             = parser.value(comments_option).toDouble();
+    generator_options.comment_block_density       = parser.value(comment_blocks_option).toDouble();
+    generator_options.scalar_register_count       = parser.value(scalar_option).toInt();
+    generator_options.vector_register_count       = parser.value(vector_option).toInt();
+    generator_options.register_range_ratio        = parser.value(ranges_option).toDouble();
+    generator_options.seed                        = parser.value(seed_option).toUInt();
+
+    const std::vector<int> mix = ParseIntegerList(parser.value(mix_option));
+
+    for (size_t i = 0; i < mix.size() && i < generator_options.instruction_mix.size(); i++)
+    {
+        generator_options.instruction_mix[i] = mix[i];
+    }
+
+    const int              iterations   = std::max(parser.value(iterations_option).toInt(), 1);
+    const std::vector<int> match_counts = ParseIntegerList(parser.value(matches_option));
+    const bool             use_arena    = parser.isSet(arena_option);
+    const bool             use_filter   = parser.isSet(filter_proxy_option);
+    const QString          output_path  = parser.value(output_option);
+
+    // Generate the shader.
+
+    std::vector<IsaItemModel::SourceBlock> blocks;
+
+    IsaBenchShaderGenerator(generator_options).Generate(blocks);
+
+    size_t line_count        = 0;
+    size_t instruction_count = 0;
+
+    for (const auto& block : blocks)
+    {
+        line_count += 1 + block.rows.size();
+
+        for (const auto& row : block.rows)
+        {
+            instruction_count += (row.row_type == IsaItemModel::RowType::kCode) ? 1 : 0;
+        }
+    }
+
+    QJsonObject config;
+
+    config["blocks"]                = generator_options.block_count;
+    config["min_rows"]              = generator_options.min_block_instruction_count;
+    config["max_rows"]              = generator_options.max_block_instruction_count;
+    config["comment_density"]       = generator_options.comment_density;
+    config["comment_block_density"] = generator_options.comment_block_density;
+    config["scalar_registers"]      = generator_options.scalar_register_count;
+    config["vector_registers"]      = generator_options.vector_register_count;
+    config["range_ratio"]           = generator_options.register_range_ratio;
+    config["mix"]                   = parser.value(mix_option);
+    config["seed"]                  = static_cast<double>(generator_options.seed);
+    config["iterations"]            = iterations;
+    config["storage"]               = use_arena ? "arena" : "blocks";
+    config["proxy"]                 = use_filter ? "filter" : "column";
+    config["lines"]                 = static_cast<double>(line_count);
+    config["instructions"]          = static_cast<double>(instruction_count);
+
+    IsaBenchResults results(config);
+
+    // Set up the widget the way an application does; the model outlives the widget.
+
+    IsaBenchItemModel model(use_arena);
+    IsaWidget         widget;
+
+    widget.SetModelAndView(&widget, &model, nullptr, use_filter ? new IsaProxyModel : nullptr);
+    widget.resize(kFrameSize);
+    widget.show();
+
+    IsaTreeView* tree_view = widget.GetTreeView();
+
+    model.SetFixedFont(QFontDatabase::systemFont(QFontDatabase::FixedFont), tree_view);
+
+    // Ingestion.
+
+    results.Measure("parse_selectable_tokens", iterations, instruction_count, [&]() { model.ParseAllSelectableTokens(blocks); });
+    results.Measure("update_data", iterations, line_count, [&]() { model.UpdateData(&blocks); });
+    results.Measure("map_blocks_to_branch_instructions", iterations, blocks.size(), [&]() { model.MapBranches(); });
+    results.Measure("cache_size_hints", iterations, line_count, [&]() { model.CacheSizeHints(); });
+
+    if (!use_arena && !blocks.empty())
+    {
+        // A recompile that changes one block in the middle of the shader; alternate between the two versions.
+        std::vector<IsaItemModel::SourceBlock> recompiled_blocks = blocks;
+        IsaItemModel::SourceBlock&             changed_block     = recompiled_blocks[recompiled_blocks.size() / 2];
+
+        changed_block.rows.push_back(changed_block.rows.empty() ? IsaItemModel::SourceRow() : changed_block.rows.back());
+
+        // Blocks filled by UpdateData have no hash yet, so the first update parses every block.
+        model.UpdateChangedBlocks(blocks);
+
+        bool recompiled = false;
+
+        results.Measure("update_blocks", iterations, line_count, [&]() {
+            recompiled = !recompiled;
+            model.UpdateChangedBlocks(recompiled ? recompiled_blocks : blocks);
+        });
+
+        model.UpdateChangedBlocks(blocks);
+    }
+
+    QTemporaryDir cache_directory;
+
+    if (use_arena && !blocks.empty() && cache_directory.isValid())
+    {
+        // Reopening a shader that was shown before; the first update parses the blocks and writes the cache file.
+        model.UpdateFromCache(blocks, cache_directory.path());
+
+        while (model.IsAsyncUpdateRunning())
+        {
+            QApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        }
+
+        results.Measure("cached_update", iterations, line_count, [&]() { model.UpdateFromCache(blocks, cache_directory.path()); });
+
+        model.UpdateData(&blocks);
+        model.MapBranches();
+        model.CacheSizeHints();
+    }
+
+    widget.ExpandCollapseAll(true);
+    QApplication::processEvents();
+
+    // Search; set the text without starting the search timer, so only the search being timed runs.
+    // The model searches on worker threads, so every run waits for the last of its matches to be shown.
+
+    QLineEdit* search_line_edit = widget.findChild<QLineEdit*>("search_");
+
+    if (search_line_edit != nullptr)
+    {
+        for (const char* query : kSearchQueries)
+        {
+            {
+                const QSignalBlocker blocker(search_line_edit);
+                search_line_edit->setText(query);
+            }
+
+            results.Measure(QString("search/%1").arg(query), iterations, line_count, [&]() {
+                widget.Search();
+
+                while (model.IsSearching())
+                {
+                    QApplication::processEvents(QEventLoop::WaitForMoreEvents);
+                }
+            });
+        }
+    }
+
+    // Scroll bar markers of search matches.
+
+    auto* scroll_bar = tree_view->verticalScrollBar();
+
+    QImage scroll_bar_image(scroll_bar->size(), QImage::Format_ARGB32_Premultiplied);
+
+    for (const int match_count : match_counts)
+    {
+        const std::set<QModelIndex> matches = PickLines(model, match_count);
+        const QString               suffix  = QString::number(matches.size());
+
+        results.Measure("set_search_match_line_numbers/" + suffix, iterations, matches.size(), [&]() {
+            tree_view->SetSearchMatchLineNumbers("bench", matches);
+        });
+
+        // The first paint after the markers change has to lay them out; later paints should not.
+        results.Measure(
+            "scroll_bar_paint_after_change/" + suffix,
+            iterations,
+            matches.size(),
+            [&]() { scroll_bar->render(&scroll_bar_image); },
+            [&]() { tree_view->SetSearchMatchLineNumbers("bench", matches); });
+
+        results.Measure("scroll_bar_paint/" + suffix, iterations, matches.size(), [&]() { scroll_bar->render(&scroll_bar_image); });
+    }
+
+    // Paint frames of the tree view at different scroll positions; every visible cell goes through IsaItemDelegate::paint.
+
+    QWidget* viewport = tree_view->viewport();
+    QImage   frame_image(viewport->size(), QImage::Format_ARGB32_Premultiplied);
+    int      frame = 0;
+
+    results.Measure(
+        "paint_frame",
+        iterations,
+        0,
+        [&]() { viewport->render(&frame_image); },
+        [&]() {
+            // Scroll outside the timing, so only painting is measured.
+            scroll_bar->setValue(static_cast<int>((static_cast<qint64>(scroll_bar->maximum()) * (frame++ % 10)) / 10));
+            QApplication::processEvents();
+        });
+
+    const QByteArray json = results.ToJson();
+
+    if (output_path.isEmpty())
+    {
+        std::fwrite(json.constData(), 1, static_cast<size_t>(json.size()), stdout);
+        return 0;
+    }
+
+    QFile output_file(output_path);
+
+    if (!output_file.open(QIODevice::WriteOnly | QIODevice::Truncate) || output_file.write(json) != json.size())
+    {
+        std::fprintf(stderr, "Failed to write %s\n", qPrintable(output_path));
+        return 1;
+    }
+
+    return 0;
+}
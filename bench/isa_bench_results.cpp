@@ -0,0 +1,106 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the timings of a benchmark run, written as json so they can be tracked over time.
+//=============================================================================
+
+#include "isa_bench_results.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "version.h"
+
+IsaBenchResults::IsaBenchResults(const QJsonObject& config)
+    : config_(config)
+{
+}
+
+IsaBenchResults::~IsaBenchResults()
+{
+}
+
+void IsaBenchResults::Measure(const QString&               name,
+                              int                          iterations,
+                              size_t                       item_count,
+                              const std::function<void()>& run,
+                              const std::function<void()>& prepare)
+{
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(std::max(iterations, 1)));
+
+    for (int i = 0; i < std::max(iterations, 1); i++)
+    {
+        if (prepare)
+        {
+            prepare();
+        }
+
+        const Clock::time_point start = Clock::now();
+
+        run();
+
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    AddResult(name, std::move(samples), item_count);
+}
+
+void IsaBenchResults::AddResult(const QString& name, std::vector<double> samples, size_t item_count)
+{
+    if (samples.empty())
+    {
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const size_t middle = samples.size() / 2;
+    const double median = (samples.size() % 2 == 1) ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+    const double mean   = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+
+    QJsonObject result;
+
+    result["name"]       = name;
+    result["unit"]       = "ms";
+    result["iterations"] = static_cast<int>(samples.size());
+    result["min"]        = samples.front();
+    result["median"]     = median;
+    result["mean"]       = mean;
+    result["max"]        = samples.back();
+
+    if (item_count != 0)
+    {
+        result["items"] = static_cast<double>(item_count);
+
+        if (median > 0)
+        {
+            result["items_per_second"] = static_cast<double>(item_count) * 1000.0 / median;
+        }
+    }
+
+    results_.push_back(result);
+}
+
+QByteArray IsaBenchResults::ToJson() const
+{
+    QJsonArray results;
+
+    for (const auto& result : results_)
+    {
+        results.append(result);
+    }
+
+    QJsonObject document;
+
+    document["benchmark"] = "qt_isa_gui_bench";
+    document["version"]   = QTISAGUI_VERSION;
+    document["config"]    = config_;
+    document["results"]   = results;
+
+    return QJsonDocument(document).toJson(QJsonDocument::Indented);
+}
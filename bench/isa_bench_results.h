@@ -0,0 +1,67 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for the timings of a benchmark run, written as json so they can be tracked over time.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_BENCH_RESULTS_H_
+#define QTISAGUI_ISA_BENCH_RESULTS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+/// @brief IsaBenchResults times benchmarks and collects their statistics.
+///
+/// Written as a json document of the form {"benchmark", "version", "config": {...}, "results": [{"name", "unit",
+/// "iterations", "min", "median", "mean", "max", "items", "items_per_second"}, ...]}, with times in milliseconds.
+class IsaBenchResults
+{
+public:
+    /// @brief Constructor.
+    ///
+    /// @param [in] config The options the benchmarks were run with.
+    explicit IsaBenchResults(const QJsonObject& config);
+
+    /// @brief Destructor.
+    ~IsaBenchResults();
+
+    /// @brief Time a benchmark and add its statistics.
+    ///
+    /// @param [in] name       The name of the benchmark.
+    /// @param [in] iterations The number of times to run the benchmark; at least 1.
+    /// @param [in] item_count The number of items, like lines or matches, a single run goes over; 0 to skip the throughput.
+    /// @param [in] run        The benchmark; called iterations times.
+    /// @param [in] prepare    If set, called before every run without being timed.
+    void Measure(const QString&               name,
+                 int                          iterations,
+                 size_t                       item_count,
+                 const std::function<void()>& run,
+                 const std::function<void()>& prepare = nullptr);
+
+    /// @brief Add the statistics of a benchmark timed by the caller.
+    ///
+    /// @param [in] name       The name of the benchmark.
+    /// @param [in] samples    The time of every run, in milliseconds.
+    /// @param [in] item_count The number of items a single run goes over; 0 to skip the throughput.
+    void AddResult(const QString& name, std::vector<double> samples, size_t item_count);
+
+    /// @brief Get the json document of the results.
+    ///
+    /// @return The json text.
+    QByteArray ToJson() const;
+
+private:
+    using Clock = std::chrono::steady_clock;  ///< The clock to time benchmarks with.
+
+    QJsonObject              config_;   ///< The options the benchmarks were run with.
+    std::vector<QJsonObject> results_;  ///< The statistics of every benchmark, in the order they ran.
+};
+
+#endif  // QTISAGUI_ISA_BENCH_RESULTS_H_
@@ -0,0 +1,290 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for a generator of synthetic shaders to benchmark the isa widgets with.
+//=============================================================================
+
+#include "isa_bench_shader_generator.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    // Op codes of every kind of instruction; the operands are made to match their shape in MakeInstruction.
+    const std::array<const char*, 6> kVectorAluOpCodes = {"v_add_f32", "v_mul_f32", "v_fma_f32", "v_mov_b32", "v_cndmask_b32", "v_lshlrev_b32"};
+    const std::array<const char*, 4> kScalarAluOpCodes = {"s_mov_b32", "s_add_u32", "s_and_b64", "s_lshl_b32"};
+    const std::array<const char*, 3> kMemoryOpCodes    = {"global_load_dwordx4", "buffer_store_dword", "s_load_dwordx8"};
+    const std::array<const char*, 3> kBranchOpCodes    = {"s_cbranch_execz", "s_cbranch_scc1", "s_branch"};
+
+    // Branches mostly go to blocks close by, the way loops and if statements do.
+    const int kBranchDistance = 16;
+
+    /// @brief Format a number as hex digits.
+    ///
+    /// @param [in] value       The number.
+    /// @param [in] digit_count The number of digits, padded with zeros.
+    ///
+    /// @return The hex text.
+    std::string FormatHex(uint64_t value, int digit_count)
+    {
+        char buffer[32];
+
+        std::snprintf(buffer, sizeof(buffer), "%0*llX", digit_count, static_cast<unsigned long long>(value));
+
+        return buffer;
+    }
+}  // namespace
+
+IsaBenchShaderGenerator::IsaBenchShaderGenerator(const Options& options)
+    : options_(options)
+    , random_(options.seed)
+{
+}
+
+IsaBenchShaderGenerator::~IsaBenchShaderGenerator()
+{
+}
+
+void IsaBenchShaderGenerator::Generate(std::vector<IsaItemModel::SourceBlock>& blocks)
+{
+    blocks.clear();
+    random_.seed(options_.seed);
+
+    const int block_count = std::max(options_.block_count, 0);
+
+    // Pick every label first, so branches can go forward as well as back.
+
+    block_labels_.assign(static_cast<size_t>(block_count), std::string());
+
+    for (int block_index = 0; block_index < block_count; block_index++)
+    {
+        if (block_index == 0 || !GetChance(options_.comment_block_density))
+        {
+            block_labels_[block_index] = "label_" + FormatHex(block_index, 4);
+        }
+    }
+
+    blocks.resize(static_cast<size_t>(block_count));
+
+    const int min_row_count = std::max(options_.min_block_instruction_count, 0);
+    const int max_row_count = std::max(options_.max_block_instruction_count, min_row_count);
+
+    uint32_t line_number = 0;
+    uint64_t pc_address  = 0;
+
+    for (int block_index = 0; block_index < block_count; block_index++)
+    {
+        auto& block = blocks[block_index];
+
+        block.line_number = line_number++;
+
+        if (block_labels_[block_index].empty())
+        {
+            // Comment blocks hold a few lines of comments, like the header of a shader.
+            block.row_type = IsaItemModel::RowType::kComment;
+            block.text     = "// Synthetic comment block " + std::to_string(block_index);
+
+            const int comment_count = 1 + static_cast<int>(GetRandom(4));
+
+            for (int i = 0; i < comment_count; i++)
+            {
+                IsaItemModel::SourceRow row;
+
+                row.row_type    = IsaItemModel::RowType::kComment;
+                row.line_number = line_number++;
+                row.text        = "// Synthetic comment " + std::to_string(i);
+
+                block.rows.push_back(std::move(row));
+            }
+
+            continue;
+        }
+
+        block.row_type = IsaItemModel::RowType::kCode;
+        block.text     = block_labels_[block_index];
+
+        const int row_count = min_row_count + static_cast<int>(GetRandom(static_cast<uint32_t>(max_row_count - min_row_count + 1)));
+
+        block.rows.resize(row_count);
+
+        for (auto& row : block.rows)
+        {
+            row.line_number = line_number++;
+
+            if (GetChance(options_.comment_density))
+            {
+                row.row_type = IsaItemModel::RowType::kComment;
+                row.text     = "// Synthetic comment at line " + std::to_string(row.line_number);
+                continue;
+            }
+
+            const InstructionKind kind = PickInstructionKind();
+
+            MakeInstruction(kind, block_index, row);
+
+            // Memory instructions take two dwords, everything else one.
+            const bool is_wide = kind == kMemory;
+
+            row.pc_address            = FormatHex(pc_address, 12);
+            row.binary_representation = FormatHex(random_(), 8);
+
+            if (is_wide)
+            {
+                row.binary_representation += " " + FormatHex(random_(), 8);
+            }
+
+            pc_address += is_wide ? 8 : 4;
+        }
+    }
+}
+
+uint32_t IsaBenchShaderGenerator::GetRandom(uint32_t count)
+{
+    return (count == 0) ? 0 : static_cast<uint32_t>(random_() % count);
+}
+
+bool IsaBenchShaderGenerator::GetChance(double chance)
+{
+    return static_cast<double>(random_()) < chance * static_cast<double>(std::mt19937::max());
+}
+
+std::string IsaBenchShaderGenerator::MakeRegister(const char* prefix, int register_count, int range_size)
+{
+    if (range_size == 1 && GetChance(options_.register_range_ratio))
+    {
+        range_size = GetChance(0.5) ? 2 : 4;
+    }
+
+    // Ranges start at a multiple of their size, the way registers are allocated.
+    const int range_count = std::max(register_count / range_size, 1);
+    const int first       = static_cast<int>(GetRandom(static_cast<uint32_t>(range_count))) * range_size;
+
+    if (range_size == 1)
+    {
+        return prefix + std::to_string(first);
+    }
+
+    return std::string(prefix) + "[" + std::to_string(first) + ":" + std::to_string(first + range_size - 1) + "]";
+}
+
+void IsaBenchShaderGenerator::MakeInstruction(InstructionKind kind, size_t block_index, IsaItemModel::SourceRow& row)
+{
+    const int s_count = std::max(options_.scalar_register_count, 1);
+    const int v_count = std::max(options_.vector_register_count, 1);
+
+    row.row_type = IsaItemModel::RowType::kCode;
+    row.operands.clear();
+
+    switch (kind)
+    {
+    case kVectorAlu:
+        row.text = kVectorAluOpCodes[GetRandom(static_cast<uint32_t>(kVectorAluOpCodes.size()))];
+        row.operands.push_back(MakeRegister("v", v_count));
+        row.operands.push_back(GetChance(0.3) ? MakeRegister("s", s_count) : MakeRegister("v", v_count));
+
+        if (GetChance(0.2))
+        {
+            row.operands.push_back(std::to_string(GetRandom(64)));
+        }
+        else
+        {
+            row.operands.push_back(MakeRegister("v", v_count));
+        }
+
+        break;
+
+    case kScalarAlu:
+        row.text = kScalarAluOpCodes[GetRandom(static_cast<uint32_t>(kScalarAluOpCodes.size()))];
+        row.operands.push_back(MakeRegister("s", s_count));
+        row.operands.push_back(MakeRegister("s", s_count));
+        row.operands.push_back(GetChance(0.5) ? "0x" + FormatHex(GetRandom(0x10000), 4) : MakeRegister("s", s_count));
+        break;
+
+    case kMemory:
+    {
+        const uint32_t op_code_index = GetRandom(static_cast<uint32_t>(kMemoryOpCodes.size()));
+
+        row.text = kMemoryOpCodes[op_code_index];
+
+        if (op_code_index == 0)
+        {
+            row.operands = {MakeRegister("v", v_count, 4), MakeRegister("v", v_count, 2), "off"};
+        }
+        else if (op_code_index == 1)
+        {
+            row.operands = {MakeRegister("v", v_count), MakeRegister("v", v_count), MakeRegister("s", s_count, 4), "0 offen"};
+        }
+        else
+        {
+            row.operands = {MakeRegister("s", s_count, 8), MakeRegister("s", s_count, 2), "0x" + FormatHex(GetRandom(0x100) * 4, 2)};
+        }
+
+        break;
+    }
+
+    case kBranch:
+    {
+        // Branch to a code block near this one.
+        const int block_count = static_cast<int>(block_labels_.size());
+        const int first       = std::max(static_cast<int>(block_index) - kBranchDistance, 0);
+        const int last        = std::min(static_cast<int>(block_index) + kBranchDistance, block_count - 1);
+        int       target      = first + static_cast<int>(GetRandom(static_cast<uint32_t>(last - first + 1)));
+
+        if (block_labels_[target].empty())
+        {
+            // Comment blocks can't be branched to; block 0 always has a label.
+            target = 0;
+        }
+
+        row.text = kBranchOpCodes[GetRandom(static_cast<uint32_t>(kBranchOpCodes.size()))];
+        row.operands.push_back(block_labels_[target]);
+        break;
+    }
+
+    case kWait:
+    default:
+        if (GetChance(0.8))
+        {
+            row.text = "s_waitcnt";
+            row.operands.push_back(GetChance(0.5) ? "vmcnt(0)" : "lgkmcnt(0)");
+        }
+        else
+        {
+            row.text = "s_nop";
+            row.operands.push_back(std::to_string(GetRandom(8)));
+        }
+
+        break;
+    }
+}
+
+IsaBenchShaderGenerator::InstructionKind IsaBenchShaderGenerator::PickInstructionKind()
+{
+    int total_weight = 0;
+
+    for (const int weight : options_.instruction_mix)
+    {
+        total_weight += std::max(weight, 0);
+    }
+
+    if (total_weight == 0)
+    {
+        return kVectorAlu;
+    }
+
+    int pick = static_cast<int>(GetRandom(static_cast<uint32_t>(total_weight)));
+
+    for (int kind = 0; kind < kInstructionKindCount; kind++)
+    {
+        pick -= std::max(options_.instruction_mix[kind], 0);
+
+        if (pick < 0)
+        {
+            return static_cast<InstructionKind>(kind);
+        }
+    }
+
+    return kVectorAlu;
+}
@@ -0,0 +1,107 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for a generator of synthetic shaders to benchmark the isa widgets with.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_BENCH_SHADER_GENERATOR_H_
+#define QTISAGUI_ISA_BENCH_SHADER_GENERATOR_H_
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "qt_isa_gui/widgets/isa_item_model.h"
+
+/// @brief IsaBenchShaderGenerator makes shaders that look like disassembly, of any size, without needing real shaders.
+///
+/// The same options and seed always give the same shader, so results of different builds can be compared.
+class IsaBenchShaderGenerator
+{
+public:
+    /// @brief Predefined kinds of instructions in the instruction mix.
+    enum InstructionKind
+    {
+        kVectorAlu = 0,  ///< Vector alu instructions, like v_fma_f32.
+        kScalarAlu,      ///< Scalar alu instructions, like s_and_b64.
+        kMemory,         ///< Scalar and vector memory instructions, like global_load_dwordx4.
+        kBranch,         ///< Branches to other code blocks, like s_cbranch_execz.
+        kWait,           ///< Waits and nops, like s_waitcnt.
+        kInstructionKindCount
+    };
+
+    /// @brief The shape of a generated shader.
+    struct Options
+    {
+        int                                    block_count                 = 2000;                 ///< The number of blocks.
+        int                                    min_block_instruction_count = 4;                    ///< The fewest rows of a code block.
+        int                                    max_block_instruction_count = 200;                  ///< The most rows of a code block.
+        double                                 comment_density             = 0.05;                 ///< The chance that a row is a comment.
+        double                                 comment_block_density       = 0.02;                 ///< The chance that a block is a comment block.
+        int                                    scalar_register_count       = 106;                  ///< Scalar registers s0 and up are used.
+        int                                    vector_register_count       = 256;                  ///< Vector registers v0 and up are used.
+        double                                 register_range_ratio        = 0.2;                  ///< The chance that a register operand is a range.
+        std::array<int, kInstructionKindCount> instruction_mix             = {40, 25, 20, 5, 10};  ///< Relative weight of every kind.
+        uint32_t                               seed                        = 1;                    ///< The seed of the random numbers.
+    };
+
+    /// @brief Constructor.
+    ///
+    /// @param [in] options The shape of the shaders to generate.
+    explicit IsaBenchShaderGenerator(const Options& options);
+
+    /// @brief Destructor.
+    ~IsaBenchShaderGenerator();
+
+    /// @brief Generate a shader.
+    ///
+    /// @param [out] blocks The blocks of the shader; cleared first.
+    void Generate(std::vector<IsaItemModel::SourceBlock>& blocks);
+
+private:
+    /// @brief Get a random number.
+    ///
+    /// Uses the raw output of the engine rather than a distribution, whose results differ between standard libraries.
+    ///
+    /// @param [in] count The number of possible values.
+    ///
+    /// @return A number from 0 up to count.
+    uint32_t GetRandom(uint32_t count);
+
+    /// @brief Roll for a chance.
+    ///
+    /// @param [in] chance The chance, from 0 to 1.
+    ///
+    /// @return true with the given chance.
+    bool GetChance(double chance);
+
+    /// @brief Make a register operand.
+    ///
+    /// @param [in] prefix         "s" for scalar registers, "v" for vector registers.
+    /// @param [in] register_count The number of registers to pick from.
+    /// @param [in] range_size     The number of registers of an operand that is always a range, or 1 to roll for a range.
+    ///
+    /// @return The operand, like v4 or v[4:7].
+    std::string MakeRegister(const char* prefix, int register_count, int range_size = 1);
+
+    /// @brief Fill in the op code and operands of an instruction.
+    ///
+    /// @param [in]  kind        The kind of instruction.
+    /// @param [in]  block_index The block of the instruction, to pick branch targets near it.
+    /// @param [out] row         The row to fill in.
+    void MakeInstruction(InstructionKind kind, size_t block_index, IsaItemModel::SourceRow& row);
+
+    /// @brief Pick a kind of instruction from the instruction mix.
+    ///
+    /// @return The kind of instruction.
+    InstructionKind PickInstructionKind();
+
+    Options                  options_;       ///< The shape of the shaders to generate.
+    std::mt19937             random_;        ///< The random numbers.
+    std::vector<std::string> block_labels_;  ///< The label of every block of the shader being generated; empty for comment blocks.
+};
+
+#endif  // QTISAGUI_ISA_BENCH_SHADER_GENERATOR_H_
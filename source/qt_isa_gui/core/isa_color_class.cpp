@@ -0,0 +1,149 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for classifying isa text by the color it is coded with.
+//=============================================================================
+
+#include "isa_color_class.h"
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    /// @brief A prefix of isa text and the color class of text that starts with it.
+    struct ColorClassPrefix
+    {
+        std::string_view prefix;       ///< The prefix.
+        IsaColorClass    color_class;  ///< The color class of text that starts with the prefix.
+    };
+
+    // Every known prefix, sorted so it can be binary searched.
+    constexpr std::array<ColorClassPrefix, 47> kColorClassPrefixes = {{{"-s", IsaColorClass::kScalar},  // Scalar register negative value.
+                                                                       {"-v", IsaColorClass::kVector},  // Vector register negative value.
+                                                                       {"//", IsaColorClass::kComment},
+                                                                       {"[s", IsaColorClass::kScalar},  // Scalar register range.
+                                                                       {"[v", IsaColorClass::kVector},  // Vector register range.
+                                                                       {"buffer_", IsaColorClass::kVectorMemory},
+                                                                       {"ds_", IsaColorClass::kLocalDataShare},
+                                                                       {"expcnt", IsaColorClass::kWaitCount},
+                                                                       {"global_load", IsaColorClass::kVectorMemory},
+                                                                       {"idxen", IsaColorClass::kVectorMemory},
+                                                                       {"image_", IsaColorClass::kVectorMemory},
+                                                                       {"lgkmcnt", IsaColorClass::kWaitCount},
+                                                                       {"s0", IsaColorClass::kScalar},
+                                                                       {"s1", IsaColorClass::kScalar},
+                                                                       {"s2", IsaColorClass::kScalar},
+                                                                       {"s3", IsaColorClass::kScalar},
+                                                                       {"s4", IsaColorClass::kScalar},
+                                                                       {"s5", IsaColorClass::kScalar},
+                                                                       {"s6", IsaColorClass::kScalar},
+                                                                       {"s7", IsaColorClass::kScalar},
+                                                                       {"s8", IsaColorClass::kScalar},
+                                                                       {"s9", IsaColorClass::kScalar},
+                                                                       {"s[", IsaColorClass::kScalar},  // Scalar register.
+                                                                       {"s_", IsaColorClass::kScalar},
+                                                                       {"s_branch", IsaColorClass::kBranch},
+                                                                       {"s_buffer", IsaColorClass::kScalarMemory},
+                                                                       {"s_cbranch", IsaColorClass::kBranch},
+                                                                       {"s_load", IsaColorClass::kScalarMemory},
+                                                                       {"s_setpc", IsaColorClass::kBranch},
+                                                                       {"s_swap", IsaColorClass::kBranch},
+                                                                       {"s_waitcnt", IsaColorClass::kWaitCount},
+                                                                       {"tbuffer_", IsaColorClass::kVectorMemory},
+                                                                       {"v0", IsaColorClass::kVector},
+                                                                       {"v1", IsaColorClass::kVector},
+                                                                       {"v2", IsaColorClass::kVector},
+                                                                       {"v3", IsaColorClass::kVector},
+                                                                       {"v4", IsaColorClass::kVector},
+                                                                       {"v5", IsaColorClass::kVector},
+                                                                       {"v6", IsaColorClass::kVector},
+                                                                       {"v7", IsaColorClass::kVector},
+                                                                       {"v8", IsaColorClass::kVector},
+                                                                       {"v9", IsaColorClass::kVector},
+                                                                       {"v[", IsaColorClass::kVector},  // Vector register.
+                                                                       {"v_", IsaColorClass::kVector},
+                                                                       {"vmcnt", IsaColorClass::kWaitCount},
+                                                                       {"|s", IsaColorClass::kScalar},  // Scalar register absolute value.
+                                                                       {"|v", IsaColorClass::kVector}}};  // Vector register absolute value.
+
+    /// @brief Check that the prefixes are sorted and distinct.
+    ///
+    /// @return true if every prefix is less than the next.
+    constexpr bool ColorClassPrefixesSorted()
+    {
+        for (size_t i = 1; i < kColorClassPrefixes.size(); i++)
+        {
+            if (!(kColorClassPrefixes[i - 1].prefix < kColorClassPrefixes[i].prefix))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(ColorClassPrefixesSorted(), "kColorClassPrefixes must be sorted");
+
+    /// @brief Get the length of the longest prefix.
+    ///
+    /// @return The length.
+    constexpr size_t MaxColorClassPrefixLength()
+    {
+        size_t max_length = 0;
+
+        for (const auto& color_class_prefix : kColorClassPrefixes)
+        {
+            max_length = std::max(max_length, color_class_prefix.prefix.size());
+        }
+
+        return max_length;
+    }
+
+    constexpr size_t kMaxColorClassPrefixLength = MaxColorClassPrefixLength();
+
+    /// @brief Find the first prefix that is not less than a string.
+    ///
+    /// @param [in] str The string.
+    ///
+    /// @return An iterator to the prefix, or the end of kColorClassPrefixes.
+    inline auto LowerBoundColorClassPrefix(std::string_view str)
+    {
+        return std::lower_bound(kColorClassPrefixes.begin(),
+                                kColorClassPrefixes.end(),
+                                str,
+                                [](const ColorClassPrefix& color_class_prefix, std::string_view value) { return color_class_prefix.prefix < value; });
+    }
+}  // namespace
+
+IsaColorClass IsaColorClassDictionary::GetColorClass(std::string_view str)
+{
+    if (str.empty())
+    {
+        return IsaColorClass::kNone;
+    }
+
+    // A string that is itself the start of a longer prefix only matches exactly;
+    // e.g. "s_b" is not highlighted even though it starts with "s_", while "s_bx" is.
+    const auto prefix_iter = LowerBoundColorClassPrefix(str);
+
+    if (prefix_iter != kColorClassPrefixes.end() && prefix_iter->prefix.substr(0, str.size()) == str)
+    {
+        return (prefix_iter->prefix.size() == str.size()) ? prefix_iter->color_class : IsaColorClass::kNone;
+    }
+
+    // Otherwise use the longest prefix the string starts with.
+    for (size_t length = std::min(kMaxColorClassPrefixLength, str.size()); length > 0; length--)
+    {
+        const std::string_view candidate      = str.substr(0, length);
+        const auto             candidate_iter = LowerBoundColorClassPrefix(candidate);
+
+        if (candidate_iter != kColorClassPrefixes.end() && candidate_iter->prefix == candidate)
+        {
+            return candidate_iter->color_class;
+        }
+    }
+
+    return IsaColorClass::kNone;
+}
@@ -0,0 +1,45 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for classifying isa text by the color it is coded with.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_COLOR_CLASS_H_
+#define QTISAGUI_ISA_COLOR_CLASS_H_
+
+#include <cstdint>
+#include <string_view>
+
+/// @brief The color coding classes of isa text; every class has its own color in every theme.
+enum class IsaColorClass : uint8_t
+{
+    kNone,            ///< Not color coded; uses the default text color.
+    kScalarMemory,    ///< Scalar memory instructions.
+    kWaitCount,       ///< Wait count instructions and counters.
+    kBranch,          ///< Branch and program counter instructions.
+    kLocalDataShare,  ///< Local data share instructions.
+    kVectorMemory,    ///< Vector memory instructions and modifiers.
+    kScalar,          ///< Other scalar instructions and scalar registers.
+    kVector,          ///< Other vector instructions and vector registers.
+    kComment,         ///< Comments.
+    kColorClassCount
+};
+
+/// @brief IsaColorClassDictionary finds the color class of isa text, without knowing the colors of any theme.
+///
+/// The colors themselves are looked up by IsaColorCodingDictionaryInstance::GetColor.
+class IsaColorClassDictionary
+{
+public:
+    /// @brief Find the color class of a string by the longest known prefix it starts with.
+    ///
+    /// Resolve it once when the string is parsed, so painting only has to look up the color of the class.
+    ///
+    /// @param [in] str The input string.
+    ///
+    /// @return The color class, or kNone if the string should not be highlighted.
+    static IsaColorClass GetColorClass(std::string_view str);
+};
+
+#endif  // QTISAGUI_ISA_COLOR_CLASS_H_
@@ -0,0 +1,206 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for a control flow graph of isa code blocks.
+//=============================================================================
+
+#include "isa_control_flow_graph.h"
+
+#include <array>
+#include <cassert>
+
+namespace
+{
+    /// @brief An op code prefix and how instructions that start with it change the flow of a shader.
+    struct BranchPrefix
+    {
+        std::string_view                prefix;       ///< The op code prefix.
+        IsaControlFlowGraph::BranchType branch_type;  ///< The branch type of op codes that start with the prefix.
+    };
+
+    // Checked in order; every op code of a family starts with the same prefix.
+    constexpr std::array<BranchPrefix, 6> kBranchPrefixes = {{{"s_branch", IsaControlFlowGraph::BranchType::kBranch},
+                                                              {"s_cbranch_", IsaControlFlowGraph::BranchType::kConditionalBranch},
+                                                              {"s_setpc", IsaControlFlowGraph::BranchType::kIndirectBranch},
+                                                              {"s_swappc", IsaControlFlowGraph::BranchType::kCall},
+                                                              {"s_call", IsaControlFlowGraph::BranchType::kCall},
+                                                              {"s_endpgm", IsaControlFlowGraph::BranchType::kEndProgram}}};
+
+    /// @brief Check if an edge is made by a branch to a label.
+    ///
+    /// @param [in] edge The edge.
+    ///
+    /// @return true for kBranch and kConditionalBranch edges.
+    inline bool IsBranchEdge(const IsaControlFlowGraph::Edge& edge)
+    {
+        return edge.kind == IsaControlFlowGraph::EdgeKind::kBranch || edge.kind == IsaControlFlowGraph::EdgeKind::kConditionalBranch;
+    }
+}  // namespace
+
+IsaControlFlowGraph::IsaControlFlowGraph()
+{
+}
+
+IsaControlFlowGraph::~IsaControlFlowGraph()
+{
+}
+
+IsaControlFlowGraph::BranchType IsaControlFlowGraph::GetBranchType(std::string_view op_code)
+{
+    for (const auto& branch_prefix : kBranchPrefixes)
+    {
+        if (op_code.substr(0, branch_prefix.prefix.size()) == branch_prefix.prefix)
+        {
+            return branch_prefix.branch_type;
+        }
+    }
+
+    return BranchType::kNone;
+}
+
+void IsaControlFlowGraph::Build(size_t block_count, const std::vector<Edge>& edges)
+{
+    successor_offsets_.assign(block_count + 1, 0);
+    predecessor_offsets_.assign(block_count + 1, 0);
+    branch_predecessor_counts_.assign(block_count, 0);
+
+    // Count the edges of every block, then turn the counts into offsets.
+
+    for (const auto& edge : edges)
+    {
+        assert(edge.source_block < block_count);
+
+        successor_offsets_[edge.source_block + 1]++;
+
+        if (edge.target_block != kInvalidIndex)
+        {
+            assert(edge.target_block < block_count);
+
+            predecessor_offsets_[edge.target_block + 1]++;
+
+            if (IsBranchEdge(edge))
+            {
+                branch_predecessor_counts_[edge.target_block]++;
+            }
+        }
+    }
+
+    for (size_t block = 0; block < block_count; block++)
+    {
+        successor_offsets_[block + 1] += successor_offsets_[block];
+        predecessor_offsets_[block + 1] += predecessor_offsets_[block];
+    }
+
+    // Place every edge; the order within a block stays the order of the edges given.
+
+    std::vector<uint32_t> successor_positions(successor_offsets_.begin(), successor_offsets_.end() - 1);
+    std::vector<uint32_t> branch_predecessor_positions(predecessor_offsets_.begin(), predecessor_offsets_.end() - 1);
+    std::vector<uint32_t> other_predecessor_positions(branch_predecessor_positions);
+
+    for (size_t block = 0; block < block_count; block++)
+    {
+        other_predecessor_positions[block] += branch_predecessor_counts_[block];
+    }
+
+    successors_.resize(edges.size());
+    predecessors_.resize(predecessor_offsets_.back());
+
+    for (const auto& edge : edges)
+    {
+        successors_[successor_positions[edge.source_block]++] = edge;
+
+        if (edge.target_block != kInvalidIndex)
+        {
+            auto& predecessor_positions = IsBranchEdge(edge) ? branch_predecessor_positions : other_predecessor_positions;
+
+            predecessors_[predecessor_positions[edge.target_block]++] = edge;
+        }
+    }
+}
+
+void IsaControlFlowGraph::Clear()
+{
+    successor_offsets_.clear();
+    successors_.clear();
+    predecessor_offsets_.clear();
+    predecessors_.clear();
+    branch_predecessor_counts_.clear();
+}
+
+IsaControlFlowGraph::EdgeRange IsaControlFlowGraph::GetSuccessors(uint32_t block) const
+{
+    assert(block < GetBlockCount());
+
+    return EdgeRange(successors_.data() + successor_offsets_[block], successors_.data() + successor_offsets_[block + 1]);
+}
+
+IsaControlFlowGraph::EdgeRange IsaControlFlowGraph::GetPredecessors(uint32_t block) const
+{
+    assert(block < GetBlockCount());
+
+    return EdgeRange(predecessors_.data() + predecessor_offsets_[block], predecessors_.data() + predecessor_offsets_[block + 1]);
+}
+
+IsaControlFlowGraph::EdgeRange IsaControlFlowGraph::GetBranchPredecessors(uint32_t block) const
+{
+    assert(block < GetBlockCount());
+
+    const Edge* first = predecessors_.data() + predecessor_offsets_[block];
+
+    return EdgeRange(first, first + branch_predecessor_counts_[block]);
+}
+
+bool IsaControlFlowGraph::IsReachable(uint32_t from_block, uint32_t to_block) const
+{
+    if (from_block >= GetBlockCount() || to_block >= GetBlockCount())
+    {
+        return false;
+    }
+
+    std::vector<bool> visited;
+
+    return Traverse(from_block, to_block, visited);
+}
+
+void IsaControlFlowGraph::GetReachableBlocks(uint32_t from_block, std::vector<bool>& reachable) const
+{
+    if (from_block >= GetBlockCount())
+    {
+        reachable.assign(GetBlockCount(), false);
+        return;
+    }
+
+    Traverse(from_block, kInvalidIndex, reachable);
+}
+
+bool IsaControlFlowGraph::Traverse(uint32_t from_block, uint32_t to_block, std::vector<bool>& visited) const
+{
+    visited.assign(GetBlockCount(), false);
+
+    std::vector<uint32_t> pending_blocks = {from_block};
+
+    visited[from_block] = true;
+
+    while (!pending_blocks.empty())
+    {
+        const uint32_t block = pending_blocks.back();
+        pending_blocks.pop_back();
+
+        if (block == to_block)
+        {
+            return true;
+        }
+
+        for (const auto& edge : GetSuccessors(block))
+        {
+            if (edge.target_block != kInvalidIndex && !visited[edge.target_block])
+            {
+                visited[edge.target_block] = true;
+                pending_blocks.push_back(edge.target_block);
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,219 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for a control flow graph of isa code blocks.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_CONTROL_FLOW_GRAPH_H_
+#define QTISAGUI_ISA_CONTROL_FLOW_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+/// @brief IsaControlFlowGraph keeps the edges between the blocks of a shader.
+///
+/// Successors and predecessors of every block are stored contiguously in compressed sparse row arrays,
+/// so iterating the edges of a block is O(degree) and does not allocate.
+class IsaControlFlowGraph
+{
+public:
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();  ///< A block or row that does not exist.
+
+    /// @brief How an instruction changes the flow of a shader.
+    enum class BranchType : uint8_t
+    {
+        kNone,               ///< Not a branch; execution continues with the next instruction.
+        kBranch,             ///< Unconditional branch to a label.
+        kConditionalBranch,  ///< Conditional branch to a label; execution may continue with the next instruction.
+        kIndirectBranch,     ///< Jump to an address in registers; the target is not known.
+        kCall,               ///< Call of an address in registers; execution continues with the next instruction on return.
+        kEndProgram,         ///< End of the shader.
+    };
+
+    /// @brief The kind of an edge between two blocks.
+    enum class EdgeKind : uint8_t
+    {
+        kFallThrough,        ///< The source block runs into the target block.
+        kBranch,             ///< An unconditional branch of the source block targets the target block.
+        kConditionalBranch,  ///< A conditional branch of the source block targets the target block.
+        kCallReturn,         ///< The source block ends with a call that returns into the target block.
+        kIndirect,           ///< An indirect branch of the source block; the target block is kInvalidIndex.
+    };
+
+    /// @brief An edge between two blocks.
+    struct Edge
+    {
+        uint32_t source_block;  ///< The block the edge starts in.
+        uint32_t source_row;    ///< The row of the instruction in the source block that makes the edge, or kInvalidIndex for a fall through.
+        uint32_t target_block;  ///< The block the edge goes to, or kInvalidIndex if it is not known.
+        EdgeKind kind;          ///< The kind of edge.
+    };
+
+    /// @brief A range of edges of a block.
+    class EdgeRange
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in] first The first edge.
+        /// @param [in] last  One past the last edge.
+        EdgeRange(const Edge* first, const Edge* last)
+            : first_(first)
+            , last_(last)
+        {
+        }
+
+        /// @brief Get the first edge.
+        ///
+        /// @return The first edge.
+        inline const Edge* begin() const
+        {
+            return first_;
+        }
+
+        /// @brief Get one past the last edge.
+        ///
+        /// @return One past the last edge.
+        inline const Edge* end() const
+        {
+            return last_;
+        }
+
+        /// @brief Get the number of edges.
+        ///
+        /// @return The number of edges.
+        inline size_t size() const
+        {
+            return static_cast<size_t>(last_ - first_);
+        }
+
+        /// @brief Check if there are no edges.
+        ///
+        /// @return true if there are no edges.
+        inline bool empty() const
+        {
+            return first_ == last_;
+        }
+
+        /// @brief Get an edge.
+        ///
+        /// @param [in] index The index of the edge, less than size.
+        ///
+        /// @return The edge.
+        inline const Edge& operator[](size_t index) const
+        {
+            return first_[index];
+        }
+
+    private:
+        const Edge* first_;  ///< The first edge.
+        const Edge* last_;   ///< One past the last edge.
+    };
+
+    /// @brief Constructor; create an empty graph.
+    IsaControlFlowGraph();
+
+    /// @brief Destructor.
+    ~IsaControlFlowGraph();
+
+    /// @brief Find how an instruction changes the flow of a shader from its op code.
+    ///
+    /// @param [in] op_code The op code text.
+    ///
+    /// @return The branch type.
+    static BranchType GetBranchType(std::string_view op_code);
+
+    /// @brief Check if a branch type takes the label of its target as its first operand.
+    ///
+    /// @param [in] branch_type The branch type.
+    ///
+    /// @return true for branches to a label.
+    static inline bool IsLabelBranch(BranchType branch_type)
+    {
+        return branch_type == BranchType::kBranch || branch_type == BranchType::kConditionalBranch;
+    }
+
+    /// @brief Replace all edges.
+    ///
+    /// @param [in] block_count The number of blocks, including blocks without edges.
+    /// @param [in] edges       Every edge, in shader order of their source instruction; fall through edges last in their block.
+    void Build(size_t block_count, const std::vector<Edge>& edges);
+
+    /// @brief Remove all blocks and edges.
+    void Clear();
+
+    /// @brief Get the number of blocks.
+    ///
+    /// @return The number of blocks.
+    inline size_t GetBlockCount() const
+    {
+        return branch_predecessor_counts_.size();
+    }
+
+    /// @brief Get every edge, grouped by source block.
+    ///
+    /// Building a graph with the same block count from these edges gives this graph again.
+    ///
+    /// @return The edges.
+    inline const std::vector<Edge>& GetEdges() const
+    {
+        return successors_;
+    }
+
+    /// @brief Get the edges out of a block, in shader order.
+    ///
+    /// @param [in] block The block, less than GetBlockCount.
+    ///
+    /// @return The edges.
+    EdgeRange GetSuccessors(uint32_t block) const;
+
+    /// @brief Get the edges into a block; branches come first, in shader order.
+    ///
+    /// @param [in] block The block, less than GetBlockCount.
+    ///
+    /// @return The edges.
+    EdgeRange GetPredecessors(uint32_t block) const;
+
+    /// @brief Get the branch instructions that target a block, in shader order.
+    ///
+    /// @param [in] block The block, less than GetBlockCount.
+    ///
+    /// @return The kBranch and kConditionalBranch edges into the block.
+    EdgeRange GetBranchPredecessors(uint32_t block) const;
+
+    /// @brief Check if a block can be reached from another block by following edges.
+    ///
+    /// @param [in] from_block The block to start from.
+    /// @param [in] to_block   The block to reach.
+    ///
+    /// @return true if to_block is from_block or can be reached from it.
+    bool IsReachable(uint32_t from_block, uint32_t to_block) const;
+
+    /// @brief Find every block that can be reached from a block by following edges.
+    ///
+    /// @param [in]  from_block The block to start from.
+    /// @param [out] reachable  true for every block that can be reached, including from_block; sized to GetBlockCount.
+    void GetReachableBlocks(uint32_t from_block, std::vector<bool>& reachable) const;
+
+private:
+    /// @brief Follow edges from a block until a block is reached or every reachable block is visited.
+    ///
+    /// @param [in]  from_block The block to start from.
+    /// @param [in]  to_block   The block to stop at, or kInvalidIndex to visit every reachable block.
+    /// @param [out] visited    true for every visited block.
+    ///
+    /// @return true if to_block was reached.
+    bool Traverse(uint32_t from_block, uint32_t to_block, std::vector<bool>& visited) const;
+
+    std::vector<uint32_t> successor_offsets_;          ///< Per block offset into successors_, plus the edge count.
+    std::vector<Edge>     successors_;                 ///< Edges grouped by source block.
+    std::vector<uint32_t> predecessor_offsets_;        ///< Per block offset into predecessors_, plus the edge count.
+    std::vector<Edge>     predecessors_;               ///< Edges with a known target, grouped by target block.
+    std::vector<uint32_t> branch_predecessor_counts_;  ///< The number of branch edges at the start of the predecessors of every block.
+};
+
+#endif  // QTISAGUI_ISA_CONTROL_FLOW_GRAPH_H_
@@ -0,0 +1,315 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for shared, thread safe isa decoders of every architecture.
+//=============================================================================
+
+#include "isa_decoder_registry.h"
+
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    // How often WaitUntilLoaded checks if it was canceled.
+    constexpr std::chrono::milliseconds kLoadWaitInterval(20);
+
+    /// @brief Get the lock and decoders of the registry.
+    ///
+    /// @param [out] registry_mutex The lock that guards the decoders.
+    ///
+    /// @return Every decoder that is held by someone, by architecture.
+    std::unordered_map<amdisa::GpuArchitecture, std::weak_ptr<IsaArchitectureDecoder>>& GetRegistry(std::mutex*& registry_mutex)
+    {
+        static std::mutex                                                                         mutex;
+        static std::unordered_map<amdisa::GpuArchitecture, std::weak_ptr<IsaArchitectureDecoder>> decoders;
+
+        registry_mutex = &mutex;
+
+        return decoders;
+    }
+
+    /// @brief LoadThreads keeps the threads that parse isa specs, so they can be joined before the process exits.
+    ///
+    /// Releasing a decoder never waits for its load thread; only WaitForLoading and the end of the process do.
+    class LoadThreads
+    {
+    public:
+        /// @brief Destructor; waits for every load thread, in case WaitForLoading was not called.
+        ~LoadThreads()
+        {
+            Join();
+        }
+
+        /// @brief Start a load thread, and join the load threads that are done.
+        ///
+        /// @param [in] load The function to run on the thread.
+        void Start(std::function<void()> load)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            for (auto thread_iter = threads_.begin(); thread_iter != threads_.end();)
+            {
+                if (*thread_iter->done)
+                {
+                    // Done is set as the thread returns, so this does not wait.
+                    thread_iter->thread.join();
+                    thread_iter = threads_.erase(thread_iter);
+                }
+                else
+                {
+                    ++thread_iter;
+                }
+            }
+
+            auto done = std::make_shared<std::atomic<bool>>(false);
+
+            // Let go of what the function holds before the thread is done, so joining a done thread never waits for a destructor.
+            threads_.push_back({std::thread([load = std::move(load), done]() mutable {
+                                    load();
+                                    load  = nullptr;
+                                    *done = true;
+                                }),
+                                done});
+        }
+
+        /// @brief Wait for every load thread.
+        void Join()
+        {
+            std::vector<LoadThread> threads;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                threads.swap(threads_);
+            }
+
+            for (auto& load_thread : threads)
+            {
+                load_thread.thread.join();
+            }
+        }
+
+    private:
+        /// @brief A load thread and whether it is done.
+        struct LoadThread
+        {
+            std::thread                        thread;  ///< The thread.
+            std::shared_ptr<std::atomic<bool>> done;    ///< Set once the thread has nothing left to do.
+        };
+
+        std::mutex              mutex_;    ///< Guards threads_.
+        std::vector<LoadThread> threads_;  ///< The threads that were not joined yet.
+    };
+
+    /// @brief Get the load threads of every decoder.
+    ///
+    /// Constructed the first time a decoder starts loading, which is after the registry, so the threads are joined before
+    /// the registry is destroyed at exit.
+    ///
+    /// @return The load threads.
+    LoadThreads& GetLoadThreads()
+    {
+        static LoadThreads load_threads;
+
+        return load_threads;
+    }
+}  // namespace
+
+IsaArchitectureDecoder::IsaArchitectureDecoder(std::shared_ptr<amdisa::IsaDecoder> decoder)
+    : architecture_(amdisa::GpuArchitecture::kUnknown)
+    , decoder_(std::move(decoder))
+    , loading_(false)
+    , loaded_(true)
+{
+}
+
+IsaArchitectureDecoder::IsaArchitectureDecoder(amdisa::GpuArchitecture architecture, std::string isa_spec_path)
+    : architecture_(architecture)
+    , isa_spec_path_(std::move(isa_spec_path))
+    , loading_(false)
+    , loaded_(false)
+{
+}
+
+IsaArchitectureDecoder::~IsaArchitectureDecoder()
+{
+}
+
+void IsaArchitectureDecoder::StartLoading()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (loaded_ || loading_)
+    {
+        return;
+    }
+
+    loading_ = true;
+
+    // Keep this decoder alive until the isa spec is parsed, so whoever lets go of this decoder last does not have to wait for
+    // it; switching architectures on the GUI thread would block until the old spec is parsed otherwise. The thread is joined
+    // by WaitForLoading or at exit instead, so it never outlives the statics it uses.
+    GetLoadThreads().Start([decoder = shared_from_this()]() { decoder->Load(); });
+}
+
+bool IsaArchitectureDecoder::IsLoaded() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return loaded_;
+}
+
+bool IsaArchitectureDecoder::HasDecoder() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return loaded_ && decoder_ != nullptr;
+}
+
+bool IsaArchitectureDecoder::WaitUntilLoaded(const std::atomic<bool>& canceled) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!loaded_)
+    {
+        if (canceled)
+        {
+            return false;
+        }
+
+        loaded_condition_.wait_for(lock, kLoadWaitInterval);
+    }
+
+    return true;
+}
+
+bool IsaArchitectureDecoder::Decode(uint64_t encoding, amdisa::InstructionInfo& instruction_info)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!loaded_ || decoder_ == nullptr)
+    {
+        return false;
+    }
+
+    const DecodedInstruction& decoded_instruction = DecodeLocked(encoding);
+
+    if (decoded_instruction.decoded)
+    {
+        instruction_info = decoded_instruction.instruction_info;
+    }
+
+    return decoded_instruction.decoded;
+}
+
+void IsaArchitectureDecoder::Predecode(const std::vector<uint64_t>& encodings, const std::atomic<bool>& canceled)
+{
+    for (const uint64_t encoding : encodings)
+    {
+        if (canceled)
+        {
+            break;
+        }
+
+        // Lock once per instruction so other users are not held up behind the whole shader.
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!loaded_ || decoder_ == nullptr)
+        {
+            break;
+        }
+
+        DecodeLocked(encoding);
+    }
+}
+
+void IsaArchitectureDecoder::Load()
+{
+    std::shared_ptr<amdisa::IsaDecoder> decoder;
+
+    // Only the load thread touches the decode manager until loaded_ is set.
+    if (!isa_spec_path_.empty())
+    {
+        std::string              initialize_error_message;
+        std::vector<std::string> xml_file_paths = {isa_spec_path_};
+
+        if (decode_manager_.Initialize(xml_file_paths, initialize_error_message))
+        {
+            decoder = decode_manager_.GetDecoder(architecture_);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        decoder_ = std::move(decoder);
+        loaded_  = true;
+    }
+
+    loaded_condition_.notify_all();
+}
+
+const IsaArchitectureDecoder::DecodedInstruction& IsaArchitectureDecoder::DecodeLocked(uint64_t encoding)
+{
+    const auto decoded_iter = decoded_instructions_.find(encoding);
+
+    if (decoded_iter != decoded_instructions_.end())
+    {
+        return decoded_iter->second;
+    }
+
+    DecodedInstruction            decoded_instruction;
+    amdisa::InstructionInfoBundle instruction_info_bundle;
+    std::string                   decode_error_message;
+
+    const bool instruction_decoded = decoder_->DecodeInstruction(encoding, instruction_info_bundle, decode_error_message);
+
+    if (instruction_decoded && !instruction_info_bundle.bundle.empty())
+    {
+        decoded_instruction.decoded          = true;
+        decoded_instruction.instruction_info = instruction_info_bundle.bundle.front();
+    }
+
+    return decoded_instructions_.emplace(encoding, std::move(decoded_instruction)).first->second;
+}
+
+std::shared_ptr<IsaArchitectureDecoder> IsaDecoderRegistry::Acquire(amdisa::GpuArchitecture architecture, const std::string& isa_spec_path)
+{
+    std::mutex* registry_mutex = nullptr;
+    auto&       decoders       = GetRegistry(registry_mutex);
+
+    std::lock_guard<std::mutex> lock(*registry_mutex);
+
+    std::shared_ptr<IsaArchitectureDecoder> decoder = decoders[architecture].lock();
+
+    if (decoder == nullptr)
+    {
+        decoder                = std::make_shared<IsaArchitectureDecoder>(architecture, isa_spec_path);
+        decoders[architecture] = decoder;
+
+        decoder->StartLoading();
+    }
+
+    return decoder;
+}
+
+std::shared_ptr<IsaArchitectureDecoder> IsaDecoderRegistry::Find(amdisa::GpuArchitecture architecture)
+{
+    std::mutex* registry_mutex = nullptr;
+    auto&       decoders       = GetRegistry(registry_mutex);
+
+    std::lock_guard<std::mutex> lock(*registry_mutex);
+
+    const auto decoder_iter = decoders.find(architecture);
+
+    return (decoder_iter != decoders.end()) ? decoder_iter->second.lock() : nullptr;
+}
+
+void IsaDecoderRegistry::WaitForLoading()
+{
+    GetLoadThreads().Join();
+}
@@ -0,0 +1,142 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for shared, thread safe isa decoders of every architecture.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_DECODER_REGISTRY_H_
+#define QTISAGUI_ISA_DECODER_REGISTRY_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "amdisa/isa_decoder.h"
+
+/// @brief IsaArchitectureDecoder is the isa decoder of a single architecture, safe to use from multiple threads.
+///
+/// The isa spec is parsed on a background thread, and decoded instructions are cached by their encoding,
+/// since many instructions repeat in a shader.
+class IsaArchitectureDecoder : public std::enable_shared_from_this<IsaArchitectureDecoder>
+{
+public:
+    /// @brief Constructor; use a decoder that is already loaded.
+    ///
+    /// @param [in] decoder The decoder; may be nullptr if there is no decoder for the architecture.
+    explicit IsaArchitectureDecoder(std::shared_ptr<amdisa::IsaDecoder> decoder);
+
+    /// @brief Constructor; the decoder is loaded from an isa spec once StartLoading is called.
+    ///
+    /// @param [in] architecture  The architecture.
+    /// @param [in] isa_spec_path The path of the isa spec xml file of the architecture; empty if there is none.
+    IsaArchitectureDecoder(amdisa::GpuArchitecture architecture, std::string isa_spec_path);
+
+    /// @brief Destructor; never waits, since a decoder that is still loading is held by its load thread; see IsaDecoderRegistry::WaitForLoading.
+    ~IsaArchitectureDecoder();
+
+    IsaArchitectureDecoder(const IsaArchitectureDecoder&)            = delete;
+    IsaArchitectureDecoder& operator=(const IsaArchitectureDecoder&) = delete;
+
+    /// @brief Start parsing the isa spec on a background thread; does nothing if the decoder was given when constructed.
+    ///
+    /// The thread holds this decoder until it is done, so this decoder must be owned by a std::shared_ptr. The thread is
+    /// joined by IsaDecoderRegistry::WaitForLoading, or at exit.
+    void StartLoading();
+
+    /// @brief Check if loading is done, whether or not it was successful.
+    ///
+    /// @return true if loading is done.
+    bool IsLoaded() const;
+
+    /// @brief Check if loading is done and there is a decoder to use.
+    ///
+    /// @return true if instructions can be decoded.
+    bool HasDecoder() const;
+
+    /// @brief Block until loading is done, or until canceled.
+    ///
+    /// @param [in] canceled Checked regularly while waiting; set it to true to stop waiting.
+    ///
+    /// @return true if loading is done, false if waiting was canceled.
+    bool WaitUntilLoaded(const std::atomic<bool>& canceled) const;
+
+    /// @brief Decode an instruction, or look it up if it was decoded before.
+    ///
+    /// @param [in]  encoding         The instruction encoding.
+    /// @param [out] instruction_info The first decoded instruction, if decoded.
+    ///
+    /// @return true if the instruction was decoded, false if it was not or the decoder is not loaded yet.
+    bool Decode(uint64_t encoding, amdisa::InstructionInfo& instruction_info);
+
+    /// @brief Decode instructions ahead of time so later calls to Decode are a lookup; the decoder must be loaded.
+    ///
+    /// @param [in] encodings The instruction encodings.
+    /// @param [in] canceled  Checked before every instruction; set it to true to stop decoding.
+    void Predecode(const std::vector<uint64_t>& encodings, const std::atomic<bool>& canceled);
+
+private:
+    /// @brief The result of decoding a single instruction encoding.
+    struct DecodedInstruction
+    {
+        bool                    decoded = false;   ///< true if the encoding was decoded, false otherwise.
+        amdisa::InstructionInfo instruction_info;  ///< The first decoded instruction, if decoded.
+    };
+
+    /// @brief Parse the isa spec; runs on the load thread.
+    void Load();
+
+    /// @brief Decode an instruction, or look it up if it was decoded before; mutex_ must be held and the decoder loaded.
+    ///
+    /// @param [in] encoding The instruction encoding.
+    ///
+    /// @return The decoded instruction.
+    const DecodedInstruction& DecodeLocked(uint64_t encoding);
+
+    amdisa::GpuArchitecture                          architecture_;          ///< The architecture to decode.
+    std::string                                      isa_spec_path_;         ///< The isa spec to load; empty if there is none.
+    amdisa::DecodeManager                            decode_manager_;        ///< Owns the parsed isa spec.
+    std::shared_ptr<amdisa::IsaDecoder>              decoder_;               ///< The decoder; nullptr until loaded, or if loading failed.
+    mutable std::mutex                               mutex_;                 ///< Guards loading_, loaded_, decoder_ and decoded_instructions_.
+    mutable std::condition_variable                  loaded_condition_;      ///< Notified when loading is done.
+    bool                                             loading_;               ///< true once the load thread is started.
+    bool                                             loaded_;                ///< true once loading is done.
+    std::unordered_map<uint64_t, DecodedInstruction> decoded_instructions_;  ///< Decoded instructions by encoding.
+};
+
+/// @brief IsaDecoderRegistry shares one decoder per architecture among every user of that architecture.
+///
+/// A decoder is unloaded when no one holds it anymore, so models showing different architectures side by side
+/// each get their own decoder, while models of the same architecture parse its isa spec only once.
+class IsaDecoderRegistry
+{
+public:
+    /// @brief Get the decoder of an architecture, and start loading it if no one holds it.
+    ///
+    /// @param [in] architecture  The architecture.
+    /// @param [in] isa_spec_path The path of the isa spec xml file of the architecture, used if the decoder has to be loaded.
+    ///
+    /// @return The decoder, which may still be loading.
+    static std::shared_ptr<IsaArchitectureDecoder> Acquire(amdisa::GpuArchitecture architecture, const std::string& isa_spec_path);
+
+    /// @brief Get the decoder of an architecture if anyone holds it already.
+    ///
+    /// @param [in] architecture The architecture.
+    ///
+    /// @return The decoder, which may still be loading, or nullptr.
+    static std::shared_ptr<IsaArchitectureDecoder> Find(amdisa::GpuArchitecture architecture);
+
+    /// @brief Block until every isa spec that is being parsed is done.
+    ///
+    /// Load threads are not joined when their decoder is released. Call this at shutdown, before static destructors run,
+    /// so no isa spec is still being parsed while the statics it uses are destroyed. If this is not called, the threads
+    /// are joined when the statics of this library are destroyed.
+    static void WaitForLoading();
+};
+
+#endif  // QTISAGUI_ISA_DECODER_REGISTRY_H_
@@ -0,0 +1,143 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for converting between the binary representation text of isa instructions and their packed words.
+//=============================================================================
+
+#include "isa_instruction_encoding.h"
+
+namespace
+{
+    /// @brief Get the value of a hex digit.
+    ///
+    /// @param [in] character The character.
+    ///
+    /// @return The value, or -1 if the character is not a hex digit.
+    int GetHexDigitValue(char character)
+    {
+        if (character >= '0' && character <= '9')
+        {
+            return character - '0';
+        }
+
+        if (character >= 'a' && character <= 'f')
+        {
+            return character - 'a' + 10;
+        }
+
+        if (character >= 'A' && character <= 'F')
+        {
+            return character - 'A' + 10;
+        }
+
+        return -1;
+    }
+
+    /// @brief Check if a character separates the words of the binary representation text.
+    ///
+    /// @param [in] character The character.
+    ///
+    /// @return true if the character is whitespace, false otherwise.
+    bool IsWhitespace(char character)
+    {
+        return character == ' ' || character == '\t' || character == '\r' || character == '\n' || character == '\f' || character == '\v';
+    }
+}  // namespace
+
+size_t IsaInstructionEncoding::Append(std::string_view binary_representation, std::vector<uint32_t>& words)
+{
+    const size_t length                  = binary_representation.size();
+    const size_t first_word              = words.size();
+    size_t       position                = 0;
+    size_t       first_number_word_count = 0;
+
+    while (position < length)
+    {
+        if (IsWhitespace(binary_representation[position]))
+        {
+            position++;
+            continue;
+        }
+
+        if (position + 2 < length && binary_representation[position] == '0' && (binary_representation[position + 1] | 0x20) == 'x' &&
+            GetHexDigitValue(binary_representation[position + 2]) >= 0)
+        {
+            position += 2;
+        }
+
+        const size_t first_digit = position;
+
+        while (position < length && GetHexDigitValue(binary_representation[position]) >= 0)
+        {
+            position++;
+        }
+
+        if (position == first_digit)
+        {
+            // Not a hex number.
+            break;
+        }
+
+        // Leading zeros of a wide number do not make words of their own.
+        size_t digit = first_digit;
+
+        while (position - digit > kFormattedWordLength && binary_representation[digit] == '0')
+        {
+            digit++;
+        }
+
+        // Most significant word first; the first word takes the digits that do not fill a whole word.
+        size_t word_digit_count = (position - digit) % kFormattedWordLength;
+
+        if (word_digit_count == 0)
+        {
+            word_digit_count = kFormattedWordLength;
+        }
+
+        while (digit < position)
+        {
+            uint32_t word = 0;
+
+            for (size_t i = 0; i < word_digit_count; i++)
+            {
+                word = (word << 4) | static_cast<uint32_t>(GetHexDigitValue(binary_representation[digit + i]));
+            }
+
+            words.push_back(word);
+
+            digit += word_digit_count;
+            word_digit_count = kFormattedWordLength;
+        }
+
+        if (first_number_word_count == 0)
+        {
+            first_number_word_count = words.size() - first_word;
+        }
+
+        if (position < length && !IsWhitespace(binary_representation[position]))
+        {
+            // The number ends in something that is not hex.
+            break;
+        }
+    }
+
+    return first_number_word_count;
+}
+
+void IsaInstructionEncoding::Format(const uint32_t* words, size_t word_count, std::string& text)
+{
+    static constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+    text.assign(GetFormattedLength(word_count), ' ');
+
+    for (size_t i = 0; i < word_count; i++)
+    {
+        char* const formatted_word = &text[i * (kFormattedWordLength + 1)];
+
+        for (size_t digit = 0; digit < kFormattedWordLength; digit++)
+        {
+            formatted_word[digit] = kHexDigits[(words[i] >> (4 * (kFormattedWordLength - 1 - digit))) & 0xF];
+        }
+    }
+}
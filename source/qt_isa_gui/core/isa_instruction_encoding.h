@@ -0,0 +1,82 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for converting between the binary representation text of isa instructions and their packed words.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_INSTRUCTION_ENCODING_H_
+#define QTISAGUI_ISA_INSTRUCTION_ENCODING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief IsaInstructionEncoding converts the binary representation text of an instruction to 32 bit words and back.
+///
+/// Disassemblers print an instruction as space separated hex words, like "D7610002 00000001". Models keep the words
+/// instead of the text, so decoding an instruction does not have to parse text, and only format the words when they are shown.
+/// Formatting gives 8 upper case hex digits per word, separated by a single space, whatever the case and width of the
+/// text the words were parsed from.
+class IsaInstructionEncoding
+{
+public:
+    static constexpr size_t kFormattedWordLength = 8;  ///< The number of characters of a formatted word.
+
+    /// @brief Parse the words of an instruction from its binary representation text.
+    ///
+    /// Every whitespace separated hex number, optionally preceded by "0x", is a word; numbers wider than 32 bits are split
+    /// into words, most significant word first. Parsing stops at the first character that is not part of a hex number.
+    ///
+    /// @param [in]     binary_representation The binary representation text.
+    /// @param [in,out] words                 The words are appended to this; existing contents are kept, so a pool of words can be filled.
+    ///
+    /// @return The number of words of the first hex number; see GetDecoderEncoding.
+    static size_t Append(std::string_view binary_representation, std::vector<uint32_t>& words);
+
+    /// @brief Format the words of an instruction for display.
+    ///
+    /// @param [in]  words      The words.
+    /// @param [in]  word_count The number of words.
+    /// @param [out] text       The text; existing contents are replaced.
+    static void Format(const uint32_t* words, size_t word_count, std::string& text);
+
+    /// @brief Get the length of the text Format gives, without formatting it.
+    ///
+    /// @param [in] word_count The number of words.
+    ///
+    /// @return The number of characters.
+    static inline size_t GetFormattedLength(size_t word_count)
+    {
+        return (word_count == 0) ? 0 : word_count * (kFormattedWordLength + 1) - 1;
+    }
+
+    /// @brief Get the encoding the isa decoder decodes for an instruction.
+    ///
+    /// This is the value of the first hex number of the binary representation text, read the way strtoull reads it, which
+    /// is what was decoded when models kept the text: the first word for text printed as 32 bit words, both words for a
+    /// single 16 digit number, and UINT64_MAX for a number that does not fit in 64 bits.
+    ///
+    /// @param [in] words                   The words.
+    /// @param [in] first_number_word_count The number of words of the first hex number, as returned by Append.
+    ///
+    /// @return The encoding, or 0 if the text does not start with a hex number.
+    static inline uint64_t GetDecoderEncoding(const uint32_t* words, size_t first_number_word_count)
+    {
+        switch (first_number_word_count)
+        {
+        case 0:
+            return 0;
+        case 1:
+            return words[0];
+        case 2:
+            return (static_cast<uint64_t>(words[0]) << 32) | words[1];
+        default:
+            return UINT64_MAX;
+        }
+    }
+};
+
+#endif  // QTISAGUI_ISA_INSTRUCTION_ENCODING_H_
@@ -0,0 +1,141 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for opt-in timing counters and trace markers of the hot paths of the isa widgets.
+//=============================================================================
+
+#include "isa_instrumentation.h"
+
+namespace
+{
+    // Names of every phase, in the order of IsaInstrumentation::Phase.
+    const std::array<const char*, static_cast<size_t>(IsaInstrumentation::Phase::kPhaseCount)> kPhaseNames = {"UpdateData",
+                                                                                                                "ParseSelectableTokens",
+                                                                                                                "MapBlocksToBranchInstructions",
+                                                                                                                "CacheSizeHints",
+                                                                                                                "Search",
+                                                                                                                "SetSearchMatchLineNumbers",
+                                                                                                                "UpdateSpannedColumns",
+                                                                                                                "PaintFrame",
+                                                                                                                "TooltipDecode",
+                                                                                                                "SetMetricValues",
+                                                                                                                "UpdateBlocks",
+                                                                                                                "SearchChunk",
+                                                                                                                "LoadModelCache",
+                                                                                                                "SaveModelCache"};
+}  // namespace
+
+std::array<IsaInstrumentation::PhaseCounters, static_cast<size_t>(IsaInstrumentation::Phase::kPhaseCount)> IsaInstrumentation::counters_;
+std::atomic<IsaInstrumentation::TraceCallback> IsaInstrumentation::trace_callback_(nullptr);
+std::atomic<void*>                             IsaInstrumentation::trace_user_data_(nullptr);
+
+IsaInstrumentation::ScopedTimer::ScopedTimer(Phase phase)
+    : phase_(phase)
+{
+    Trace(phase_, true);
+
+    start_ = std::chrono::steady_clock::now();
+}
+
+IsaInstrumentation::ScopedTimer::~ScopedTimer()
+{
+    const auto duration = std::chrono::steady_clock::now() - start_;
+
+    AddRun(phase_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+
+    Trace(phase_, false);
+}
+
+const char* IsaInstrumentation::GetPhaseName(Phase phase)
+{
+    const size_t phase_index = static_cast<size_t>(phase);
+
+    return (phase_index < kPhaseNames.size()) ? kPhaseNames[phase_index] : "";
+}
+
+IsaInstrumentation::Statistics IsaInstrumentation::GetStatistics(Phase phase)
+{
+    Statistics statistics;
+
+    const size_t phase_index = static_cast<size_t>(phase);
+
+    if (phase_index >= counters_.size())
+    {
+        return statistics;
+    }
+
+    // Each counter is read on its own; a run that ends meanwhile may be counted in some of them only.
+    const auto& counters = counters_[phase_index];
+
+    statistics.count             = counters.count.load(std::memory_order_relaxed);
+    statistics.total_nanoseconds = counters.total_nanoseconds.load(std::memory_order_relaxed);
+    statistics.max_nanoseconds   = counters.max_nanoseconds.load(std::memory_order_relaxed);
+    statistics.last_nanoseconds  = counters.last_nanoseconds.load(std::memory_order_relaxed);
+    statistics.item_count        = counters.item_count.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+void IsaInstrumentation::Reset()
+{
+    for (auto& counters : counters_)
+    {
+        counters.count.store(0, std::memory_order_relaxed);
+        counters.total_nanoseconds.store(0, std::memory_order_relaxed);
+        counters.max_nanoseconds.store(0, std::memory_order_relaxed);
+        counters.last_nanoseconds.store(0, std::memory_order_relaxed);
+        counters.item_count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void IsaInstrumentation::SetTraceCallback(TraceCallback callback, void* user_data)
+{
+    // Publish the user data before the callback that uses it.
+    trace_user_data_.store(user_data, std::memory_order_relaxed);
+    trace_callback_.store(callback, std::memory_order_release);
+}
+
+void IsaInstrumentation::AddRun(Phase phase, uint64_t nanoseconds)
+{
+    const size_t phase_index = static_cast<size_t>(phase);
+
+    if (!kEnabled || phase_index >= counters_.size())
+    {
+        return;
+    }
+
+    auto& counters = counters_[phase_index];
+
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.total_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    counters.last_nanoseconds.store(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t max_nanoseconds = counters.max_nanoseconds.load(std::memory_order_relaxed);
+
+    while (nanoseconds > max_nanoseconds && !counters.max_nanoseconds.compare_exchange_weak(max_nanoseconds, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+void IsaInstrumentation::AddItems(Phase phase, uint64_t item_count)
+{
+    const size_t phase_index = static_cast<size_t>(phase);
+
+    if (!kEnabled || phase_index >= counters_.size())
+    {
+        return;
+    }
+
+    counters_[phase_index].item_count.fetch_add(item_count, std::memory_order_relaxed);
+}
+
+void IsaInstrumentation::Trace(Phase phase, bool begin)
+{
+    const TraceCallback callback = trace_callback_.load(std::memory_order_acquire);
+
+    if (callback != nullptr)
+    {
+        callback(phase, begin, trace_user_data_.load(std::memory_order_relaxed));
+    }
+}
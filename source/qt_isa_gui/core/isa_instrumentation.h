@@ -0,0 +1,164 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for opt-in timing counters and trace markers of the hot paths of the isa widgets.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_INSTRUMENTATION_H_
+#define QTISAGUI_ISA_INSTRUMENTATION_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief IsaInstrumentation keeps timing counters of every phase of the isa widgets, and forwards trace markers.
+///
+/// Phases are timed by the QTISAGUI_SCOPED_TIMER and QTISAGUI_COUNT_ITEMS macros, which compile to nothing unless the
+/// library is built with the QTISAGUI_INSTRUMENTATION cmake option. This class is always available, so applications can
+/// query it without checking how the library was built; the counters simply stay at zero when instrumentation is compiled out.
+/// Counters may be updated from any thread.
+class IsaInstrumentation
+{
+public:
+#ifdef QTISAGUI_INSTRUMENTATION
+    static constexpr bool kEnabled = true;  ///< true if the hot paths are instrumented.
+#else
+    static constexpr bool kEnabled = false;  ///< true if the hot paths are instrumented.
+#endif
+
+    /// @brief Predefined phases that are timed.
+    enum class Phase
+    {
+        kUpdateData = 0,                 ///< Replacing the rows of a model; for applications to time their UpdateData, and virtual updates.
+        kParseSelectableTokens,          ///< Tokenizing a single instruction.
+        kMapBlocksToBranchInstructions,  ///< Mapping branches to their code blocks and building the control flow graph.
+        kCacheSizeHints,                 ///< Measuring columns and building the line map and indices.
+        kSearch,                         ///< IsaWidget::Search; items are matches.
+        kSetSearchMatchLineNumbers,      ///< Mapping search matches to scroll bar markers; items are matches.
+        kUpdateSpannedColumns,           ///< IsaWidget::UpdateSpannedColumns.
+        kPaintFrame,                     ///< Painting the tree view once; items are cells painted by the delegate.
+        kTooltipDecode,                  ///< Decoding an instruction and filling in its tooltip.
+        kSetMetricValues,                ///< IsaItemModel::SetMetricValues; items are values.
+        kUpdateBlocks,                   ///< IsaItemModel::UpdateBlocks; items are blocks parsed again.
+        kSearchChunk,                    ///< Searching a chunk of lines on a worker thread; items are matching lines.
+        kLoadModelCache,                 ///< Reading the rows of a model cache file; items are rows.
+        kSaveModelCache,                 ///< Writing the rows of a model to a cache file.
+        kPhaseCount
+    };
+
+    /// @brief Timing counters of a phase.
+    struct Statistics
+    {
+        uint64_t count             = 0;  ///< The number of times the phase ran.
+        uint64_t total_nanoseconds = 0;  ///< The total time of all runs.
+        uint64_t max_nanoseconds   = 0;  ///< The time of the longest run.
+        uint64_t last_nanoseconds  = 0;  ///< The time of the last run.
+        uint64_t item_count        = 0;  ///< The number of items processed by all runs; see Phase.
+    };
+
+    /// @brief A callback to forward trace markers to an external tracing backend.
+    ///
+    /// @param [in] phase     The phase.
+    /// @param [in] begin     true when the phase begins, false when it ends.
+    /// @param [in] user_data The user data given to SetTraceCallback.
+    using TraceCallback = void (*)(Phase phase, bool begin, void* user_data);
+
+    /// @brief Time a phase for as long as this object lives.
+    class ScopedTimer
+    {
+    public:
+        /// @brief Constructor; the phase begins.
+        ///
+        /// @param [in] phase The phase.
+        explicit ScopedTimer(Phase phase);
+
+        /// @brief Destructor; the phase ends.
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&)            = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Phase                                 phase_;  ///< The phase.
+        std::chrono::steady_clock::time_point start_;  ///< When the phase began.
+    };
+
+    /// @brief Get the name of a phase, for reports and trace markers.
+    ///
+    /// @param [in] phase The phase.
+    ///
+    /// @return The name, like "CacheSizeHints".
+    static const char* GetPhaseName(Phase phase);
+
+    /// @brief Get the counters of a phase.
+    ///
+    /// @param [in] phase The phase.
+    ///
+    /// @return The counters; all zero if instrumentation is compiled out.
+    static Statistics GetStatistics(Phase phase);
+
+    /// @brief Set all counters back to zero.
+    static void Reset();
+
+    /// @brief Forward the beginning and end of every phase to a callback.
+    ///
+    /// The callback is called on the thread of the phase, so it must be thread safe and fast. Set it before the widgets
+    /// are used, and clear it only once they are idle.
+    ///
+    /// @param [in] callback  The callback, or nullptr to stop forwarding.
+    /// @param [in] user_data Given to the callback.
+    static void SetTraceCallback(TraceCallback callback, void* user_data = nullptr);
+
+    /// @brief Add the time of a run of a phase.
+    ///
+    /// @param [in] phase       The phase.
+    /// @param [in] nanoseconds The time of the run.
+    static void AddRun(Phase phase, uint64_t nanoseconds);
+
+    /// @brief Add items processed by a phase.
+    ///
+    /// @param [in] phase      The phase.
+    /// @param [in] item_count The number of items.
+    static void AddItems(Phase phase, uint64_t item_count);
+
+private:
+    /// @brief The counters of a phase, updated without locking.
+    struct PhaseCounters
+    {
+        std::atomic<uint64_t> count{0};              ///< The number of times the phase ran.
+        std::atomic<uint64_t> total_nanoseconds{0};  ///< The total time of all runs.
+        std::atomic<uint64_t> max_nanoseconds{0};    ///< The time of the longest run.
+        std::atomic<uint64_t> last_nanoseconds{0};   ///< The time of the last run.
+        std::atomic<uint64_t> item_count{0};         ///< The number of items processed by all runs.
+    };
+
+    /// @brief Call the trace callback, if any.
+    ///
+    /// @param [in] phase The phase.
+    /// @param [in] begin true when the phase begins, false when it ends.
+    static void Trace(Phase phase, bool begin);
+
+    static std::array<PhaseCounters, static_cast<size_t>(Phase::kPhaseCount)> counters_;         ///< The counters of every phase.
+    static std::atomic<TraceCallback>                                          trace_callback_;   ///< Forwards trace markers.
+    static std::atomic<void*>                                                  trace_user_data_;  ///< Given to trace_callback_.
+};
+
+#ifdef QTISAGUI_INSTRUMENTATION
+#define QTISAGUI_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define QTISAGUI_INSTRUMENTATION_CONCAT(a, b) QTISAGUI_INSTRUMENTATION_CONCAT_(a, b)
+
+/// Time a phase until the end of the enclosing scope.
+#define QTISAGUI_SCOPED_TIMER(phase) \
+    const IsaInstrumentation::ScopedTimer QTISAGUI_INSTRUMENTATION_CONCAT(qtisagui_scoped_timer_, __LINE__)(IsaInstrumentation::Phase::phase)
+
+/// Count items processed by a phase.
+#define QTISAGUI_COUNT_ITEMS(phase, item_count) IsaInstrumentation::AddItems(IsaInstrumentation::Phase::phase, static_cast<uint64_t>(item_count))
+#else
+#define QTISAGUI_SCOPED_TIMER(phase)
+#define QTISAGUI_COUNT_ITEMS(phase, item_count)
+#endif
+
+#endif  // QTISAGUI_ISA_INSTRUMENTATION_H_
@@ -0,0 +1,171 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for dense per-line metric values, like profiler sample counts or stall cycles.
+//=============================================================================
+
+#include "isa_metric_columns.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+IsaMetricColumns::IsaMetricColumns()
+{
+}
+
+IsaMetricColumns::~IsaMetricColumns()
+{
+}
+
+void IsaMetricColumns::Clear()
+{
+    metrics_.clear();
+}
+
+void IsaMetricColumns::ClearValues()
+{
+    for (auto& metric : metrics_)
+    {
+        metric.values.clear();
+
+        if (!metric.fixed_range)
+        {
+            metric.minimum = 0.0f;
+            metric.maximum = 0.0f;
+        }
+    }
+}
+
+size_t IsaMetricColumns::AddMetric(const std::string& name)
+{
+    Metric metric;
+    metric.name = name;
+
+    metrics_.push_back(std::move(metric));
+
+    return metrics_.size() - 1;
+}
+
+const std::string& IsaMetricColumns::GetMetricName(size_t metric) const
+{
+    assert(metric < metrics_.size());
+
+    return metrics_[metric].name;
+}
+
+bool IsaMetricColumns::SetValues(size_t metric, size_t first_line, const float* values, size_t count)
+{
+    assert(metric < metrics_.size());
+
+    Metric& columns = metrics_[metric];
+
+    if (count == 0)
+    {
+        return false;
+    }
+
+    if (columns.values.size() < first_line + count)
+    {
+        columns.values.resize(first_line + count, std::numeric_limits<float>::quiet_NaN());
+    }
+
+    std::copy(values, values + count, columns.values.begin() + first_line);
+
+    if (columns.fixed_range)
+    {
+        return false;
+    }
+
+    // The range only grows, so an update never has to look at values it did not change.
+    const float previous_minimum = columns.minimum;
+    const float previous_maximum = columns.maximum;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!std::isnan(values[i]))
+        {
+            columns.minimum = std::min(columns.minimum, values[i]);
+            columns.maximum = std::max(columns.maximum, values[i]);
+        }
+    }
+
+    return columns.minimum != previous_minimum || columns.maximum != previous_maximum;
+}
+
+float IsaMetricColumns::GetValue(size_t metric, size_t line) const
+{
+    if (metric >= metrics_.size() || line >= metrics_[metric].values.size())
+    {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    return metrics_[metric].values[line];
+}
+
+float IsaMetricColumns::GetMaximumValue(size_t metric, size_t first_line, size_t end_line) const
+{
+    float maximum = std::numeric_limits<float>::quiet_NaN();
+
+    if (metric >= metrics_.size())
+    {
+        return maximum;
+    }
+
+    const auto& values = metrics_[metric].values;
+
+    end_line = std::min(end_line, values.size());
+
+    for (size_t line = first_line; line < end_line; line++)
+    {
+        // Comparisons with NaN are false, so lines without a value are skipped.
+        if (std::isnan(maximum) || values[line] > maximum)
+        {
+            maximum = values[line];
+        }
+    }
+
+    return maximum;
+}
+
+void IsaMetricColumns::SetRange(size_t metric, bool fixed, float minimum, float maximum)
+{
+    assert(metric < metrics_.size());
+
+    Metric& columns = metrics_[metric];
+
+    columns.fixed_range = fixed;
+    columns.minimum     = fixed ? minimum : 0.0f;
+    columns.maximum     = fixed ? maximum : 0.0f;
+}
+
+void IsaMetricColumns::GetRange(size_t metric, float& minimum, float& maximum) const
+{
+    minimum = 0.0f;
+    maximum = 0.0f;
+
+    if (metric < metrics_.size())
+    {
+        minimum = metrics_[metric].minimum;
+        maximum = metrics_[metric].maximum;
+    }
+}
+
+float IsaMetricColumns::GetIntensity(size_t metric, float value) const
+{
+    if (std::isnan(value) || metric >= metrics_.size())
+    {
+        return -1.0f;
+    }
+
+    const Metric& columns = metrics_[metric];
+
+    if (columns.maximum <= columns.minimum)
+    {
+        return (value > columns.minimum) ? 1.0f : 0.0f;
+    }
+
+    return std::clamp((value - columns.minimum) / (columns.maximum - columns.minimum), 0.0f, 1.0f);
+}
@@ -0,0 +1,121 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for dense per-line metric values, like profiler sample counts or stall cycles.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_METRIC_COLUMNS_H_
+#define QTISAGUI_ISA_METRIC_COLUMNS_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// @brief IsaMetricColumns keeps a dense array of values per metric, indexed by line number.
+///
+/// Values may be replaced in bulk as often as a profiler streams them; an update costs O(number of values changed).
+/// Every metric has a range to turn its values into heatmap intensities; the range either grows to fit every value
+/// set since the values were last cleared, or is fixed by the application.
+class IsaMetricColumns
+{
+public:
+    /// @brief Constructor; create an empty set of metrics.
+    IsaMetricColumns();
+
+    /// @brief Destructor.
+    ~IsaMetricColumns();
+
+    /// @brief Remove all metrics.
+    void Clear();
+
+    /// @brief Unset the values of every metric, and give metrics without a fixed range an empty range again.
+    void ClearValues();
+
+    /// @brief Add a metric without any values.
+    ///
+    /// @param [in] name The name of the metric.
+    ///
+    /// @return The metric.
+    size_t AddMetric(const std::string& name);
+
+    /// @brief Get the number of metrics.
+    ///
+    /// @return The number of metrics.
+    inline size_t GetMetricCount() const
+    {
+        return metrics_.size();
+    }
+
+    /// @brief Get the name of a metric.
+    ///
+    /// @param [in] metric The metric.
+    ///
+    /// @return The name.
+    const std::string& GetMetricName(size_t metric) const;
+
+    /// @brief Replace the values of consecutive lines; lines past the last line with a value are added.
+    ///
+    /// @param [in] metric     The metric.
+    /// @param [in] first_line The line of the first value.
+    /// @param [in] values     The values; NaN to unset the value of a line.
+    /// @param [in] count      The number of values.
+    ///
+    /// @return true if the range of the metric changed, which changes the intensity of every line.
+    bool SetValues(size_t metric, size_t first_line, const float* values, size_t count);
+
+    /// @brief Get the value of a line.
+    ///
+    /// @param [in] metric The metric.
+    /// @param [in] line   The line.
+    ///
+    /// @return The value, or NaN if the line has no value.
+    float GetValue(size_t metric, size_t line) const;
+
+    /// @brief Get the largest value of a range of lines.
+    ///
+    /// @param [in] metric     The metric.
+    /// @param [in] first_line The first line.
+    /// @param [in] end_line   The line after the last line.
+    ///
+    /// @return The largest value, or NaN if none of the lines has a value.
+    float GetMaximumValue(size_t metric, size_t first_line, size_t end_line) const;
+
+    /// @brief Fix the range of a metric, or let it grow to fit its values again.
+    ///
+    /// @param [in] metric  The metric.
+    /// @param [in] fixed   true to fix the range to [minimum, maximum], false to fit the values set from now on.
+    /// @param [in] minimum The value of intensity 0.
+    /// @param [in] maximum The value of intensity 1.
+    void SetRange(size_t metric, bool fixed, float minimum = 0.0f, float maximum = 0.0f);
+
+    /// @brief Get the range of a metric.
+    ///
+    /// @param [in]  metric  The metric.
+    /// @param [out] minimum The value of intensity 0.
+    /// @param [out] maximum The value of intensity 1.
+    void GetRange(size_t metric, float& minimum, float& maximum) const;
+
+    /// @brief Turn a value into a heatmap intensity with the range of its metric.
+    ///
+    /// @param [in] metric The metric.
+    /// @param [in] value  The value.
+    ///
+    /// @return The intensity in [0, 1], or -1 if the value is NaN.
+    float GetIntensity(size_t metric, float value) const;
+
+private:
+    /// @brief The values of one metric.
+    struct Metric
+    {
+        std::string        name;                 ///< The name of the metric.
+        std::vector<float> values;               ///< The value of every line; NaN for lines without a value.
+        bool               fixed_range = false;  ///< true if the range was fixed by the application.
+        float              minimum     = 0.0f;   ///< The value of intensity 0.
+        float              maximum     = 0.0f;   ///< The value of intensity 1.
+    };
+
+    std::vector<Metric> metrics_;  ///< Every metric.
+};
+
+#endif  // QTISAGUI_ISA_METRIC_COLUMNS_H_
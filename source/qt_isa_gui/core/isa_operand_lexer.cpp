@@ -0,0 +1,216 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for a single pass lexer of isa operand tokens.
+//=============================================================================
+
+#include "isa_operand_lexer.h"
+
+#include <climits>
+
+namespace
+{
+    // Whitespace trimmed from tokens; same as IsaItemModel::TrimStr.
+    constexpr std::string_view kWhitespace = " \t\n\r\f\v";
+
+    /// @brief Check if a character is a decimal digit, independent of the locale.
+    ///
+    /// @param [in] c The character.
+    ///
+    /// @return true if c is 0-9.
+    inline bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /// @brief Consume a run of decimal digits.
+    ///
+    /// @param [in]     token    The token text.
+    /// @param [in,out] position The position of the first digit; moved past the last digit.
+    /// @param [out]    value    The value of the digits.
+    ///
+    /// @return true if at least one digit was consumed and the value fits in an int.
+    bool ConsumeNumber(std::string_view token, size_t& position, int& value)
+    {
+        const size_t first_digit = position;
+        long long    number      = 0;
+        bool         overflow    = false;
+
+        while (position < token.size() && IsDigit(token[position]))
+        {
+            number = (number * 10) + (token[position] - '0');
+
+            if (number > INT_MAX)
+            {
+                overflow = true;
+                number   = INT_MAX;
+            }
+
+            position++;
+        }
+
+        value = static_cast<int>(number);
+
+        return position != first_digit && !overflow;
+    }
+}  // namespace
+
+IsaOperandLexer::Operand IsaOperandLexer::Lex(std::string_view token)
+{
+    Operand operand;
+
+    const size_t size = token.size();
+
+    if (size == 0)
+    {
+        return operand;
+    }
+
+    const char first_character = token[0];
+
+    // Constant; a digit, optionally preceded by a '-', then anything that fits on one line.
+    // Only ascii text is accepted after the first digit, the way the character count of the token was compared before.
+
+    const size_t first_digit = (first_character == '-') ? 1 : 0;
+
+    if (first_digit < size && IsDigit(token[first_digit]))
+    {
+        for (size_t position = first_digit + 1; position < size; position++)
+        {
+            const unsigned char c = static_cast<unsigned char>(token[position]);
+
+            if (c == '\n' || c == '\0' || c >= 0x80)
+            {
+                return operand;
+            }
+        }
+
+        operand.kind = Kind::kConstant;
+
+        return operand;
+    }
+
+    // Range of registers; s[a:b] or v[a:b].
+
+    if ((first_character == 's' || first_character == 'v') && size > 1 && token[1] == '[')
+    {
+        size_t position    = 2;
+        int    range_start = 0;
+        int    range_end   = 0;
+
+        if (!ConsumeNumber(token, position, range_start) || position >= size || token[position] != ':')
+        {
+            return operand;
+        }
+
+        position++;
+
+        if (!ConsumeNumber(token, position, range_end) || position + 1 != size || token[position] != ']')
+        {
+            return operand;
+        }
+
+        operand.kind                 = (first_character == 's') ? Kind::kScalarRegister : Kind::kVectorRegister;
+        operand.start_register_index = range_start;
+        operand.end_register_index   = range_end;
+
+        return operand;
+    }
+
+    // Single register; [ (start of a pair) or nothing, then -, then |, then s or v and the index, then a matching |,
+    // then ] (end of a pair) if this is not the start of a pair.
+
+    size_t position = 0;
+
+    const bool is_pair_start = (token[position] == '[');
+
+    if (is_pair_start)
+    {
+        position++;
+    }
+
+    if (position < size && token[position] == '-')
+    {
+        position++;
+    }
+
+    const bool is_absolute_value = (position < size && token[position] == '|');
+
+    if (is_absolute_value)
+    {
+        position++;
+    }
+
+    if (position >= size || (token[position] != 's' && token[position] != 'v'))
+    {
+        return operand;
+    }
+
+    const char register_character = token[position++];
+    int        register_index     = 0;
+
+    if (!ConsumeNumber(token, position, register_index))
+    {
+        return operand;
+    }
+
+    if (is_absolute_value)
+    {
+        if (position >= size || token[position] != '|')
+        {
+            return operand;
+        }
+
+        position++;
+    }
+
+    if (!is_pair_start && position < size && token[position] == ']')
+    {
+        position++;
+    }
+
+    if (position != size)
+    {
+        return operand;
+    }
+
+    operand.kind                 = (register_character == 's') ? Kind::kScalarRegister : Kind::kVectorRegister;
+    operand.start_register_index = register_index;
+
+    return operand;
+}
+
+void IsaOperandLexer::SplitOperand(std::string_view operand, std::vector<std::string_view>& tokens)
+{
+    tokens.clear();
+
+    size_t token_start = 0;
+
+    while (true)
+    {
+        const size_t token_end = operand.find(' ', token_start);
+
+        std::string_view token = operand.substr(token_start, (token_end == std::string_view::npos) ? std::string_view::npos : token_end - token_start);
+
+        const size_t first = token.find_first_not_of(kWhitespace);
+
+        if (first == std::string_view::npos)
+        {
+            token = std::string_view();
+        }
+        else
+        {
+            token = token.substr(first, token.find_last_not_of(kWhitespace) - first + 1);
+        }
+
+        tokens.push_back(token);
+
+        if (token_end == std::string_view::npos)
+        {
+            break;
+        }
+
+        token_start = token_end + 1;
+    }
+}
@@ -0,0 +1,59 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for a single pass lexer of isa operand tokens.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_OPERAND_LEXER_H_
+#define QTISAGUI_ISA_OPERAND_LEXER_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// @brief IsaOperandLexer classifies the tokens of isa operands without allocating memory.
+///
+/// Recognized tokens, with an optional negative '-' and/or absolute value '|' modifier on single registers:
+///   Single registers:     s0, v0, -s0, |s0|, -|v0|
+///   Start of a pair:      [s0, [-v1
+///   End of a pair:        s1], |v1|]
+///   Range of registers:   s[0:1], v[2:5]
+///   Constants:            0, -1, 1.0, 0x01, 4e-3 (a digit, optionally preceded by '-', then anything)
+class IsaOperandLexer
+{
+public:
+    /// @brief The kinds of operand tokens.
+    enum class Kind : uint8_t
+    {
+        kUnknown = 0,     ///< Anything that is not recognized; not selectable.
+        kScalarRegister,  ///< A single scalar register, or a range of scalar registers.
+        kVectorRegister,  ///< A single vector register, or a range of vector registers.
+        kConstant,        ///< A constant.
+    };
+
+    /// @brief The result of classifying a single operand token.
+    struct Operand
+    {
+        Kind kind                 = Kind::kUnknown;  ///< The kind of this token.
+        int  start_register_index = -1;              ///< The first register index for registers, -1 otherwise.
+        int  end_register_index   = -1;              ///< The last register index for register ranges, -1 otherwise.
+    };
+
+    /// @brief Classify a single operand token in one pass.
+    ///
+    /// @param [in] token The token text, without surrounding whitespace.
+    ///
+    /// @return The classification of the token.
+    static Operand Lex(std::string_view token);
+
+    /// @brief Split an operand into space separated tokens, and trim whitespace from each token.
+    ///
+    /// Consecutive spaces result in empty tokens, matching IsaItemModel::Split.
+    ///
+    /// @param [in]  operand The operand text.
+    /// @param [out] tokens  The tokens; views into operand. Existing contents are replaced.
+    static void SplitOperand(std::string_view operand, std::vector<std::string_view>& tokens);
+};
+
+#endif  // QTISAGUI_ISA_OPERAND_LEXER_H_
@@ -0,0 +1,161 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for an index of every register reference in an isa shader.
+//=============================================================================
+
+#include "isa_register_index.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Registers above this are not real registers; skip them rather than size the index after bad text.
+    constexpr int kMaxRegisterCount = 1024;
+
+    /// @brief Get the last register of an operand, or -1 if the operand cannot be indexed.
+    ///
+    /// @param [in] start_register_index The first register.
+    /// @param [in] end_register_index   The last register, or -1 for a single register.
+    ///
+    /// @return The last register.
+    inline int GetLastRegister(int start_register_index, int end_register_index)
+    {
+        const int last_register = (end_register_index == -1) ? start_register_index : end_register_index;
+
+        if (start_register_index < 0 || last_register < start_register_index || last_register >= kMaxRegisterCount)
+        {
+            return -1;
+        }
+
+        return last_register;
+    }
+}  // namespace
+
+IsaRegisterIndex::IsaRegisterIndex()
+    : build_count_(0)
+{
+}
+
+IsaRegisterIndex::~IsaRegisterIndex()
+{
+}
+
+void IsaRegisterIndex::Build(const std::vector<RegisterOperand>& register_operands)
+{
+    Clear();
+
+    // Find the size of every register file, then count the references of every register and turn the counts into offsets.
+
+    for (const auto& register_operand : register_operands)
+    {
+        const int last_register = GetLastRegister(register_operand.start_register_index, register_operand.end_register_index);
+
+        if (last_register != -1)
+        {
+            auto& offsets = register_files_[static_cast<size_t>(register_operand.register_file)].offsets;
+
+            if (offsets.size() < static_cast<size_t>(last_register) + 2)
+            {
+                offsets.resize(static_cast<size_t>(last_register) + 2, 0);
+            }
+
+            for (int register_index = register_operand.start_register_index; register_index <= last_register; register_index++)
+            {
+                offsets[register_index + 1]++;
+            }
+        }
+    }
+
+    for (auto& register_file : register_files_)
+    {
+        for (size_t register_index = 1; register_index < register_file.offsets.size(); register_index++)
+        {
+            register_file.offsets[register_index] += register_file.offsets[register_index - 1];
+        }
+
+        register_file.references.resize(register_file.offsets.empty() ? 0 : register_file.offsets.back());
+    }
+
+    // Place every reference; operands are given in shader order, so the references of every register end up sorted.
+
+    std::array<std::vector<uint32_t>, static_cast<size_t>(RegisterFile::kRegisterFileCount)> positions;
+
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        positions[i] = register_files_[i].offsets;
+    }
+
+    for (const auto& register_operand : register_operands)
+    {
+        const int last_register = GetLastRegister(register_operand.start_register_index, register_operand.end_register_index);
+
+        if (last_register != -1)
+        {
+            const size_t register_file = static_cast<size_t>(register_operand.register_file);
+
+            for (int register_index = register_operand.start_register_index; register_index <= last_register; register_index++)
+            {
+                register_files_[register_file].references[positions[register_file][register_index]++] = register_operand.reference;
+            }
+        }
+    }
+}
+
+void IsaRegisterIndex::Clear()
+{
+    build_count_++;
+
+    for (auto& register_file : register_files_)
+    {
+        register_file.offsets.clear();
+        register_file.references.clear();
+    }
+}
+
+size_t IsaRegisterIndex::GetRegisterCount(RegisterFile register_file) const
+{
+    const auto& offsets = register_files_[static_cast<size_t>(register_file)].offsets;
+
+    return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+IsaRegisterIndex::ReferenceRange IsaRegisterIndex::GetReferences(RegisterFile register_file, int register_index) const
+{
+    if (register_index < 0 || static_cast<size_t>(register_index) >= GetRegisterCount(register_file))
+    {
+        return ReferenceRange(nullptr, nullptr);
+    }
+
+    const auto& references = register_files_[static_cast<size_t>(register_file)];
+
+    return ReferenceRange(references.references.data() + references.offsets[register_index],
+                          references.references.data() + references.offsets[register_index + 1]);
+}
+
+void IsaRegisterIndex::FindReferences(RegisterFile register_file, int start_register_index, int end_register_index, std::vector<Reference>& references) const
+{
+    references.clear();
+
+    const int last_register = GetLastRegister(start_register_index, end_register_index);
+
+    if (last_register == -1)
+    {
+        return;
+    }
+
+    for (int register_index = start_register_index; register_index <= last_register; register_index++)
+    {
+        const ReferenceRange register_references = GetReferences(register_file, register_index);
+
+        references.insert(references.end(), register_references.begin(), register_references.end());
+    }
+
+    // A token that references a range is listed under every register of the range.
+    if (last_register != start_register_index)
+    {
+        std::sort(references.begin(), references.end());
+        references.erase(std::unique(references.begin(), references.end()), references.end());
+    }
+}
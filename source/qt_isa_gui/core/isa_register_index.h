@@ -0,0 +1,177 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for an index of every register reference in an isa shader.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_REGISTER_INDEX_H_
+#define QTISAGUI_ISA_REGISTER_INDEX_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief IsaRegisterIndex finds every line and token that references a register.
+///
+/// References of every register are stored contiguously and sorted by line in a compressed sparse row array,
+/// built once per shader, so all uses of a register can be found without going over the text of the shader.
+class IsaRegisterIndex
+{
+public:
+    /// @brief The register files that can be indexed.
+    enum class RegisterFile : uint8_t
+    {
+        kScalar,             ///< Scalar registers, s0 or s[0:1].
+        kVector,             ///< Vector registers, v0 or v[0:1].
+        kRegisterFileCount,  ///< The number of register files.
+    };
+
+    /// @brief A token that references a register.
+    struct Reference
+    {
+        uint32_t line_number;  ///< The line of the reference; see IsaItemModel::GetLineNumberModelIndex.
+        uint32_t token_index;  ///< The index of the token among the tokens of the operands of the line.
+
+        /// @brief Order references by line, then by token.
+        ///
+        /// @param [in] other The reference to compare with.
+        ///
+        /// @return true if this reference comes before other.
+        inline bool operator<(const Reference& other) const
+        {
+            return line_number < other.line_number || (line_number == other.line_number && token_index < other.token_index);
+        }
+
+        /// @brief Compare references.
+        ///
+        /// @param [in] other The reference to compare with.
+        ///
+        /// @return true if both references are the same token.
+        inline bool operator==(const Reference& other) const
+        {
+            return line_number == other.line_number && token_index == other.token_index;
+        }
+    };
+
+    /// @brief A register operand token to index.
+    struct RegisterOperand
+    {
+        RegisterFile register_file;         ///< The register file of the registers.
+        int          start_register_index;  ///< The first register.
+        int          end_register_index;    ///< The last register of a range like v[4:7], or -1 for a single register.
+        Reference    reference;             ///< Where the token is.
+    };
+
+    /// @brief A range of references of a register.
+    class ReferenceRange
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in] first The first reference.
+        /// @param [in] last  One past the last reference.
+        ReferenceRange(const Reference* first, const Reference* last)
+            : first_(first)
+            , last_(last)
+        {
+        }
+
+        /// @brief Get the first reference.
+        ///
+        /// @return The first reference.
+        inline const Reference* begin() const
+        {
+            return first_;
+        }
+
+        /// @brief Get one past the last reference.
+        ///
+        /// @return One past the last reference.
+        inline const Reference* end() const
+        {
+            return last_;
+        }
+
+        /// @brief Get the number of references.
+        ///
+        /// @return The number of references.
+        inline size_t size() const
+        {
+            return static_cast<size_t>(last_ - first_);
+        }
+
+        /// @brief Check if there are no references.
+        ///
+        /// @return true if there are no references.
+        inline bool empty() const
+        {
+            return first_ == last_;
+        }
+
+    private:
+        const Reference* first_;  ///< The first reference.
+        const Reference* last_;   ///< One past the last reference.
+    };
+
+    /// @brief Constructor; create an empty index.
+    IsaRegisterIndex();
+
+    /// @brief Destructor.
+    ~IsaRegisterIndex();
+
+    /// @brief Replace all references.
+    ///
+    /// Ranges are expanded so every register of a range has its own reference to the token.
+    ///
+    /// @param [in] register_operands Every register operand token, in shader order.
+    void Build(const std::vector<RegisterOperand>& register_operands);
+
+    /// @brief Remove all references.
+    void Clear();
+
+    /// @brief Get the number of times the references changed, to tell if results taken from this index are stale.
+    ///
+    /// @return The number of calls to Build and Clear so far.
+    inline uint64_t GetBuildCount() const
+    {
+        return build_count_;
+    }
+
+    /// @brief Get the number of registers of a register file, one past the highest referenced register.
+    ///
+    /// @param [in] register_file The register file.
+    ///
+    /// @return The number of registers.
+    size_t GetRegisterCount(RegisterFile register_file) const;
+
+    /// @brief Get the references of a register, sorted by line and token.
+    ///
+    /// @param [in] register_file  The register file.
+    /// @param [in] register_index The register.
+    ///
+    /// @return The references; empty if the register is not referenced.
+    ReferenceRange GetReferences(RegisterFile register_file, int register_index) const;
+
+    /// @brief Find every token that references any register of a range.
+    ///
+    /// @param [in]  register_file        The register file.
+    /// @param [in]  start_register_index The first register.
+    /// @param [in]  end_register_index   The last register, or -1 for a single register.
+    /// @param [out] references           The references, sorted by line and token, each token once; cleared first.
+    void FindReferences(RegisterFile register_file, int start_register_index, int end_register_index, std::vector<Reference>& references) const;
+
+private:
+    /// @brief The references of a single register file.
+    struct RegisterFileReferences
+    {
+        std::vector<uint32_t>  offsets;     ///< Per register offset into references, plus the reference count.
+        std::vector<Reference> references;  ///< References grouped by register.
+    };
+
+    std::array<RegisterFileReferences, static_cast<size_t>(RegisterFile::kRegisterFileCount)> register_files_;  ///< References of every register file.
+    uint64_t                                                                                 build_count_;     ///< The number of calls to Build and Clear.
+};
+
+#endif  // QTISAGUI_ISA_REGISTER_INDEX_H_
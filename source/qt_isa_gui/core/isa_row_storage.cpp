@@ -0,0 +1,559 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for contiguous, arena backed storage of isa blocks, rows and tokens.
+//=============================================================================
+
+#include "isa_row_storage.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "isa_instruction_encoding.h"
+
+namespace
+{
+    // Marks the start of serialized storage; reads back differently on a machine with another byte order.
+    const uint32_t kSerializedMagic = 0x53524149;
+
+    // Symbol ids past this are not valid; see IsaSymbolTable.
+    const uint32_t kMaxSerializedSymbol = 4096 * 4096;
+
+    /// @brief The start of serialized storage; followed by the text, the words, the blocks, rows, operands and tokens, and the symbols.
+    struct SerializedHeader
+    {
+        uint32_t magic               = kSerializedMagic;                     ///< kSerializedMagic.
+        uint32_t version             = IsaRowStorage::kSerializationVersion;  ///< The version of the format.
+        uint32_t block_record_size   = 0;                                    ///< sizeof(BlockRecord) of the build that wrote the data.
+        uint32_t row_record_size     = 0;                                    ///< sizeof(RowRecord) of the build that wrote the data.
+        uint32_t operand_record_size = 0;                                    ///< sizeof(OperandRecord) of the build that wrote the data.
+        uint32_t token_record_size   = 0;                                    ///< sizeof(TokenRecord) of the build that wrote the data.
+        uint64_t text_size           = 0;                                    ///< The number of characters of text.
+        uint64_t word_count          = 0;                                    ///< The number of instruction words.
+        uint64_t block_count         = 0;                                    ///< The number of blocks.
+        uint64_t row_count           = 0;                                    ///< The number of rows.
+        uint64_t operand_count       = 0;                                    ///< The number of operands.
+        uint64_t token_count         = 0;                                    ///< The number of tokens.
+        uint64_t symbol_count        = 0;                                    ///< The number of symbols; each is an id, a length and the text.
+    };
+
+    /// @brief Check that a bool read from serialized data holds false or true, without reading it as a bool.
+    ///
+    /// @param [in] value The bool.
+    ///
+    /// @return true if the byte of the bool is 0 or 1.
+    bool IsValidBool(const bool& value)
+    {
+        uint8_t byte = 0;
+        std::memcpy(&byte, &value, sizeof(byte));
+
+        return byte <= 1;
+    }
+
+    /// @brief Write the records of a vector.
+    ///
+    /// @param [in] write   The writer.
+    /// @param [in] records The records.
+    ///
+    /// @return true if the records were written.
+    template <typename Record>
+    bool WriteRecords(const IsaRowStorage::SerializeWriter& write, const std::vector<Record>& records)
+    {
+        return records.empty() || write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    }
+
+    /// @brief Read records into a vector.
+    ///
+    /// @param [in]     data    The data.
+    /// @param [in]     size    The size of the data.
+    /// @param [in,out] offset  The offset of the records into data; moved past them.
+    /// @param [in]     count   The number of records.
+    /// @param [out]    records The records.
+    ///
+    /// @return true if the data holds all records.
+    template <typename Record>
+    bool ReadRecords(const char* data, size_t size, size_t& offset, uint64_t count, std::vector<Record>& records)
+    {
+        if (count > (size - offset) / sizeof(Record))
+        {
+            return false;
+        }
+
+        records.resize(static_cast<size_t>(count));
+
+        if (count != 0)
+        {
+            std::memcpy(records.data(), data + offset, records.size() * sizeof(Record));
+        }
+
+        offset += records.size() * sizeof(Record);
+
+        return true;
+    }
+}  // namespace
+
+IsaRowStorage::IsaRowStorage()
+    : symbol_table_(IsaSymbolTable::GetGlobal())
+{
+}
+
+IsaRowStorage::~IsaRowStorage()
+{
+}
+
+void IsaRowStorage::SetSymbolTable(const std::shared_ptr<IsaSymbolTable>& symbol_table)
+{
+    if (symbol_table == nullptr || symbol_table == symbol_table_)
+    {
+        return;
+    }
+
+    for (auto& token : tokens_)
+    {
+        token.symbol = symbol_table->Intern(symbol_table_->GetText(token.symbol));
+    }
+
+    symbol_table_ = symbol_table;
+}
+
+void IsaRowStorage::Clear()
+{
+    text_.clear();
+    words_.clear();
+    blocks_.clear();
+    rows_.clear();
+    operands_.clear();
+    tokens_.clear();
+}
+
+void IsaRowStorage::ReleaseMemory()
+{
+    // Swap with empty containers; clear() alone keeps the capacity.
+    std::string().swap(text_);
+    std::vector<uint32_t>().swap(words_);
+    std::vector<BlockRecord>().swap(blocks_);
+    std::vector<RowRecord>().swap(rows_);
+    std::vector<OperandRecord>().swap(operands_);
+    std::vector<TokenRecord>().swap(tokens_);
+}
+
+void IsaRowStorage::Reserve(size_t block_count, size_t row_count, size_t token_count, size_t text_size)
+{
+    text_.reserve(text_size);
+    words_.reserve(row_count);
+    blocks_.reserve(block_count);
+    rows_.reserve(row_count);
+    tokens_.reserve(token_count);
+
+    // Most instructions have about as many operands as tokens.
+    operands_.reserve(token_count);
+}
+
+uint32_t IsaRowStorage::AppendBlock(bool is_comment, uint32_t line_number, std::string_view text)
+{
+    BlockRecord block;
+
+    block.text        = AppendText(text);
+    block.line_number = line_number;
+    block.first_row   = static_cast<uint32_t>(rows_.size());
+    block.row_count   = 0;
+    block.is_comment  = is_comment;
+
+    if (!is_comment)
+    {
+        TokenRecord label_token;
+        label_token.symbol = symbol_table_->Intern(text);
+
+        block.label_token = static_cast<uint32_t>(tokens_.size());
+        tokens_.push_back(label_token);
+    }
+
+    blocks_.push_back(block);
+
+    return static_cast<uint32_t>(blocks_.size() - 1);
+}
+
+uint32_t IsaRowStorage::AppendRow(bool             is_comment,
+                                  uint32_t         line_number,
+                                  std::string_view text,
+                                  std::string_view pc_address,
+                                  std::string_view binary_representation,
+                                  bool             enabled)
+{
+    assert(!blocks_.empty());
+
+    RowRecord row;
+
+    row.line_number   = line_number;
+    row.first_operand = static_cast<uint32_t>(operands_.size());
+    row.operand_count = 0;
+    row.is_comment    = is_comment;
+    row.enabled       = enabled;
+
+    if (is_comment)
+    {
+        row.text = AppendText(text);
+    }
+    else
+    {
+        row.pc_address = AppendText(pc_address);
+        row.first_word = static_cast<uint32_t>(words_.size());
+
+        // Parsed straight into the pool, so appending a row does not allocate.
+        const size_t number_words = IsaInstructionEncoding::Append(binary_representation, words_);
+
+        row.word_count   = static_cast<uint32_t>(words_.size() - row.first_word);
+        row.number_words = static_cast<uint8_t>(std::min<size_t>(number_words, 3));
+
+        // Op codes repeat on every line, so they are only kept as a token.
+        TokenRecord op_code_token;
+        op_code_token.symbol = symbol_table_->Intern(text);
+
+        row.op_code_token = static_cast<uint32_t>(tokens_.size());
+        tokens_.push_back(op_code_token);
+    }
+
+    rows_.push_back(row);
+
+    return blocks_.back().row_count++;
+}
+
+void IsaRowStorage::AppendOperand()
+{
+    assert(!rows_.empty());
+
+    OperandRecord operand;
+    operand.first_token = static_cast<uint32_t>(tokens_.size());
+    operand.token_count = 0;
+
+    operands_.push_back(operand);
+    rows_.back().operand_count++;
+}
+
+IsaRowStorage::TokenRecord& IsaRowStorage::AppendOperandToken(std::string_view text)
+{
+    assert(!operands_.empty());
+
+    TokenRecord token;
+    token.symbol = symbol_table_->Intern(text);
+
+    tokens_.push_back(token);
+    operands_.back().token_count++;
+
+    return tokens_.back();
+}
+
+void IsaRowStorage::Append(const IsaRowStorage& other)
+{
+    const uint32_t text_offset    = static_cast<uint32_t>(text_.size());
+    const uint32_t word_offset    = static_cast<uint32_t>(words_.size());
+    const uint32_t row_offset     = static_cast<uint32_t>(rows_.size());
+    const uint32_t operand_offset = static_cast<uint32_t>(operands_.size());
+    const uint32_t token_offset   = static_cast<uint32_t>(tokens_.size());
+
+    text_.append(other.text_);
+    words_.insert(words_.end(), other.words_.begin(), other.words_.end());
+
+    blocks_.reserve(blocks_.size() + other.blocks_.size());
+    rows_.reserve(rows_.size() + other.rows_.size());
+    operands_.reserve(operands_.size() + other.operands_.size());
+    tokens_.reserve(tokens_.size() + other.tokens_.size());
+
+    // Copy every record and rebase its offsets onto this storage.
+
+    for (BlockRecord block : other.blocks_)
+    {
+        block.text.offset += text_offset;
+        block.first_row += row_offset;
+
+        if (block.label_token != kInvalidIndex)
+        {
+            block.label_token += token_offset;
+        }
+
+        blocks_.push_back(block);
+    }
+
+    for (RowRecord row : other.rows_)
+    {
+        row.text.offset += text_offset;
+        row.pc_address.offset += text_offset;
+        row.first_word += word_offset;
+        row.first_operand += operand_offset;
+
+        if (row.op_code_token != kInvalidIndex)
+        {
+            row.op_code_token += token_offset;
+        }
+
+        rows_.push_back(row);
+    }
+
+    for (OperandRecord operand : other.operands_)
+    {
+        operand.first_token += token_offset;
+
+        operands_.push_back(operand);
+    }
+
+    // Symbols only need to be interned again if the other storage uses another table.
+    const bool same_symbol_table = other.symbol_table_ == symbol_table_;
+
+    for (TokenRecord token : other.tokens_)
+    {
+        if (!same_symbol_table)
+        {
+            token.symbol = symbol_table_->Intern(other.GetTokenText(token));
+        }
+
+        tokens_.push_back(token);
+    }
+}
+
+bool IsaRowStorage::Serialize(const SerializeWriter& write) const
+{
+    // Only the symbols the tokens use are written; a shared table holds the symbols of other shaders too.
+    std::vector<bool> used_symbols(symbol_table_->GetSymbolCount(), false);
+    uint64_t          symbol_count = 0;
+
+    for (const auto& token : tokens_)
+    {
+        if (token.symbol < used_symbols.size() && !used_symbols[token.symbol])
+        {
+            used_symbols[token.symbol] = true;
+            symbol_count++;
+        }
+    }
+
+    SerializedHeader header;
+
+    header.block_record_size   = sizeof(BlockRecord);
+    header.row_record_size     = sizeof(RowRecord);
+    header.operand_record_size = sizeof(OperandRecord);
+    header.token_record_size   = sizeof(TokenRecord);
+    header.text_size           = text_.size();
+    header.word_count          = words_.size();
+    header.block_count         = blocks_.size();
+    header.row_count           = rows_.size();
+    header.operand_count       = operands_.size();
+    header.token_count         = tokens_.size();
+    header.symbol_count        = symbol_count;
+
+    if (!write(reinterpret_cast<const char*>(&header), sizeof(header)) || (!text_.empty() && !write(text_.data(), text_.size())) ||
+        !WriteRecords(write, words_) || !WriteRecords(write, blocks_) || !WriteRecords(write, rows_) || !WriteRecords(write, operands_) ||
+        !WriteRecords(write, tokens_))
+    {
+        return false;
+    }
+
+    for (uint32_t symbol = 0; symbol < static_cast<uint32_t>(used_symbols.size()); symbol++)
+    {
+        if (!used_symbols[symbol])
+        {
+            continue;
+        }
+
+        const std::string_view text                = symbol_table_->GetText(symbol);
+        const uint32_t         symbol_and_length[] = {symbol, static_cast<uint32_t>(text.size())};
+
+        if (!write(reinterpret_cast<const char*>(symbol_and_length), sizeof(symbol_and_length)) || (!text.empty() && !write(text.data(), text.size())))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IsaRowStorage::Deserialize(const char* data, size_t size)
+{
+    SerializedHeader header;
+
+    if (data == nullptr || size < sizeof(header))
+    {
+        return false;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != kSerializedMagic || header.version != kSerializationVersion || header.block_record_size != sizeof(BlockRecord) ||
+        header.row_record_size != sizeof(RowRecord) || header.operand_record_size != sizeof(OperandRecord) ||
+        header.token_record_size != sizeof(TokenRecord))
+    {
+        return false;
+    }
+
+    // Records index each other with 32 bit indices.
+    if (header.text_size > UINT32_MAX || header.word_count > UINT32_MAX || header.block_count > UINT32_MAX || header.row_count > UINT32_MAX ||
+        header.operand_count > UINT32_MAX || header.token_count > UINT32_MAX || header.symbol_count > kMaxSerializedSymbol)
+    {
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+
+    if (header.text_size > size - offset)
+    {
+        return false;
+    }
+
+    std::string                text(data + offset, static_cast<size_t>(header.text_size));
+    std::vector<uint32_t>      words;
+    std::vector<BlockRecord>   blocks;
+    std::vector<RowRecord>     rows;
+    std::vector<OperandRecord> operands;
+    std::vector<TokenRecord>   tokens;
+
+    offset += text.size();
+
+    if (!ReadRecords(data, size, offset, header.word_count, words) || !ReadRecords(data, size, offset, header.block_count, blocks) ||
+        !ReadRecords(data, size, offset, header.row_count, rows) || !ReadRecords(data, size, offset, header.operand_count, operands) ||
+        !ReadRecords(data, size, offset, header.token_count, tokens))
+    {
+        return false;
+    }
+
+    // Every record must only index records that exist, so the storage can be used without checking indices again.
+
+    auto is_valid_text = [&text](const TextRange& text_range) {
+        return text_range.offset <= text.size() && text_range.length <= text.size() - text_range.offset;
+    };
+    auto is_valid_token = [&tokens](uint32_t token_index, bool required) {
+        return (token_index == kInvalidIndex) ? !required : (token_index < tokens.size());
+    };
+
+    for (const BlockRecord& block : blocks)
+    {
+        if (!IsValidBool(block.is_comment) || !is_valid_text(block.text) || !is_valid_token(block.label_token, false) || block.first_row > rows.size() ||
+            block.row_count > rows.size() - block.first_row)
+        {
+            return false;
+        }
+    }
+
+    for (const RowRecord& row : rows)
+    {
+        if (!IsValidBool(row.is_comment) || !IsValidBool(row.enabled) || !is_valid_text(row.text) || !is_valid_text(row.pc_address) ||
+            row.first_word > words.size() || row.word_count > words.size() - row.first_word || row.number_words > std::min<uint32_t>(row.word_count, 3) ||
+            !is_valid_token(row.op_code_token, !row.is_comment) ||
+            row.first_operand > operands.size() || row.operand_count > operands.size() - row.first_operand)
+        {
+            return false;
+        }
+    }
+
+    for (const OperandRecord& operand : operands)
+    {
+        if (operand.first_token > tokens.size() || operand.token_count > tokens.size() - operand.first_token)
+        {
+            return false;
+        }
+    }
+
+    // Read the symbols, and map the ids of the table that wrote them to their index in symbol_texts.
+
+    std::vector<std::string_view> symbol_texts;
+    std::vector<uint32_t>         symbol_entries;
+
+    symbol_texts.reserve(static_cast<size_t>(header.symbol_count));
+
+    for (uint64_t i = 0; i < header.symbol_count; i++)
+    {
+        uint32_t symbol_and_length[2] = {};
+
+        if (sizeof(symbol_and_length) > size - offset)
+        {
+            return false;
+        }
+
+        std::memcpy(symbol_and_length, data + offset, sizeof(symbol_and_length));
+        offset += sizeof(symbol_and_length);
+
+        const uint32_t symbol = symbol_and_length[0];
+        const uint32_t length = symbol_and_length[1];
+
+        if (symbol >= kMaxSerializedSymbol || length > size - offset)
+        {
+            return false;
+        }
+
+        if (symbol >= symbol_entries.size())
+        {
+            symbol_entries.resize(static_cast<size_t>(symbol) + 1, kInvalidIndex);
+        }
+
+        symbol_entries[symbol] = static_cast<uint32_t>(symbol_texts.size());
+        symbol_texts.emplace_back(data + offset, length);
+
+        offset += length;
+    }
+
+    if (offset != size)
+    {
+        return false;
+    }
+
+    for (const TokenRecord& token : tokens)
+    {
+        if (!IsValidBool(token.is_selectable))
+        {
+            return false;
+        }
+
+        if (token.symbol != IsaSymbolTable::kInvalidSymbol && (token.symbol >= symbol_entries.size() || symbol_entries[token.symbol] == kInvalidIndex))
+        {
+            return false;
+        }
+    }
+
+    // The data is valid; intern the symbols in this storage's table.
+
+    std::vector<uint32_t> symbols(symbol_texts.size());
+
+    for (size_t i = 0; i < symbol_texts.size(); i++)
+    {
+        symbols[i] = symbol_table_->Intern(symbol_texts[i]);
+    }
+
+    for (TokenRecord& token : tokens)
+    {
+        if (token.symbol != IsaSymbolTable::kInvalidSymbol)
+        {
+            token.symbol = symbols[symbol_entries[token.symbol]];
+        }
+    }
+
+    text_.swap(text);
+    words_.swap(words);
+    blocks_.swap(blocks);
+    rows_.swap(rows);
+    operands_.swap(operands);
+    tokens_.swap(tokens);
+
+    return true;
+}
+
+uint64_t IsaRowStorage::GetRowDecoderEncoding(const RowRecord& row) const
+{
+    return IsaInstructionEncoding::GetDecoderEncoding(words_.data() + row.first_word, row.number_words);
+}
+
+size_t IsaRowStorage::GetAllocatedSize() const
+{
+    return text_.capacity() + (words_.capacity() * sizeof(uint32_t)) + (blocks_.capacity() * sizeof(BlockRecord)) + (rows_.capacity() * sizeof(RowRecord)) +
+           (operands_.capacity() * sizeof(OperandRecord)) + (tokens_.capacity() * sizeof(TokenRecord));
+}
+
+IsaRowStorage::TextRange IsaRowStorage::AppendText(std::string_view text)
+{
+    TextRange text_range;
+
+    text_range.offset = static_cast<uint32_t>(text_.size());
+    text_range.length = static_cast<uint32_t>(text.size());
+
+    text_.append(text.data(), text.size());
+
+    return text_range;
+}
@@ -0,0 +1,356 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for contiguous, arena backed storage of isa blocks, rows and tokens.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_ROW_STORAGE_H_
+#define QTISAGUI_ISA_ROW_STORAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "isa_symbol_table.h"
+
+/// @brief Predefined token types.
+enum class IsaTokenType : uint8_t
+{
+    kLabelType = 0,       ///< Code block label in op code column.
+    kBranchLabelType,     ///< Label targeted by a branch instruction in operands column.
+    kScalarRegisterType,  ///< Scalar operand.
+    kVectorRegisterType,  ///< Vector operand.
+    kConstantType,        ///< Constant operand.
+    kTypeCount
+};
+
+/// @brief IsaRowStorage stores the blocks, rows and tokens of a shader in a handful of flat buffers.
+///
+/// All text is kept in a single string pool and referenced by offset, so filling or clearing the
+/// storage costs a few allocations regardless of the number of lines in the shader. The binary representation of
+/// instructions is kept as 32 bit words in a pool of its own; see IsaInstructionEncoding.
+/// The text of tokens, including op codes, is interned in a symbol table that may be shared with other storages instead,
+/// since a shader repeats the same few hundred op codes and registers on every line.
+/// Blocks, rows, operands and tokens are appended in order; the rows of a block are contiguous,
+/// as are the operands of a row and the tokens of an operand.
+class IsaRowStorage
+{
+public:
+    static constexpr uint32_t kInvalidIndex         = UINT32_MAX;  ///< Index used for records that do not exist.
+    static constexpr uint32_t kSerializationVersion = 3;           ///< Incremented whenever the records or the format of Serialize change.
+
+    /// @brief Writes serialized data somewhere; returns false if the data could not be written.
+    using SerializeWriter = std::function<bool(const char* data, size_t size)>;
+
+    /// @brief A range of characters in the text pool.
+    struct TextRange
+    {
+        uint32_t offset = 0;  ///< Offset of the first character in the text pool.
+        uint32_t length = 0;  ///< Number of characters in the range.
+    };
+
+    /// @brief Packed equivalent of IsaItemModel::Token.
+    struct TokenRecord
+    {
+        double   x_position_start     = -1;                              ///< The token's starting x view position.
+        double   x_position_end       = -1;                              ///< The token's ending x view position.
+        uint32_t symbol               = IsaSymbolTable::kInvalidSymbol;  ///< The id of the token's isa text in the symbol table.
+        int32_t  start_register_index = -1;                              ///< The starting register index if this token represents a register.
+        int32_t  end_register_index   = -1;                              ///< The ending register index if this token represents a register.
+        uint8_t  type                 = 0;                               ///< The IsaTokenType of this token.           
+        uint8_t  color_class          = 0;                               ///< The IsaColorClass of this token's text.
+        bool     is_selectable        = false;                           ///< true if the token can be selected, false otherwise.
+    };
+
+    /// @brief A group of tokens that belong to the same operand.
+    struct OperandRecord
+    {
+        uint32_t first_token = 0;  ///< Index of the first token of this operand.
+        uint32_t token_count = 0;  ///< Number of tokens in this operand.
+    };
+
+    /// @brief A single child row; either an instruction or a comment.
+    struct RowRecord
+    {
+        TextRange text;                           ///< The text of a comment; an instruction's op code is the text of its op code token.
+        TextRange pc_address;                     ///< The pc address text of an instruction.
+        uint32_t  first_word    = 0;              ///< Index of the first word of an instruction's binary representation.
+        uint32_t  word_count    = 0;              ///< Number of words in an instruction's binary representation.
+        uint32_t  line_number   = 0;              ///< Line # relative to the entire shader.
+        uint32_t  op_code_token = kInvalidIndex;  ///< Index of the op code token of an instruction.
+        uint32_t  first_operand = 0;              ///< Index of the first operand of an instruction.
+        uint32_t  operand_count = 0;              ///< Number of operands of an instruction.
+        bool      is_comment    = false;          ///< true if this row is a comment, false if it is an instruction.
+        bool      enabled       = true;           ///< true if this instruction should be color coded, false otherwise.
+        uint8_t   number_words  = 0;              ///< Number of words of the first hex number, at most 3; see IsaInstructionEncoding::GetDecoderEncoding.
+    };
+
+    /// @brief A single parent block; either a code block or a comment block.
+    struct BlockRecord
+    {
+        TextRange text;                         ///< The label of a code block, or the text of a comment block.
+        uint32_t  line_number = 0;              ///< Line # relative to the entire shader.
+        uint32_t  label_token = kInvalidIndex;  ///< Index of the label token of a code block.
+        uint32_t  first_row   = 0;              ///< Index of the first row of this block.
+        uint32_t  row_count   = 0;              ///< Number of rows in this block.
+        bool      is_comment  = false;          ///< true if this block is a comment block, false if it is a code block.
+    };
+
+    /// @brief Constructor; create empty storage that interns token text in the global symbol table.
+    IsaRowStorage();
+
+    /// @brief Destructor.
+    ~IsaRowStorage();
+
+    /// @brief Change the symbol table token text is interned in; the text of existing tokens is interned again in the new table.
+    ///
+    /// @param [in] symbol_table The symbol table.
+    void SetSymbolTable(const std::shared_ptr<IsaSymbolTable>& symbol_table);
+
+    /// @brief Get the symbol table token text is interned in.
+    ///
+    /// @return The symbol table.
+    inline const std::shared_ptr<IsaSymbolTable>& GetSymbolTable() const
+    {
+        return symbol_table_;
+    }
+
+    /// @brief Remove all blocks, rows, tokens and text; the allocated capacity is kept so it can be reused.
+    void Clear();
+
+    /// @brief Remove all blocks, rows, tokens and text and give the allocated memory back.
+    void ReleaseMemory();
+
+    /// @brief Pre-allocate room for the given amount of records and text.
+    ///
+    /// @param [in] block_count The expected number of blocks.
+    /// @param [in] row_count   The expected number of rows in all blocks.
+    /// @param [in] token_count The expected number of tokens in all rows.
+    /// @param [in] text_size   The expected number of characters of text.
+    void Reserve(size_t block_count, size_t row_count, size_t token_count, size_t text_size);
+
+    /// @brief Append a block; rows appended from now on belong to this block.
+    ///
+    /// Code blocks get a label token whose text is the block text.
+    ///
+    /// @param [in] is_comment  true to append a comment block, false to append a code block.
+    /// @param [in] line_number The line number of the block.
+    /// @param [in] text        The label of the code block, or the text of the comment block.
+    ///
+    /// @return The index of the new block.
+    uint32_t AppendBlock(bool is_comment, uint32_t line_number, std::string_view text);
+
+    /// @brief Append a row to the last block.
+    ///
+    /// Instructions get an op code token whose text is the row text, and the binary representation text is parsed into words.
+    ///
+    /// @param [in] is_comment            true to append a comment, false to append an instruction.
+    /// @param [in] line_number           The line number of the row.
+    /// @param [in] text                  The op code of the instruction, or the text of the comment.
+    /// @param [in] pc_address            The pc address text of the instruction.
+    /// @param [in] binary_representation The binary representation text of the instruction; see IsaInstructionEncoding::Append.
+    /// @param [in] enabled               true if the instruction should be color coded, false otherwise.
+    ///
+    /// @return The index of the new row relative to its block.
+    uint32_t AppendRow(bool             is_comment,
+                       uint32_t         line_number,
+                       std::string_view text,
+                       std::string_view pc_address,
+                       std::string_view binary_representation,
+                       bool             enabled);
+
+    /// @brief Append an empty operand to the last row.
+    void AppendOperand();
+
+    /// @brief Append a token to the last operand of the last row.
+    ///
+    /// @param [in] text The text of the token.
+    ///
+    /// @return The new token, to be filled in by the caller.
+    TokenRecord& AppendOperandToken(std::string_view text);
+
+    /// @brief Append all blocks of another storage after the blocks of this storage.
+    ///
+    /// @param [in] other The storage to copy.
+    void Append(const IsaRowStorage& other);
+
+    /// @brief Get the number of blocks.
+    ///
+    /// @return The number of blocks.
+    inline size_t GetBlockCount() const
+    {
+        return blocks_.size();
+    }
+
+    /// @brief Get the number of rows in all blocks.
+    ///
+    /// @return The number of rows.
+    inline size_t GetRowCount() const
+    {
+        return rows_.size();
+    }
+
+    /// @brief Get the number of tokens in all rows.
+    ///
+    /// @return The number of tokens.
+    inline size_t GetTokenCount() const
+    {
+        return tokens_.size();
+    }
+
+    /// @brief Get the number of characters in the text pool.
+    ///
+    /// @return The size of the text pool.
+    inline size_t GetTextSize() const
+    {
+        return text_.size();
+    }
+
+    /// @brief Get a block.
+    ///
+    /// @param [in] block_index The block index.
+    ///
+    /// @return The block.
+    inline const BlockRecord& GetBlock(size_t block_index) const
+    {
+        return blocks_.at(block_index);
+    }
+
+    /// @brief Get a row of a block.
+    ///
+    /// @param [in] block_index The block index.
+    /// @param [in] row_index   The row index relative to the block.
+    ///
+    /// @return The row.
+    inline const RowRecord& GetRow(size_t block_index, size_t row_index) const
+    {
+        return rows_.at(blocks_.at(block_index).first_row + row_index);
+    }
+
+    /// @brief Get an operand.
+    ///
+    /// @param [in] operand_index The operand index; see RowRecord::first_operand.
+    ///
+    /// @return The operand.
+    inline const OperandRecord& GetOperand(size_t operand_index) const
+    {
+        return operands_[operand_index];
+    }
+
+    /// @brief Get a token.
+    ///
+    /// @param [in] token_index The token index.
+    ///
+    /// @return The token.
+    inline const TokenRecord& GetToken(size_t token_index) const
+    {
+        return tokens_[token_index];
+    }
+
+    /// @brief Get a token that may be changed.
+    ///
+    /// @param [in] token_index The token index.
+    ///
+    /// @return The token.
+    inline TokenRecord& GetMutableToken(size_t token_index)
+    {
+        return tokens_[token_index];
+    }
+
+    /// @brief Get a view of text in the text pool; the view is invalidated when more text is appended.
+    ///
+    /// @param [in] text_range The range of text.
+    ///
+    /// @return The text.
+    inline std::string_view GetText(const TextRange& text_range) const
+    {
+        return std::string_view(text_.data() + text_range.offset, text_range.length);
+    }
+
+    /// @brief Get the words of an instruction's binary representation; invalidated when more rows are appended.
+    ///
+    /// @param [in] row The row.
+    ///
+    /// @return The first of row.word_count words.
+    inline const uint32_t* GetRowWords(const RowRecord& row) const
+    {
+        return words_.data() + row.first_word;
+    }
+
+    /// @brief Get the encoding the isa decoder decodes for an instruction.
+    ///
+    /// @param [in] row The row.
+    ///
+    /// @return The encoding; see IsaInstructionEncoding::GetDecoderEncoding.
+    uint64_t GetRowDecoderEncoding(const RowRecord& row) const;
+
+    /// @brief Get the text of a token.
+    ///
+    /// @param [in] token The token.
+    ///
+    /// @return The text, valid for the lifetime of the symbol table.
+    inline std::string_view GetTokenText(const TokenRecord& token) const
+    {
+        return symbol_table_->GetText(token.symbol);
+    }
+
+    /// @brief Get the text of a row; the op code of an instruction, or the text of a comment.
+    ///
+    /// @param [in] row The row.
+    ///
+    /// @return The text.
+    inline std::string_view GetRowText(const RowRecord& row) const
+    {
+        return row.is_comment ? GetText(row.text) : GetTokenText(tokens_[row.op_code_token]);
+    }
+
+    /// @brief Write every block, row, token and their text in a binary format that Deserialize reads back.
+    ///
+    /// Records are written as they are in memory, so the data can only be read by a build with the same record layout and
+    /// byte order; Deserialize checks both. The text of every symbol the tokens use is written too, since symbol ids are
+    /// only meaningful within the table that made them.
+    ///
+    /// @param [in] write Called with consecutive pieces of the data.
+    ///
+    /// @return true if every piece was written, false if write failed.
+    bool Serialize(const SerializeWriter& write) const;
+
+    /// @brief Replace all blocks, rows, tokens and text by data written by Serialize.
+    ///
+    /// The data is checked before anything is replaced, so records that index past the end of other records, or data from
+    /// another version or build, leave this storage as it is. Symbols are interned in the symbol table of this storage.
+    ///
+    /// @param [in] data The data.
+    /// @param [in] size The size of the data.
+    ///
+    /// @return true if the data was read, false if it is not valid.
+    bool Deserialize(const char* data, size_t size);
+
+    /// @brief Get the number of bytes allocated by this storage, not counting its symbol table, which may be shared.
+    ///
+    /// @return The number of allocated bytes.
+    size_t GetAllocatedSize() const;
+
+private:
+    /// @brief Copy text into the text pool.
+    ///
+    /// @param [in] text The text to copy.
+    ///
+    /// @return The range of the copied text.
+    TextRange AppendText(std::string_view text);
+
+    std::string                     text_;          ///< Pool of all text but the text of tokens.
+    std::vector<uint32_t>           words_;         ///< Pool of the binary representation words of all instructions.
+    std::vector<BlockRecord>        blocks_;        ///< All blocks.
+    std::vector<RowRecord>          rows_;          ///< All rows, in block order.
+    std::vector<OperandRecord>      operands_;      ///< All operands, in row order.
+    std::vector<TokenRecord>        tokens_;        ///< All tokens, in row order.
+    std::shared_ptr<IsaSymbolTable> symbol_table_;  ///< The symbol table the text of tokens is interned in.
+};
+
+#endif  // QTISAGUI_ISA_ROW_STORAGE_H_
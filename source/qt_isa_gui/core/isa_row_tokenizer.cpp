@@ -0,0 +1,217 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for tokenizing isa rows into an IsaRowStorage.
+//=============================================================================
+
+#include "isa_row_tokenizer.h"
+
+#include "isa_color_class.h"
+#include "isa_control_flow_graph.h"
+#include "isa_instrumentation.h"
+#include "isa_operand_lexer.h"
+
+namespace
+{
+    /// @brief Determine the type, register indices and selectability of a single operand token.
+    ///
+    /// @param [in]     is_branch_instruction true if the token belongs to a branch instruction.
+    /// @param [in,out] token                 The token to classify; its text, color class and hit box are left alone.
+    void ClassifyOperandToken(bool is_branch_instruction, IsaRowTokenizer::TokenLayout& token)
+    {
+        if (is_branch_instruction)
+        {
+            // Identify this operand token simply as the target of a branch instruction.
+
+            token.type = IsaTokenType::kBranchLabelType;
+            return;
+        }
+
+        const IsaOperandLexer::Operand operand = IsaOperandLexer::Lex(token.text);
+
+        switch (operand.kind)
+        {
+        case IsaOperandLexer::Kind::kScalarRegister:
+        case IsaOperandLexer::Kind::kVectorRegister:
+            // Single register or range of registers.
+            token.type = (operand.kind == IsaOperandLexer::Kind::kScalarRegister) ? IsaTokenType::kScalarRegisterType : IsaTokenType::kVectorRegisterType;
+            token.is_selectable        = true;
+            token.start_register_index = operand.start_register_index;
+            token.end_register_index   = operand.end_register_index;
+            break;
+
+        case IsaOperandLexer::Kind::kConstant:
+            token.type          = IsaTokenType::kConstantType;
+            token.is_selectable = true;
+            break;
+
+        default:
+            token.type = IsaTokenType::kTypeCount;
+            break;
+        }
+    }
+
+    /// @brief Copy the tokens of an instruction into an IsaRowStorage.
+    class RowStorageTokenSink : public IsaRowTokenizer::TokenSink
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in,out] row_storage The storage; the instruction's row must be its last row.
+        /// @param [in]     block_index The block of the row.
+        /// @param [in]     row_index   The row.
+        RowStorageTokenSink(IsaRowStorage& row_storage, size_t block_index, uint32_t row_index)
+            : row_storage_(row_storage)
+            , block_index_(block_index)
+            , row_index_(row_index)
+        {
+        }
+
+        /// @brief Fill in the op code token AppendRow made for the row.
+        ///
+        /// @param [in] token The token.
+        void AddOpCodeToken(const IsaRowTokenizer::TokenLayout& token) override
+        {
+            CopyToken(token, row_storage_.GetMutableToken(row_storage_.GetRow(block_index_, row_index_).op_code_token));
+        }
+
+        /// @brief Append an operand to the row.
+        void AddOperand() override
+        {
+            row_storage_.AppendOperand();
+        }
+
+        /// @brief Append a token to the last operand of the row.
+        ///
+        /// @param [in] token The token.
+        void AddOperandToken(const IsaRowTokenizer::TokenLayout& token) override
+        {
+            CopyToken(token, row_storage_.AppendOperandToken(token.text));
+        }
+
+    private:
+        /// @brief Copy everything but the text of a token into its record; the storage interns the text itself.
+        ///
+        /// @param [in]  token        The token.
+        /// @param [out] token_record The record.
+        static void CopyToken(const IsaRowTokenizer::TokenLayout& token, IsaRowStorage::TokenRecord& token_record)
+        {
+            token_record.type                 = static_cast<uint8_t>(token.type);
+            token_record.color_class          = static_cast<uint8_t>(token.color_class);
+            token_record.is_selectable        = token.is_selectable;
+            token_record.start_register_index = token.start_register_index;
+            token_record.end_register_index   = token.end_register_index;
+            token_record.x_position_start     = token.x_position_start;
+            token_record.x_position_end       = token.x_position_end;
+        }
+
+        IsaRowStorage& row_storage_;  ///< The storage.
+        size_t         block_index_;  ///< The block of the row.
+        uint32_t       row_index_;    ///< The row.
+    };
+}  // namespace
+
+uint32_t IsaRowTokenizer::AppendBlock(IsaRowStorage& row_storage, bool is_comment, uint32_t line_number, std::string_view text, double fixed_character_width)
+{
+    const uint32_t block_index = row_storage.AppendBlock(is_comment, line_number, text);
+
+    if (!is_comment)
+    {
+        auto& label_token = row_storage.GetMutableToken(row_storage.GetBlock(block_index).label_token);
+
+        label_token.type             = static_cast<uint8_t>(IsaTokenType::kLabelType);
+        label_token.color_class      = static_cast<uint8_t>(IsaColorClassDictionary::GetColorClass(text));
+        label_token.x_position_start = 0;
+        label_token.x_position_end   = fixed_character_width * static_cast<double>(text.size());
+    }
+
+    return block_index;
+}
+
+void IsaRowTokenizer::AppendComment(IsaRowStorage& row_storage, uint32_t line_number, std::string_view text)
+{
+    row_storage.AppendRow(true, line_number, text, std::string_view(), std::string_view(), true);
+}
+
+void IsaRowTokenizer::AppendInstruction(IsaRowStorage&                  row_storage,
+                                        uint32_t                        line_number,
+                                        std::string_view                op_code,
+                                        const std::vector<std::string>& operands,
+                                        std::string_view                pc_address,
+                                        std::string_view                binary_representation,
+                                        bool                            enabled,
+                                        double                          fixed_character_width)
+{
+    const size_t   block_index = row_storage.GetBlockCount() - 1;
+    const uint32_t row_index   = row_storage.AppendRow(false, line_number, op_code, pc_address, binary_representation, enabled);
+
+    RowStorageTokenSink sink(row_storage, block_index, row_index);
+
+    LayoutInstruction(op_code, operands, fixed_character_width, sink);
+}
+
+void IsaRowTokenizer::LayoutInstruction(std::string_view op_code, const std::vector<std::string>& operands, double fixed_character_width, TokenSink& sink)
+{
+    QTISAGUI_SCOPED_TIMER(kParseSelectableTokens);
+
+    // Op code; should be a single token and always selectable.
+    // Sent before any operand token, so a sink may rely on the op code token existing already.
+
+    double token_width = fixed_character_width * static_cast<double>(op_code.size());
+
+    TokenLayout op_code_token;
+
+    op_code_token.text             = op_code;
+    op_code_token.color_class      = IsaColorClassDictionary::GetColorClass(op_code);
+    op_code_token.is_selectable    = true;
+    op_code_token.x_position_start = fixed_character_width * static_cast<double>(kOpCodeColumnIndent.size());
+    op_code_token.x_position_end   = op_code_token.x_position_start + token_width;
+
+    sink.AddOpCodeToken(op_code_token);
+
+    const bool is_branch_instruction = IsaControlFlowGraph::IsLabelBranch(IsaControlFlowGraph::GetBranchType(op_code));
+
+    // Operands; determine which tokens can be selected and set their hit boxes.
+
+    const double space_width     = fixed_character_width * static_cast<double>(kOperandTokenSpace.size());
+    const double delimiter_width = fixed_character_width * static_cast<double>(kOperandDelimiter.size());
+
+    double                        token_start_x = 0;
+    double                        token_end_x   = 0;
+    std::vector<std::string_view> tokens;
+
+    for (const auto& operand : operands)
+    {
+        IsaOperandLexer::SplitOperand(operand, tokens);
+
+        sink.AddOperand();
+
+        for (size_t i = 0; i < tokens.size(); i++)
+        {
+            TokenLayout token;
+
+            token.text        = tokens[i];
+            token.color_class = IsaColorClassDictionary::GetColorClass(token.text);
+
+            ClassifyOperandToken(is_branch_instruction, token);
+
+            token_width = fixed_character_width * static_cast<double>(token.text.size());
+            token_end_x += token_width;
+
+            token.x_position_start = token_start_x;
+            token.x_position_end   = token_end_x;
+
+            sink.AddOperandToken(token);
+
+            if (i < tokens.size() - 1)
+            {
+                token_start_x = token_start_x + token_width + space_width;  // Add whitespace width too.
+                token_end_x   = token_end_x + space_width;                  // Add whitespace width too.
+            }
+        }
+
+        token_start_x = token_start_x + token_width + delimiter_width;  // Add delimiter width too.
+        token_end_x   = token_end_x + delimiter_width;                  // Add delimiter width too.
+    }
+}
@@ -0,0 +1,115 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for tokenizing isa rows into an IsaRowStorage.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_ROW_TOKENIZER_H_
+#define QTISAGUI_ISA_ROW_TOKENIZER_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "isa_color_class.h"
+#include "isa_row_storage.h"
+
+/// @brief IsaRowTokenizer appends blocks and rows to an IsaRowStorage, splitting instructions into classified tokens with hit boxes.
+///
+/// Hit boxes are laid out in units of a fixed font character width the way the isa view paints the op code and operands columns,
+/// so tools can tokenize shaders headlessly and models only have to copy the storage.
+class IsaRowTokenizer
+{
+public:
+    static constexpr std::string_view kOpCodeColumnIndent = "     ";  ///< Indent of the op code column; 5 characters.
+    static constexpr std::string_view kOperandTokenSpace  = " ";      ///< Separates tokens within the same operand.
+    static constexpr std::string_view kOperandDelimiter   = ", ";     ///< Separates operands; a comma and a space.
+
+    /// @brief The classification and hit box of a single token of an instruction.
+    struct TokenLayout
+    {
+        std::string_view text;                                             ///< The token's isa text; refers to the text being laid out.
+        IsaTokenType     type                 = IsaTokenType::kTypeCount;  ///< The type of this token.
+        IsaColorClass    color_class          = IsaColorClass::kNone;      ///< The color coding class of the token's text.
+        bool             is_selectable        = false;                     ///< true if the token can be selected, false otherwise.
+        int32_t          start_register_index = -1;                        ///< The starting register index if this token represents a register.
+        int32_t          end_register_index   = -1;                        ///< The ending register index if this token represents a register.
+        double           x_position_start     = -1;                        ///< The token's starting x view position.
+        double           x_position_end       = -1;                        ///< The token's ending x view position.
+    };
+
+    /// @brief TokenSink receives the tokens of an instruction from LayoutInstruction, so every kind of storage lays them out the same way.
+    class TokenSink
+    {
+    public:
+        /// @brief Destructor.
+        virtual ~TokenSink() = default;
+
+        /// @brief Receive the op code token; always the first token.
+        ///
+        /// @param [in] token The token.
+        virtual void AddOpCodeToken(const TokenLayout& token) = 0;
+
+        /// @brief Start the next operand; the tokens that follow belong to it.
+        virtual void AddOperand() = 0;
+
+        /// @brief Receive a token of the current operand.
+        ///
+        /// @param [in] token The token.
+        virtual void AddOperandToken(const TokenLayout& token) = 0;
+    };
+
+    /// @brief Split an instruction into classified tokens and lay out their hit boxes.
+    ///
+    /// The op code is indented by kOpCodeColumnIndent in its column. Operand hit boxes start at the operands column,
+    /// with kOperandTokenSpace between the tokens of an operand and kOperandDelimiter between operands.
+    ///
+    /// @param [in]     op_code               The op code text.
+    /// @param [in]     operands              The operand strings.
+    /// @param [in]     fixed_character_width The width of a single character of the fixed font the rows are shown with.
+    /// @param [in,out] sink                  Receives the tokens, in order.
+    static void LayoutInstruction(std::string_view op_code, const std::vector<std::string>& operands, double fixed_character_width, TokenSink& sink);
+
+    /// @brief Append a block.
+    ///
+    /// @param [in,out] row_storage           The storage to append to.
+    /// @param [in]     is_comment            true to append a comment block, false to append a code block.
+    /// @param [in]     line_number           The line number of the block.
+    /// @param [in]     text                  The label of the code block, or the text of the comment block.
+    /// @param [in]     fixed_character_width The width of a single character of the fixed font the rows are shown with.
+    ///
+    /// @return The position of the new block.
+    static uint32_t AppendBlock(IsaRowStorage& row_storage, bool is_comment, uint32_t line_number, std::string_view text, double fixed_character_width);
+
+    /// @brief Append a comment to the last block.
+    ///
+    /// @param [in,out] row_storage The storage to append to.
+    /// @param [in]     line_number The line number of the comment.
+    /// @param [in]     text        The text of the comment.
+    static void AppendComment(IsaRowStorage& row_storage, uint32_t line_number, std::string_view text);
+
+    /// @brief Append an instruction to the last block, and parse its selectable tokens.
+    ///
+    /// Only touches the given storage so it may be used to fill storage off of the GUI thread.
+    ///
+    /// @param [in,out] row_storage           The storage to append to.
+    /// @param [in]     line_number           The line number of the instruction.
+    /// @param [in]     op_code               The op code text.
+    /// @param [in]     operands              The operand strings.
+    /// @param [in]     pc_address            The pc address text.
+    /// @param [in]     binary_representation The binary representation text.
+    /// @param [in]     enabled               true if the instruction should be color coded, false otherwise.
+    /// @param [in]     fixed_character_width The width of a single character of the fixed font the rows are shown with.
+    static void AppendInstruction(IsaRowStorage&                  row_storage,
+                                  uint32_t                        line_number,
+                                  std::string_view                op_code,
+                                  const std::vector<std::string>& operands,
+                                  std::string_view                pc_address,
+                                  std::string_view                binary_representation,
+                                  bool                            enabled,
+                                  double                          fixed_character_width);
+};
+
+#endif  // QTISAGUI_ISA_ROW_TOKENIZER_H_
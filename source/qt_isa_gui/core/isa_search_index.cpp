@@ -0,0 +1,537 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for a full text search index of isa lines.
+//=============================================================================
+
+#include "isa_search_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace
+{
+    /// @brief Lower case an ascii character; other characters are returned as is.
+    ///
+    /// @param [in] c The character.
+    ///
+    /// @return The lower case character.
+    inline char ToLowerAscii(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    /// @brief Convert an offset into UTF-8 text to the offset into the same text in UTF-16.
+    ///
+    /// @param [in] text        The UTF-8 text.
+    /// @param [in] byte_offset The offset into text; must be at the start of a character.
+    ///
+    /// @return The number of UTF-16 code units before the offset.
+    inline uint32_t GetUtf16Offset(std::string_view text, size_t byte_offset)
+    {
+        uint32_t utf16_offset = 0;
+
+        for (size_t i = 0; i < byte_offset; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(text[i]);
+
+            // Skip continuation bytes; characters of 4 bytes take a surrogate pair.
+            if ((c & 0xC0) != 0x80)
+            {
+                utf16_offset += (c >= 0xF0) ? 2 : 1;
+            }
+        }
+
+        return utf16_offset;
+    }
+
+    /// @brief Check if a character is part of a word, for MatchMode::kWholeWord.
+    ///
+    /// @param [in] c The character.
+    ///
+    /// @return true for ascii letters, digits and underscores.
+    inline bool IsWordCharacter(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+}  // namespace
+
+IsaSearchIndex::Query::Query()
+    : mode_(MatchMode::kContains)
+    , valid_(false)
+{
+}
+
+IsaSearchIndex::Query::~Query()
+{
+}
+
+bool IsaSearchIndex::Query::Compile(std::string_view text, MatchMode mode)
+{
+    mode_  = mode;
+    valid_ = false;
+    text_.clear();
+
+    if (text.empty())
+    {
+        return false;
+    }
+
+    if (mode == MatchMode::kRegularExpression)
+    {
+        // The index keeps lower case text, so the expression ignores case instead of being lower cased, which would change escapes like \S.
+        text_.assign(text);
+
+        try
+        {
+            regex_ = std::regex(text_, std::regex_constants::ECMAScript | std::regex_constants::icase | std::regex_constants::optimize);
+        }
+        catch (const std::regex_error&)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        text_.reserve(text.size());
+        std::transform(text.begin(), text.end(), std::back_inserter(text_), ToLowerAscii);
+    }
+
+    valid_ = true;
+
+    return true;
+}
+
+bool IsaSearchIndex::Query::Find(std::string_view text, size_t offset, size_t& match_start, size_t& match_length) const
+{
+    if (!valid_ || offset > text.size())
+    {
+        return false;
+    }
+
+    if (mode_ == MatchMode::kRegularExpression)
+    {
+        // Let anchors and word boundaries see the text before the offset.
+        auto flags = std::regex_constants::match_not_null;
+
+        if (offset > 0)
+        {
+            flags |= std::regex_constants::match_prev_avail;
+        }
+
+        std::cmatch match;
+
+        if (!std::regex_search(text.data() + offset, text.data() + text.size(), match, regex_, flags))
+        {
+            return false;
+        }
+
+        match_start  = offset + static_cast<size_t>(match.position(0));
+        match_length = static_cast<size_t>(match.length(0));
+
+        return true;
+    }
+
+    size_t position = text.find(text_, offset);
+
+    while (position != std::string_view::npos)
+    {
+        const size_t end = position + text_.size();
+
+        // Only a query that starts or ends with a word character can be part of a longer word at that end.
+        const bool starts_word = position == 0 || !IsWordCharacter(text[position - 1]) || !IsWordCharacter(text_.front());
+        const bool ends_word   = end == text.size() || !IsWordCharacter(text[end]) || !IsWordCharacter(text_.back());
+
+        if (mode_ == MatchMode::kContains || (starts_word && ends_word))
+        {
+            match_start  = position;
+            match_length = text_.size();
+
+            return true;
+        }
+
+        position = text.find(text_, position + 1);
+    }
+
+    return false;
+}
+
+IsaSearchIndex::IsaSearchIndex()
+{
+}
+
+IsaSearchIndex::~IsaSearchIndex()
+{
+}
+
+void IsaSearchIndex::Clear()
+{
+    columns_.clear();
+
+    ClearResults();
+}
+
+void IsaSearchIndex::BeginColumn(size_t column)
+{
+    if (column >= columns_.size())
+    {
+        columns_.resize(column + 1);
+    }
+
+    Column& indexed_column = columns_[column];
+
+    indexed_column.indexed = true;
+    indexed_column.text.clear();
+    indexed_column.line_offsets.assign(1, 0);
+
+    ClearResults();
+}
+
+void IsaSearchIndex::AppendLine(size_t column, std::string_view text)
+{
+    assert(HasColumn(column));
+
+    Column& indexed_column = columns_[column];
+
+    std::transform(text.begin(), text.end(), std::back_inserter(indexed_column.text), ToLowerAscii);
+
+    indexed_column.line_offsets.push_back(static_cast<uint32_t>(indexed_column.text.size()));
+}
+
+bool IsaSearchIndex::HasColumn(size_t column) const
+{
+    return column < columns_.size() && columns_[column].indexed;
+}
+
+uint32_t IsaSearchIndex::GetLineCount() const
+{
+    for (const auto& column : columns_)
+    {
+        if (column.indexed)
+        {
+            return static_cast<uint32_t>(column.line_offsets.size() - 1);
+        }
+    }
+
+    return 0;
+}
+
+void IsaSearchIndex::Search(std::string_view query, const std::vector<size_t>& columns, std::vector<uint32_t>& lines)
+{
+    lines.clear();
+
+    std::string lower_case_query;
+    lower_case_query.reserve(query.size());
+
+    std::transform(query.begin(), query.end(), std::back_inserter(lower_case_query), ToLowerAscii);
+
+    if (lower_case_query.empty())
+    {
+        ClearResults();
+        return;
+    }
+
+    // Any line that contains the new query also contains the previous query when the new query extends it,
+    // so only the previous results need to be looked at again.
+
+    const bool refine = has_previous_search_ && previous_mode_ == MatchMode::kContains && columns == previous_columns_ &&
+                        lower_case_query.find(previous_query_) != std::string::npos;
+
+    if (refine)
+    {
+        for (const uint32_t line : previous_lines_)
+        {
+            for (const size_t column : columns)
+            {
+                if (HasColumn(column) && LineContains(columns_[column], line, lower_case_query))
+                {
+                    lines.push_back(line);
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        std::vector<uint32_t> column_lines;
+        std::vector<uint32_t> merged_lines;
+
+        for (const size_t column : columns)
+        {
+            if (!HasColumn(column))
+            {
+                continue;
+            }
+
+            SearchColumn(columns_[column], lower_case_query, column_lines);
+
+            merged_lines.clear();
+            std::set_union(lines.begin(), lines.end(), column_lines.begin(), column_lines.end(), std::back_inserter(merged_lines));
+            lines.swap(merged_lines);
+        }
+    }
+
+    previous_query_      = lower_case_query;
+    previous_mode_       = MatchMode::kContains;
+    previous_columns_    = columns;
+    previous_lines_      = lines;
+    has_previous_search_ = true;
+    has_matches_         = true;
+
+    FindMatches();
+}
+
+void IsaSearchIndex::Search(const Query& query, const std::vector<size_t>& columns, std::vector<uint32_t>& lines)
+{
+    if (query.GetMode() == MatchMode::kContains)
+    {
+        // Substrings are found with one scan per column, and may refine the previous search.
+        Search(query.GetText(), columns, lines);
+        return;
+    }
+
+    std::vector<size_t> sorted_columns = columns;
+
+    std::sort(sorted_columns.begin(), sorted_columns.end());
+    sorted_columns.erase(std::unique(sorted_columns.begin(), sorted_columns.end()), sorted_columns.end());
+
+    Results results;
+    SearchRange(query, sorted_columns, 0, GetLineCount(), results);
+
+    BeginResults(query, columns);
+    AppendResults(results);
+    EndResults();
+
+    lines = previous_lines_;
+}
+
+void IsaSearchIndex::SearchRange(const Query& query, const std::vector<size_t>& columns, uint32_t first_line, uint32_t end_line, Results& results) const
+{
+    results.lines.clear();
+    results.cells.clear();
+    results.match_starts.clear();
+    results.match_lengths.clear();
+
+    for (uint32_t line = first_line; line < end_line; line++)
+    {
+        bool line_matches = false;
+
+        for (const size_t column : columns)
+        {
+            if (!HasColumn(column) || line + 1 >= columns_[column].line_offsets.size())
+            {
+                continue;
+            }
+
+            const Column&          indexed_column = columns_[column];
+            const uint32_t         line_start     = indexed_column.line_offsets[line];
+            const uint32_t         line_end       = indexed_column.line_offsets[line + 1];
+            const std::string_view line_text      = std::string_view(indexed_column.text).substr(line_start, line_end - line_start);
+            const uint32_t         first_match    = static_cast<uint32_t>(results.match_starts.size());
+
+            size_t match_start  = 0;
+            size_t match_length = 0;
+            size_t offset       = 0;
+
+            if (!query.Find(line_text, offset, match_start, match_length))
+            {
+                continue;
+            }
+
+            const bool is_ascii = IsAscii(line_text);
+
+            do
+            {
+                if (is_ascii)
+                {
+                    results.match_starts.push_back(static_cast<uint32_t>(match_start));
+                    results.match_lengths.push_back(static_cast<uint32_t>(match_length));
+                }
+                else
+                {
+                    const uint32_t utf16_start = GetUtf16Offset(line_text, match_start);
+
+                    results.match_starts.push_back(utf16_start);
+                    results.match_lengths.push_back(GetUtf16Offset(line_text, match_start + match_length) - utf16_start);
+                }
+
+                // Matches are never empty, so this always moves forward.
+                offset = match_start + match_length;
+            } while (query.Find(line_text, offset, match_start, match_length));
+
+            results.cells.push_back({line, static_cast<uint32_t>(column), first_match});
+
+            line_matches = true;
+        }
+
+        if (line_matches)
+        {
+            results.lines.push_back(line);
+        }
+    }
+}
+
+void IsaSearchIndex::BeginResults(const Query& query, const std::vector<size_t>& columns)
+{
+    ClearResults();
+
+    previous_query_   = query.GetText();
+    previous_mode_    = query.GetMode();
+    previous_columns_ = columns;
+    has_matches_      = true;
+}
+
+void IsaSearchIndex::AppendResults(const Results& results)
+{
+    const uint32_t match_offset = static_cast<uint32_t>(match_starts_.size());
+
+    previous_lines_.insert(previous_lines_.end(), results.lines.begin(), results.lines.end());
+
+    for (const MatchCell& cell : results.cells)
+    {
+        match_cells_.push_back({cell.line, cell.column, cell.first_match + match_offset});
+    }
+
+    match_starts_.insert(match_starts_.end(), results.match_starts.begin(), results.match_starts.end());
+    match_lengths_.insert(match_lengths_.end(), results.match_lengths.begin(), results.match_lengths.end());
+}
+
+void IsaSearchIndex::EndResults()
+{
+    has_previous_search_ = true;
+}
+
+bool IsaSearchIndex::GetMatches(uint32_t line, size_t column, const uint32_t*& match_starts, const uint32_t*& match_lengths, size_t& match_count) const
+{
+    match_starts  = nullptr;
+    match_lengths = nullptr;
+    match_count   = 0;
+
+    if (!has_matches_ || std::find(previous_columns_.begin(), previous_columns_.end(), column) == previous_columns_.end())
+    {
+        return false;
+    }
+
+    const auto cell_iter = std::lower_bound(match_cells_.begin(), match_cells_.end(), std::make_pair(line, column), [](const MatchCell& cell, const auto& key) {
+        return (cell.line != key.first) ? (cell.line < key.first) : (cell.column < key.second);
+    });
+
+    if (cell_iter != match_cells_.end() && cell_iter->line == line && cell_iter->column == column)
+    {
+        const size_t next_match = (std::next(cell_iter) != match_cells_.end()) ? std::next(cell_iter)->first_match : match_starts_.size();
+
+        match_starts  = match_starts_.data() + cell_iter->first_match;
+        match_lengths = match_lengths_.data() + cell_iter->first_match;
+        match_count   = next_match - cell_iter->first_match;
+    }
+
+    return true;
+}
+
+bool IsaSearchIndex::IsAscii(std::string_view text)
+{
+    return std::all_of(text.begin(), text.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+}
+
+void IsaSearchIndex::SearchColumn(const Column& column, std::string_view query, std::vector<uint32_t>& lines) const
+{
+    lines.clear();
+
+    const std::string_view text(column.text);
+    const auto&            offsets = column.line_offsets;
+
+    size_t position = text.find(query);
+
+    while (position != std::string_view::npos)
+    {
+        // Find the line the match starts in; a match that runs into the next line does not count.
+        const auto     line_end_iter = std::upper_bound(offsets.begin(), offsets.end(), static_cast<uint32_t>(position));
+        const uint32_t line          = static_cast<uint32_t>(std::distance(offsets.begin(), line_end_iter) - 1);
+        const size_t   line_end      = *line_end_iter;
+
+        if (position + query.size() <= line_end)
+        {
+            lines.push_back(line);
+
+            // One match per line is enough; continue with the next line.
+            position = text.find(query, line_end);
+        }
+        else
+        {
+            position = text.find(query, position + 1);
+        }
+    }
+}
+
+bool IsaSearchIndex::LineContains(const Column& column, uint32_t line, std::string_view query) const
+{
+    const uint32_t line_start = column.line_offsets[line];
+    const uint32_t line_end   = column.line_offsets[line + 1];
+
+    return std::string_view(column.text).substr(line_start, line_end - line_start).find(query) != std::string_view::npos;
+}
+
+void IsaSearchIndex::ClearResults()
+{
+    previous_lines_.clear();
+    match_cells_.clear();
+    match_starts_.clear();
+    match_lengths_.clear();
+
+    has_previous_search_ = false;
+    has_matches_         = false;
+}
+
+void IsaSearchIndex::FindMatches()
+{
+    match_cells_.clear();
+    match_starts_.clear();
+    match_lengths_.clear();
+
+    // Cells are kept in order of line, then column, so they can be looked up with a binary search.
+    std::vector<size_t> columns = previous_columns_;
+
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+    const std::string_view query(previous_query_);
+
+    for (const uint32_t line : previous_lines_)
+    {
+        for (const size_t column : columns)
+        {
+            if (!HasColumn(column))
+            {
+                continue;
+            }
+
+            const Column&          indexed_column = columns_[column];
+            const uint32_t         line_start     = indexed_column.line_offsets[line];
+            const uint32_t         line_end       = indexed_column.line_offsets[line + 1];
+            const std::string_view line_text      = std::string_view(indexed_column.text).substr(line_start, line_end - line_start);
+            const uint32_t         first_match    = static_cast<uint32_t>(match_starts_.size());
+
+            // Like QString::indexOf in a loop, a match starts after the end of the previous match.
+            size_t position = line_text.find(query);
+
+            if (position == std::string_view::npos)
+            {
+                continue;
+            }
+
+            const bool is_ascii = IsAscii(line_text);
+
+            while (position != std::string_view::npos)
+            {
+                match_starts_.push_back(is_ascii ? static_cast<uint32_t>(position) : GetUtf16Offset(line_text, position));
+                match_lengths_.push_back(static_cast<uint32_t>(query.size()));
+
+                position = line_text.find(query, position + query.size());
+            }
+
+            match_cells_.push_back({line, static_cast<uint32_t>(column), first_match});
+        }
+    }
+}
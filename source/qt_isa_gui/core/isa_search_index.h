@@ -0,0 +1,246 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for a full text search index of isa lines.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_SEARCH_INDEX_H_
+#define QTISAGUI_ISA_SEARCH_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief IsaSearchIndex finds the lines of a shader that contain some text, ignoring case.
+///
+/// The text of every column is kept lower case in one contiguous buffer per column, with the offset of each line,
+/// so a search is a handful of substring scans over a few buffers instead of one string per cell.
+/// When a query contains the previous query, only the lines that matched the previous query are searched again.
+/// Where the last query matches in every matching line is kept as well, so painting the matches does not search again.
+/// Ranges of lines can be searched on worker threads with SearchRange, and their results added in line order.
+class IsaSearchIndex
+{
+public:
+    /// @brief How a query matches text.
+    enum class MatchMode
+    {
+        kContains,           ///< The query text appears anywhere.
+        kWholeWord,          ///< The query text appears, and is not part of a longer word where it starts or ends with a word character.
+        kRegularExpression,  ///< An ECMAScript regular expression matches; empty matches are ignored.
+    };
+
+    /// @brief A query prepared once to be matched against many lines, from any number of threads.
+    class Query
+    {
+    public:
+        /// @brief Constructor; create an empty query that matches nothing.
+        Query();
+
+        /// @brief Destructor.
+        ~Query();
+
+        /// @brief Prepare a query.
+        ///
+        /// @param [in] text The text to search for, or the regular expression.
+        /// @param [in] mode How the query matches; case is ignored in every mode.
+        ///
+        /// @return true if the query can be matched, false if it is empty or not a valid regular expression.
+        bool Compile(std::string_view text, MatchMode mode);
+
+        /// @brief Get the mode the query was prepared with.
+        ///
+        /// @return The mode.
+        inline MatchMode GetMode() const
+        {
+            return mode_;
+        }
+
+        /// @brief Get the lower case text of the query, or the regular expression.
+        ///
+        /// @return The text.
+        inline const std::string& GetText() const
+        {
+            return text_;
+        }
+
+        /// @brief Find the next match in lower case text.
+        ///
+        /// @param [in]  text         The lower case text.
+        /// @param [in]  offset       The offset into text to start looking at.
+        /// @param [out] match_start  The offset of the match into text.
+        /// @param [out] match_length The length of the match.
+        ///
+        /// @return true if a match was found.
+        bool Find(std::string_view text, size_t offset, size_t& match_start, size_t& match_length) const;
+
+    private:
+        std::string text_;   ///< The lower case text, or the regular expression.
+        MatchMode   mode_;   ///< How the query matches.
+        bool        valid_;  ///< true if Compile succeeded.
+        std::regex  regex_;  ///< The compiled regular expression of MatchMode::kRegularExpression.
+    };
+
+    /// @brief The matches of a query in one line of one column.
+    struct MatchCell
+    {
+        uint32_t line;         ///< The line.
+        uint32_t column;       ///< The column.
+        uint32_t first_match;  ///< Index of the first match into match_starts.
+    };
+
+    /// @brief The results of searching a range of lines.
+    struct Results
+    {
+        std::vector<uint32_t>  lines;          ///< The matching lines, in ascending order.
+        std::vector<MatchCell> cells;          ///< Cells with matches, by line and column.
+        std::vector<uint32_t>  match_starts;   ///< The start of every match, cell after cell, in UTF-16 code units.
+        std::vector<uint32_t>  match_lengths;  ///< The length of every match, in UTF-16 code units.
+    };
+
+    /// @brief Constructor; create an empty index.
+    IsaSearchIndex();
+
+    /// @brief Destructor.
+    ~IsaSearchIndex();
+
+    /// @brief Remove all columns and forget the previous search.
+    void Clear();
+
+    /// @brief Start indexing a column; any text already indexed for the column is removed.
+    ///
+    /// @param [in] column The column.
+    void BeginColumn(size_t column);
+
+    /// @brief Append the text of the next line to a column.
+    ///
+    /// @param [in] column The column; BeginColumn must have been called for it.
+    /// @param [in] text   The text of the line in this column.
+    void AppendLine(size_t column, std::string_view text);
+
+    /// @brief Check if a column has been indexed.
+    ///
+    /// @param [in] column The column.
+    ///
+    /// @return true if BeginColumn was called for the column since the last Clear.
+    bool HasColumn(size_t column) const;
+
+    /// @brief Get the number of lines in the indexed columns.
+    ///
+    /// @return The number of lines of the first indexed column, or 0 if none is indexed.
+    uint32_t GetLineCount() const;
+
+    /// @brief Find the lines that contain the query in any of the given columns, ignoring ascii case.
+    ///
+    /// @param [in]  query   The text to search for.
+    /// @param [in]  columns The indexed columns to search.
+    /// @param [out] lines   The matching lines, in ascending order.
+    void Search(std::string_view query, const std::vector<size_t>& columns, std::vector<uint32_t>& lines);
+
+    /// @brief Find the lines that a prepared query matches in any of the given columns.
+    ///
+    /// @param [in]  query   The query.
+    /// @param [in]  columns The indexed columns to search.
+    /// @param [out] lines   The matching lines, in ascending order.
+    void Search(const Query& query, const std::vector<size_t>& columns, std::vector<uint32_t>& lines);
+
+    /// @brief Find the lines of a range that a prepared query matches in any of the given columns, and where it matches.
+    ///
+    /// Only reads the index, so ranges can be searched on several threads at once, as long as the index is not changed.
+    ///
+    /// @param [in]  query      The query.
+    /// @param [in]  columns    The indexed columns to search, sorted and without duplicates.
+    /// @param [in]  first_line The first line.
+    /// @param [in]  end_line   The line after the last line.
+    /// @param [out] results    The results.
+    void SearchRange(const Query& query, const std::vector<size_t>& columns, uint32_t first_line, uint32_t end_line, Results& results) const;
+
+    /// @brief Forget the last search, and start collecting the results of a search by ranges; see SearchRange.
+    ///
+    /// @param [in] query   The query.
+    /// @param [in] columns The columns being searched.
+    void BeginResults(const Query& query, const std::vector<size_t>& columns);
+
+    /// @brief Add the results of the next range of lines to the last search.
+    ///
+    /// @param [in] results The results of a range after the ranges added before.
+    void AppendResults(const Results& results);
+
+    /// @brief Mark the results of the last search as complete, so a query that extends it refines its results.
+    void EndResults();
+
+    /// @brief Get the lines the last search found so far.
+    ///
+    /// @return The matching lines, in ascending order.
+    inline const std::vector<uint32_t>& GetLines() const
+    {
+        return previous_lines_;
+    }
+
+    /// @brief Get where the last query matches in a line of a column.
+    ///
+    /// Matches do not overlap, and are offsets in UTF-16 code units, like the offsets into a QString of the line's text.
+    ///
+    /// @param [in]  line          The line.
+    /// @param [in]  column        The column.
+    /// @param [out] match_starts  The offset of the first match; only valid until the next search or change of the index.
+    /// @param [out] match_lengths The length of the first match; valid as long as match_starts.
+    /// @param [out] match_count   The number of matches, possibly 0.
+    ///
+    /// @return true if the last search covered the column, false if there was no search since the index last changed.
+    bool GetMatches(uint32_t line, size_t column, const uint32_t*& match_starts, const uint32_t*& match_lengths, size_t& match_count) const;
+
+    /// @brief Check if text only has ascii characters; case insensitive search of other text is not supported.
+    ///
+    /// @param [in] text The text.
+    ///
+    /// @return true if every character is ascii.
+    static bool IsAscii(std::string_view text);
+
+private:
+    /// @brief The lower case text of every line of one column.
+    struct Column
+    {
+        bool                  indexed = false;  ///< true if this column has been indexed.
+        std::string           text;             ///< The lower case text of all lines, back to back.
+        std::vector<uint32_t> line_offsets;     ///< Offset of every line into text, plus the size of text.
+    };
+
+    /// @brief Find the lines of a column that contain the query.
+    ///
+    /// @param [in]  column The column.
+    /// @param [in]  query  The lower case query.
+    /// @param [out] lines  The matching lines, in ascending order.
+    void SearchColumn(const Column& column, std::string_view query, std::vector<uint32_t>& lines) const;
+
+    /// @brief Check if a line of a column contains the query.
+    ///
+    /// @param [in] column The column.
+    /// @param [in] line   The line.
+    /// @param [in] query  The lower case query.
+    ///
+    /// @return true if the line contains the query.
+    bool LineContains(const Column& column, uint32_t line, std::string_view query) const;
+
+    /// @brief Record where the previous query matches in every line of previous_lines_.
+    void FindMatches();
+
+    /// @brief Forget the previous search and its matches.
+    void ClearResults();
+
+    std::vector<Column>    columns_;                                     ///< The indexed columns.
+    std::string            previous_query_;                              ///< The lower case query of the previous search.
+    MatchMode              previous_mode_       = MatchMode::kContains;  ///< The mode of the previous search.
+    std::vector<size_t>    previous_columns_;                            ///< The columns of the previous search.
+    std::vector<uint32_t>  previous_lines_;                              ///< The results of the previous search.
+    bool                   has_previous_search_ = false;                 ///< true if previous_* describe a complete search of the current text.
+    bool                   has_matches_         = false;                 ///< true if match_* describe a search of the current text, maybe not complete yet.
+    std::vector<MatchCell> match_cells_;                                 ///< Cells with matches of the previous query, by line and column.
+    std::vector<uint32_t>  match_starts_;                                ///< The start of every match, cell after cell.
+    std::vector<uint32_t>  match_lengths_;                               ///< The length of every match.
+};
+
+#endif  // QTISAGUI_ISA_SEARCH_INDEX_H_
@@ -0,0 +1,133 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for a table of interned isa token text, shared by isa models.
+//=============================================================================
+
+#include "isa_symbol_table.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+IsaSymbolTable::IsaSymbolTable()
+    : text_chunk_used_(0)
+    , text_chunk_capacity_(0)
+    , text_allocated_size_(0)
+    , symbol_count_(0)
+{
+    for (auto& page : pages_)
+    {
+        page.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+IsaSymbolTable::~IsaSymbolTable()
+{
+}
+
+std::shared_ptr<IsaSymbolTable> IsaSymbolTable::GetGlobal()
+{
+    static std::shared_ptr<IsaSymbolTable> global_symbol_table = std::make_shared<IsaSymbolTable>();
+
+    return global_symbol_table;
+}
+
+uint32_t IsaSymbolTable::Intern(std::string_view text)
+{
+    {
+        // Almost every token of a shader is a text that was seen before.
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+
+        const auto symbol_iter = symbol_ids_.find(text);
+
+        if (symbol_iter != symbol_ids_.end())
+        {
+            return symbol_iter->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    // Another thread may have added the text in between the locks.
+    const auto symbol_iter = symbol_ids_.find(text);
+
+    if (symbol_iter != symbol_ids_.end())
+    {
+        return symbol_iter->second;
+    }
+
+    const uint32_t symbol = symbol_count_;
+    const size_t   page   = symbol / kPageSize;
+
+    assert(page < kMaxPageCount);
+
+    if (symbol % kPageSize == 0)
+    {
+        page_storage_.push_back(std::make_unique<Symbol[]>(kPageSize));
+        pages_[page].store(page_storage_.back().get(), std::memory_order_release);
+    }
+
+    const std::string_view copy = CopyText(text);
+
+    page_storage_[page][symbol % kPageSize].text = copy;
+    symbol_ids_.emplace(copy, symbol);
+
+    symbol_count_++;
+
+    return symbol;
+}
+
+uint32_t IsaSymbolTable::Find(std::string_view text) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    const auto symbol_iter = symbol_ids_.find(text);
+
+    return (symbol_iter != symbol_ids_.end()) ? symbol_iter->second : kInvalidSymbol;
+}
+
+size_t IsaSymbolTable::GetSymbolCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    return symbol_count_;
+}
+
+size_t IsaSymbolTable::GetAllocatedSize() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    size_t allocated_size = text_allocated_size_;
+
+    allocated_size += page_storage_.size() * kPageSize * sizeof(Symbol);
+    allocated_size += symbol_ids_.bucket_count() * sizeof(void*) + symbol_ids_.size() * (sizeof(std::string_view) + sizeof(uint32_t) + sizeof(void*));
+
+    return allocated_size;
+}
+
+std::string_view IsaSymbolTable::CopyText(std::string_view text)
+{
+    if (text.empty())
+    {
+        return std::string_view();
+    }
+
+    if (text_chunk_used_ + text.size() > text_chunk_capacity_)
+    {
+        // Text is never freed on its own, so the rest of a chunk that does not fit is left unused.
+        text_chunk_capacity_ = std::max(kTextChunkSize, text.size());
+        text_chunk_used_     = 0;
+
+        text_chunks_.push_back(std::make_unique<char[]>(text_chunk_capacity_));
+        text_allocated_size_ += text_chunk_capacity_;
+    }
+
+    char* const copy = text_chunks_.back().get() + text_chunk_used_;
+    std::memcpy(copy, text.data(), text.size());
+
+    text_chunk_used_ += text.size();
+
+    return std::string_view(copy, text.size());
+}
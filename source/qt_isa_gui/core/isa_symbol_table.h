@@ -0,0 +1,115 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for a table of interned isa token text, shared by isa models.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_SYMBOL_TABLE_H_
+#define QTISAGUI_ISA_SYMBOL_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @brief IsaSymbolTable maps the text of isa tokens, like op codes, registers and labels, to small integer ids.
+///
+/// A shader only uses a few hundred distinct op codes and registers, so models store the id of a token instead of a copy of
+/// its text, and compare tokens by id. Ids are only meaningful within the table that made them.
+/// Interning is thread safe, so parser threads can share a table; looking up the text of an id never takes a lock.
+/// Text is never removed from a table, so give models that load unrelated shaders a table of their own if that matters.
+class IsaSymbolTable
+{
+public:
+    static constexpr uint32_t kInvalidSymbol = UINT32_MAX;  ///< Id of a symbol that does not exist.
+
+    /// @brief Constructor; create an empty table.
+    IsaSymbolTable();
+
+    /// @brief Destructor.
+    ~IsaSymbolTable();
+
+    /// @brief Get the table shared by every model that is not given a table of its own.
+    ///
+    /// @return The process wide table.
+    static std::shared_ptr<IsaSymbolTable> GetGlobal();
+
+    /// @brief Get the id of text, adding the text to this table if it is not in it yet.
+    ///
+    /// @param [in] text The text.
+    ///
+    /// @return The id of the text.
+    uint32_t Intern(std::string_view text);
+
+    /// @brief Get the id of text without adding it.
+    ///
+    /// @param [in] text The text.
+    ///
+    /// @return The id of the text, or kInvalidSymbol if the text is not in this table.
+    uint32_t Find(std::string_view text) const;
+
+    /// @brief Get the text of an id.
+    ///
+    /// @param [in] symbol An id returned by Intern or Find.
+    ///
+    /// @return The text, valid for the lifetime of this table; empty for kInvalidSymbol.
+    inline std::string_view GetText(uint32_t symbol) const
+    {
+        if (symbol == kInvalidSymbol)
+        {
+            return std::string_view();
+        }
+
+        // The page was published before the id was handed out.
+        const Symbol* page = pages_[symbol / kPageSize].load(std::memory_order_acquire);
+
+        return page[symbol % kPageSize].text;
+    }
+
+    /// @brief Get the number of symbols.
+    ///
+    /// @return The number of distinct texts interned so far.
+    size_t GetSymbolCount() const;
+
+    /// @brief Get the number of bytes allocated by this table.
+    ///
+    /// @return The number of allocated bytes.
+    size_t GetAllocatedSize() const;
+
+private:
+    /// @brief The text of one symbol.
+    struct Symbol
+    {
+        std::string_view text;  ///< The text, in one of the text chunks.
+    };
+
+    static constexpr size_t kPageSize      = 4096;       ///< The number of symbols in a page.
+    static constexpr size_t kMaxPageCount  = 4096;       ///< The number of pages; limits a table to 16M symbols.
+    static constexpr size_t kTextChunkSize = 64 * 1024;  ///< The size of a chunk of text; longer text gets a chunk of its own size.
+
+    /// @brief Copy text into the text chunks, which never move.
+    ///
+    /// @param [in] text The text.
+    ///
+    /// @return A view of the copy.
+    std::string_view CopyText(std::string_view text);
+
+    mutable std::shared_mutex                       mutex_;                ///< Guards everything but the published pages.
+    std::unordered_map<std::string_view, uint32_t>  symbol_ids_;           ///< The id of every text; the keys view the text chunks.
+    std::array<std::atomic<Symbol*>, kMaxPageCount> pages_;                ///< Pages of symbols, in id order; nullptr past the last page.
+    std::vector<std::unique_ptr<Symbol[]>>          page_storage_;         ///< Owns the pages.
+    std::vector<std::unique_ptr<char[]>>            text_chunks_;          ///< Owns the text of every symbol.
+    size_t                                          text_chunk_used_;      ///< The number of characters used in the last text chunk.
+    size_t                                          text_chunk_capacity_;  ///< The number of characters in the last text chunk.
+    size_t                                          text_allocated_size_;  ///< The number of characters in all text chunks.
+    uint32_t                                        symbol_count_;         ///< The number of symbols.
+};
+
+#endif  // QTISAGUI_ISA_SYMBOL_TABLE_H_
@@ -0,0 +1,134 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the rows of a shader that are parsed from its text on demand.
+//=============================================================================
+
+#include "isa_virtual_row_source.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+IsaVirtualRowSource::IsaVirtualRowSource()
+    : block_first_rows_(1, 0)
+    , cache_row_count_(kDefaultCacheRowCount)
+{
+}
+
+IsaVirtualRowSource::~IsaVirtualRowSource()
+{
+}
+
+void IsaVirtualRowSource::SetText(std::string_view text)
+{
+    Clear();
+
+    text_ = text;
+}
+
+void IsaVirtualRowSource::Clear()
+{
+    text_ = std::string_view();
+
+    block_first_rows_.assign(1, 0);
+    row_offsets_.clear();
+    row_offsets_.shrink_to_fit();
+    row_line_numbers_.clear();
+    row_line_numbers_.shrink_to_fit();
+
+    ClearParsedRows();
+}
+
+void IsaVirtualRowSource::AppendBlock()
+{
+    block_first_rows_.push_back(block_first_rows_.back());
+}
+
+void IsaVirtualRowSource::AppendRow(size_t offset, uint32_t line_number, bool is_comment)
+{
+    assert(GetBlockCount() != 0);
+    assert(offset < text_.size());
+
+    row_offsets_.push_back(static_cast<uint64_t>(offset) | (is_comment ? kCommentFlag : 0));
+    row_line_numbers_.push_back(line_number);
+
+    block_first_rows_.back()++;
+}
+
+std::string_view IsaVirtualRowSource::GetLine(size_t block_index, size_t row_index) const
+{
+    const size_t offset = static_cast<size_t>(row_offsets_[block_first_rows_[block_index] + row_index] & ~kCommentFlag);
+    size_t       end    = text_.find('\n', offset);
+
+    if (end == std::string_view::npos)
+    {
+        end = text_.size();
+    }
+
+    std::string_view line = text_.substr(offset, end - offset);
+
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+
+    return line;
+}
+
+void IsaVirtualRowSource::SetCacheRowCount(size_t row_count)
+{
+    cache_row_count_ = std::max(row_count, size_t(1));
+
+    while (cache_.size() > cache_row_count_)
+    {
+        cache_index_.erase(cache_.back().key);
+        cache_.pop_back();
+    }
+}
+
+void IsaVirtualRowSource::ClearParsedRows()
+{
+    cache_index_.clear();
+    cache_.clear();
+}
+
+const IsaRowStorage* IsaVirtualRowSource::FindParsedRow(size_t block_index, size_t row_index)
+{
+    const auto index_iter = cache_index_.find(MakeKey(block_index, row_index));
+
+    if (index_iter == cache_index_.end())
+    {
+        return nullptr;
+    }
+
+    // Move the row to the front without invalidating any iterator.
+    cache_.splice(cache_.begin(), cache_, index_iter->second);
+
+    return &index_iter->second->row_storage;
+}
+
+IsaRowStorage& IsaVirtualRowSource::InsertParsedRow(size_t block_index, size_t row_index)
+{
+    const uint64_t key = MakeKey(block_index, row_index);
+
+    assert(cache_index_.find(key) == cache_index_.end());
+
+    if (cache_.size() >= cache_row_count_)
+    {
+        // Reuse the least recently used row.
+        cache_index_.erase(cache_.back().key);
+        cache_.splice(cache_.begin(), cache_, std::prev(cache_.end()));
+        cache_.front().row_storage.Clear();
+    }
+    else
+    {
+        cache_.emplace_front();
+    }
+
+    cache_.front().key = key;
+    cache_index_[key]  = cache_.begin();
+
+    return cache_.front().row_storage;
+}
@@ -0,0 +1,183 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for the rows of a shader that are parsed from its text on demand.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_VIRTUAL_ROW_SOURCE_H_
+#define QTISAGUI_ISA_VIRTUAL_ROW_SOURCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "isa_row_storage.h"
+
+/// @brief IsaVirtualRowSource keeps the rows of a shader in its text, typically a memory mapped file, until they are needed.
+///
+/// Only the offset, line number and type of every row is indexed, so the index costs a few bytes per line regardless of
+/// the length of the lines. Rows parsed from the text are kept in a least recently used cache of a bounded number of
+/// rows, so the memory used by parsed rows is proportional to the rows being looked at rather than to the shader.
+class IsaVirtualRowSource
+{
+public:
+    static constexpr size_t kDefaultCacheRowCount = 4096;  ///< The number of parsed rows kept by default.
+
+    /// @brief Constructor; create an empty source.
+    IsaVirtualRowSource();
+
+    /// @brief Destructor.
+    ~IsaVirtualRowSource();
+
+    /// @brief Replace the text the rows are read from; removes all blocks, rows and parsed rows.
+    ///
+    /// @param [in] text The text; must stay valid until the text is replaced or this source is cleared.
+    void SetText(std::string_view text);
+
+    /// @brief Remove all blocks, rows and parsed rows, and forget the text.
+    void Clear();
+
+    /// @brief Get the text the rows are read from.
+    ///
+    /// @return The text.
+    inline std::string_view GetText() const
+    {
+        return text_;
+    }
+
+    /// @brief Append a block; rows appended from now on belong to this block.
+    void AppendBlock();
+
+    /// @brief Append a row to the last block.
+    ///
+    /// @param [in] offset      The offset of the first character of the line of the row in the text.
+    /// @param [in] line_number The line number of the row.
+    /// @param [in] is_comment  true if the row is a comment, false if it is an instruction.
+    void AppendRow(size_t offset, uint32_t line_number, bool is_comment);
+
+    /// @brief Get the number of blocks.
+    ///
+    /// @return The number of blocks.
+    inline size_t GetBlockCount() const
+    {
+        return block_first_rows_.size() - 1;
+    }
+
+    /// @brief Get the number of rows in a block.
+    ///
+    /// @param [in] block_index The block index.
+    ///
+    /// @return The number of rows.
+    inline uint32_t GetRowCount(size_t block_index) const
+    {
+        return block_first_rows_[block_index + 1] - block_first_rows_[block_index];
+    }
+
+    /// @brief Check if a row is a comment without parsing it.
+    ///
+    /// @param [in] block_index The block index.
+    /// @param [in] row_index   The row index relative to the block.
+    ///
+    /// @return true if the row is a comment, false if it is an instruction.
+    inline bool IsComment(size_t block_index, size_t row_index) const
+    {
+        return (row_offsets_[block_first_rows_[block_index] + row_index] & kCommentFlag) != 0;
+    }
+
+    /// @brief Get the line number of a row without parsing it.
+    ///
+    /// @param [in] block_index The block index.
+    /// @param [in] row_index   The row index relative to the block.
+    ///
+    /// @return The line number.
+    inline uint32_t GetLineNumber(size_t block_index, size_t row_index) const
+    {
+        return row_line_numbers_[block_first_rows_[block_index] + row_index];
+    }
+
+    /// @brief Get the line of a row in the text.
+    ///
+    /// @param [in] block_index The block index.
+    /// @param [in] row_index   The row index relative to the block.
+    ///
+    /// @return A view of the line without its line break.
+    std::string_view GetLine(size_t block_index, size_t row_index) const;
+
+    /// @brief Change the number of parsed rows to keep; the least recently used rows are dropped if there are more.
+    ///
+    /// @param [in] row_count The number of parsed rows; at least 1.
+    void SetCacheRowCount(size_t row_count);
+
+    /// @brief Get the number of parsed rows that are kept at most.
+    ///
+    /// @return The number of parsed rows.
+    inline size_t GetCacheRowCount() const
+    {
+        return cache_row_count_;
+    }
+
+    /// @brief Get the number of parsed rows that are kept now.
+    ///
+    /// @return The number of parsed rows.
+    inline size_t GetCachedRowCount() const
+    {
+        return cache_.size();
+    }
+
+    /// @brief Drop all parsed rows; the index of the rows is kept.
+    void ClearParsedRows();
+
+    /// @brief Find a parsed row, and mark it as the most recently used row.
+    ///
+    /// @param [in] block_index The block index.
+    /// @param [in] row_index   The row index relative to the block.
+    ///
+    /// @return The storage of the row, which holds the row as row 0 of block 0; nullptr if the row is not parsed.
+    const IsaRowStorage* FindParsedRow(size_t block_index, size_t row_index);
+
+    /// @brief Make room for a row to be parsed, and mark it as the most recently used row.
+    ///
+    /// Takes the storage of the least recently used row if the cache is full, so parsing does not allocate once the cache is warm.
+    ///
+    /// @param [in] block_index The block index.
+    /// @param [in] row_index   The row index relative to the block; must not be parsed already.
+    ///
+    /// @return Empty storage to parse the row into, as row 0 of block 0; valid until the row is dropped.
+    IsaRowStorage& InsertParsedRow(size_t block_index, size_t row_index);
+
+private:
+    static constexpr uint64_t kCommentFlag = uint64_t(1) << 63;  ///< Set in the offset of rows that are comments.
+
+    /// @brief A parsed row.
+    struct ParsedRow
+    {
+        uint64_t      key;          ///< The block index in the upper half and the row index in the lower half.
+        IsaRowStorage row_storage;  ///< The row, as row 0 of block 0.
+    };
+
+    /// @brief Make the cache key of a row.
+    ///
+    /// @param [in] block_index The block index.
+    /// @param [in] row_index   The row index relative to the block.
+    ///
+    /// @return The key.
+    static inline uint64_t MakeKey(size_t block_index, size_t row_index)
+    {
+        return (static_cast<uint64_t>(block_index) << 32) | static_cast<uint64_t>(row_index);
+    }
+
+    std::string_view      text_;              ///< The text the rows are read from.
+    std::vector<uint32_t> block_first_rows_;  ///< Index of the first row of every block, plus the number of rows.
+    std::vector<uint64_t> row_offsets_;       ///< Offset of the line of every row in the text; kCommentFlag is set for comments.
+    std::vector<uint32_t> row_line_numbers_;  ///< Line number of every row.
+
+    size_t                                                       cache_row_count_;  ///< The number of parsed rows kept at most.
+    std::list<ParsedRow>                                         cache_;            ///< Parsed rows, the most recently used first.
+    std::unordered_map<uint64_t, std::list<ParsedRow>::iterator> cache_index_;      ///< Parsed rows by key.
+};
+
+#endif  // QTISAGUI_ISA_VIRTUAL_ROW_SOURCE_H_
@@ -16,89 +16,44 @@ IsaColorCodingDictionaryInstance& IsaColorCodingDictionaryInstance::GetInstance(
     return instance;
 }
 
-bool IsaColorCodingDictionaryInstance::ShouldHighlight(const std::string& str, QColor& color) const
+bool IsaColorCodingDictionaryInstance::ShouldHighlight(std::string_view str, QColor& color) const
 {
-    color = QtCommon::QtUtils::ColorTheme::Get().GetCurrentThemeColors().graphics_scene_text_color;
-
-    QColor tree_colors;
-
-    bool should_highlight = prefix_tree_[QtCommon::QtUtils::ColorTheme::Get().GetColorTheme()].PrefixFoundInTree(str, tree_colors);
+    return GetColor(GetColorClass(str), color);
+}
 
-    if (tree_colors != nullptr)
+bool IsaColorCodingDictionaryInstance::GetColor(IsaColorClass color_class, QColor& color) const
+{
+    if (color_class == IsaColorClass::kNone)
     {
-        color = tree_colors;
+        color = QtCommon::QtUtils::ColorTheme::Get().GetCurrentThemeColors().graphics_scene_text_color;
+        return false;
     }
 
-    return should_highlight;
+    color = colors_[QtCommon::QtUtils::ColorTheme::Get().GetColorTheme()][static_cast<size_t>(color_class)];
+    return true;
 }
 
 IsaColorCodingDictionaryInstance::IsaColorCodingDictionaryInstance()
 {
-    prefix_tree_[kColorThemeTypeLight].Insert("s_buffer", kIsaLightThemeColorLightOrange);
-    prefix_tree_[kColorThemeTypeLight].Insert("s_load", kIsaLightThemeColorLightOrange);
-    prefix_tree_[kColorThemeTypeLight].Insert("s_waitcnt", kIsaLightThemeColorPink);
-    prefix_tree_[kColorThemeTypeLight].Insert("expcnt", kIsaLightThemeColorPink);
-    prefix_tree_[kColorThemeTypeLight].Insert("vmcnt", kIsaLightThemeColorPink);
-    prefix_tree_[kColorThemeTypeLight].Insert("lgkmcnt", kIsaLightThemeColorPink);
-    prefix_tree_[kColorThemeTypeLight].Insert("s_swap", kIsaLightThemeColorRed);
-    prefix_tree_[kColorThemeTypeLight].Insert("s_branch", kIsaLightThemeColorRed);
-    prefix_tree_[kColorThemeTypeLight].Insert("s_cbranch", kIsaLightThemeColorRed);
-    prefix_tree_[kColorThemeTypeLight].Insert("s_setpc", kIsaLightThemeColorRed);
-    prefix_tree_[kColorThemeTypeLight].Insert("ds_", kIsaLightThemeColorBlue);
-    prefix_tree_[kColorThemeTypeLight].Insert("buffer_", kIsaLightThemeColorPurple);
-    prefix_tree_[kColorThemeTypeLight].Insert("tbuffer_", kIsaLightThemeColorPurple);
-    prefix_tree_[kColorThemeTypeLight].Insert("image_", kIsaLightThemeColorPurple);
-    prefix_tree_[kColorThemeTypeLight].Insert("global_load", kIsaLightThemeColorPurple);
-    prefix_tree_[kColorThemeTypeLight].Insert("idxen", kIsaLightThemeColorPurple);
-    prefix_tree_[kColorThemeTypeLight].Insert("s_", kIsaLightThemeColorBlue);
-    prefix_tree_[kColorThemeTypeLight].Insert("s[", kIsaLightThemeColorBlue);  // Scalar register.
-    prefix_tree_[kColorThemeTypeLight].Insert("[s", kIsaLightThemeColorBlue);  // Scalar register range.
-    prefix_tree_[kColorThemeTypeLight].Insert("|s", kIsaLightThemeColorBlue);  // Scalar register absolute value.
-    prefix_tree_[kColorThemeTypeLight].Insert("-s", kIsaLightThemeColorBlue);  // Scalar register negative value.
-    prefix_tree_[kColorThemeTypeLight].Insert("v_", kIsaLightThemeColorLightGreen);
-    prefix_tree_[kColorThemeTypeLight].Insert("v[", kIsaLightThemeColorLightGreen);  // Vector register.
-    prefix_tree_[kColorThemeTypeLight].Insert("[v", kIsaLightThemeColorLightGreen);  // Vector register range.
-    prefix_tree_[kColorThemeTypeLight].Insert("|v", kIsaLightThemeColorLightGreen);  // Vector register absolute value.
-    prefix_tree_[kColorThemeTypeLight].Insert("-v", kIsaLightThemeColorLightGreen);  // Vector register negative value.
-    prefix_tree_[kColorThemeTypeLight].Insert("//", kIsaLightThemeColorLightBlue);   // Comments.
-
-    for (size_t i = 0; i <= 9; ++i)
-    {
-        prefix_tree_[kColorThemeTypeLight].Insert("s" + std::to_string(i), kIsaLightThemeColorBlue);
-        prefix_tree_[kColorThemeTypeLight].Insert("v" + std::to_string(i), kIsaLightThemeColorLightGreen);
-    }
-
-    prefix_tree_[kColorThemeTypeDark].Insert("s_buffer", kIsaDarkThemeColorLightOrange);
-    prefix_tree_[kColorThemeTypeDark].Insert("s_load", kIsaDarkThemeColorLightOrange);
-    prefix_tree_[kColorThemeTypeDark].Insert("s_waitcnt", kIsaDarkThemeColorPink);
-    prefix_tree_[kColorThemeTypeDark].Insert("expcnt", kIsaDarkThemeColorPink);
-    prefix_tree_[kColorThemeTypeDark].Insert("vmcnt", kIsaDarkThemeColorPink);
-    prefix_tree_[kColorThemeTypeDark].Insert("lgkmcnt", kIsaDarkThemeColorPink);
-    prefix_tree_[kColorThemeTypeDark].Insert("s_swap", kIsaDarkThemeColorRed);
-    prefix_tree_[kColorThemeTypeDark].Insert("s_branch", kIsaDarkThemeColorRed);
-    prefix_tree_[kColorThemeTypeDark].Insert("s_cbranch", kIsaDarkThemeColorRed);
-    prefix_tree_[kColorThemeTypeDark].Insert("s_setpc", kIsaDarkThemeColorRed);
-    prefix_tree_[kColorThemeTypeDark].Insert("ds_", kIsaDarkThemeColorBlue);
-    prefix_tree_[kColorThemeTypeDark].Insert("buffer_", kIsaDarkThemeColorPurple);
-    prefix_tree_[kColorThemeTypeDark].Insert("tbuffer_", kIsaDarkThemeColorPurple);
-    prefix_tree_[kColorThemeTypeDark].Insert("image_", kIsaDarkThemeColorPurple);
-    prefix_tree_[kColorThemeTypeDark].Insert("global_load", kIsaDarkThemeColorPurple);
-    prefix_tree_[kColorThemeTypeDark].Insert("idxen", kIsaDarkThemeColorPurple);
-    prefix_tree_[kColorThemeTypeDark].Insert("s_", kIsaDarkThemeColorBlue);
-    prefix_tree_[kColorThemeTypeDark].Insert("s[", kIsaDarkThemeColorBlue);  // Scalar register.
-    prefix_tree_[kColorThemeTypeDark].Insert("[s", kIsaDarkThemeColorBlue);  // Scalar register range.
-    prefix_tree_[kColorThemeTypeDark].Insert("|s", kIsaDarkThemeColorBlue);  // Scalar register absolute value.
-    prefix_tree_[kColorThemeTypeDark].Insert("-s", kIsaDarkThemeColorBlue);  // Scalar register negative value.
-    prefix_tree_[kColorThemeTypeDark].Insert("v_", kIsaDarkThemeColorLightGreen);
-    prefix_tree_[kColorThemeTypeDark].Insert("v[", kIsaDarkThemeColorLightGreen);  // Vector register.
-    prefix_tree_[kColorThemeTypeDark].Insert("[v", kIsaDarkThemeColorLightGreen);  // Vector register range.
-    prefix_tree_[kColorThemeTypeDark].Insert("|v", kIsaDarkThemeColorLightGreen);  // Vector register absolute value.
-    prefix_tree_[kColorThemeTypeDark].Insert("-v", kIsaDarkThemeColorLightGreen);  // Vector register negative value.
-    prefix_tree_[kColorThemeTypeDark].Insert("//", kIsaDarkThemeColorLightBlue);   // Comments.
-
-    for (size_t i = 0; i <= 9; ++i)
-    {
-        prefix_tree_[kColorThemeTypeDark].Insert("s" + std::to_string(i), kIsaDarkThemeColorBlue);
-        prefix_tree_[kColorThemeTypeDark].Insert("v" + std::to_string(i), kIsaDarkThemeColorLightGreen);
-    }
+    auto& light_theme_colors = colors_[kColorThemeTypeLight];
+
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kScalarMemory)]   = kIsaLightThemeColorLightOrange;
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kWaitCount)]      = kIsaLightThemeColorPink;
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kBranch)]         = kIsaLightThemeColorRed;
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kLocalDataShare)] = kIsaLightThemeColorBlue;
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kVectorMemory)]   = kIsaLightThemeColorPurple;
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kScalar)]         = kIsaLightThemeColorBlue;
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kVector)]         = kIsaLightThemeColorLightGreen;
+    light_theme_colors[static_cast<size_t>(IsaColorClass::kComment)]        = kIsaLightThemeColorLightBlue;
+
+    auto& dark_theme_colors = colors_[kColorThemeTypeDark];
+
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kScalarMemory)]   = kIsaDarkThemeColorLightOrange;
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kWaitCount)]      = kIsaDarkThemeColorPink;
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kBranch)]         = kIsaDarkThemeColorRed;
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kLocalDataShare)] = kIsaDarkThemeColorBlue;
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kVectorMemory)]   = kIsaDarkThemeColorPurple;
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kScalar)]         = kIsaDarkThemeColorBlue;
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kVector)]         = kIsaDarkThemeColorLightGreen;
+    dark_theme_colors[static_cast<size_t>(IsaColorClass::kComment)]        = kIsaDarkThemeColorLightBlue;
 }
@@ -0,0 +1,311 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for an isa proxy model that hides columns without mapping tables.
+//=============================================================================
+
+#include "isa_column_proxy_model.h"
+
+#include <algorithm>
+
+IsaColumnProxyModel::IsaColumnProxyModel(QObject* parent, std::vector<bool> columns_visiblity)
+    : QIdentityProxyModel(parent)
+    , IsaColumnVisibility(this, columns_visiblity)
+    , visible_column_count_(0)
+{
+    UpdateColumnMaps();
+}
+
+IsaColumnProxyModel::~IsaColumnProxyModel()
+{
+}
+
+void IsaColumnProxyModel::setSourceModel(QAbstractItemModel* source_model)
+{
+    if (sourceModel() != nullptr)
+    {
+        disconnect(sourceModel(), &QAbstractItemModel::dataChanged, this, &IsaColumnProxyModel::SourceDataChanged);
+        disconnect(sourceModel(), &QAbstractItemModel::headerDataChanged, this, &IsaColumnProxyModel::SourceHeaderDataChanged);
+    }
+
+    QIdentityProxyModel::setSourceModel(source_model);
+
+    if (source_model != nullptr)
+    {
+        // The identity model forwards these with source columns; forward them with proxy columns instead.
+        disconnect(source_model, &QAbstractItemModel::dataChanged, this, nullptr);
+        disconnect(source_model, &QAbstractItemModel::headerDataChanged, this, nullptr);
+
+        connect(source_model, &QAbstractItemModel::dataChanged, this, &IsaColumnProxyModel::SourceDataChanged);
+        connect(source_model, &QAbstractItemModel::headerDataChanged, this, &IsaColumnProxyModel::SourceHeaderDataChanged);
+    }
+}
+
+int IsaColumnProxyModel::columnCount(const QModelIndex& parent) const
+{
+    if (sourceModel() == nullptr)
+    {
+        return 0;
+    }
+
+    const int source_column_count = sourceModel()->columnCount(mapToSource(parent));
+
+    return std::max(source_column_count - (IsaItemModel::kColumnCount - visible_column_count_), 0);
+}
+
+QModelIndex IsaColumnProxyModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (sourceModel() == nullptr || row < 0 || column < 0)
+    {
+        return QModelIndex();
+    }
+
+    return mapFromSource(sourceModel()->index(row, GetSourceColumn(column), mapToSource(parent)));
+}
+
+QModelIndex IsaColumnProxyModel::parent(const QModelIndex& child) const
+{
+    const QModelIndex source_parent = mapToSource(child).parent();
+
+    if (!source_parent.isValid())
+    {
+        return QModelIndex();
+    }
+
+    return mapFromSource(source_parent.siblingAtColumn(GetSourceColumn(0)));
+}
+
+QModelIndex IsaColumnProxyModel::sibling(int row, int column, const QModelIndex& idx) const
+{
+    if (sourceModel() == nullptr || !idx.isValid() || row < 0 || column < 0)
+    {
+        return QModelIndex();
+    }
+
+    return mapFromSource(sourceModel()->sibling(row, GetSourceColumn(column), mapToSource(idx)));
+}
+
+QModelIndex IsaColumnProxyModel::mapToSource(const QModelIndex& proxy_index) const
+{
+    if (sourceModel() == nullptr || !proxy_index.isValid())
+    {
+        return QModelIndex();
+    }
+
+    Q_ASSERT(proxy_index.model() == this);
+
+    return createSourceIndex(proxy_index.row(), GetSourceColumn(proxy_index.column()), proxy_index.internalPointer());
+}
+
+QModelIndex IsaColumnProxyModel::mapFromSource(const QModelIndex& source_index) const
+{
+    if (sourceModel() == nullptr || !source_index.isValid())
+    {
+        return QModelIndex();
+    }
+
+    Q_ASSERT(source_index.model() == sourceModel());
+
+    const int proxy_column = GetProxyColumn(source_index.column());
+
+    if (proxy_column < 0)
+    {
+        return QModelIndex();
+    }
+
+    return createIndex(source_index.row(), proxy_column, source_index.internalPointer());
+}
+
+QItemSelection IsaColumnProxyModel::mapSelectionToSource(const QItemSelection& selection) const
+{
+    return QAbstractProxyModel::mapSelectionToSource(selection);
+}
+
+QItemSelection IsaColumnProxyModel::mapSelectionFromSource(const QItemSelection& selection) const
+{
+    return QAbstractProxyModel::mapSelectionFromSource(selection);
+}
+
+QVariant IsaColumnProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (sourceModel() == nullptr)
+    {
+        return QVariant();
+    }
+
+    if (orientation == Qt::Horizontal)
+    {
+        section = GetSourceColumn(section);
+    }
+
+    return sourceModel()->headerData(section, orientation, role);
+}
+
+void IsaColumnProxyModel::ApplyColumnVisibility(uint32_t column, bool visibility)
+{
+    if (visibility)
+    {
+        // Visible columns keep the order of the source, so the new column goes after the visible columns before it.
+        int proxy_column = 0;
+
+        for (uint32_t source_column = 0; source_column < column; source_column++)
+        {
+            proxy_column += visible_columns_[source_column] ? 1 : 0;
+        }
+
+        beginInsertColumns(QModelIndex(), proxy_column, proxy_column);
+        UpdateColumnMaps();
+        UpdateChildPersistentIndices(proxy_column, true);
+        endInsertColumns();
+    }
+    else
+    {
+        const int proxy_column = proxy_columns_[column];
+
+        beginRemoveColumns(QModelIndex(), proxy_column, proxy_column);
+        UpdateColumnMaps();
+        UpdateChildPersistentIndices(proxy_column, false);
+        endRemoveColumns();
+    }
+}
+
+void IsaColumnProxyModel::SourceDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right, const QList<int>& roles)
+{
+    int first_proxy_column = 0;
+    int last_proxy_column  = 0;
+
+    if (!MapColumnRange(top_left.column(), bottom_right.column(), first_proxy_column, last_proxy_column))
+    {
+        return;
+    }
+
+    const QModelIndex proxy_top_left     = mapFromSource(top_left.siblingAtColumn(GetSourceColumn(first_proxy_column)));
+    const QModelIndex proxy_bottom_right = mapFromSource(bottom_right.siblingAtColumn(GetSourceColumn(last_proxy_column)));
+
+    emit dataChanged(proxy_top_left, proxy_bottom_right, roles);
+}
+
+void IsaColumnProxyModel::SourceHeaderDataChanged(Qt::Orientation orientation, int first, int last)
+{
+    if (orientation == Qt::Horizontal && !MapColumnRange(first, last, first, last))
+    {
+        return;
+    }
+
+    emit headerDataChanged(orientation, first, last);
+}
+
+int IsaColumnProxyModel::GetSourceColumn(int proxy_column) const
+{
+    if (proxy_column < 0)
+    {
+        return -1;
+    }
+
+    if (proxy_column < visible_column_count_)
+    {
+        return source_columns_[proxy_column];
+    }
+
+    // Columns added by the application are never hidden, and follow the IsaItemModel columns.
+    return proxy_column - visible_column_count_ + IsaItemModel::kColumnCount;
+}
+
+int IsaColumnProxyModel::GetProxyColumn(int source_column) const
+{
+    if (source_column < 0)
+    {
+        return -1;
+    }
+
+    if (source_column < IsaItemModel::kColumnCount)
+    {
+        return proxy_columns_[source_column];
+    }
+
+    return source_column - IsaItemModel::kColumnCount + visible_column_count_;
+}
+
+bool IsaColumnProxyModel::MapColumnRange(int first_source_column, int last_source_column, int& first_proxy_column, int& last_proxy_column) const
+{
+    // Proxy columns keep the order of the source, so the range is bounded by its first and last visible columns.
+    int first = -1;
+    int last  = -1;
+
+    for (int source_column = first_source_column; source_column <= last_source_column; source_column++)
+    {
+        const int proxy_column = GetProxyColumn(source_column);
+
+        if (proxy_column >= 0)
+        {
+            first = (first < 0) ? proxy_column : first;
+            last  = proxy_column;
+        }
+
+        if (source_column >= IsaItemModel::kColumnCount)
+        {
+            // The rest are columns added by the application, which map one to one.
+            last = GetProxyColumn(last_source_column);
+            break;
+        }
+    }
+
+    if (first < 0)
+    {
+        return false;
+    }
+
+    first_proxy_column = first;
+    last_proxy_column  = last;
+
+    return true;
+}
+
+void IsaColumnProxyModel::UpdateColumnMaps()
+{
+    visible_column_count_ = 0;
+
+    for (int source_column = 0; source_column < IsaItemModel::kColumnCount; source_column++)
+    {
+        source_columns_[source_column] = -1;
+        proxy_columns_[source_column]  = -1;
+    }
+
+    for (int source_column = 0; source_column < IsaItemModel::kColumnCount; source_column++)
+    {
+        if (visible_columns_[source_column])
+        {
+            source_columns_[visible_column_count_] = source_column;
+            proxy_columns_[source_column]          = visible_column_count_;
+
+            visible_column_count_++;
+        }
+    }
+}
+
+void IsaColumnProxyModel::UpdateChildPersistentIndices(int proxy_column, bool inserted)
+{
+    const QModelIndexList persistent_indices = persistentIndexList();
+
+    for (const QModelIndex& persistent_index : persistent_indices)
+    {
+        if (persistent_index.column() < proxy_column || !persistent_index.parent().isValid())
+        {
+            continue;
+        }
+
+        if (inserted)
+        {
+            changePersistentIndex(persistent_index, createIndex(persistent_index.row(), persistent_index.column() + 1, persistent_index.internalPointer()));
+        }
+        else if (persistent_index.column() == proxy_column)
+        {
+            changePersistentIndex(persistent_index, QModelIndex());
+        }
+        else
+        {
+            changePersistentIndex(persistent_index, createIndex(persistent_index.row(), persistent_index.column() - 1, persistent_index.internalPointer()));
+        }
+    }
+}
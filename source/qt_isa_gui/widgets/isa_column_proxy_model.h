@@ -0,0 +1,175 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for an isa proxy model that hides columns without mapping tables.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_COLUMN_PROXY_MODEL_H_
+#define QTISAGUI_ISA_COLUMN_PROXY_MODEL_H_
+
+#include <array>
+#include <vector>
+
+#include <QIdentityProxyModel>
+
+#include "isa_item_model.h"
+#include "isa_proxy_model.h"
+
+/// @brief IsaColumnProxyModel hides IsaItemModel columns set to be invisible via the gui, like IsaProxyModel.
+///
+/// Rows are never sorted or filtered, so rows map one to one and columns are remapped arithmetically: mapping an index
+/// costs a lookup in an array of IsaItemModel::kColumnCount entries, and no per-parent mapping tables are kept.
+/// Columns the application adds after the IsaItemModel columns are always visible.
+class IsaColumnProxyModel : public QIdentityProxyModel, public IsaColumnVisibility
+{
+    Q_OBJECT
+
+public:
+    /// @brief Constructor.
+    ///
+    /// @param [in] parent            The parent object.
+    /// @param [in] columns_visiblity Vector to specify column visibilty. kPcAddress and kBinaryRepresentation are hidden by default.
+    explicit IsaColumnProxyModel(QObject* parent = nullptr, std::vector<bool> columns_visiblity = {true, false, true, true, false});
+
+    /// @brief Destructor.
+    virtual ~IsaColumnProxyModel();
+
+    /// @brief Override setSourceModel to map the column ranges of data and header changes.
+    ///
+    /// @param [in] source_model The source model; an IsaItemModel or a subclass of it.
+    virtual void setSourceModel(QAbstractItemModel* source_model) Q_DECL_OVERRIDE;
+
+    /// @brief Override columnCount to leave out hidden columns.
+    ///
+    /// @param [in] parent The parent index.
+    ///
+    /// @return The number of visible columns.
+    virtual int columnCount(const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+    /// @brief Override index to remap the column.
+    ///
+    /// @param [in] row    The row.
+    /// @param [in] column The proxy column.
+    /// @param [in] parent The parent index.
+    ///
+    /// @return The index, or an invalid index if it is out of range.
+    virtual QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+    /// @brief Override parent to map the parent through a visible column.
+    ///
+    /// @param [in] child The child index.
+    ///
+    /// @return The parent index, in the first proxy column.
+    virtual QModelIndex parent(const QModelIndex& child) const Q_DECL_OVERRIDE;
+
+    /// @brief Override sibling to remap the column.
+    ///
+    /// @param [in] row    The row.
+    /// @param [in] column The proxy column.
+    /// @param [in] idx    The index to get a sibling of.
+    ///
+    /// @return The sibling, or an invalid index if it is out of range.
+    virtual QModelIndex sibling(int row, int column, const QModelIndex& idx) const Q_DECL_OVERRIDE;
+
+    /// @brief Override mapToSource to remap the column.
+    ///
+    /// @param [in] proxy_index The proxy index.
+    ///
+    /// @return The source index.
+    virtual QModelIndex mapToSource(const QModelIndex& proxy_index) const Q_DECL_OVERRIDE;
+
+    /// @brief Override mapFromSource to remap the column.
+    ///
+    /// @param [in] source_index The source index.
+    ///
+    /// @return The proxy index, or an invalid index if the column is hidden.
+    virtual QModelIndex mapFromSource(const QModelIndex& source_index) const Q_DECL_OVERRIDE;
+
+    /// @brief Override mapSelectionToSource; selection ranges may not stay contiguous when columns are remapped.
+    ///
+    /// @param [in] selection The proxy selection.
+    ///
+    /// @return The source selection.
+    virtual QItemSelection mapSelectionToSource(const QItemSelection& selection) const Q_DECL_OVERRIDE;
+
+    /// @brief Override mapSelectionFromSource; selection ranges may not stay contiguous when columns are remapped.
+    ///
+    /// @param [in] selection The source selection.
+    ///
+    /// @return The proxy selection.
+    virtual QItemSelection mapSelectionFromSource(const QItemSelection& selection) const Q_DECL_OVERRIDE;
+
+    /// @brief Override headerData to remap horizontal sections.
+    ///
+    /// @param [in] section     The proxy section.
+    /// @param [in] orientation The orientation.
+    /// @param [in] role        The role.
+    ///
+    /// @return The header data of the source section.
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+
+protected:
+    /// @brief Insert or remove the proxy column of an IsaItemModel column after its visibility changed.
+    ///
+    /// @param [in] column     The IsaItemModel column that changed.
+    /// @param [in] visibility true if the column was made visible, false if it was made invisible.
+    virtual void ApplyColumnVisibility(uint32_t column, bool visibility) Q_DECL_OVERRIDE;
+
+private slots:
+    /// @brief Forward source data changes, narrowed to the visible columns.
+    ///
+    /// @param [in] top_left     The top left source index.
+    /// @param [in] bottom_right The bottom right source index.
+    /// @param [in] roles        The roles that changed.
+    void SourceDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right, const QList<int>& roles);
+
+    /// @brief Forward source header changes, narrowed to the visible columns.
+    ///
+    /// @param [in] orientation The orientation.
+    /// @param [in] first       The first source section.
+    /// @param [in] last        The last source section.
+    void SourceHeaderDataChanged(Qt::Orientation orientation, int first, int last);
+
+private:
+    /// @brief Get the source column of a proxy column.
+    ///
+    /// @param [in] proxy_column The proxy column.
+    ///
+    /// @return The source column.
+    int GetSourceColumn(int proxy_column) const;
+
+    /// @brief Get the proxy column of a source column.
+    ///
+    /// @param [in] source_column The source column.
+    ///
+    /// @return The proxy column, or -1 if the column is hidden.
+    int GetProxyColumn(int source_column) const;
+
+    /// @brief Narrow a range of source columns to the range of proxy columns of its visible columns.
+    ///
+    /// @param [in]  first_source_column The first source column.
+    /// @param [in]  last_source_column  The last source column.
+    /// @param [out] first_proxy_column  The first visible proxy column.
+    /// @param [out] last_proxy_column   The last visible proxy column.
+    ///
+    /// @return true if any column of the range is visible, false otherwise.
+    bool MapColumnRange(int first_source_column, int last_source_column, int& first_proxy_column, int& last_proxy_column) const;
+
+    /// @brief Rebuild the column maps from visible_columns_.
+    void UpdateColumnMaps();
+
+    /// @brief Shift the columns of persistent indices below the top level after a proxy column was inserted or removed.
+    ///
+    /// The top level persistent indices are updated by beginInsertColumns and beginRemoveColumns.
+    ///
+    /// @param [in] proxy_column The proxy column that was inserted or removed.
+    /// @param [in] inserted     true if the column was inserted, false if it was removed.
+    void UpdateChildPersistentIndices(int proxy_column, bool inserted);
+
+    std::array<int, IsaItemModel::kColumnCount> source_columns_;        ///< Source column of every visible proxy column, in order.
+    std::array<int, IsaItemModel::kColumnCount> proxy_columns_;         ///< Proxy column of every IsaItemModel column; -1 if hidden.
+    int                                         visible_column_count_;  ///< The number of visible IsaItemModel columns.
+};
+
+#endif  // QTISAGUI_ISA_COLUMN_PROXY_MODEL_H_
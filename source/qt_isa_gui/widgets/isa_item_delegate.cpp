@@ -7,51 +7,97 @@
 
 #include "isa_item_delegate.h"
 
+#include <QAbstractProxyModel>
 #include <QColor>
 #include <QEvent>
 #include <QGuiApplication>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPointF>
-#include <QSortFilterProxyModel>
+
+#include <algorithm>
+#include <utility>
 
 #include "qt_common/utils/common_definitions.h"
 #include "qt_common/utils/qt_util.h"
 
+#include "qt_isa_gui/core/isa_instrumentation.h"
 #include "qt_isa_gui/utility/isa_dictionary.h"
 
 #include "isa_item_model.h"
 #include "isa_tree_view.h"
 
+/// @brief The alpha of the heatmap tint of a line with the largest value of the heatmap metric.
+static const int kHeatmapMaximumAlpha = 112;
+
+/// @brief Convert isa text stored in the model to a QString.
+///
+/// @param [in] text The utf-8 text.
+///
+/// @return The text as a QString.
+static QString ToQString(std::string_view text)
+{
+    return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+/// @brief Check whether a token has the same text as a token of the model being painted.
+///
+/// Tokens of a model are interned in its symbol table, so their ids are compared instead of their text when both have one.
+///
+/// @param [in] token      The selected or mouse over token.
+/// @param [in] token_view The token being painted.
+///
+/// @return true if the tokens have the same text.
+static bool IsSameTokenText(const IsaItemModel::Token& token, const IsaItemModel::TokenView& token_view)
+{
+    if (token.symbol != IsaSymbolTable::kInvalidSymbol && token_view.symbol != IsaSymbolTable::kInvalidSymbol)
+    {
+        return token.symbol == token_view.symbol;
+    }
+
+    return token.token_text == token_view.token_text;
+}
+
+/// @brief Get the color coding of a token based on its type or syntax.
+///
+/// @param [in]  token The token.
+/// @param [out] color The color of the token, if it is color coded.
+///
+/// @return true if the token is color coded, false if it should use the default text color.
+static bool GetTokenColor(const IsaItemModel::TokenView& token, QColor& color)
+{
+    if (token.type == IsaItemModel::TokenType::kBranchLabelType)
+    {
+        // Operand that is the target of a branch instruction.
+        if (QtCommon::QtUtils::ColorTheme::Get().GetColorTheme() == kColorThemeTypeLight)
+        {
+            color = kIsaLightThemeColorDarkMagenta;
+        }
+        else
+        {
+            color = kIsaDarkThemeColorDarkMagenta;
+        }
+
+        return true;
+    }
+
+    return IsaColorCodingDictionaryInstance::GetInstance().GetColor(token.color_class, color);
+}
+
 /// @brief Paint a token's text using a color based on its type or syntax.
 ///
 /// @param [in] token                The token to paint.
 /// @param [in] token_rectangle      The rectangle to paint to.
 /// @param [in] painter              The painter.
 /// @param [in] color_coding_enabled True to apply a color coding to the token, false otherwise.
-static void PaintTokenText(const IsaItemModel::Token& token, const QRectF& token_rectangle, QPainter* painter, const bool color_coding_enabled)
+static void PaintTokenText(const IsaItemModel::TokenView& token, const QRectF& token_rectangle, QPainter* painter, const bool color_coding_enabled)
 {
     if (color_coding_enabled)
     {
         QColor color;
         auto   pen = painter->pen();
 
-        if (token.type == IsaItemModel::TokenType::kBranchLabelType)
-        {
-            QColor operand_color;
-            if (QtCommon::QtUtils::ColorTheme::Get().GetColorTheme() == kColorThemeTypeLight)
-            {
-                operand_color = kIsaLightThemeColorDarkMagenta;
-            }
-            else
-            {
-                operand_color = kIsaDarkThemeColorDarkMagenta;
-            }
-
-            // Operand that is the target of a branch instruction.
-            color = operand_color;
-        }
-        else if (!IsaColorCodingDictionaryInstance::GetInstance().ShouldHighlight(token.token_text, color))
+        if (!GetTokenColor(token, color))
         {
             color = pen.color();
         }
@@ -60,28 +106,44 @@ static void PaintTokenText(const IsaItemModel::Token& token, const QRectF& token
         painter->setPen(pen);
     }
 
-    painter->drawText(token_rectangle, Qt::TextSingleLine, token.token_text.c_str());
+    painter->drawText(token_rectangle, Qt::TextSingleLine, ToQString(token.token_text));
 }
 
-/// @brief Paint a comma.
+/// @brief Prepare the static text of a token or delimiter for painting.
 ///
-/// @param [in] comma_rectangle      The rectangle to paint to.
-/// @param [in] painter              The painter.
-static void PaintCommaText(const QRectF& comma_rectangle, QPainter* painter)
+/// @param [in]  text        The text.
+/// @param [in]  font        The font the text will be painted with.
+/// @param [out] static_text The prepared static text.
+static void PrepareStaticText(const QString& text, const QFont& font, QStaticText& static_text)
 {
-    painter->drawText(comma_rectangle, ",");
+    static_text.setTextFormat(Qt::PlainText);
+    static_text.setPerformanceHint(QStaticText::AggressiveCaching);
+    static_text.setText(text);
+    static_text.prepare(QTransform(), font);
 }
 
 IsaItemDelegate::IsaItemDelegate(IsaTreeView* view, QObject* parent)
     : QStyledItemDelegate(parent)
     , view_(view)
+    , selected_register_model_(nullptr)
+    , selected_register_build_count_(0)
+    , selected_register_references_valid_(false)
     , mouse_over_code_block_index_(-1)
     , mouse_over_instruction_index_(-1)
     , mouse_over_token_index_(-1)
     , tooltip_(nullptr)
+    , search_mode_(IsaSearchIndex::MatchMode::kContains)
+    , heatmap_metric_(-1)
+    , render_cache_model_(nullptr)
 {
     tooltip_ = new IsaTooltip(view, view->viewport());
 
+    // Token colors depend on the theme.
+    connect(&QtCommon::QtUtils::ColorTheme::Get(), &QtCommon::QtUtils::ColorTheme::ColorThemeUpdated, this, &IsaItemDelegate::InvalidateRenderCache);
+
+    tooltip_prefetch_timer_.setSingleShot(true);
+    connect(&tooltip_prefetch_timer_, &QTimer::timeout, this, &IsaItemDelegate::PrefetchTooltips);
+
     // Force hide the tooltip if the tree view is scrolled.
     connect(view_->horizontalScrollBar(), &QScrollBar::valueChanged, this, [this]() { tooltip_->hide(); });
     connect(view_->verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() { tooltip_->hide(); });
@@ -89,6 +151,10 @@ IsaItemDelegate::IsaItemDelegate(IsaTreeView* view, QObject* parent)
 
 IsaItemDelegate::~IsaItemDelegate()
 {
+    for (const auto& connection : render_cache_connections_)
+    {
+        disconnect(connection);
+    }
 }
 
 void IsaItemDelegate::RegisterScrollAreas(std::vector<QScrollArea*> container_scroll_areas)
@@ -106,7 +172,7 @@ bool IsaItemDelegate::editorEvent(QEvent* event, QAbstractItemModel* model, cons
         return true;
     }
 
-    const auto* proxy_model  = qobject_cast<QSortFilterProxyModel*>(model);
+    const auto* proxy_model  = qobject_cast<QAbstractProxyModel*>(model);
     QModelIndex source_index = (proxy_model != nullptr) ? proxy_model->mapToSource(index) : index;
 
     switch (event->type())
@@ -135,6 +201,9 @@ bool IsaItemDelegate::editorEvent(QEvent* event, QAbstractItemModel* model, cons
             // Determine if there is a token that is selectable underneath the mouse.
             SetSelectableTokenUnderMouse(source_index, index, local_x_position, selected_isa_token_, token_under_mouse_index, offset, isa_token_global_hit_box);
 
+            // The references of a newly selected register are found on the next paint.
+            selected_register_references_valid_ = false;
+
             // Determine if there is a branch label token underneath the mouse.
             const bool label_clicked = SetBranchLabelTokenUnderMouse(source_index, local_x_position);
 
@@ -270,15 +339,17 @@ bool IsaItemDelegate::editorEvent(QEvent* event, QAbstractItemModel* model, cons
 
 void IsaItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& model_index) const
 {
+    QTISAGUI_COUNT_ITEMS(kPaintFrame, 1);
+
     // Bounds checking.
     if (!model_index.isValid())
     {
         return;
     }
 
-    const IsaProxyModel* proxy_model  = qobject_cast<const IsaProxyModel*>(model_index.model());
-    const IsaItemModel*  source_model = nullptr;
-    QModelIndex          source_model_index;
+    const QAbstractProxyModel* proxy_model  = qobject_cast<const QAbstractProxyModel*>(model_index.model());
+    const IsaItemModel*        source_model = nullptr;
+    QModelIndex                source_model_index;
 
     // Get the source model and index.
     if (proxy_model == nullptr)
@@ -297,6 +368,8 @@ void IsaItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& optio
         return;
     }
 
+    UpdateSelectedRegisterReferences(source_model);
+
     const auto row_type                  = qvariant_cast<IsaItemModel::RowType>(source_model_index.data(IsaItemModel::UserRoles::kRowTypeRole));
     const bool is_comment                = row_type == IsaItemModel::RowType::kComment;
     int        proxy_index_y_position    = -1;
@@ -331,6 +404,21 @@ void IsaItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& optio
         initialized_option.widget->style()->drawPrimitive(QStyle::PE_PanelItemViewItem, &initialized_option, painter, initialized_option.widget);
     }
 
+    // Tint the whole line by the heatmap metric, over the highlight so hot lines stay visible when selected.
+    if (heatmap_metric_ >= 0)
+    {
+        const int   line_number = source_model->GetLineNumber(source_model_index);
+        const float intensity   = source_model->GetMetricIntensity(heatmap_metric_, source_model->GetMetricValue(heatmap_metric_, line_number));
+
+        if (intensity > 0.0f)
+        {
+            QColor heatmap_color = Qt::red;
+            heatmap_color.setAlpha(static_cast<int>(intensity * kHeatmapMaximumAlpha));
+
+            painter->fillRect(initialized_option.rect, heatmap_color);
+        }
+    }
+
     // Don't try to paint any columns not defined in the isa model.
     if (source_model_index.column() >= IsaItemModel::kColumnCount)
     {
@@ -348,18 +436,19 @@ void IsaItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& optio
     }
 
     // Paint a highlight rectangle for any text search matches in columns defined in the isa model, except the line number column.
-    bool    paint_highlight = false;
-    QString display_role_text_for_highlight;
+    bool paint_highlight  = false;
+    int  highlight_column = source_model_index.column();
 
-    if (view_->isFirstColumnSpanned(model_index.row(), model_index.parent()))
+    if (view_->IsRowSpanned(model_index.row(), model_index.parent()))
     {
         // Highlight comments and labels which also span columns.
 
         paint_highlight = true;
 
-        // Comments and labels are stored in the op code column so get them from the op code column's display role.
+        // Comments and labels are stored in the op code column so highlight the op code column's text.
+        highlight_column = IsaItemModel::kOpCode;
+
         const auto op_code_source_index = source_model_index.siblingAtColumn(IsaItemModel::kOpCode);
-        display_role_text_for_highlight = op_code_source_index.data(Qt::DisplayRole).toString();
         const auto op_code_proxy_index  = (proxy_model != nullptr) ? proxy_model->mapFromSource(op_code_source_index) : op_code_source_index;
         const auto x_position           = GetColumnSpanStartPosition(is_comment, op_code_proxy_index);
 
@@ -371,14 +460,27 @@ void IsaItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& optio
         // Highlighting op codes, operands, addresses and binary representation.
 
         paint_highlight = true;
-
-        // Get their concatenated text from their own display roles.
-        display_role_text_for_highlight = source_model_index.data(Qt::DisplayRole).toString();
     }
 
-    if (paint_highlight)
+    if (paint_highlight && !search_text_.isEmpty())
     {
-        PaintSearchHighlight(painter, paint_rectangle, display_role_text_for_highlight, source_model->GetFixedFontCharacterWidth(), source_model_index);
+        const uint32_t* match_starts  = nullptr;
+        const uint32_t* match_lengths = nullptr;
+        size_t          match_count   = 0;
+
+        // Fill the matches found by the last search; only search the display text if the search could not find them.
+        if (source_model->GetSearchMatches(
+                search_text_, source_model->GetLineNumber(source_model_index), highlight_column, match_starts, match_lengths, match_count))
+        {
+            PaintSearchMatches(
+                painter, paint_rectangle, match_starts, match_lengths, match_count, source_model->GetFixedFontCharacterWidth(), source_model_index);
+        }
+        else if (search_mode_ == IsaSearchIndex::MatchMode::kContains)
+        {
+            const QString display_role_text_for_highlight = source_model_index.siblingAtColumn(highlight_column).data(Qt::DisplayRole).toString();
+
+            PaintSearchHighlight(painter, paint_rectangle, display_role_text_for_highlight, source_model->GetFixedFontCharacterWidth(), source_model_index);
+        }
     }
 
     // Get a default text color if applicable.
@@ -440,9 +542,7 @@ void IsaItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& optio
         font.setBold(true);
         painter->setFont(font);
 
-        const std::vector<IsaItemModel::Token> op_code_token = qvariant_cast<std::vector<IsaItemModel::Token>>(source_model_index.data(Qt::UserRole));
-
-        PaintText(painter, initialized_option, source_model_index, paint_rectangle, op_code_token, 0, false);
+        PaintRenderedCell(painter, initialized_option, source_model, source_model_index, paint_rectangle);
     }
     else if ((source_model_index.column() == IsaItemModel::kOperands) && source_model_index.parent().isValid() && (proxy_index_y_position != 0) &&
              (row_type != IsaItemModel::RowType::kComment))
@@ -454,26 +554,7 @@ void IsaItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& optio
         font.setBold(true);
         painter->setFont(font);
 
-        std::vector<std::vector<IsaItemModel::Token>> tokens =
-            qvariant_cast<std::vector<std::vector<IsaItemModel::Token>>>(source_model_index.data(Qt::UserRole));
-
-        std::pair<int, QRectF> token_info = std::pair<int, QRectF>(0, paint_rectangle);
-
-        // Break the operands down into their individual tokens, and paint them token by token.
-        for (size_t i = 0; i < tokens.size(); i++)
-        {
-            const auto& operand_tokens = tokens.at(i);
-
-            token_info = PaintText(painter, initialized_option, source_model_index, token_info.second, operand_tokens, token_info.first, false);
-
-            // Add a comma if it is not the last operand.
-            if (i < tokens.size() - 1)
-            {
-                PaintCommaText(token_info.second, painter);
-
-                token_info.second.adjust(initialized_option.fontMetrics.horizontalAdvance(QString(IsaItemModel::kOperandDelimiter)), 0, 0, 0);
-            }
-        }
+        PaintRenderedCell(painter, initialized_option, source_model, source_model_index, paint_rectangle);
     }
     else if (source_model_index.column() == IsaItemModel::kPcAddress || source_model_index.column() == IsaItemModel::kBinaryRepresentation)
     {
@@ -539,6 +620,14 @@ void IsaItemDelegate::ConnectTooltipTimerCallback(bool connect_timer)
     }
 }
 
+void IsaItemDelegate::InvalidateRenderCache() const
+{
+    render_cache_.clear();
+
+    // The indices may not be valid anymore; the op codes are queued again when they are laid out again.
+    tooltip_prefetch_indices_.clear();
+}
+
 void IsaItemDelegate::HideTooltip() const
 {
     tooltip_->hide();
@@ -568,42 +657,56 @@ void IsaItemDelegate::PaintSearchHighlight(QPainter*         painter,
         return;
     }
 
-    const auto sibling_line_number_source_index = source_index.sibling(source_index.row(), IsaItemModel::kLineNumber);
+    search_match_starts_.clear();
 
-    // Text length and highlight rectangle width.
-    const qreal search_text_length        = search_text_.length();
-    const qreal highlight_rectangle_width = fixed_font_character_width * search_text_length;
+    qsizetype search_text_match_index = 0;
 
-    // Font and metrics.
-    const auto font         = painter->font();
-    const auto font_metrics = QFontMetricsF(font);
+    while ((search_text_match_index = display_role_text.indexOf(search_text_, search_text_match_index, Qt::CaseInsensitive)) != -1)
+    {
+        search_match_starts_.push_back(static_cast<uint32_t>(search_text_match_index));
 
-    // Colors.
-    const QColor isa_search_match_color = QtCommon::QtUtils::ColorTheme::Get().GetCurrentThemeColors().isa_search_match_row_color;
-    const QColor selection_color        = QtCommon::QtUtils::ColorTheme::Get().GetCurrentPalette().color(QPalette::Highlight);
-    QColor       search_match_color;
+        search_text_match_index = search_text_match_index + search_text_.length();
+    }
 
-    // Offsets.
-    qsizetype search_text_match_index = 0;
-    QRectF    highlight_rectangle     = rectangle;
+    PaintSearchMatches(painter, rectangle, search_match_starts_.data(), nullptr, search_match_starts_.size(), fixed_font_character_width, source_index);
+}
+
+void IsaItemDelegate::PaintSearchMatches(QPainter*         painter,
+                                         const QRectF&     rectangle,
+                                         const uint32_t*   match_starts,
+                                         const uint32_t*   match_lengths,
+                                         size_t            match_count,
+                                         const qreal       fixed_font_character_width,
+                                         const QModelIndex source_index) const
+{
+    if (match_count == 0)
+    {
+        return;
+    }
+
+    const auto sibling_line_number_source_index = source_index.sibling(source_index.row(), IsaItemModel::kLineNumber);
+
+    // Text length, for matches that are as long as the search text.
+    const uint32_t search_text_length = static_cast<uint32_t>(search_text_.length());
+
+    // Use the palette's selection color if this index belongs to the current search row, otherwise use the isa search color.
+    const bool   is_current_search_row = sibling_line_number_source_index.isValid() && search_source_index_.isValid() &&
+                                       (sibling_line_number_source_index == search_source_index_);
+    const QColor search_match_color    = is_current_search_row ? QtCommon::QtUtils::ColorTheme::Get().GetCurrentPalette().color(QPalette::Highlight)
+                                                               : QtCommon::QtUtils::ColorTheme::Get().GetCurrentThemeColors().isa_search_match_row_color;
+
+    QRectF highlight_rectangle = rectangle;
 
     // Paint a highlight rectangle over every text search match.
-    while ((search_text_match_index = display_role_text.indexOf(search_text_, search_text_match_index, Qt::CaseInsensitive)) != -1)
+    for (size_t i = 0; i < match_count; i++)
     {
-        const qreal text_start = (fixed_font_character_width * static_cast<qreal>(search_text_match_index)) + rectangle.x();
+        const qreal text_start   = (fixed_font_character_width * static_cast<qreal>(match_starts[i])) + rectangle.x();
+        const qreal match_length = static_cast<qreal>((match_lengths != nullptr) ? match_lengths[i] : search_text_length);
 
         highlight_rectangle.setX(text_start);
-        highlight_rectangle.setWidth(highlight_rectangle_width);
-
-        // Use the palette's selection color if this index belongs to the current search row, otherwise use the isa search color.
-        search_match_color =
-            (sibling_line_number_source_index.isValid() && search_source_index_.isValid() && (sibling_line_number_source_index == search_source_index_))
-                ? selection_color
-                : isa_search_match_color;
+        highlight_rectangle.setWidth(fixed_font_character_width * match_length);
 
         painter->fillRect(highlight_rectangle, search_match_color);
-
-        search_text_match_index = search_text_match_index + search_text_length;
     }
 }
 
@@ -618,6 +721,7 @@ void IsaItemDelegate::TooltipTimerCallback()
     if (tooltip_timeout_token_hit_box_.contains(current_mouse_global_position))
     {
         // The current position of the mouse is close enough, so show the tooltip.
+        QTISAGUI_SCOPED_TIMER(kTooltipDecode);
 
         const QVariant data = tooltip_timeout_source_index_.data(IsaItemModel::UserRoles::kDecodedIsa);
         if (data.isValid())
@@ -637,12 +741,28 @@ void IsaItemDelegate::TooltipTimerCallback()
     }
 }
 
+void IsaItemDelegate::PrefetchTooltips()
+{
+    for (const auto& source_index : tooltip_prefetch_indices_)
+    {
+        // Decoded instructions are usually cached by the model already; see IsaItemModel::CacheSizeHints.
+        const QVariant data = source_index.data(IsaItemModel::UserRoles::kDecodedIsa);
+
+        if (data.isValid())
+        {
+            tooltip_->Prefetch(qvariant_cast<amdisa::InstructionInfo>(data));
+        }
+    }
+
+    tooltip_prefetch_indices_.clear();
+}
+
 void IsaItemDelegate::AdjustXPositionForSpannedColumns(const QModelIndex&           index,
-                                                       const QSortFilterProxyModel* proxy,
-                                                       QModelIndex&                 source_index,
-                                                       qreal&                       local_x_position)
+                                                       const QAbstractProxyModel* proxy,
+                                                       QModelIndex&               source_index,
+                                                       qreal&                     local_x_position)
 {
-    if (view_->isFirstColumnSpanned(index.row(), index.parent()))
+    if (view_->IsRowSpanned(index.row(), index.parent()))
     {
         int opcode_index = IsaItemModel::kOpCode;
 
@@ -709,23 +829,17 @@ bool IsaItemDelegate::SetSelectableTokenUnderMouse(const QModelIndex&   source_i
         return false;
     }
 
-    // Get the tokens at the index.
-    std::vector<IsaItemModel::Token> tokens;
+    const IsaItemModel* source_model = qobject_cast<const IsaItemModel*>(source_index.model());
 
-    if (source_index.column() == IsaItemModel::Columns::kOpCode)
+    if (source_model == nullptr)
     {
-        tokens = qvariant_cast<std::vector<IsaItemModel::Token>>(source_index.data(Qt::UserRole));
+        return false;
     }
-    else
-    {
-        const std::vector<std::vector<IsaItemModel::Token>> tokens_per_operands =
-            qvariant_cast<std::vector<std::vector<IsaItemModel::Token>>>(source_index.data(Qt::UserRole));
 
-        for (const auto& tokens_per_operand : tokens_per_operands)
-        {
-            tokens.insert(tokens.end(), tokens_per_operand.begin(), tokens_per_operand.end());
-        }
-    }
+    // Get the tokens at the index; the tokens of all operands are back to back.
+    auto& tokens = token_views_;
+
+    source_model->GetTokens(source_index, tokens);
 
     // Check if the mouse position is directly over any token.
     for (int i = 0; i < static_cast<int>(tokens.size()); i++)
@@ -736,7 +850,7 @@ bool IsaItemDelegate::SetSelectableTokenUnderMouse(const QModelIndex&   source_i
         {
             // Save the isa token.
             isa_token_under_mouse_index = i;
-            isa_token_under_mouse       = isa_token;
+            isa_token_under_mouse       = isa_token.ToToken();
 
             // Save the token's hit box in global coordinates.
             const auto token_left   = view_->mapToGlobal(QPoint(offset + isa_token.x_position_start, 0)).x();
@@ -760,6 +874,8 @@ bool IsaItemDelegate::SetBranchLabelTokenUnderMouse(const QModelIndex& source_in
 {
     bool hover_over_label = false;
 
+    const IsaItemModel* source_model = qobject_cast<const IsaItemModel*>(source_index.model());
+
     if (source_index.column() == IsaItemModel::kOpCode)
     {
         const bool is_mouse_over_branch_label = source_index.data(IsaItemModel::kLabelBranchRole).toBool();
@@ -768,39 +884,52 @@ bool IsaItemDelegate::SetBranchLabelTokenUnderMouse(const QModelIndex& source_in
         {
             // Label is referenced by branch instructions.
 
-            std::vector<IsaItemModel::Token> tokens = qvariant_cast<std::vector<IsaItemModel::Token>>(source_index.data(Qt::UserRole));
-
-            IsaItemModel::Token token;
-
-            if (!tokens.empty())
+            if (source_model != nullptr)
             {
-                token = tokens.front();
+                source_model->GetTokens(source_index, token_views_);
+            }
+            else
+            {
+                token_views_.clear();
             }
 
-            if (token.type == IsaItemModel::TokenType::kLabelType && local_x_position >= token.x_position_start && local_x_position <= token.x_position_end)
+            if (!token_views_.empty())
             {
-                hover_over_label = true;
+                const auto& token = token_views_.front();
 
-                view_->setCursor(Qt::PointingHandCursor);
+                if (token.type == IsaItemModel::TokenType::kLabelType && local_x_position >= token.x_position_start && local_x_position <= token.x_position_end)
+                {
+                    hover_over_label = true;
+
+                    view_->setCursor(Qt::PointingHandCursor);
+                }
             }
         }
     }
     else if (source_index.column() == IsaItemModel::kOperands)
     {
-        std::vector<std::vector<IsaItemModel::Token>> tokens = qvariant_cast<std::vector<std::vector<IsaItemModel::Token>>>(source_index.data(Qt::UserRole));
-
-        IsaItemModel::Token token;
-
-        if (!tokens.empty() && !tokens.front().empty())
+        if (source_model != nullptr)
         {
-            token = tokens.front().front();
+            source_model->GetTokens(source_index, token_views_, &operand_ends_);
+        }
+        else
+        {
+            token_views_.clear();
+            operand_ends_.clear();
         }
 
-        if (token.type == IsaItemModel::TokenType::kBranchLabelType && local_x_position >= token.x_position_start && local_x_position <= token.x_position_end)
+        // Only the first token of the first operand can be a branch label.
+        if (!operand_ends_.empty() && operand_ends_.front() > 0)
         {
-            hover_over_label = true;
+            const auto& token = token_views_.front();
 
-            view_->setCursor(Qt::PointingHandCursor);
+            if (token.type == IsaItemModel::TokenType::kBranchLabelType && local_x_position >= token.x_position_start &&
+                local_x_position <= token.x_position_end)
+            {
+                hover_over_label = true;
+
+                view_->setCursor(Qt::PointingHandCursor);
+            }
         }
     }
 
@@ -812,75 +941,44 @@ bool IsaItemDelegate::SetBranchLabelTokenUnderMouse(const QModelIndex& source_in
     return hover_over_label;
 }
 
-void IsaItemDelegate::PaintTokenHighlight(const IsaItemModel::Token& token,
-                                          const QRectF&              isa_token_rectangle,
-                                          QPainter*                  painter,
-                                          const QFontMetrics&        font_metrics,
-                                          int                        code_block_index,
-                                          int                        instruction_index,
-                                          int                        token_index) const
+void IsaItemDelegate::PaintTokenHighlight(const IsaItemModel::TokenView& token,
+                                          const QRectF&                  isa_token_rectangle,
+                                          QPainter*                      painter,
+                                          const QFontMetrics&            font_metrics,
+                                          int                            code_block_index,
+                                          int                            instruction_index,
+                                          int                            line_number,
+                                          int                            token_index) const
 {
     bool is_token_selected = false;
 
     if (token.type == IsaItemModel::TokenType::kScalarRegisterType || token.type == IsaItemModel::TokenType::kVectorRegisterType)
     {
-        // Check if register numbers match.
-
-        if (((token.type == IsaItemModel::TokenType::kScalarRegisterType && selected_isa_token_.type == IsaItemModel::TokenType::kScalarRegisterType) ||
-             (token.type == IsaItemModel::TokenType::kVectorRegisterType && selected_isa_token_.type == IsaItemModel::TokenType::kVectorRegisterType)))
+        if (line_number != -1 && selected_register_references_valid_)
         {
-            // Comparing scalar to scalar or vector to vector.
-
-            if (selected_isa_token_.start_register_index != -1 && token.start_register_index != -1)
+            // Most lines do not reference the selected register; only look for the token in lines that do.
+            if (static_cast<size_t>(line_number) < selected_register_lines_.size() && selected_register_lines_[line_number])
             {
-                // End can be -1 but start should never be -1.
-
-                if (selected_isa_token_.end_register_index == -1 && token.end_register_index != -1)
-                {
-                    // The selected/clicked token is a single register but the token we are checking is a range.
-
-                    if (selected_isa_token_.start_register_index >= token.start_register_index &&
-                        selected_isa_token_.start_register_index <= token.end_register_index)
-                    {
-                        is_token_selected = true;
-                    }
-                }
-                else if (token.end_register_index == -1 && selected_isa_token_.end_register_index != -1)
-                {
-                    // The token we are checking is a single register but the selected/clicked is a range.
-
-                    if (token.start_register_index >= selected_isa_token_.start_register_index &&
-                        token.start_register_index <= selected_isa_token_.end_register_index)
-                    {
-                        is_token_selected = true;
-                    }
-                }
-                else if (token.end_register_index == -1 && selected_isa_token_.end_register_index == -1)
-                {
-                    // Both tokens are a single register.
-
-                    if (token.start_register_index == selected_isa_token_.start_register_index)
-                    {
-                        is_token_selected = true;
-                    }
-                }
-                else if ((token.start_register_index >= selected_isa_token_.start_register_index &&
-                          token.start_register_index <= selected_isa_token_.end_register_index) ||
-                         (token.end_register_index >= selected_isa_token_.start_register_index &&
-                          token.end_register_index <= selected_isa_token_.end_register_index))
-
-                {
-                    // Both tokens are ranges and the ranges overlap.
+                const IsaRegisterIndex::Reference reference = {static_cast<uint32_t>(line_number), static_cast<uint32_t>(token_index)};
 
-                    is_token_selected = true;
-                }
+                is_token_selected = std::binary_search(selected_register_references_.begin(), selected_register_references_.end(), reference);
             }
         }
+        else if (token.type == selected_isa_token_.type && selected_isa_token_.start_register_index != -1 && token.start_register_index != -1)
+        {
+            // Line numbers are not mapped yet, so the register index is not built; check if the register ranges overlap.
+            const int token_start    = token.start_register_index;
+            const int token_end      = (token.end_register_index == -1) ? token_start : token.end_register_index;
+            const int selected_start = selected_isa_token_.start_register_index;
+            const int selected_end   = (selected_isa_token_.end_register_index == -1) ? selected_start : selected_isa_token_.end_register_index;
+
+            is_token_selected = token_start <= selected_end && selected_start <= token_end;
+        }
     }
     else
     {
         // Op code or constant, string check should be sufficient.
-        if (selected_isa_token_.token_text == token.token_text)
+        if (IsSameTokenText(selected_isa_token_, token))
         {
             is_token_selected = true;
         }
@@ -894,22 +992,68 @@ void IsaItemDelegate::PaintTokenHighlight(const IsaItemModel::Token& token,
         // This token matches the currently selected token so highlight it.
 
         QRectF highlighted_operand_rectangle = isa_token_rectangle;
-        highlighted_operand_rectangle.setWidth(font_metrics.horizontalAdvance(token.token_text.c_str()));
+        highlighted_operand_rectangle.setWidth(font_metrics.horizontalAdvance(ToQString(token.token_text)));
 
         painter->fillRect(highlighted_operand_rectangle, token_highlight_color);
     }
-    else if (mouse_over_isa_token_.token_text == token.token_text && code_block_index == mouse_over_code_block_index_ &&
+    else if (IsSameTokenText(mouse_over_isa_token_, token) && code_block_index == mouse_over_code_block_index_ &&
              instruction_index == mouse_over_instruction_index_ && mouse_over_token_index_ == token_index)
     {
         // This token is underneath the mouse so highlight it.
 
         QRectF highlighted_token_rectangle = isa_token_rectangle;
-        highlighted_token_rectangle.setWidth(font_metrics.horizontalAdvance(token.token_text.c_str()));
+        highlighted_token_rectangle.setWidth(font_metrics.horizontalAdvance(ToQString(token.token_text)));
 
         painter->fillRect(highlighted_token_rectangle, token_highlight_color);
     }
 }
 
+void IsaItemDelegate::UpdateSelectedRegisterReferences(const IsaItemModel* source_model) const
+{
+    const IsaRegisterIndex& register_index = source_model->GetRegisterIndex();
+
+    if (selected_register_references_valid_ && selected_register_model_ == source_model && selected_register_build_count_ == register_index.GetBuildCount())
+    {
+        return;
+    }
+
+    selected_register_references_valid_ = true;
+    selected_register_model_            = source_model;
+    selected_register_build_count_      = register_index.GetBuildCount();
+
+    selected_register_references_.clear();
+    selected_register_lines_.clear();
+
+    const bool is_scalar_register = selected_isa_token_.type == IsaItemModel::TokenType::kScalarRegisterType;
+    const bool is_vector_register = selected_isa_token_.type == IsaItemModel::TokenType::kVectorRegisterType;
+
+    if ((is_scalar_register || is_vector_register) && selected_isa_token_.start_register_index != -1)
+    {
+        register_index.FindReferences(is_scalar_register ? IsaRegisterIndex::RegisterFile::kScalar : IsaRegisterIndex::RegisterFile::kVector,
+                                      selected_isa_token_.start_register_index,
+                                      selected_isa_token_.end_register_index,
+                                      selected_register_references_);
+    }
+
+    std::vector<int> line_numbers;
+
+    if (!selected_register_references_.empty())
+    {
+        selected_register_lines_.assign(selected_register_references_.back().line_number + 1, false);
+
+        for (const auto& reference : selected_register_references_)
+        {
+            if (!selected_register_lines_[reference.line_number])
+            {
+                selected_register_lines_[reference.line_number] = true;
+                line_numbers.push_back(static_cast<int>(reference.line_number));
+            }
+        }
+    }
+
+    view_->SetRegisterReferenceLineNumbers(std::move(line_numbers));
+}
+
 void IsaItemDelegate::PaintSpanned(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& source_index, int x_position) const
 {
     painter->save();
@@ -927,9 +1071,19 @@ void IsaItemDelegate::PaintSpanned(QPainter* painter, const QStyleOptionViewItem
         painter->setPen(pen);
     }
 
-    const std::vector<IsaItemModel::Token> tokens     = qvariant_cast<std::vector<IsaItemModel::Token>>(source_index.data(Qt::UserRole));
-    const auto                             row_type   = qvariant_cast<IsaItemModel::RowType>(source_index.data(IsaItemModel::UserRoles::kRowTypeRole));
-    const bool                             is_comment = row_type == IsaItemModel::RowType::kComment;
+    const IsaItemModel* source_model = qobject_cast<const IsaItemModel*>(source_index.model());
+
+    if (source_model != nullptr)
+    {
+        source_model->GetTokens(source_index, token_views_);
+    }
+    else
+    {
+        token_views_.clear();
+    }
+
+    const auto row_type   = qvariant_cast<IsaItemModel::RowType>(source_index.data(IsaItemModel::UserRoles::kRowTypeRole));
+    const bool is_comment = row_type == IsaItemModel::RowType::kComment;
 
     x_position -= view_->horizontalScrollBar()->value();
 
@@ -937,18 +1091,18 @@ void IsaItemDelegate::PaintSpanned(QPainter* painter, const QStyleOptionViewItem
     text_rectangle.setX(x_position);
     text_rectangle.setWidth(view_->width() - text_rectangle.x());
 
-    PaintText(painter, option, source_index, text_rectangle, tokens, 0, is_comment);
+    PaintText(painter, option, source_index, text_rectangle, token_views_, 0, is_comment);
 
     painter->restore();
 }
 
-std::pair<int, QRectF> IsaItemDelegate::PaintText(QPainter*                        painter,
-                                                  const QStyleOptionViewItem&      option,
-                                                  const QModelIndex&               source_index,
-                                                  QRectF                           token_rectangle,
-                                                  std::vector<IsaItemModel::Token> tokens,
-                                                  int                              token_index,
-                                                  bool                             is_comment) const
+std::pair<int, QRectF> IsaItemDelegate::PaintText(QPainter*                                   painter,
+                                                  const QStyleOptionViewItem&                 option,
+                                                  const QModelIndex&                          source_index,
+                                                  QRectF                                      token_rectangle,
+                                                  const std::vector<IsaItemModel::TokenView>& tokens,
+                                                  int                                         token_index,
+                                                  bool                                        is_comment) const
 {
     if (is_comment)
     {
@@ -966,9 +1120,12 @@ std::pair<int, QRectF> IsaItemDelegate::PaintText(QPainter*
     }
     else
     {
+        const IsaItemModel* source_model = qobject_cast<const IsaItemModel*>(source_index.model());
+        const int           line_number  = (source_model != nullptr) ? source_model->GetLineNumber(source_index) : -1;
+
         for (size_t i = 0; i < tokens.size(); i++)
         {
-            const auto token = tokens.at(i);
+            const auto& token = tokens.at(i);
 
             if (token.is_selectable)
             {
@@ -978,6 +1135,7 @@ std::pair<int, QRectF> IsaItemDelegate::PaintText(QPainter*
                                     option.fontMetrics,
                                     source_index.parent().row(),
                                     source_index.row(),
+                                    line_number,
                                     token_index);  // Assume 0 index for op code.
             }
 
@@ -994,8 +1152,7 @@ std::pair<int, QRectF> IsaItemDelegate::PaintText(QPainter*
                 painter->drawLine(label_underline_start, label_underline_end);
             }
             painter->restore();
-            const QString token_text(token.token_text.c_str());
-            token_rectangle.adjust(option.fontMetrics.horizontalAdvance(token_text), 0, 0, 0);
+            token_rectangle.adjust(option.fontMetrics.horizontalAdvance(ToQString(token.token_text)), 0, 0, 0);
 
             // Add a space if it is not the last token in the operand.
             if (i < tokens.size() - 1)
@@ -1009,3 +1166,234 @@ std::pair<int, QRectF> IsaItemDelegate::PaintText(QPainter*
 
     return std::pair<int, QRectF>(token_index, token_rectangle);
 }
+
+void IsaItemDelegate::PaintRenderedCell(QPainter*                   painter,
+                                        const QStyleOptionViewItem& option,
+                                        const IsaItemModel*         source_model,
+                                        const QModelIndex&          source_index,
+                                        const QRectF&               cell_rectangle) const
+{
+    WatchRenderCacheModel(source_model);
+
+    if (painter->font() != render_cache_font_)
+    {
+        render_cache_.clear();
+        render_cache_font_       = painter->font();
+        render_cache_comma_text_ = QStaticText();
+    }
+
+    if (render_cache_comma_text_.text().isEmpty())
+    {
+        PrepareStaticText(",", render_cache_font_, render_cache_comma_text_);
+    }
+
+    // Identify the cell by the rows of its code block and instruction, and whether it is the op code or operands column.
+    const uint64_t key = (static_cast<uint64_t>(source_index.parent().row()) << 33) | (static_cast<uint64_t>(source_index.row()) << 1) |
+                         ((source_index.column() == IsaItemModel::kOperands) ? 1 : 0);
+
+    auto cell_iter = render_cache_.find(key);
+
+    if (cell_iter == render_cache_.end())
+    {
+        if (render_cache_.size() >= GetRenderCacheCapacity(source_model))
+        {
+            render_cache_.clear();
+        }
+
+        cell_iter = render_cache_.emplace(key, RenderedCell()).first;
+
+        BuildRenderedCell(option, source_model, render_cache_font_, source_index, cell_iter->second);
+
+        // Op codes that are painted are the ones the mouse can hover over next.
+        if (source_index.column() == IsaItemModel::kOpCode && tooltip_prefetch_indices_.size() < kRenderCacheMaxCellCount)
+        {
+            tooltip_prefetch_indices_.push_back(source_index);
+            tooltip_prefetch_timer_.start(kTooltipPrefetchDelayMs);
+        }
+    }
+
+    const RenderedCell& cell = cell_iter->second;
+
+    // Text painted with a rectangle is clipped to it; keep doing so for the static text.
+    painter->save();
+    painter->setClipRect(cell_rectangle, Qt::IntersectClip);
+
+    const QPen default_pen = painter->pen();
+    const int  line_number = source_model->GetLineNumber(source_index);
+
+    for (const auto& rendered_token : cell.tokens)
+    {
+        QRectF token_rectangle = cell_rectangle;
+        token_rectangle.adjust(rendered_token.x_offset, 0, 0, 0);
+
+        // Selection and mouse over highlights change all the time, so they are not cached.
+        if (rendered_token.token.is_selectable)
+        {
+            IsaItemModel::TokenView token = rendered_token.token;
+            token.token_text              = rendered_token.token_text;
+
+            PaintTokenHighlight(token,
+                                token_rectangle,
+                                painter,
+                                option.fontMetrics,
+                                source_index.parent().row(),
+                                source_index.row(),
+                                line_number,
+                                rendered_token.token_index);
+        }
+
+        QPen pen = default_pen;
+
+        if (rendered_token.has_color)
+        {
+            pen.setColor(rendered_token.color);
+        }
+
+        painter->setPen(pen);
+        painter->drawStaticText(token_rectangle.topLeft(), rendered_token.static_text);
+
+        if (rendered_token.token.type == IsaItemModel::TokenType::kBranchLabelType)
+        {
+            const int underline_y = static_cast<int>(token_rectangle.bottom());
+
+            QPoint label_underline_start(static_cast<int>(token_rectangle.x() + rendered_token.token.x_position_start), underline_y);
+            QPoint label_underline_end(static_cast<int>(token_rectangle.x() + rendered_token.token.x_position_end), underline_y);
+
+            // Re-use color and draw a line underneath the target of the branch instruction.
+            painter->drawLine(label_underline_start, label_underline_end);
+        }
+    }
+
+    painter->setPen(default_pen);
+
+    for (const qreal comma_offset : cell.comma_offsets)
+    {
+        painter->drawStaticText(QPointF(cell_rectangle.x() + comma_offset, cell_rectangle.y()), render_cache_comma_text_);
+    }
+
+    painter->restore();
+}
+
+void IsaItemDelegate::BuildRenderedCell(const QStyleOptionViewItem& option,
+                                        const IsaItemModel*         source_model,
+                                        const QFont&                font,
+                                        const QModelIndex&          source_index,
+                                        RenderedCell&               cell) const
+{
+    // The op code column has a single operand, the op code itself.
+    source_model->GetTokens(source_index, token_views_, &operand_ends_);
+
+    if (source_index.column() != IsaItemModel::kOperands)
+    {
+        operand_ends_.assign(1, token_views_.size());
+    }
+
+    const bool  color_coding_enabled = source_index.data(IsaItemModel::kLineEnabledRole).toBool();
+    const qreal token_space_width    = option.fontMetrics.horizontalAdvance(IsaItemModel::kOperandTokenSpace);
+    const qreal delimiter_width      = option.fontMetrics.horizontalAdvance(IsaItemModel::kOperandDelimiter);
+
+    qreal  x_offset    = 0;
+    size_t token_index = 0;
+
+    // Lay out the tokens the same way PaintText does, operand by operand.
+    for (size_t i = 0; i < operand_ends_.size(); i++)
+    {
+        const size_t operand_end = operand_ends_[i];
+
+        for (; token_index < operand_end; token_index++)
+        {
+            const auto&   token = token_views_[token_index];
+            const QString token_text(ToQString(token.token_text));
+
+            RenderedToken rendered_token;
+            rendered_token.token       = token;
+            rendered_token.token_text  = std::string(token.token_text);
+            rendered_token.has_color   = color_coding_enabled && GetTokenColor(token, rendered_token.color);
+            rendered_token.x_offset    = x_offset;
+            rendered_token.token_index = static_cast<int>(token_index);
+
+            PrepareStaticText(token_text, font, rendered_token.static_text);
+
+            cell.tokens.push_back(std::move(rendered_token));
+
+            x_offset += option.fontMetrics.horizontalAdvance(token_text);
+
+            // Add a space if it is not the last token in the operand.
+            if (token_index + 1 < operand_end)
+            {
+                x_offset += token_space_width;
+            }
+        }
+
+        // Add a comma if it is not the last operand.
+        if (i < operand_ends_.size() - 1)
+        {
+            cell.comma_offsets.push_back(x_offset);
+
+            x_offset += delimiter_width;
+        }
+    }
+}
+
+size_t IsaItemDelegate::GetRenderCacheCapacity(const IsaItemModel* source_model) const
+{
+    if (source_model == nullptr || source_model->GetStorageMode() != IsaItemModel::StorageMode::kVirtual)
+    {
+        return kRenderCacheMaxCellCount;
+    }
+
+    // Every parsed row has an op code and an operands cell; cells of rows that are no longer kept are parsed again when repainted.
+    return std::max<size_t>(1, std::min(kRenderCacheMaxCellCount, 2 * source_model->GetVirtualCacheRowCount()));
+}
+
+void IsaItemDelegate::WatchRenderCacheModel(const IsaItemModel* source_model) const
+{
+    if (source_model == render_cache_model_)
+    {
+        return;
+    }
+
+    for (const auto& connection : render_cache_connections_)
+    {
+        disconnect(connection);
+    }
+
+    render_cache_connections_.clear();
+    render_cache_.clear();
+    tooltip_prefetch_indices_.clear();
+
+    // Another model may show another architecture.
+    tooltip_->ClearCache();
+
+    render_cache_model_ = source_model;
+
+    if (source_model == nullptr)
+    {
+        return;
+    }
+
+    const auto invalidate = [this]() { InvalidateRenderCache(); };
+
+    render_cache_connections_.push_back(connect(source_model, &QAbstractItemModel::modelReset, this, invalidate));
+    render_cache_connections_.push_back(connect(source_model, &QAbstractItemModel::layoutChanged, this, invalidate));
+    render_cache_connections_.push_back(connect(source_model, &QAbstractItemModel::rowsInserted, this, invalidate));
+    render_cache_connections_.push_back(connect(source_model, &QAbstractItemModel::rowsRemoved, this, invalidate));
+    render_cache_connections_.push_back(connect(source_model, &IsaItemModel::ArchitectureChanged, this, invalidate));
+    render_cache_connections_.push_back(connect(source_model, &IsaItemModel::ArchitectureChanged, tooltip_, &IsaTooltip::ClearCache));
+
+    // This delegate asks for repaints with invalid indices after mouse moves; those do not change any text.
+    // Metric updates only change the background of lines; see IsaItemModel::SetMetricValues.
+    render_cache_connections_.push_back(connect(
+        source_model, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex& top_left, const QModelIndex&, const QList<int>& roles) {
+            if (top_left.isValid() && roles != QList<int>{Qt::BackgroundRole})
+            {
+                InvalidateRenderCache();
+            }
+        }));
+
+    render_cache_connections_.push_back(connect(source_model, &QObject::destroyed, this, [this]() {
+        render_cache_connections_.clear();
+        render_cache_.clear();
+        render_cache_model_ = nullptr;
+    }));
+}
@@ -12,10 +12,16 @@
 #include <QPainter>
 #include <QRectF>
 #include <QScrollArea>
+#include <QStaticText>
 #include <QStyleOptionViewItem>
 #include <QStyledItemDelegate>
 #include <QTimer>
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "isa_item_model.h"
 #include "isa_proxy_model.h"
 #include "isa_tooltip.h"
@@ -80,6 +86,14 @@ public:
         search_text_ = search_text;
     }
 
+    /// @brief Cache how the current search text matches; cells the search index did not search are only highlighted in contains mode.
+    ///
+    /// @param [in] search_mode The search mode.
+    inline void SetSearchMode(IsaSearchIndex::MatchMode search_mode)
+    {
+        search_mode_ = search_mode;
+    }
+
     /// @brief Cache the source index of the current search to assist highlighting the current text search match.
     ///
     /// @param [in] search_index The source index.
@@ -88,6 +102,17 @@ public:
         search_source_index_ = search_index;
     }
 
+    /// @brief Set the metric whose values are painted as a heatmap behind every line; see IsaItemModel::AddMetric.
+    ///
+    /// @param [in] metric The metric, or -1 to paint no heatmap.
+    inline void SetHeatmapMetric(int metric)
+    {
+        heatmap_metric_ = metric;
+    }
+
+    /// @brief Forget all prepared op code and operand text, so it is laid out again the next time it is painted.
+    void InvalidateRenderCache() const;
+
 public slots:
     /// @brief Connects the timer to show the tooltip after the mouse stays hovered over an opcode.
     ///
@@ -119,6 +144,23 @@ protected:
                               const qreal       fixed_font_character_width,
                               const QModelIndex source_index) const;
 
+    /// @brief Paint a rectangle highlight over matches of the current search text that were already found.
+    ///
+    /// [in] @param painter                    The painter
+    /// [in] @param rectangle                  The starting rectangle to paint into.
+    /// [in] @param match_starts               The character offset of every match into the text painted in rectangle.
+    /// [in] @param match_lengths              The length of every match, or nullptr if every match is as long as the search text.
+    /// [in] @param match_count                The number of matches.
+    /// [in] @param fixed_font_character_width The view width of a single character.
+    /// [in] @param source_index               The source index to paint for.
+    void PaintSearchMatches(QPainter*         painter,
+                            const QRectF&     rectangle,
+                            const uint32_t*   match_starts,
+                            const uint32_t*   match_lengths,
+                            size_t            match_count,
+                            const qreal       fixed_font_character_width,
+                            const QModelIndex source_index) const;
+
     IsaTreeView* view_;  ///< The corresponding tree view.
 
 private slots:
@@ -126,6 +168,9 @@ private slots:
     /// @brief  A timer callback that runs when a delta of time has passed since there was a successful mouse position to isa token position collision.
     void TooltipTimerCallback();
 
+    /// @brief Prepare the tooltips of the op codes painted since the last prefetch, so they show without any work.
+    void PrefetchTooltips();
+
 private:
     /// @brief Help navigating from labels to branches by accomodating for column span when calculating x position relative to a column.
     ///
@@ -133,7 +178,7 @@ private:
     /// @param [in]  proxy            The proxy model.
     /// @param [out] source_index     The source index to check; will be changed to the op code source index if the given index spans columns.
     /// @param [out] local_x_position The x position of a mouse event; will be changed if the given index spans columns to be relative to the op code column.
-    void AdjustXPositionForSpannedColumns(const QModelIndex& index, const QSortFilterProxyModel* proxy, QModelIndex& source_index, qreal& local_x_position);
+    void AdjustXPositionForSpannedColumns(const QModelIndex& index, const QAbstractProxyModel* proxy, QModelIndex& source_index, qreal& local_x_position);
 
     /// @brief Helper to get the starting painting position of indicies that span across columns.
     ///
@@ -177,14 +222,23 @@ private:
     /// @param [in] font_metrics        The font metrics.
     /// @param [in] code_block_index    The token's code block index.
     /// @param [in] instruction_index   The token's instruction index.
+    /// @param [in] line_number         The token's source model line number, or -1 if line numbers are not mapped yet.
     /// @param [in] token_index         The token's index.
-    void PaintTokenHighlight(const IsaItemModel::Token& token,
-                             const QRectF&              isa_token_rectangle,
-                             QPainter*                  painter,
-                             const QFontMetrics&        font_metrics,
-                             int                        code_block_index,
-                             int                        instruction_index,
-                             int                        token_index) const;
+    void PaintTokenHighlight(const IsaItemModel::TokenView& token,
+                             const QRectF&                  isa_token_rectangle,
+                             QPainter*                      painter,
+                             const QFontMetrics&            font_metrics,
+                             int                            code_block_index,
+                             int                            instruction_index,
+                             int                            line_number,
+                             int                            token_index) const;
+
+    /// @brief Find every token that references the selected register, if the selection or the model's register index changed.
+    ///
+    /// Also gives the lines of the references to the view, to mark them in its scroll bar.
+    ///
+    /// @param [in] source_model The source model being painted.
+    void UpdateSelectedRegisterReferences(const IsaItemModel* source_model) const;
 
     /// @brief Helper function to paint the text of a list of isa tokens or isa comments.
     ///
@@ -197,13 +251,13 @@ private:
     /// @param [in] is_comment      true if painting comment text, false if painting an instruction's tokens.
     ///
     /// @return A pair of the final token index and text rectangle for when painting a double vector of tokens.
-    std::pair<int, QRectF> PaintText(QPainter*                        painter,
-                                     const QStyleOptionViewItem&      option,
-                                     const QModelIndex&               source_index,
-                                     QRectF                           token_rectangle,
-                                     std::vector<IsaItemModel::Token> tokens,
-                                     int                              token_index,
-                                     bool                             is_comment) const;
+    std::pair<int, QRectF> PaintText(QPainter*                                   painter,
+                                     const QStyleOptionViewItem&                 option,
+                                     const QModelIndex&                          source_index,
+                                     QRectF                                      token_rectangle,
+                                     const std::vector<IsaItemModel::TokenView>& tokens,
+                                     int                                         token_index,
+                                     bool                                        is_comment) const;
 
     /// @brief Helper function to paint an isa opcode or isa comments in a spanned column.
     ///
@@ -212,9 +266,78 @@ private:
     /// @param [in] x_position The x position to start painting the spanning text.
     void PaintSpanned(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& source_index, int x_position) const;
 
+    /// @brief A token of an instruction's op code or operands, laid out and ready to be painted.
+    struct RenderedToken
+    {
+        IsaItemModel::TokenView token;        ///< The token, for highlighting; its text is token_text, since the row it views may be dropped.
+        std::string             token_text;   ///< A copy of the token's text; virtual models reuse the text of rows that are no longer kept.
+        QStaticText             static_text;  ///< The prepared text of the token.
+        QColor                  color;        ///< The color of the token; only used if has_color is true.
+        bool                    has_color;    ///< true if the token is color coded, false if it uses the default pen.
+        qreal                   x_offset;     ///< The x offset of the token from the start of the cell.
+        int                     token_index;  ///< The index of the token across all operands of the instruction.
+    };
+
+    /// @brief The op code or operands cell of an instruction, laid out and ready to be painted.
+    struct RenderedCell
+    {
+        std::vector<RenderedToken> tokens;         ///< The tokens, in painting order.
+        std::vector<qreal>         comma_offsets;  ///< The x offsets of the commas after every operand but the last.
+    };
+
+    /// @brief Paint the op code or operands of an instruction from the render cache, laying them out first if needed.
+    ///
+    /// @param [in] painter        The QPainter that will be used for painting; its font should already be set.
+    /// @param [in] option         The style option for determining font metrics.
+    /// @param [in] source_model   The source model.
+    /// @param [in] source_index   The source model index of the op code or operands of an instruction.
+    /// @param [in] cell_rectangle The rectangle where the text will be drawn.
+    void PaintRenderedCell(QPainter*                   painter,
+                           const QStyleOptionViewItem& option,
+                           const IsaItemModel*         source_model,
+                           const QModelIndex&          source_index,
+                           const QRectF&               cell_rectangle) const;
+
+    /// @brief Lay out the op code or operands of an instruction.
+    ///
+    /// @param [in]  option       The style option for determining font metrics.
+    /// @param [in]  source_model The source model.
+    /// @param [in]  font         The font the text will be painted with.
+    /// @param [in]  source_index The source model index of the op code or operands of an instruction.
+    /// @param [out] cell         The laid out cell.
+    void BuildRenderedCell(const QStyleOptionViewItem& option,
+                           const IsaItemModel*         source_model,
+                           const QFont&                font,
+                           const QModelIndex&          source_index,
+                           RenderedCell&               cell) const;
+
+    /// @brief Track the source model whose text is in the render cache, and invalidate the cache whenever that model's data changes.
+    ///
+    /// @param [in] source_model The source model being painted.
+    void WatchRenderCacheModel(const IsaItemModel* source_model) const;
+
+    /// @brief Get the number of cells the render cache may hold for a model.
+    ///
+    /// @param [in] source_model The source model being painted.
+    ///
+    /// @return kRenderCacheMaxCellCount, or fewer for a virtual model that keeps fewer parsed rows than that.
+    size_t GetRenderCacheCapacity(const IsaItemModel* source_model) const;
+
+    /// @brief Maximum number of cells in the render cache; the cache is emptied when it grows past this, which is plenty for a few screens.
+    static constexpr size_t kRenderCacheMaxCellCount = 8192;
+
+    /// @brief Time after the last op code is laid out before the tooltips of the painted op codes are prepared, so scrolling is not slowed down.
+    static constexpr int kTooltipPrefetchDelayMs = 100;
+
     IsaItemModel::Token mouse_over_isa_token_;  ///< Track the token that the mouse is over.
     IsaItemModel::Token selected_isa_token_;    ///< Track the selected token.
 
+    mutable std::vector<IsaRegisterIndex::Reference> selected_register_references_;        ///< Tokens that reference the selected register, sorted.
+    mutable std::vector<bool>                        selected_register_lines_;             ///< true for every line in selected_register_references_.
+    mutable const IsaItemModel*                      selected_register_model_;             ///< The model selected_register_references_ came from.
+    mutable uint64_t                                 selected_register_build_count_;       ///< The register index build the references came from.
+    mutable bool                                     selected_register_references_valid_;  ///< false if the selected token changed since.
+
     int mouse_over_code_block_index_;   ///< Track the code block index that the mouse is over.
     int mouse_over_instruction_index_;  ///< Track the instruction index that the mouse is over.
     int mouse_over_token_index_;        ///< Track the token index that the mouse is over.
@@ -224,8 +347,24 @@ private:
     QModelIndex tooltip_timeout_source_index_;   ///< The latest source index at which the mouse position has collided with an isa token hit box, if any.
     QRectF      tooltip_timeout_token_hit_box_;  ///< The latest hit box of the isa token which has collided with the mouse, if any.
 
-    QString     search_text_;          ///< Cache the current search text to assist highlighting text search matches.
-    QModelIndex search_source_index_;  ///< Cache the current search source index to assist highlighting the current text search match.
+    mutable QTimer                   tooltip_prefetch_timer_;    ///< A timer to prefetch tooltips once painting settles.
+    mutable std::vector<QModelIndex> tooltip_prefetch_indices_;  ///< Source indices of op codes laid out since the last prefetch.
+
+    QString                   search_text_;          ///< Cache the current search text to assist highlighting text search matches.
+    IsaSearchIndex::MatchMode search_mode_;          ///< Cache how the current search text matches.
+    QModelIndex               search_source_index_;  ///< Cache the current search source index to assist highlighting the current text search match.
+    int                       heatmap_metric_;       ///< The metric painted as a heatmap behind every line; -1 for none.
+
+    mutable std::vector<uint32_t> search_match_starts_;  ///< Reused buffer for the matches PaintSearchHighlight finds.
+
+    mutable std::vector<IsaItemModel::TokenView> token_views_;   ///< Reused buffer for the tokens of an index.
+    mutable std::vector<size_t>                  operand_ends_;  ///< Reused buffer for the operand boundaries in token_views_.
+
+    mutable std::unordered_map<uint64_t, RenderedCell> render_cache_;              ///< Laid out op code and operands cells, by instruction and column.
+    mutable QFont                                      render_cache_font_;         ///< The font the cells in the render cache were laid out with.
+    mutable QStaticText                                render_cache_comma_text_;   ///< The prepared comma between operands, in render_cache_font_.
+    mutable const IsaItemModel*                        render_cache_model_;        ///< The source model the cells in the render cache came from.
+    mutable std::vector<QMetaObject::Connection>       render_cache_connections_;  ///< Connections to the signals of render_cache_model_.
 };
 
 #endif  // QTISAGUI_ISA_ITEM_DELEGATE_H_
@@ -7,30 +7,41 @@
 
 #include "isa_item_model.h"
 
-#include <cctype>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
-#include <sstream>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <unordered_map>
 
 #include <QColor>
+#include <QCoreApplication>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QFontDatabase>
 #include <QFontMetrics>
-#include <QRegularExpression>
+#include <QSaveFile>
 #include <QStringList>
 
 #include "qt_common/utils/common_definitions.h"
 #include "qt_common/utils/qt_util.h"
 
+#include "qt_isa_gui/core/isa_control_flow_graph.h"
+#include "qt_isa_gui/core/isa_decoder_registry.h"
+#include "qt_isa_gui/core/isa_instruction_encoding.h"
+#include "qt_isa_gui/core/isa_instrumentation.h"
+#include "qt_isa_gui/core/isa_row_tokenizer.h"
 #include "qt_isa_gui/utility/isa_dictionary.h"
 
 #include "isa_tree_view.h"
 
 const QString                                             IsaItemModel::kColumnPadding             = " ";           // Pad columns by 1 character.
-const QString                                             IsaItemModel::kOpCodeColumnIndent        = "     ";       // Indent op code column by 5 characters.
-const QString                                             IsaItemModel::kOperandTokenSpace         = " ";           // Separate tokens within the same operand.
-const QString                                             IsaItemModel::kOperandDelimiter          = ", ";          // Separate operands by a comma and a space.
+const QString                                             IsaItemModel::kOpCodeColumnIndent        = QLatin1String(IsaRowTokenizer::kOpCodeColumnIndent.data());
+const QString                                             IsaItemModel::kOperandTokenSpace         = QLatin1String(IsaRowTokenizer::kOperandTokenSpace.data());
+const QString                                             IsaItemModel::kOperandDelimiter          = QLatin1String(IsaRowTokenizer::kOperandDelimiter.data());
 const std::string                                         IsaItemModel::kUnconditionalBranchString = "s_branch";    // Branch op code text.
 const std::string                                         IsaItemModel::kConditionalBranchString   = "s_cbranch_";  // Conditional branch op code text.
 const std::array<std::string, IsaItemModel::kColumnCount> IsaItemModel::kColumnNames               = {"",
@@ -41,15 +52,6 @@ const std::array<std::string, IsaItemModel::kColumnCount> IsaItemModel::kColumnN
 
 namespace
 {
-    // The active decoder for the active architecture.
-    std::shared_ptr<amdisa::IsaDecoder> isa_decoder;
-
-    // The manager of all the architectures.
-    amdisa::DecodeManager decode_manager;
-
-    // Isa decoder initialization status.
-    bool is_decoder_initialized = false;
-
     // The individual isa spec names.
     const std::unordered_map<amdisa::GpuArchitecture, std::string> kIsaSpecNameMap = {{amdisa::GpuArchitecture::kRdna1, "amdgpu_isa_rdna1.xml"},
                                                                                       {amdisa::GpuArchitecture::kRdna2, "amdgpu_isa_rdna2.xml"},
@@ -64,46 +66,329 @@ namespace
     const std::string kOperandTokenSpaceStdString = IsaItemModel::kOperandTokenSpace.toStdString();
     const std::string kOperandDelimiterStdString  = IsaItemModel::kOperandDelimiter.toStdString();
 
-    // Single register operands; match negative value or absolute value too. Ex) s0 or -s0 or |s0|
-    const QRegularExpression kScalarRegisterExpression(QString("(-?)(") + QRegularExpression::escape("|") + QString("?)(s[0-9]+)(\\2)"));
-    const QRegularExpression kVectorRegisterExpression(QString("(-?)(") + QRegularExpression::escape("|") + QString("?)(v[0-9]+)(\\2)"));
+    // Private local helper variable to assist setting branch label hit boxes.
+    qreal fixed_font_character_width = 0;
+
+    // Number of lines an asynchronous update parses before publishing them to the model.
+    const size_t kAsyncUpdateBatchLineCount = 4096;
+
+    // Number of lines a search worker thread searches before publishing their matches to the model.
+    const size_t kSearchChunkLineCount = 16384;
+
+    // Parameters of the 64-bit FNV-1a hash that UpdateBlocks compares blocks with.
+    const uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+    const uint64_t kFnvPrime       = 1099511628211ull;
 
-    // The start of a pair of single register operands. Ex) [s0
-    const QRegularExpression kScalarPairStartRegisterExpression(QRegularExpression::escape("[") + QString("(-?)(") + QRegularExpression::escape("|") +
-                                                                QString("?)(s[0-9]+)(\\2)"));
-    const QRegularExpression kVectorPairStartRegisterExpression(QRegularExpression::escape("[") + QString("(-?)(") + QRegularExpression::escape("|") +
-                                                                QString("?)(v[0-9]+)(\\2)"));
+    /// @brief Mix text into a hash.
+    ///
+    /// @param [in] hash The hash so far.
+    /// @param [in] text The text.
+    ///
+    /// @return The new hash.
+    uint64_t HashText(uint64_t hash, std::string_view text)
+    {
+        for (const char character : text)
+        {
+            hash = (hash ^ static_cast<uint8_t>(character)) * kFnvPrime;
+        }
 
-    // The end of a pair of single register operands. Ex) s0]
-    const QRegularExpression kScalarPairEndRegisterExpression(QString("(-?)(") + QRegularExpression::escape("|") + QString("?)(s[0-9]+)(\\2)") +
-                                                              QRegularExpression::escape("]"));
-    const QRegularExpression kVectorPairEndRegisterExpression(QString("(-?)(") + QRegularExpression::escape("|") + QString("?)(v[0-9]+)(\\2)") +
-                                                              QRegularExpression::escape("]"));
+        // Mix in the length too, so that consecutive texts split differently do not hash the same.
+        return (hash ^ text.size()) * kFnvPrime;
+    }
 
-    // Register range operands. Ex) s[0:1]
-    const QRegularExpression kScalarRegisterRangeExpression(QString("s") + QRegularExpression::escape("[") + QString("[0-9]+:[0-9]+") +
-                                                            QRegularExpression::escape("]"));
-    const QRegularExpression kVectorRegisterRangeExpression(QString("v") + QRegularExpression::escape("[") + QString("[0-9]+:[0-9]+") +
-                                                            QRegularExpression::escape("]"));
+    /// @brief Hash the text a block is parsed from.
+    ///
+    /// Leaves out line numbers, pc addresses and binary representations; they move whenever an instruction is added above,
+    /// and are not parsed.
+    ///
+    /// @param [in] block The block.
+    ///
+    /// @return The hash; never 0.
+    uint64_t HashSourceBlock(const IsaItemModel::SourceBlock& block)
+    {
+        uint64_t hash = kFnvOffsetBasis;
 
-    // Constant operands. Ex) 0 or 1.0 or 0x01
-    const QRegularExpression kConstantExpression("-?[0-9].*");
+        hash = (hash ^ static_cast<uint64_t>(block.row_type)) * kFnvPrime;
+        hash = HashText(hash, block.text);
 
-    // Private local helper variable to assist setting branch label hit boxes.
-    qreal fixed_font_character_width = 0;
+        for (const auto& row : block.rows)
+        {
+            hash = (hash ^ static_cast<uint64_t>(row.row_type)) * kFnvPrime;
+            hash = HashText(hash, row.text);
+            hash = (hash ^ row.operands.size()) * kFnvPrime;
+
+            for (const auto& operand : row.operands)
+            {
+                hash = HashText(hash, operand);
+            }
+        }
+
+        return (hash != 0) ? hash : 1;
+    }
+
+    /// @brief Hash all text of a shader, for the name of its model cache file; see IsaItemModel::BeginCachedUpdate.
+    ///
+    /// @param [in] blocks The blocks of the shader.
+    ///
+    /// @return The hash.
+    uint64_t HashSourceBlocks(const std::vector<IsaItemModel::SourceBlock>& blocks)
+    {
+        uint64_t hash = kFnvOffsetBasis;
+
+        for (const auto& block : blocks)
+        {
+            // Unlike HashSourceBlock, the text that is not parsed is also in the cache.
+            hash = (hash ^ HashSourceBlock(block)) * kFnvPrime;
+            hash = (hash ^ block.line_number) * kFnvPrime;
+
+            for (const auto& row : block.rows)
+            {
+                hash = (hash ^ row.line_number) * kFnvPrime;
+                hash = (hash ^ static_cast<uint64_t>(row.enabled)) * kFnvPrime;
+                hash = HashText(hash, row.pc_address);
+                hash = HashText(hash, row.binary_representation);
+            }
+        }
+
+        return (hash ^ blocks.size()) * kFnvPrime;
+    }
+
+    // Marks a model cache file, and the version of what it holds besides the row storage.
+    const char     kModelCacheMagic[8] = {'I', 'S', 'A', 'C', 'A', 'C', 'H', 'E'};
+    const uint32_t kModelCacheVersion  = 2;
+
+    /// @brief The start of a model cache file.
+    ///
+    /// Followed by the character count of every column as doubles, the number of edges of the control flow graph as a uint64_t,
+    /// its edges as ModelCacheEdge, and the serialized row storage.
+    struct ModelCacheHeader
+    {
+        char     magic[8];  ///< kModelCacheMagic.
+        uint32_t version;   ///< kModelCacheVersion.
+        uint32_t reserved;  ///< Always 0.
+        uint64_t key;       ///< The key of the shader; see IsaItemModel::BeginCachedUpdate.
+    };
+
+    /// @brief An edge of the control flow graph in a model cache file; IsaControlFlowGraph::Edge without padding.
+    struct ModelCacheEdge
+    {
+        uint32_t source_block;  ///< The block the edge starts in.
+        uint32_t source_row;    ///< The row of the instruction that makes the edge, or IsaControlFlowGraph::kInvalidIndex.
+        uint32_t target_block;  ///< The block the edge goes to, or IsaControlFlowGraph::kInvalidIndex.
+        uint32_t kind;          ///< The IsaControlFlowGraph::EdgeKind of the edge.
+    };
+
+    /// @brief Read values from a model cache file.
+    ///
+    /// @param [in]     data   The file.
+    /// @param [in]     size   The size of the file.
+    /// @param [in,out] offset The offset to read at; moved past the values.
+    /// @param [in]     count  The number of values.
+    /// @param [out]    values The values.
+    ///
+    /// @return true if the file holds all values.
+    template <typename Value>
+    bool ReadModelCacheValues(const uchar* data, size_t size, size_t& offset, size_t count, Value* values)
+    {
+        if (offset > size || count > (size - offset) / sizeof(Value))
+        {
+            return false;
+        }
+
+        if (count != 0)
+        {
+            std::memcpy(values, data + offset, count * sizeof(Value));
+        }
+
+        offset += count * sizeof(Value);
+
+        return true;
+    }
+
+    /// @brief Copy the tokens of an instruction into the tokens of an InstructionRow.
+    class SelectableTokenSink : public IsaRowTokenizer::TokenSink
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in]  symbol_table      The symbol table to intern the text of the tokens in.
+        /// @param [out] op_code_token     The op code token.
+        /// @param [out] selectable_tokens The operand tokens; tokens belonging to the same operand are grouped together.
+        SelectableTokenSink(IsaSymbolTable&                                symbol_table,
+                            IsaItemModel::Token&                           op_code_token,
+                            std::vector<std::vector<IsaItemModel::Token>>& selectable_tokens)
+            : symbol_table_(symbol_table)
+            , op_code_token_(op_code_token)
+            , selectable_tokens_(selectable_tokens)
+        {
+        }
+
+        /// @brief Fill in the op code token.
+        ///
+        /// @param [in] token The token.
+        void AddOpCodeToken(const IsaRowTokenizer::TokenLayout& token) override
+        {
+            CopyToken(token, op_code_token_);
+        }
+
+        /// @brief Start the tokens of the next operand.
+        void AddOperand() override
+        {
+            selectable_tokens_.emplace_back();
+        }
+
+        /// @brief Append a token to the last operand.
+        ///
+        /// @param [in] token The token.
+        void AddOperandToken(const IsaRowTokenizer::TokenLayout& token) override
+        {
+            CopyToken(token, selectable_tokens_.back().emplace_back());
+        }
+
+    private:
+        /// @brief Copy a token, interning its text.
+        ///
+        /// @param [in]  token            The token.
+        /// @param [out] selectable_token The model's token.
+        void CopyToken(const IsaRowTokenizer::TokenLayout& token, IsaItemModel::Token& selectable_token)
+        {
+            selectable_token.token_text           = std::string(token.text);
+            selectable_token.symbol               = symbol_table_.Intern(token.text);
+            selectable_token.type                 = token.type;
+            selectable_token.color_class          = token.color_class;
+            selectable_token.is_selectable        = token.is_selectable;
+            selectable_token.start_register_index = token.start_register_index;
+            selectable_token.end_register_index   = token.end_register_index;
+            selectable_token.x_position_start     = token.x_position_start;
+            selectable_token.x_position_end       = token.x_position_end;
+        }
+
+        IsaSymbolTable&                                symbol_table_;       ///< The symbol table to intern the text of the tokens in.
+        IsaItemModel::Token&                           op_code_token_;      ///< The op code token.
+        std::vector<std::vector<IsaItemModel::Token>>& selectable_tokens_;  ///< The operand tokens.
+    };
+
+    // Op codes of instructions are indented under their code block label when rows are exported as text.
+    const std::string kExportOpCodeIndent = "    ";
+
+    // Name of the line number column in the header of exported comma separated values.
+    const std::string kExportLineNumberColumnName = "Line number";
 
+    // Exported text is handed out in chunks of about this many bytes.
+    const size_t kExportChunkSize = 64 * 1024;
+
+    // Number of rows of a virtual update that are parsed to measure the widths of the shared columns.
+    const size_t kVirtualMeasuredRowCount = 4096;
+
+    /// @brief Remove leading and trailing whitespace from a view.
+    ///
+    /// @param [in] text The text.
+    ///
+    /// @return A view of the text without leading and trailing whitespace.
+    std::string_view TrimView(std::string_view text)
+    {
+        const size_t first = text.find_first_not_of(" \t\r");
+
+        if (first == std::string_view::npos)
+        {
+            return std::string_view();
+        }
+
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    /// @brief Count the characters of utf8 text, to pad it the way it is shown.
+    ///
+    /// @param [in] text The text.
+    ///
+    /// @return The number of characters.
+    size_t GetCharacterCount(std::string_view text)
+    {
+        size_t character_count = 0;
+
+        for (const char character : text)
+        {
+            // Continuation bytes are part of the character before them.
+            if ((static_cast<unsigned char>(character) & 0xC0) != 0x80)
+            {
+                character_count++;
+            }
+        }
+
+        return character_count;
+    }
+
+    /// @brief Check if a comma separated value has to be quoted.
+    ///
+    /// @param [in] text The value.
+    ///
+    /// @return true if the value contains a comma, a quote or a line break.
+    inline bool IsCsvQuoteNeeded(std::string_view text)
+    {
+        return text.find_first_of(",\"\r\n") != std::string_view::npos;
+    }
+
+    /// @brief Append a comma separated value, quoted where needed.
+    ///
+    /// @param [in]     text   The value.
+    /// @param [in,out] output The text to append to.
+    void AppendCsvValue(std::string_view text, std::string& output)
+    {
+        if (!IsCsvQuoteNeeded(text))
+        {
+            output.append(text);
+            return;
+        }
+
+        output.push_back('"');
+
+        for (const char character : text)
+        {
+            if (character == '"')
+            {
+                output.push_back('"');
+            }
+
+            output.push_back(character);
+        }
+
+        output.push_back('"');
+    }
 }  // namespace
 
 IsaItemModel::IsaItemModel(QObject* parent, amdisa::DecodeManager* decode_manager_ptr)
     : QAbstractItemModel(parent)
     , fixed_font_character_width_(0)
     , line_numbers_visible_(true)
-    , decode_manager_((decode_manager_ptr != nullptr) ? decode_manager_ptr : &decode_manager)
+    , storage_mode_(StorageMode::kBlocks)
+    , virtual_line_count_(0)
+    , async_update_canceled_(false)
+    , async_update_next_batch_(0)
+    , async_update_next_published_batch_(0)
+    , async_update_published_block_count_(0)
+    , async_update_generation_(0)
+    , search_canceled_(false)
+    , search_next_chunk_(0)
+    , search_chunk_count_(0)
+    , search_next_published_chunk_(0)
+    , search_generation_(0)
+    , model_cache_key_(0)
+    , predecode_canceled_(false)
+    , isa_decoder_announced_(false)
+    , decode_manager_(decode_manager_ptr)
 {
+    // Any change to the rows makes the state derived from them stale.
+    connect(this, &QAbstractItemModel::modelReset, this, [this]() { InvalidateDerivedState(true); });
+    connect(this, &QAbstractItemModel::rowsInserted, this, [this]() { InvalidateDerivedState(false); });
+    connect(this, &QAbstractItemModel::rowsRemoved, this, [this]() { InvalidateDerivedState(false); });
 }
 
 IsaItemModel::~IsaItemModel()
 {
+    // Worker threads must not outlive the model they post their batches to.
+    StopAsyncUpdateThreads();
+    StopSearchThreads();
+    StopPredecodeThread();
 }
 
 int IsaItemModel::columnCount(const QModelIndex& parent) const
@@ -122,6 +407,26 @@ int IsaItemModel::rowCount(const QModelIndex& parent) const
         return 0;
     }
 
+    if (UsesRowStorage())
+    {
+        if (!parent.isValid())
+        {
+            return static_cast<int>(row_storage_.GetBlockCount());
+        }
+
+        if (parent.internalId() == 0)
+        {
+            if (storage_mode_ == StorageMode::kVirtual)
+            {
+                return static_cast<int>(virtual_rows_.GetRowCount(parent.row()));
+            }
+
+            return static_cast<int>(row_storage_.GetBlock(parent.row()).row_count);
+        }
+
+        return 0;
+    }
+
     if (!parent.isValid())
     {
         // The number of top-level nodes is the number of code blocks.
@@ -153,6 +458,12 @@ QModelIndex IsaItemModel::index(int row, int column, const QModelIndex& parent)
         return createIndex(row, column, nullptr);
     }
 
+    if (UsesRowStorage())
+    {
+        // Arena rows have no addressable block; attach parent row + 1 as internal data.
+        return createIndex(row, column, static_cast<quintptr>(parent.row()) + 1);
+    }
+
     // Individual instruction lines are child nodes; attach parent row index as internal data.
     return createIndex(row, column, (void*)blocks_[parent.row()].get());
 }
@@ -164,6 +475,18 @@ QModelIndex IsaItemModel::parent(const QModelIndex& index) const
         return QModelIndex();
     }
 
+    if (UsesRowStorage())
+    {
+        const quintptr parent_id = index.internalId();
+
+        if (parent_id != 0)
+        {
+            return createIndex(static_cast<int>(parent_id - 1), 0, nullptr);
+        }
+
+        return QModelIndex();
+    }
+
     const InstructionBlock* code_block = static_cast<InstructionBlock*>(index.internalPointer());
 
     if (code_block != nullptr)
@@ -222,13 +545,15 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
         // Default to color theme's text color.
         data.setValue(QtCommon::QtUtils::ColorTheme::Get().GetCurrentThemeColors().graphics_scene_text_color);
 
-        if (!index.parent().isValid() && index.column() == kOpCode)
+        const int parent_row = GetParentRow(index);
+
+        if (parent_row == -1 && index.column() == kOpCode)
         {
             // Provide a different starting color for code block comments and code block labels with matching branching instructions.
 
-            const auto block = blocks_.at(index.row());
+            const RowType row_type = GetRowType(parent_row, index.row());
 
-            if (block->row_type == RowType::kComment)
+            if (row_type == RowType::kComment)
             {
                 QColor comment_color;
                 if (QtCommon::QtUtils::ColorTheme::Get().GetColorTheme() == kColorThemeTypeLight)
@@ -243,11 +568,9 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
                 // This is a code block comment; provide light blue as its text color.
                 data.setValue(comment_color);
             }
-            else if (block->row_type == RowType::kCode)
+            else if (row_type == RowType::kCode)
             {
-                const auto code_block = std::static_pointer_cast<InstructionBlock>(block);
-
-                if (!code_block->mapped_branch_instructions.empty())
+                if (GetBranchInstructionCount(index.row()) != 0)
                 {
                     // This is a code block label that is called by a branch instruction(s); provide purple as its text color.
                     QColor label_color;
@@ -265,13 +588,11 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
                 }
             }
         }
-        else if (index.parent().isValid() && index.column() != kLineNumber)
+        else if (parent_row != -1 && index.column() != kLineNumber)
         {
             // Provide a different starting color for child row comments
 
-            const auto row = blocks_.at(index.parent().row())->instruction_lines.at(index.row());
-
-            if (row->row_type == RowType::kComment)
+            if (GetRowType(parent_row, index.row()) == RowType::kComment)
             {
                 QColor comment_color;
 
@@ -292,122 +613,91 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
     }
     case Qt::DisplayRole:
     {
-        const QModelIndex parent_index = index.parent();
+        const int parent_row = GetParentRow(index);
 
         switch (index.column())
         {
         case kLineNumber:
         {
-            int line_number = 0;
-
-            if (!parent_index.isValid())
-            {
-                // Code block.
-                line_number = blocks_.at(index.row())->line_number;
-            }
-            else
-            {
-                // Instruction line.
-                line_number = blocks_.at(parent_index.row())->instruction_lines.at(index.row())->line_number;
-            }
+            // Code block or instruction line.
+            const int line_number = GetRowLineNumber(parent_row, index.row());
 
             data.setValue(line_number);
             break;
         }
         case kOpCode:
         {
-            if (!index.parent().isValid())
-            {
-                const auto block = blocks_.at(index.row());
-
-                if (block->row_type == RowType::kComment)
-                {
-                    const auto comment_block = std::static_pointer_cast<CommentBlock>(block);
+            // Code block label, comment, or instruction op code.
+            QString text;
 
-                    data.setValue(QString(comment_block->text.c_str()));
-                }
-                else if (block->row_type == RowType::kCode)
-                {
-                    const auto code_block = std::static_pointer_cast<InstructionBlock>(block);
-
-                    data.setValue(QString(code_block->token.token_text.c_str()));
-                }
-            }
-            else
+            if (!GetCachedDisplayText(parent_row, index.row(), kOpCode, text))
             {
-                const auto row = blocks_.at(index.parent().row())->instruction_lines.at(index.row());
-
-                if (row->row_type == RowType::kCode)
-                {
-                    const auto instruction = std::static_pointer_cast<InstructionRow>(row);
-
-                    data.setValue(QString(instruction->op_code_token.token_text.c_str()));
-                }
-                else if (row->row_type == RowType::kComment)
-                {
-                    const auto comment = std::static_pointer_cast<CommentRow>(row);
+                const std::string_view row_text = GetRowText(parent_row, index.row());
 
-                    data.setValue(QString(comment->text.c_str()));
-                }
+                text = QString::fromUtf8(row_text.data(), static_cast<qsizetype>(row_text.size()));
             }
 
+            data.setValue(text);
             break;
         }
         case kOperands:
         {
-            if (index.parent().isValid() && (blocks_.at(index.parent().row())->instruction_lines.at(index.row())->row_type == RowType::kCode))
+            if (parent_row != -1 && GetRowType(parent_row, index.row()) == RowType::kCode)
             {
-                const auto  instruction = std::static_pointer_cast<InstructionRow>(blocks_.at(index.parent().row())->instruction_lines.at(index.row()));
-                const auto& operand_token_groups = instruction->operand_tokens;
-                std::string operands_string      = "";
+                QString text;
 
-                for (size_t i = 0; i < operand_token_groups.size(); i++)
+                if (!GetCachedDisplayText(parent_row, index.row(), kOperands, text))
                 {
-                    const auto& operand_token_group = operand_token_groups.at(i);
-
-                    for (size_t j = 0; j < operand_token_group.size(); j++)
-                    {
-                        const std::string& arg = operand_token_group[j].token_text;
-                        operands_string += arg;
+                    std::string operands_string;
 
-                        if (j != operand_token_group.size() - 1)
-                        {
-                            operands_string += kOperandTokenSpaceStdString;
-                        }
-                    }
+                    GetRowOperandsText(parent_row, index.row(), operands_string);
 
-                    if (i != operand_token_groups.size() - 1)
-                    {
-                        operands_string += kOperandDelimiterStdString;
-                    }
+                    text = QString::fromStdString(operands_string);
                 }
 
-                data.setValue(QString(operands_string.c_str()));
+                data.setValue(text);
             }
             break;
         }
         case kPcAddress:
         {
-            if (index.parent().isValid() && (blocks_.at(index.parent().row())->instruction_lines.at(index.row())->row_type == RowType::kCode))
+            if (parent_row != -1 && GetRowType(parent_row, index.row()) == RowType::kCode)
             {
                 // Instruction line.
+                QString text;
 
-                const auto instruction = std::static_pointer_cast<InstructionRow>(blocks_.at(index.parent().row())->instruction_lines.at(index.row()));
+                if (!GetCachedDisplayText(parent_row, index.row(), kPcAddress, text))
+                {
+                    const std::string_view pc_address = GetRowPcAddress(parent_row, index.row());
+
+                    text = QString::fromUtf8(pc_address.data(), static_cast<qsizetype>(pc_address.size()));
+                }
 
-                data.setValue(QString(instruction->pc_address.c_str()));
+                data.setValue(text);
             }
 
             break;
         }
         case kBinaryRepresentation:
         {
-            if (index.parent().isValid() && (blocks_.at(index.parent().row())->instruction_lines.at(index.row())->row_type == RowType::kCode))
+            if (parent_row != -1 && GetRowType(parent_row, index.row()) == RowType::kCode)
             {
                 // Instruction line.
+                QString text;
+
+                if (!GetCachedDisplayText(parent_row, index.row(), kBinaryRepresentation, text))
+                {
+                    // Only the words are stored; format them for display.
+                    std::string     binary_representation;
+                    size_t          word_count = 0;
+                    const uint32_t* words      = GetRowWords(parent_row, index.row(), word_count);
+
+                    IsaInstructionEncoding::Format(words, word_count, binary_representation);
 
-                const auto instruction = std::static_pointer_cast<InstructionRow>(blocks_.at(index.parent().row())->instruction_lines.at(index.row()));
+                    text = QString::fromLatin1(binary_representation.data(), static_cast<qsizetype>(binary_representation.size()));
+                }
 
-                data.setValue(QString(instruction->binary_representation.c_str()));
+                data.setValue(text);
             }
 
             break;
@@ -426,24 +716,73 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
         // Store tokens for instructions.
         // Store nothing for comments.
 
-        if (!index.parent().isValid())
+        const int parent_row = GetParentRow(index);
+
+        if (parent_row == -1)
         {
             std::vector<Token> tokens;
 
-            const auto block = blocks_.at(index.row());
+            if (UsesRowStorage())
+            {
+                const auto& block = row_storage_.GetBlock(index.row());
 
-            if (block->row_type == RowType::kCode)
+                if (!block.is_comment)
+                {
+                    tokens.push_back(MakeToken(row_storage_, row_storage_.GetToken(block.label_token)));
+                }
+            }
+            else
             {
-                const auto code_block = std::static_pointer_cast<InstructionBlock>(block);
+                const auto block = blocks_.at(index.row());
+
+                if (block->row_type == RowType::kCode)
+                {
+                    const auto code_block = std::static_pointer_cast<InstructionBlock>(block);
 
-                tokens.push_back(code_block->token);
+                    tokens.push_back(code_block->token);
+                }
             }
 
             data.setValue(tokens);
         }
+        else if (UsesRowStorage())
+        {
+            const IsaRowStorage* row_storage = nullptr;
+            const auto&          row         = GetArenaRow(parent_row, index.row(), row_storage);
+
+            if (!row.is_comment)
+            {
+                if ((index.column() == kOpCode))
+                {
+                    std::vector<Token> tokens;
+
+                    tokens.push_back(MakeToken(*row_storage, row_storage->GetToken(row.op_code_token)));
+
+                    data.setValue(tokens);
+                }
+                else if ((index.column() == kOperands))
+                {
+                    std::vector<std::vector<Token>> operand_tokens(row.operand_count);
+
+                    for (uint32_t i = 0; i < row.operand_count; i++)
+                    {
+                        const auto& operand = row_storage->GetOperand(row.first_operand + i);
+
+                        operand_tokens[i].reserve(operand.token_count);
+
+                        for (uint32_t j = 0; j < operand.token_count; j++)
+                        {
+                            operand_tokens[i].push_back(MakeToken(*row_storage, row_storage->GetToken(operand.first_token + j)));
+                        }
+                    }
+
+                    data.setValue(operand_tokens);
+                }
+            }
+        }
         else
         {
-            const auto row = blocks_.at(index.parent().row())->instruction_lines.at(index.row());
+            const auto row = blocks_.at(parent_row)->instruction_lines.at(index.row());
 
             if (row->row_type == RowType::kCode)
             {
@@ -470,15 +809,9 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
     {
         bool is_code_block_label_branch_target = false;
 
-        if (!index.parent().isValid())
+        if (GetParentRow(index) == -1 && GetRowType(-1, index.row()) == RowType::kCode)
         {
-            const auto block = blocks_.at(index.row());
-
-            if (block->row_type == RowType::kCode)
-            {
-                const auto code_block             = std::static_pointer_cast<InstructionBlock>(block);
-                is_code_block_label_branch_target = !code_block->mapped_branch_instructions.empty();
-            }
+            is_code_block_label_branch_target = GetBranchInstructionCount(index.row()) != 0;
         }
 
         data.setValue(is_code_block_label_branch_target);
@@ -488,50 +821,38 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
     {
         QVector<QModelIndex> branch_label_indices;
 
+        const int parent_row = GetParentRow(index);
+
         if (index.column() == kOpCode)
         {
-            if (!index.parent().isValid())
+            if (parent_row == -1 && GetRowType(parent_row, index.row()) == RowType::kCode)
             {
-                const auto block = blocks_.at(index.row());
+                const size_t branch_instruction_count = GetBranchInstructionCount(index.row());
 
-                if (block->row_type == RowType::kCode)
-                {
-                    const auto code_block = std::static_pointer_cast<InstructionBlock>(block);
+                branch_label_indices.reserve(static_cast<qsizetype>(branch_instruction_count));
 
-                    for (const auto& mapped_branch_instruction : code_block->mapped_branch_instructions)
-                    {
-                        const int         label_code_block_index  = mapped_branch_instruction.first;
-                        const int         label_instruction_index = mapped_branch_instruction.second;
-                        const QModelIndex branch_label_index      = this->index(label_instruction_index, 0, this->index(label_code_block_index, 0));
-                        branch_label_indices.push_back(branch_label_index);
-                    }
+                for (size_t i = 0; i < branch_instruction_count; i++)
+                {
+                    const auto        mapped_branch_instruction = GetBranchInstruction(index.row(), i);
+                    const int         label_code_block_index    = mapped_branch_instruction.first;
+                    const int         label_instruction_index   = mapped_branch_instruction.second;
+                    const QModelIndex branch_label_index        = this->index(label_instruction_index, 0, this->index(label_code_block_index, 0));
+                    branch_label_indices.push_back(branch_label_index);
                 }
             }
         }
         else if (index.column() == kOperands)
         {
-            if (index.parent().isValid())
+            if (parent_row != -1)
             {
-                // Instruction line.
+                // Instruction line; check the first token in the first operand.
 
-                const auto row = blocks_.at(index.parent().row())->instruction_lines.at(index.row());
+                const int branch_target = GetBranchTarget(parent_row, index.row());
 
-                if (row->row_type == RowType::kCode)
+                if (branch_target != -1)
                 {
-                    const auto instruction = std::static_pointer_cast<const InstructionRow>(row);
-
-                    if (!instruction->operand_tokens.empty() && !instruction->operand_tokens.front().empty())
-                    {
-                        // Check the first token in the first operand.
-
-                        const auto& token = instruction->operand_tokens.front().front();
-
-                        if (token.type == TokenType::kBranchLabelType && token.start_register_index != -1)
-                        {
-                            const QModelIndex label_index = this->index(token.start_register_index, 0);
-                            branch_label_indices.push_back(label_index);
-                        }
-                    }
+                    const QModelIndex label_index = this->index(branch_target, 0);
+                    branch_label_indices.push_back(label_index);
                 }
             }
         }
@@ -543,15 +864,11 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
     {
         bool line_enabled = true;
 
-        if (index.parent().isValid())
-        {
-            const auto row = blocks_.at(index.parent().row())->instruction_lines.at(index.row());
+        const int parent_row = GetParentRow(index);
 
-            if (row->row_type == RowType::kCode)
-            {
-                const auto instruction = std::static_pointer_cast<InstructionRow>(row);
-                line_enabled           = instruction->enabled;
-            }
+        if (parent_row != -1)
+        {
+            line_enabled = GetRowEnabled(parent_row, index.row());
         }
 
         data.setValue(line_enabled);
@@ -559,18 +876,7 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
     }
     case kRowTypeRole:
     {
-        RowType row_type = RowType::kRowCount;
-
-        if (!index.parent().isValid())
-        {
-            const auto block = blocks_.at(index.row());
-            row_type         = block->row_type;
-        }
-        else
-        {
-            const auto row = blocks_.at(index.parent().row())->instruction_lines.at(index.row());
-            row_type       = row->row_type;
-        }
+        const RowType row_type = GetRowType(GetParentRow(index), index.row());
 
         data.setValue(row_type);
         break;
@@ -582,30 +888,24 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
             return data;
         }
 
-        const auto        binary_isa_string = index.siblingAtColumn(IsaItemModel::Columns::kBinaryRepresentation).data().toString().toStdString();
-        uint64_t          binary_isa        = 0;
-        std::stringstream string_stream;
-
-        string_stream << binary_isa_string;
-        string_stream >> std::hex >> binary_isa;
+        const int parent_row = GetParentRow(index);
 
-        amdisa::InstructionInfoBundle instruction_info_bundle;
-        std::string                   decode_error_message;
-
-        const bool instruction_decoded = (isa_decoder != nullptr) && isa_decoder->DecodeInstruction(binary_isa, instruction_info_bundle, decode_error_message);
-
-        if (!instruction_decoded)
+        if (parent_row == -1 || GetRowType(parent_row, index.row()) != RowType::kCode)
         {
             return data;
         }
-        else if (!instruction_info_bundle.bundle.empty())
-        {
-            const auto instruction_info = instruction_info_bundle.bundle.front();
 
-            data.setValue(instruction_info);
+        const uint64_t binary_isa = GetRowDecoderEncoding(parent_row, index.row());
 
-            return data;
+        // Usually decoded already by the pre-decode thread, so this is a lookup.
+        amdisa::InstructionInfo instruction_info;
+
+        if (isa_decoder_ != nullptr && isa_decoder_->Decode(binary_isa, instruction_info))
+        {
+            data.setValue(instruction_info);
         }
+
+        return data;
     }
     default:
     {
@@ -618,78 +918,206 @@ QVariant IsaItemModel::data(const QModelIndex& index, int role) const
 
 void IsaItemModel::CacheSizeHints()
 {
+    QTISAGUI_SCOPED_TIMER(kCacheSizeHints);
+
     column_widths_.fill(0);
+    column_character_counts_.fill(0);
     line_number_corresponding_indices_.clear();
+    block_line_numbers_.clear();
+    InvalidateDerivedState(false);
 
-    const uint32_t line_number = (!blocks_.empty() && !blocks_.back()->instruction_lines.empty()) ? blocks_.back()->instruction_lines.back()->line_number : 0;
-    const QString  max_line_number                  = QString::number(line_number);
-    const qreal    padding_length                   = static_cast<qreal>(kColumnPadding.size());
-    const qreal    max_line_number_length           = padding_length + static_cast<qreal>(max_line_number.size());
-    qreal          max_pc_address_length            = 0;
-    qreal          max_op_code_length               = 0;
-    qreal          max_operand_length               = 0;
-    qreal          max_binary_representation_length = 0;
-
-    if (blocks_.empty())
-    {
-        return;
-    }
+    virtual_line_count_ = 0;
 
-    int code_block_index = 0;
+    const bool use_arena  = UsesRowStorage();
+    const bool is_virtual = storage_mode_ == StorageMode::kVirtual;
+    uint32_t   line_number = 0;
 
-    for (auto& code_block : blocks_)
+    if (use_arena)
     {
-        line_number_corresponding_indices_.emplace_back(-1, code_block_index);
+        const size_t block_count = row_storage_.GetBlockCount();
 
-        int instruction_index = 0;
-
-        for (auto instruction : code_block->instruction_lines)
+        if (block_count != 0)
         {
-            line_number_corresponding_indices_.emplace_back(code_block_index, instruction_index++);
+            const int last_block_row = static_cast<int>(block_count) - 1;
+            const int last_row_count = rowCount(index(last_block_row, 0));
 
-            if (instruction->row_type == RowType::kComment)
+            if (last_row_count != 0)
             {
-                // Don't force comments to fit in the op code column.
-                continue;
+                line_number = GetRowLineNumber(last_block_row, last_row_count - 1);
             }
+        }
+    }
+    else
+    {
+        line_number = (!blocks_.empty() && !blocks_.back()->instruction_lines.empty()) ? blocks_.back()->instruction_lines.back()->line_number : 0;
+    }
 
-            const auto instruction_line = std::static_pointer_cast<InstructionRow>(instruction);
+    const QString max_line_number                  = QString::number(line_number);
+    const qreal   padding_length                   = static_cast<qreal>(kColumnPadding.size());
+    const qreal   max_line_number_length           = padding_length + static_cast<qreal>(max_line_number.size());
+    qreal         max_pc_address_length            = 0;
+    qreal         max_op_code_length               = 0;
+    qreal         max_operand_length               = 0;
+    qreal         max_binary_representation_length = 0;
 
-            max_op_code_length    = std::max(max_op_code_length, static_cast<qreal>(instruction_line->op_code_token.token_text.size()));
-            max_pc_address_length = std::max(max_pc_address_length, static_cast<qreal>(instruction_line->pc_address.length()));
+    if ((use_arena && row_storage_.GetBlockCount() == 0) || (!use_arena && blocks_.empty()))
+    {
+        return;
+    }
 
-            std::string operands;
+    if (use_arena)
+    {
+        // Measure the operands without joining them into a string.
+        auto measure_row = [&](const IsaRowStorage& row_storage, const IsaRowStorage::RowRecord& row) {
+            if (row.is_comment)
+            {
+                // Don't force comments to fit in the op code column.
+                return;
+            }
 
-            const auto number_operand_groups = instruction_line->operand_tokens.size();
+            size_t operands_length = 0;
 
-            for (size_t i = 0; i < number_operand_groups; i++)
+            for (uint32_t i = 0; i < row.operand_count; i++)
             {
-                const auto& operand_group            = instruction_line->operand_tokens.at(i);
-                const auto  number_operands_in_group = operand_group.size();
+                const auto& operand = row_storage.GetOperand(row.first_operand + i);
 
-                for (size_t j = 0; j < number_operands_in_group; j++)
+                for (uint32_t j = 0; j < operand.token_count; j++)
                 {
-                    const auto& operand = operand_group.at(j);
+                    operands_length += row_storage.GetTokenText(row_storage.GetToken(operand.first_token + j)).size();
+                }
+
+                if (operand.token_count > 1)
+                {
+                    operands_length += (operand.token_count - 1) * kOperandTokenSpaceStdString.size();
+                }
+            }
+
+            if (row.operand_count > 1)
+            {
+                operands_length += (row.operand_count - 1) * kOperandDelimiterStdString.size();
+            }
+
+            max_op_code_length               = std::max(max_op_code_length, static_cast<qreal>(row_storage.GetRowText(row).size()));
+            max_pc_address_length            = std::max(max_pc_address_length, static_cast<qreal>(row.pc_address.length));
+            max_operand_length               = std::max(max_operand_length, static_cast<qreal>(operands_length));
+            max_binary_representation_length =
+                std::max(max_binary_representation_length, static_cast<qreal>(IsaInstructionEncoding::GetFormattedLength(row.word_count)));
+        };
+
+        const uint32_t block_count        = static_cast<uint32_t>(row_storage_.GetBlockCount());
+        uint32_t       line_count         = 0;
+        size_t         measured_row_count = 0;
+
+        if (!is_virtual)
+        {
+            line_number_corresponding_indices_.reserve(row_storage_.GetBlockCount() + row_storage_.GetRowCount());
+        }
+
+        block_line_numbers_.reserve(row_storage_.GetBlockCount());
+
+        for (uint32_t block_index = 0; block_index < block_count; block_index++)
+        {
+            const uint32_t row_count = static_cast<uint32_t>(rowCount(index(static_cast<int>(block_index), 0)));
 
-                    operands += operand.token_text;
+            block_line_numbers_.push_back(line_count);
+            line_count += 1 + row_count;
 
-                    if (j < number_operands_in_group - 1)
+            if (is_virtual)
+            {
+                // Parsing every row would defeat the purpose of keeping them in the file; the first rows have to do.
+                for (uint32_t row_index = 0; row_index < row_count && measured_row_count < kVirtualMeasuredRowCount; row_index++)
+                {
+                    if (!virtual_rows_.IsComment(block_index, row_index))
                     {
-                        operands += kOperandTokenSpaceStdString;
+                        const IsaRowStorage* row_storage = nullptr;
+                        const auto&          row         = GetArenaRow(static_cast<int>(block_index), static_cast<int>(row_index), row_storage);
+
+                        measure_row(*row_storage, row);
+                        measured_row_count++;
                     }
                 }
 
-                if (i < number_operand_groups - 1)
+                continue;
+            }
+
+            line_number_corresponding_indices_.emplace_back(-1, block_index);
+
+            for (uint32_t row_index = 0; row_index < row_count; row_index++)
+            {
+                line_number_corresponding_indices_.emplace_back(block_index, row_index);
+
+                measure_row(row_storage_, row_storage_.GetRow(block_index, row_index));
+            }
+        }
+
+        if (is_virtual)
+        {
+            virtual_line_count_ = static_cast<int>(line_count);
+        }
+    }
+    else
+    {
+        // Applications fill blocks_ themselves; intern the text of any tokens they made without going through ParseSelectableTokens.
+        InternBlockTokens(false);
+
+        int code_block_index = 0;
+
+        for (auto& code_block : blocks_)
+        {
+            block_line_numbers_.push_back(static_cast<uint32_t>(line_number_corresponding_indices_.size()));
+            line_number_corresponding_indices_.emplace_back(-1, code_block_index);
+
+            int instruction_index = 0;
+
+            for (auto instruction : code_block->instruction_lines)
+            {
+                line_number_corresponding_indices_.emplace_back(code_block_index, instruction_index++);
+
+                if (instruction->row_type == RowType::kComment)
+                {
+                    // Don't force comments to fit in the op code column.
+                    continue;
+                }
+
+                const auto instruction_line = std::static_pointer_cast<InstructionRow>(instruction);
+
+                max_op_code_length    = std::max(max_op_code_length, static_cast<qreal>(instruction_line->op_code_token.token_text.size()));
+                max_pc_address_length = std::max(max_pc_address_length, static_cast<qreal>(instruction_line->pc_address.length()));
+
+                std::string operands;
+
+                const auto number_operand_groups = instruction_line->operand_tokens.size();
+
+                for (size_t i = 0; i < number_operand_groups; i++)
                 {
-                    operands += kOperandDelimiterStdString;
+                    const auto& operand_group            = instruction_line->operand_tokens.at(i);
+                    const auto  number_operands_in_group = operand_group.size();
+
+                    for (size_t j = 0; j < number_operands_in_group; j++)
+                    {
+                        const auto& operand = operand_group.at(j);
+
+                        operands += operand.token_text;
+
+                        if (j < number_operands_in_group - 1)
+                        {
+                            operands += kOperandTokenSpaceStdString;
+                        }
+                    }
+
+                    if (i < number_operand_groups - 1)
+                    {
+                        operands += kOperandDelimiterStdString;
+                    }
                 }
+
+                max_operand_length = std::max(max_operand_length, static_cast<qreal>(operands.size()));
+                max_binary_representation_length = std::max(max_binary_representation_length,
+                                                            static_cast<qreal>(IsaInstructionEncoding::GetFormattedLength(instruction_line->words.size())));
             }
 
-            max_operand_length               = std::max(max_operand_length, static_cast<qreal>(operands.size()));
-            max_binary_representation_length = std::max(max_binary_representation_length, static_cast<qreal>(instruction_line->binary_representation.size()));
+            code_block_index++;
         }
-
-        code_block_index++;
     }
 
     max_pc_address_length += padding_length;
@@ -697,17 +1125,27 @@ void IsaItemModel::CacheSizeHints()
     max_operand_length += padding_length;
     max_binary_representation_length += padding_length;
 
-    const uint32_t line_number_width           = static_cast<uint32_t>(std::ceil(max_line_number_length * fixed_font_character_width_));
-    const uint32_t pc_address_width            = static_cast<uint32_t>(std::ceil(max_pc_address_length * fixed_font_character_width_));
-    const uint32_t op_code_width               = static_cast<uint32_t>(std::ceil(max_op_code_length * fixed_font_character_width_));
-    const uint32_t operand_width               = static_cast<uint32_t>(std::ceil(max_operand_length * fixed_font_character_width_));
-    const uint32_t binary_representation_width = static_cast<uint32_t>(std::ceil(max_binary_representation_length * fixed_font_character_width_));
+    column_character_counts_[kLineNumber]           = max_line_number_length;
+    column_character_counts_[kPcAddress]            = max_pc_address_length;
+    column_character_counts_[kOpCode]               = max_op_code_length;
+    column_character_counts_[kOperands]             = max_operand_length;
+    column_character_counts_[kBinaryRepresentation] = max_binary_representation_length;
+
+    UpdateColumnWidths();
+
+    BuildRowIndices();
+}
+
+void IsaItemModel::BuildRowIndices()
+{
+    BuildRegisterIndex();
+
+    if (display_text_cache_enabled_)
+    {
+        BuildDisplayTextCache();
+    }
 
-    column_widths_[kLineNumber]           = line_number_width;
-    column_widths_[kPcAddress]            = pc_address_width;
-    column_widths_[kOpCode]               = op_code_width;
-    column_widths_[kOperands]             = operand_width;
-    column_widths_[kBinaryRepresentation] = binary_representation_width;
+    StartPredecodeThread();
 }
 
 QSize IsaItemModel::ColumnSizeHint(int column_index, IsaTreeView* tree) const
@@ -733,32 +1171,95 @@ void IsaItemModel::SetFixedFont(const QFont& fixed_font, IsaTreeView* tree)
 
     fixed_font_character_width_ = font_metrics.horizontalAdvance('T');
     fixed_font_character_width  = fixed_font_character_width_;
+
+    // Parsed virtual rows have their hit boxes in the old font.
+    virtual_rows_.ClearParsedRows();
+
+    // The widest text of every column is known already; only its width in the new font has to be worked out.
+    UpdateColumnWidths();
+}
+
+void IsaItemModel::UpdateColumnWidths()
+{
+    for (int column = 0; column < kColumnCount; column++)
+    {
+        column_widths_[column] = static_cast<uint32_t>(std::ceil(column_character_counts_[column] * fixed_font_character_width_));
+    }
 }
 
 void IsaItemModel::SetArchitecture(amdisa::GpuArchitecture architecture, bool load_isa_spec)
 {
-    if (load_isa_spec)
+    std::shared_ptr<IsaArchitectureDecoder> decoder;
+
+    if (decode_manager_ != nullptr)
+    {
+        // The client's decode manager is initialized already.
+        decoder = std::make_shared<IsaArchitectureDecoder>(decode_manager_->GetDecoder(architecture));
+    }
+    else if (load_isa_spec)
     {
-        LoadIsaSpec(architecture);
+        const std::string isa_spec_path = GetIsaSpecPath(architecture);
 
-        if (!is_decoder_initialized)
+        if (isa_spec_path.empty())
         {
             return;
         }
-    }
 
-    if (decode_manager_ == nullptr)
+        // Let an isa spec still being parsed finish when the application is destroyed, before static destructors run.
+        static const bool wait_for_loading_registered = []() {
+            qAddPostRoutine(&IsaDecoderRegistry::WaitForLoading);
+            return true;
+        }();
+        Q_UNUSED(wait_for_loading_registered);
+
+        // Parsed on a background thread, and only once for all models of the same architecture.
+        decoder = IsaDecoderRegistry::Acquire(architecture, isa_spec_path);
+    }
+    else
     {
-        return;
+        decoder = IsaDecoderRegistry::Find(architecture);
+
+        if (decoder == nullptr)
+        {
+            return;
+        }
     }
 
-    isa_decoder = decode_manager_->GetDecoder(architecture);
+    StopPredecodeThread();
 
-    emit ArchitectureChanged(isa_decoder != nullptr);
+    isa_decoder_           = decoder;
+    isa_decoder_announced_ = false;
+
+    // Announce now if the decoder is ready; otherwise the pre-decode thread announces it once the isa spec is loaded.
+    if (isa_decoder_->IsLoaded())
+    {
+        isa_decoder_announced_ = true;
+
+        emit ArchitectureChanged(isa_decoder_->HasDecoder());
+    }
+
+    StartPredecodeThread();
 }
 
 QModelIndex IsaItemModel::GetLineNumberModelIndex(int line_number)
 {
+    if (storage_mode_ == StorageMode::kVirtual)
+    {
+        if (line_number < 0 || line_number >= virtual_line_count_ || block_line_numbers_.empty())
+        {
+            return QModelIndex();
+        }
+
+        // Lines are not mapped one by one; find the block of the line instead.
+        const auto block_iter = std::upper_bound(block_line_numbers_.begin(), block_line_numbers_.end(), static_cast<uint32_t>(line_number)) - 1;
+        const int  block_row  = static_cast<int>(block_iter - block_line_numbers_.begin());
+        const int  row        = line_number - static_cast<int>(*block_iter) - 1;
+
+        const QModelIndex parent_index = index(block_row, 0);
+
+        return (row == -1) ? parent_index : index(row, 0, parent_index);
+    }
+
     if (line_number < 0 || line_number >= static_cast<int>(line_number_corresponding_indices_.size()))
     {
         return QModelIndex();
@@ -773,439 +1274,3086 @@ QModelIndex IsaItemModel::GetLineNumberModelIndex(int line_number)
     return index(child_row, 0, parent_index);
 }
 
-std::string IsaItemModel::TrimStr(std::string input_string)
+IsaItemModel::RowType IsaItemModel::GetRowType(const QModelIndex& index) const
 {
-    static const char* kSpecialChars = " \t\n\r\f\v";
+    if (!index.isValid())
+    {
+        return RowType::kCode;
+    }
 
-    input_string.erase(input_string.find_last_not_of(kSpecialChars) + 1);
-    input_string.erase(0, input_string.find_first_not_of(kSpecialChars));
+    return GetRowType(GetParentRow(index), index.row());
+}
 
-    return input_string;
+int IsaItemModel::GetLineNumber(const QModelIndex& index) const
+{
+    if (!index.isValid())
+    {
+        return -1;
+    }
+
+    return GetLineNumber(GetParentRow(index), index.row());
 }
 
-void IsaItemModel::Split(std::string line, std::string delimiter, std::vector<std::string>& list)
+int IsaItemModel::GetLineNumber(int parent_row, int row) const
 {
-    size_t      pos = 0;
-    std::string token;
+    const int block_row = (parent_row == -1) ? row : parent_row;
 
-    while ((pos = line.find(delimiter)) != std::string::npos)
+    if (block_row < 0 || static_cast<size_t>(block_row) >= block_line_numbers_.size())
     {
-        token = line.substr(0, pos);
-        list.push_back(TrimStr(token));
-        line.erase(0, pos + delimiter.length());
+        return -1;
     }
 
-    list.push_back(TrimStr(line));
+    // A block's rows are the lines right after the block.
+    return static_cast<int>(block_line_numbers_[block_row]) + ((parent_row == -1) ? 0 : row + 1);
 }
 
-void IsaItemModel::ClearBranchInstructionMapping()
+bool IsaItemModel::SearchLines(const QString&            text,
+                               const std::vector<int>&   columns,
+                               std::vector<int>&         line_numbers,
+                               IsaSearchIndex::MatchMode mode)
 {
-    for (auto block : blocks_)
-    {
-        if (block->row_type != RowType::kCode)
-        {
-            continue;
-        }
+    line_numbers.clear();
 
-        auto code_block = std::static_pointer_cast<InstructionBlock>(block);
+    IsaSearchIndex::Query query;
+    std::vector<size_t>   search_columns;
 
-        code_block->mapped_branch_instructions.clear();
+    if (!PrepareSearch(text, columns, mode, query, search_columns))
+    {
+        return false;
     }
+
+    std::vector<uint32_t> lines;
+
+    search_index_.Search(query, search_columns, lines);
+
+    line_numbers.assign(lines.begin(), lines.end());
+
+    search_text_ = text;
+
+    return true;
 }
 
-void IsaItemModel::MapBlocksToBranchInstructions()
+bool IsaItemModel::BeginSearch(const QString& text, const std::vector<int>& columns, IsaSearchIndex::MatchMode mode, int thread_count)
 {
-    if (blocks_.empty())
+    auto                query = std::make_shared<IsaSearchIndex::Query>();
+    std::vector<size_t> search_columns;
+
+    if (!PrepareSearch(text, columns, mode, *query, search_columns))
     {
-        return;
+        return false;
     }
 
-    ClearBranchInstructionMapping();
+    search_index_.BeginResults(*query, search_columns);
 
-    code_block_label_to_index_.clear();
+    search_text_ = text;
 
-    // Build map of code block label -> code block index.
+    const uint32_t line_count = search_index_.GetLineCount();
 
-    for (size_t block_index = 0; block_index < blocks_.size(); block_index++)
+    search_chunk_count_ = (line_count + kSearchChunkLineCount - 1) / kSearchChunkLineCount;
+
+    if (search_chunk_count_ == 0)
     {
-        const auto block = blocks_.at(block_index);
+        search_index_.EndResults();
 
-        if (block->row_type != RowType::kCode)
-        {
-            continue;
-        }
+        emit SearchUpdated(true);
 
-        const auto code_block                                    = std::static_pointer_cast<const InstructionBlock>(block);
-        code_block_label_to_index_[code_block->token.token_text] = code_block->position;
+        return true;
     }
 
-    // Use map to assign block's their corresponding branch instructions and vice versa.
-
-    for (size_t block_index = 0; block_index < blocks_.size(); block_index++)
+    if (thread_count <= 0)
     {
-        const auto block = blocks_.at(block_index);
+        thread_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
 
-        if (block->row_type != RowType::kCode)
-        {
-            continue;
-        }
+    thread_count = std::min(thread_count, static_cast<int>(search_chunk_count_));
 
-        const auto code_block = std::static_pointer_cast<InstructionBlock>(block);
+    search_canceled_             = false;
+    search_next_chunk_           = 0;
+    search_next_published_chunk_ = 0;
+    search_generation_++;
 
-        for (size_t instruction_index = 0; instruction_index < code_block->instruction_lines.size(); instruction_index++)
-        {
-            const auto row = code_block->instruction_lines.at(instruction_index);
+    const uint64_t generation  = search_generation_;
+    const size_t   chunk_count = search_chunk_count_;
 
-            if (row->row_type != RowType::kCode)
+    // Each worker thread keeps taking the next chunk until there is none left; the matches are posted to the GUI thread,
+    // which adds them to the index in line order, so the lines found so far are always the first matches.
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        search_threads_.emplace_back([this, generation, chunk_count, line_count, query, search_columns]() {
+            while (!search_canceled_)
             {
-                continue;
-            }
+                const size_t chunk_index = search_next_chunk_++;
 
-            auto       instruction  = std::static_pointer_cast<InstructionRow>(row);
-            const auto op_code_text = instruction->op_code_token.token_text;
-            const bool is_branch =
-                ((op_code_text.find(kUnconditionalBranchString) != std::string::npos) || (op_code_text.find(kConditionalBranchString) != std::string::npos));
+                if (chunk_index >= chunk_count)
+                {
+                    break;
+                }
 
-            if (is_branch && (!instruction->operand_tokens.empty()) && (!instruction->operand_tokens.front().empty()))
-            {
-                // Assume branch target is first operand of first operand group.
+                const uint32_t first_line = static_cast<uint32_t>(chunk_index * kSearchChunkLineCount);
+                const uint32_t end_line   = static_cast<uint32_t>(std::min(first_line + kSearchChunkLineCount, static_cast<size_t>(line_count)));
 
-                const auto map_iter = code_block_label_to_index_.find(instruction->operand_tokens.front().front().token_text);
+                auto results = std::make_shared<IsaSearchIndex::Results>();
 
-                if (map_iter != code_block_label_to_index_.end())
                 {
-                    const auto branch_target_block_index = map_iter->second;
-                    const auto branch_target_block       = blocks_.at(branch_target_block_index);
-                    auto       branch_target_code_block  = std::static_pointer_cast<IsaItemModel::InstructionBlock>(blocks_.at(branch_target_block_index));
+                    QTISAGUI_SCOPED_TIMER(kSearchChunk);
 
-                    // Code block remembers which branch instruction targeted it.
-                    branch_target_code_block->mapped_branch_instructions.emplace_back(
-                        std::make_pair(static_cast<uint32_t>(block_index), static_cast<uint32_t>(instruction_index)));
+                    search_index_.SearchRange(*query, search_columns, first_line, end_line, *results);
 
-                    // Branch instruction remembers which code block is its target.
-                    instruction->operand_tokens.front().front().start_register_index = branch_target_block_index;
+                    QTISAGUI_COUNT_ITEMS(kSearchChunk, results->lines.size());
                 }
+
+                QMetaObject::invokeMethod(
+                    this, [this, generation, chunk_index, results]() { PublishSearchResults(generation, chunk_index, results); }, Qt::QueuedConnection);
             }
-        }
+        });
     }
 
-    code_block_label_to_index_.clear();
+    return true;
 }
 
-void IsaItemModel::ParseSelectableTokens(const std::string&                             op_code,
-                                         IsaItemModel::Token&                           op_code_token,
-                                         const std::vector<std::string>&                operands,
-                                         std::vector<std::vector<IsaItemModel::Token>>& selectable_tokens,
-                                         qreal                                          fixed_character_width) const
+void IsaItemModel::CancelSearch()
 {
-    // Op code; should be a single token and always selectable.
-
-    qreal token_width = fixed_character_width * static_cast<qreal>(op_code.size());
+    if (search_threads_.empty())
+    {
+        return;
+    }
 
-    op_code_token.type             = IsaItemModel::TokenType::kTypeCount;
-    op_code_token.is_selectable    = true;
-    op_code_token.token_text       = op_code;
-    op_code_token.x_position_start = fixed_character_width * static_cast<qreal>(IsaItemModel::kOpCodeColumnIndent.size());
-    op_code_token.x_position_end   = op_code_token.x_position_start + token_width;
+    StopSearchThreads();
+}
 
-    bool is_branch_instruction = false;
+bool IsaItemModel::GetSearchMatches(const QString&   text,
+                                    int              line_number,
+                                    int              column,
+                                    const uint32_t*& match_starts,
+                                    const uint32_t*& match_lengths,
+                                    size_t&          match_count) const
+{
+    match_starts  = nullptr;
+    match_lengths = nullptr;
+    match_count   = 0;
 
-    if ((op_code.find(IsaItemModel::kUnconditionalBranchString) != std::string::npos) ||
-        (op_code.find(IsaItemModel::kConditionalBranchString) != std::string::npos))
+    // The index forgets its matches whenever the rows of this model change.
+    if (text.isEmpty() || line_number < 0 || column < 0 || text != search_text_)
     {
-        is_branch_instruction = true;
+        return false;
     }
 
-    // Operands; determine which tokens can be selected.
+    return search_index_.GetMatches(static_cast<uint32_t>(line_number), static_cast<size_t>(column), match_starts, match_lengths, match_count);
+}
 
-    qreal token_start_x = 0;
-    qreal token_end_x   = 0;
+int IsaItemModel::AddMetric(const QString& name)
+{
+    return static_cast<int>(metric_columns_.AddMetric(name.toStdString()));
+}
 
-    for (const auto& operand : operands)
+void IsaItemModel::RemoveMetrics()
+{
+    if (metric_columns_.GetMetricCount() == 0)
     {
-        std::vector<std::string>         tokens;
-        std::vector<IsaItemModel::Token> operand_tokens;
-
-        Split(operand, " ", tokens);
-
-        for (const auto& token : tokens)
-        {
-            IsaItemModel::Token selectable_token;
-            selectable_token.is_selectable = false;
-            selectable_token.token_text    = token;
+        return;
+    }
 
-            selectable_token.type = IsaItemModel::TokenType::kTypeCount;
+    metric_columns_.Clear();
 
-            if (is_branch_instruction)
-            {
-                // Identify this operand token simply as the target of a branch instruction.
+    EmitLineBackgroundChanged(0, GetLineCount() - 1);
 
-                selectable_token.type = IsaItemModel::TokenType::kBranchLabelType;
-            }
-            else
-            {
-                const QString token_string      = token.c_str();
-                const int     token_string_size = static_cast<int>(token.size());
+    emit MetricValuesChanged(-1, 0, GetLineCount() - 1, true);
+}
 
-                // Single registers.
-                const auto s_register_expression_match = kScalarRegisterExpression.match(token_string);
-                const auto v_register_expression_match = kVectorRegisterExpression.match(token_string);
+QString IsaItemModel::GetMetricName(int metric) const
+{
+    if (metric < 0 || metric >= GetMetricCount())
+    {
+        return QString();
+    }
 
-                // Single register that is the start of a pair of registers.
-                const auto s_register_pair_start_expression_match = kScalarPairStartRegisterExpression.match(token_string);
-                const auto v_register_pair_start_expression_match = kVectorPairStartRegisterExpression.match(token_string);
+    return QString::fromStdString(metric_columns_.GetMetricName(static_cast<size_t>(metric)));
+}
 
-                // Single register that is the end of a pair of registers.
-                const auto s_register_pair_end_expression_match = kScalarPairEndRegisterExpression.match(token_string);
-                const auto v_register_pair_end_expression_match = kVectorPairEndRegisterExpression.match(token_string);
+void IsaItemModel::SetMetricValues(int metric, int first_line_number, const std::vector<float>& values)
+{
+    if (metric < 0 || metric >= GetMetricCount() || first_line_number < 0 || values.empty())
+    {
+        return;
+    }
 
-                // Range of registers.
-                const auto s_register_range_expression_match = kScalarRegisterRangeExpression.match(token_string);
-                const auto v_register_range_expression_match = kVectorRegisterRangeExpression.match(token_string);
+    QTISAGUI_SCOPED_TIMER(kSetMetricValues);
+    QTISAGUI_COUNT_ITEMS(kSetMetricValues, values.size());
 
-                // Constants.
-                const auto constant_expression_match = kConstantExpression.match(token_string);
+    const bool range_changed = metric_columns_.SetValues(static_cast<size_t>(metric), static_cast<size_t>(first_line_number), values.data(), values.size());
+    const int  last_line     = first_line_number + static_cast<int>(values.size()) - 1;
 
-                // Attempt to exact match single registers.
-                bool is_scalar_register = s_register_expression_match.hasMatch() && s_register_expression_match.capturedStart() == 0 &&
-                                          s_register_expression_match.capturedEnd() == token_string_size;
+    // A new range changes the intensity of every line, but views repaint whole viewports for that; see MetricValuesChanged.
+    EmitLineBackgroundChanged(first_line_number, last_line);
 
-                bool is_vector_register = v_register_expression_match.hasMatch() && v_register_expression_match.capturedStart() == 0 &&
-                                          v_register_expression_match.capturedEnd() == token_string_size;
+    emit MetricValuesChanged(metric, first_line_number, last_line, range_changed);
+}
 
-                if (!is_scalar_register)
-                {
-                    is_scalar_register |= s_register_pair_start_expression_match.hasMatch() && s_register_pair_start_expression_match.capturedStart() == 0 &&
-                                          s_register_pair_start_expression_match.capturedEnd() == token_string_size;
-                }
+void IsaItemModel::ClearMetricValues()
+{
+    if (metric_columns_.GetMetricCount() == 0)
+    {
+        return;
+    }
 
-                if (!is_vector_register)
-                {
-                    is_vector_register |= v_register_pair_start_expression_match.hasMatch() && v_register_pair_start_expression_match.capturedStart() == 0 &&
-                                          v_register_pair_start_expression_match.capturedEnd() == token_string_size;
-                }
+    metric_columns_.ClearValues();
 
-                if (!is_scalar_register)
-                {
-                    is_scalar_register |= s_register_pair_end_expression_match.hasMatch() && s_register_pair_end_expression_match.capturedStart() == 0 &&
-                                          s_register_pair_end_expression_match.capturedEnd() == token_string_size;
-                }
+    EmitLineBackgroundChanged(0, GetLineCount() - 1);
 
-                if (!is_vector_register)
-                {
-                    is_vector_register |= v_register_pair_end_expression_match.hasMatch() && v_register_pair_end_expression_match.capturedStart() == 0 &&
-                                          v_register_pair_end_expression_match.capturedEnd() == token_string_size;
-                }
+    for (int metric = 0; metric < GetMetricCount(); metric++)
+    {
+        emit MetricValuesChanged(metric, 0, GetLineCount() - 1, true);
+    }
+}
 
-                // Attempt to exact match register ranges.
-                const bool is_scalar_register_range = s_register_range_expression_match.hasMatch() && s_register_range_expression_match.capturedStart() == 0 &&
-                                                      s_register_range_expression_match.capturedEnd() == token_string_size;
+void IsaItemModel::SetMetricRange(int metric, bool fixed, float minimum, float maximum)
+{
+    if (metric < 0 || metric >= GetMetricCount())
+    {
+        return;
+    }
 
-                const bool is_vector_register_range = v_register_range_expression_match.hasMatch() && v_register_range_expression_match.capturedStart() == 0 &&
-                                                      v_register_range_expression_match.capturedEnd() == token_string_size;
+    metric_columns_.SetRange(static_cast<size_t>(metric), fixed, minimum, maximum);
 
-                // Attempt to exact match constants.
-                const bool is_constant = constant_expression_match.hasMatch() && constant_expression_match.capturedStart() == 0 &&
-                                         constant_expression_match.capturedEnd() == token_string_size;
+    emit MetricValuesChanged(metric, 0, GetLineCount() - 1, true);
+}
 
-                if (is_scalar_register || is_vector_register || is_scalar_register_range || is_vector_register_range || is_constant)
-                {
-                    // Single register, range of registers, or a constant.
+void IsaItemModel::GetMetricRange(int metric, float& minimum, float& maximum) const
+{
+    minimum = 0.0f;
+    maximum = 0.0f;
 
-                    selectable_token.is_selectable = true;
-                }
+    if (metric >= 0)
+    {
+        metric_columns_.GetRange(static_cast<size_t>(metric), minimum, maximum);
+    }
+}
 
-                if (is_scalar_register || is_vector_register)
-                {
-                    // Single register.
+float IsaItemModel::GetMetricValue(int metric, int line_number) const
+{
+    if (metric < 0 || line_number < 0)
+    {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
 
-                    std::string register_string = token;
+    return metric_columns_.GetValue(static_cast<size_t>(metric), static_cast<size_t>(line_number));
+}
 
-                    if (is_scalar_register)
-                    {
-                        // Remove 's', '-s', '|s', or '[s'.
-                        const auto register_character_position = register_string.find("s");
-                        register_string                        = register_string.substr(register_character_position + 1);
-                    }
-                    else
-                    {
-                        // Remove 'v', '-v', '|v', or '[v'.
-                        const auto register_character_position = register_string.find("v");
-                        register_string                        = register_string.substr(register_character_position + 1);
-                    }
+float IsaItemModel::GetMetricMaximum(int metric, int first_line_number, int end_line_number) const
+{
+    if (metric < 0 || first_line_number < 0 || end_line_number <= first_line_number)
+    {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
 
-                    selectable_token.start_register_index = -1;
-                    selectable_token.end_register_index   = -1;
+    return metric_columns_.GetMaximumValue(static_cast<size_t>(metric), static_cast<size_t>(first_line_number), static_cast<size_t>(end_line_number));
+}
 
-                    if (!register_string.empty() && std::isdigit(register_string.front()))
-                    {
-                        const auto register_number = std::stoi(register_string);
+float IsaItemModel::GetMetricIntensity(int metric, float value) const
+{
+    if (metric < 0)
+    {
+        return -1.0f;
+    }
 
-                        selectable_token.start_register_index = register_number;
+    return metric_columns_.GetIntensity(static_cast<size_t>(metric), value);
+}
 
-                        selectable_token.type =
-                            is_scalar_register ? IsaItemModel::TokenType::kScalarRegisterType : IsaItemModel::TokenType::kVectorRegisterType;
-                    }
-                    else
-                    {
-                        selectable_token.is_selectable = false;
-                    }
-                }
-                else if (is_scalar_register_range || is_vector_register_range)
-                {
-                    // Range of registers.
+void IsaItemModel::EmitLineBackgroundChanged(int first_line_number, int last_line_number)
+{
+    const int line_count = GetLineCount();
 
-                    selectable_token.type =
-                        is_scalar_register_range ? IsaItemModel::TokenType::kScalarRegisterType : IsaItemModel::TokenType::kVectorRegisterType;
+    last_line_number = std::min(last_line_number, line_count - 1);
 
-                    std::string register_range_string = token;
+    if (block_line_numbers_.empty() || first_line_number > last_line_number)
+    {
+        return;
+    }
 
-                    register_range_string.pop_back();   // remove ']''
-                    register_range_string.erase(0, 2);  // remove 's[' or 'v['
+    const QList<int> roles       = {Qt::BackgroundRole};
+    const int        last_column = columnCount() - 1;
 
-                    std::vector<std::string> register_indices;
+    // Find the block of the first line; every block after it starts at the next block line number.
+    const auto block_iter = std::upper_bound(block_line_numbers_.begin(), block_line_numbers_.end(), static_cast<uint32_t>(first_line_number));
+    size_t     block_row  = (block_iter == block_line_numbers_.begin()) ? 0 : static_cast<size_t>(block_iter - block_line_numbers_.begin()) - 1;
+    int        line       = std::max(first_line_number, static_cast<int>(block_line_numbers_[block_row]));
 
-                    Split(register_range_string, ":", register_indices);
+    while (line <= last_line_number && block_row < block_line_numbers_.size())
+    {
+        const int block_line = static_cast<int>(block_line_numbers_[block_row]);
+        const int end_line   = (block_row + 1 < block_line_numbers_.size()) ? static_cast<int>(block_line_numbers_[block_row + 1]) : line_count;
 
-                    const auto register_start = std::stoi(register_indices[0]);
-                    const auto register_end   = std::stoi(register_indices[1]);
+        const QModelIndex block_index = index(static_cast<int>(block_row), 0);
 
-                    selectable_token.start_register_index = register_start;
-                    selectable_token.end_register_index   = register_end;
-                }
-                else if (is_constant)
-                {
-                    // Constant.
+        if (line == block_line)
+        {
+            emit dataChanged(block_index, block_index.siblingAtColumn(last_column), roles);
+            line++;
+        }
 
-                    selectable_token.type = IsaItemModel::TokenType::kConstantType;
-                }
-            }
+        const int last_row_line = std::min(last_line_number, end_line - 1);
 
-            operand_tokens.emplace_back(selectable_token);
+        if (line <= last_row_line)
+        {
+            emit dataChanged(index(line - block_line - 1, 0, block_index), index(last_row_line - block_line - 1, last_column, block_index), roles);
         }
 
-        // Set the tokens' hit boxes and increment the next hit box.
+        line = end_line;
+        block_row++;
+    }
+}
+
+void IsaItemModel::ExportRows(const std::vector<ExportRange>& ranges, const std::vector<int>& columns, ExportFormat format, std::string& text) const
+{
+    std::vector<ExportRange> valid_ranges;
+    std::vector<size_t>      widths;
+
+    GetValidExportRanges(ranges, valid_ranges);
+
+    text.clear();
+    text.reserve(MeasureExport(valid_ranges, columns, format, widths));
+
+    WriteExport(valid_ranges, columns, format, widths, text, nullptr);
+}
+
+bool IsaItemModel::ExportRows(const std::vector<ExportRange>&              ranges,
+                              const std::vector<int>&                      columns,
+                              ExportFormat                                 format,
+                              const std::function<bool(std::string_view)>& write) const
+{
+    std::vector<ExportRange> valid_ranges;
+    std::vector<size_t>      widths(columns.size(), 0);
+
+    GetValidExportRanges(ranges, valid_ranges);
+
+    // Only text is padded to the widths of the columns; comma separated values are written in a single pass.
+    if (format == ExportFormat::kText)
+    {
+        MeasureExport(valid_ranges, columns, format, widths);
+    }
+
+    std::string chunk;
+    chunk.reserve(kExportChunkSize * 2);
+
+    return WriteExport(valid_ranges, columns, format, widths, chunk, &write);
+}
+
+void IsaItemModel::GetTokens(const QModelIndex& index, std::vector<TokenView>& tokens, std::vector<size_t>* operand_ends) const
+{
+    tokens.clear();
+
+    if (operand_ends != nullptr)
+    {
+        operand_ends->clear();
+    }
+
+    if (!index.isValid())
+    {
+        return;
+    }
+
+    // Same tokens as Qt::UserRole gives, without going through a QVariant.
 
-        size_t i = 0;
+    const int parent_row = GetParentRow(index);
 
-        for (auto& selectable_token : operand_tokens)
+    if (parent_row == -1)
+    {
+        if (UsesRowStorage())
         {
-            token_width = fixed_character_width * static_cast<qreal>(selectable_token.token_text.size());
-            token_end_x += token_width;
+            const auto& block = row_storage_.GetBlock(index.row());
 
-            selectable_token.x_position_start = token_start_x;
-            selectable_token.x_position_end   = token_end_x;
+            if (!block.is_comment)
+            {
+                tokens.push_back(MakeTokenView(row_storage_, row_storage_.GetToken(block.label_token)));
+            }
+        }
+        else
+        {
+            const auto& block = blocks_.at(index.row());
 
-            if (i < operand_tokens.size() - 1)
+            if (block->row_type == RowType::kCode)
             {
-                token_start_x = token_start_x + token_width + fixed_character_width;  // Add whitespace width too.
-                token_end_x   = token_end_x + fixed_character_width;                  // Add whitespace width too.
+                tokens.push_back(MakeTokenView(std::static_pointer_cast<InstructionBlock>(block)->token));
             }
+        }
+    }
+    else if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          row         = GetArenaRow(parent_row, index.row(), row_storage);
+
+        if (row.is_comment)
+        {
+            return;
+        }
 
-            i++;
+        if (index.column() == kOpCode)
+        {
+            tokens.push_back(MakeTokenView(*row_storage, row_storage->GetToken(row.op_code_token)));
         }
+        else if (index.column() == kOperands)
+        {
+            for (uint32_t i = 0; i < row.operand_count; i++)
+            {
+                const auto& operand = row_storage->GetOperand(row.first_operand + i);
 
-        selectable_tokens.emplace_back(operand_tokens);
+                for (uint32_t j = 0; j < operand.token_count; j++)
+                {
+                    tokens.push_back(MakeTokenView(*row_storage, row_storage->GetToken(operand.first_token + j)));
+                }
 
-        token_start_x = token_start_x + token_width + (fixed_character_width * static_cast<qreal>(QString(", ").size()));  // Add delimiter width too.
-        token_end_x   = token_end_x + (fixed_character_width * static_cast<qreal>(QString(", ").size()));                  // Add delimiter width too.
+                if (operand_ends != nullptr)
+                {
+                    operand_ends->push_back(tokens.size());
+                }
+            }
+        }
     }
-}
+    else
+    {
+        const auto& row = blocks_.at(parent_row)->instruction_lines.at(index.row());
 
-IsaItemModel::Row::Row(RowType type, uint32_t line)
-    : row_type(type)
-    , line_number(line)
-{
+        if (row->row_type != RowType::kCode)
+        {
+            return;
+        }
+
+        const auto* instruction = static_cast<const InstructionRow*>(row.get());
+
+        if (index.column() == kOpCode)
+        {
+            tokens.push_back(MakeTokenView(instruction->op_code_token));
+        }
+        else if (index.column() == kOperands)
+        {
+            for (const auto& operand_tokens : instruction->operand_tokens)
+            {
+                for (const auto& token : operand_tokens)
+                {
+                    tokens.push_back(MakeTokenView(token));
+                }
+
+                if (operand_ends != nullptr)
+                {
+                    operand_ends->push_back(tokens.size());
+                }
+            }
+        }
+    }
 }
 
-IsaItemModel::Row::~Row()
+std::string IsaItemModel::TrimStr(std::string input_string)
 {
+    static const char* kSpecialChars = " \t\n\r\f\v";
+
+    input_string.erase(input_string.find_last_not_of(kSpecialChars) + 1);
+    input_string.erase(0, input_string.find_first_not_of(kSpecialChars));
+
+    return input_string;
 }
 
-IsaItemModel::CommentRow::CommentRow(uint32_t line, std::string comment)
-    : Row(RowType::kComment, line)
-    , text(comment)
+void IsaItemModel::Split(std::string line, std::string delimiter, std::vector<std::string>& list)
 {
+    size_t      pos = 0;
+    std::string token;
+
+    while ((pos = line.find(delimiter)) != std::string::npos)
+    {
+        token = line.substr(0, pos);
+        list.push_back(TrimStr(token));
+        line.erase(0, pos + delimiter.length());
+    }
+
+    list.push_back(TrimStr(line));
 }
 
-IsaItemModel::CommentRow::~CommentRow()
+void IsaItemModel::SetStorageMode(StorageMode storage_mode)
 {
+    CancelAsyncUpdate();
+
+    if (storage_mode == storage_mode_)
+    {
+        return;
+    }
+
+    beginResetModel();
+
+    blocks_.clear();
+    ClearRowStorage(true);
+    line_number_corresponding_indices_.clear();
+    block_line_numbers_.clear();
+
+    storage_mode_ = storage_mode;
+
+    endResetModel();
 }
 
-IsaItemModel::InstructionRow::InstructionRow(uint32_t line, std::string op, std::string address, std::string representation)
-    : Row(RowType::kCode, line)
-    , pc_address(address)
-    , binary_representation(representation)
-    , enabled(true)
+void IsaItemModel::ClearRowStorage(bool release_memory)
 {
-    op_code_token.token_text = op;
+    if (release_memory)
+    {
+        row_storage_.ReleaseMemory();
+    }
+    else
+    {
+        row_storage_.Clear();
+    }
+
+    control_flow_graph_.Clear();
+
+    virtual_rows_.Clear();
+    virtual_label_blocks_.clear();
+    virtual_file_.reset();
+    virtual_line_count_ = 0;
 }
 
-IsaItemModel::InstructionRow::~InstructionRow()
+int IsaItemModel::AppendCodeBlock(uint32_t line_number, std::string_view label)
 {
+    return static_cast<int>(IsaRowTokenizer::AppendBlock(row_storage_, false, line_number, label, fixed_font_character_width_));
 }
 
-IsaItemModel::Block::Block(RowType type, int block_position, uint32_t shader_line_number)
-    : row_type(type)
-    , position(block_position)
-    , line_number(shader_line_number)
+int IsaItemModel::AppendCommentBlock(uint32_t line_number, std::string_view text)
 {
+    return static_cast<int>(IsaRowTokenizer::AppendBlock(row_storage_, true, line_number, text, fixed_font_character_width_));
 }
 
-IsaItemModel::Block::~Block()
+void IsaItemModel::AppendInstruction(uint32_t                        line_number,
+                                     std::string_view                op_code,
+                                     const std::vector<std::string>& operands,
+                                     std::string_view                pc_address,
+                                     std::string_view                binary_representation,
+                                     bool                            enabled)
 {
+    IsaRowTokenizer::AppendInstruction(row_storage_, line_number, op_code, operands, pc_address, binary_representation, enabled, fixed_font_character_width_);
 }
 
-IsaItemModel::CommentBlock::CommentBlock(int block_position, uint32_t shader_line_number, std::string comment_text)
-    : Block(RowType::kComment, block_position, shader_line_number)
-    , text(comment_text)
+void IsaItemModel::AppendComment(uint32_t line_number, std::string_view text)
 {
+    IsaRowTokenizer::AppendComment(row_storage_, line_number, text);
 }
 
-IsaItemModel::CommentBlock::~CommentBlock()
+void IsaItemModel::BeginAsyncUpdate(std::vector<SourceBlock> blocks, int thread_count)
 {
+    CancelAsyncUpdate();
+
+    model_cache_path_.clear();
+
+    beginResetModel();
+
+    blocks_.clear();
+    ClearRowStorage();
+    line_number_corresponding_indices_.clear();
+    block_line_numbers_.clear();
+
+    storage_mode_ = StorageMode::kArena;
+
+    endResetModel();
+
+    // Split the blocks into batches of roughly the same number of lines.
+
+    size_t row_count        = 0;
+    size_t batch_line_count = 0;
+
+    async_update_batch_offsets_.clear();
+
+    for (size_t block_index = 0; block_index < blocks.size(); block_index++)
+    {
+        if (batch_line_count == 0)
+        {
+            async_update_batch_offsets_.push_back(block_index);
+        }
+
+        row_count += blocks[block_index].rows.size();
+        batch_line_count += 1 + blocks[block_index].rows.size();
+
+        if (batch_line_count >= kAsyncUpdateBatchLineCount)
+        {
+            batch_line_count = 0;
+        }
+    }
+
+    async_update_batch_offsets_.push_back(blocks.size());
+
+    const size_t batch_count = async_update_batch_offsets_.size() - 1;
+
+    if (batch_count == 0)
+    {
+        MapBlocksToBranchInstructions();
+        CacheSizeHints();
+
+        emit AsyncUpdateFinished(false);
+
+        return;
+    }
+
+    row_storage_.Reserve(blocks.size(), row_count, 0, 0);
+
+    if (thread_count <= 0)
+    {
+        thread_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    thread_count = std::min(thread_count, static_cast<int>(batch_count));
+
+    async_update_canceled_              = false;
+    async_update_next_batch_            = 0;
+    async_update_next_published_batch_  = 0;
+    async_update_published_block_count_ = 0;
+    async_update_generation_++;
+
+    const uint64_t                                  generation            = async_update_generation_;
+    const qreal                                     fixed_character_width = fixed_font_character_width_;
+    const std::shared_ptr<std::vector<SourceBlock>> source_blocks         = std::make_shared<std::vector<SourceBlock>>(std::move(blocks));
+
+    // Each worker thread keeps taking the next batch until there is none left; the batches are posted to the GUI thread,
+    // which inserts them into this model in shader order.
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        async_update_threads_.emplace_back([this, generation, fixed_character_width, source_blocks, symbol_table = row_storage_.GetSymbolTable()]() {
+            while (!async_update_canceled_)
+            {
+                const size_t batch_index = async_update_next_batch_++;
+
+                if (batch_index + 1 >= async_update_batch_offsets_.size())
+                {
+                    break;
+                }
+
+                auto batch = std::make_shared<IsaRowStorage>();
+                batch->SetSymbolTable(symbol_table);
+
+                if (!ParseSourceBlocks(*source_blocks,
+                                       async_update_batch_offsets_[batch_index],
+                                       async_update_batch_offsets_[batch_index + 1],
+                                       fixed_character_width,
+                                       async_update_canceled_,
+                                       *batch))
+                {
+                    break;
+                }
+
+                QMetaObject::invokeMethod(
+                    this, [this, generation, batch_index, batch]() { PublishAsyncUpdateBatch(generation, batch_index, batch); }, Qt::QueuedConnection);
+            }
+        });
+    }
 }
 
-IsaItemModel::InstructionBlock::InstructionBlock(int block_position, uint32_t shader_line_number, std::string block_label)
-    : Block(RowType::kCode, block_position, shader_line_number)
+void IsaItemModel::CancelAsyncUpdate()
 {
-    token.token_text       = block_label;
-    token.type             = IsaItemModel::TokenType::kLabelType;
-    token.x_position_start = 0;
-    token.x_position_end   = fixed_font_character_width * block_label.size();
+    if (async_update_threads_.empty())
+    {
+        return;
+    }
+
+    StopAsyncUpdateThreads();
+
+    // Only a complete model is worth caching.
+    model_cache_path_.clear();
+
+    emit AsyncUpdateFinished(true);
 }
 
-IsaItemModel::InstructionBlock::~InstructionBlock()
+bool IsaItemModel::BeginCachedUpdate(std::vector<SourceBlock> blocks, amdisa::GpuArchitecture architecture, const QString& cache_directory, int thread_count)
 {
+    uint64_t character_width_bits = 0;
+    std::memcpy(&character_width_bits, &fixed_font_character_width_, std::min(sizeof(character_width_bits), sizeof(fixed_font_character_width_)));
+
+    // Files written with another format get another name, so they are never mistaken for the current format.
+    uint64_t key = HashSourceBlocks(blocks);
+
+    key = (key ^ static_cast<uint64_t>(architecture)) * kFnvPrime;
+    key = (key ^ character_width_bits) * kFnvPrime;
+    key = (key ^ kModelCacheVersion) * kFnvPrime;
+    key = (key ^ IsaRowStorage::kSerializationVersion) * kFnvPrime;
+
+    const QString file_path = QDir(cache_directory).filePath(QString("%1.isacache").arg(static_cast<qulonglong>(key), 16, 16, QChar('0')));
+
+    if (LoadModelCache(file_path, key))
+    {
+        return true;
+    }
+
+    BeginAsyncUpdate(std::move(blocks), thread_count);
+
+    if (IsAsyncUpdateRunning())
+    {
+        model_cache_path_ = file_path;
+        model_cache_key_  = key;
+    }
+
+    return false;
 }
 
-void IsaItemModel::LoadIsaSpec(amdisa::GpuArchitecture architecture)
+void IsaItemModel::UpdateBlocks(const std::vector<SourceBlock>& blocks)
 {
-    const std::string application_dir = qApp->applicationDirPath().toStdString();
+    QTISAGUI_SCOPED_TIMER(kUpdateBlocks);
 
-    std::filesystem::path isa_spec_dir_path(application_dir);
-    isa_spec_dir_path /= "utils";
-    isa_spec_dir_path /= "isa_spec";
-    isa_spec_dir_path.make_preferred();
+    SetStorageMode(StorageMode::kBlocks);
 
-    if (std::filesystem::exists(isa_spec_dir_path) && std::filesystem::is_directory(isa_spec_dir_path))
+    // Match blocks by type and label, in shader order; a block is matched to the first block after the last match with
+    // the same label, so a block that moved above other blocks is removed and inserted again.
+
+    constexpr size_t kNoMatch = std::numeric_limits<size_t>::max();
+
+    std::array<std::unordered_map<std::string_view, std::vector<size_t>>, 2> old_blocks_by_label;
+
+    for (size_t block_index = blocks_.size(); block_index-- > 0;)
+    {
+        const Block* block = blocks_[block_index].get();
+
+        if (block->row_type == RowType::kComment)
+        {
+            old_blocks_by_label[0][static_cast<const CommentBlock*>(block)->text].push_back(block_index);
+        }
+        else
+        {
+            old_blocks_by_label[1][static_cast<const InstructionBlock*>(block)->token.token_text].push_back(block_index);
+        }
+    }
+
+    std::vector<size_t>   matches(blocks.size(), kNoMatch);
+    std::vector<uint64_t> source_hashes(blocks.size());
+    size_t                next_old_block = 0;
+
+    for (size_t block_index = 0; block_index < blocks.size(); block_index++)
     {
-        std::string              initialize_error_message;
-        std::vector<std::string> xml_file_paths;
+        source_hashes[block_index] = HashSourceBlock(blocks[block_index]);
+
+        auto&      labels     = old_blocks_by_label[(blocks[block_index].row_type == RowType::kComment) ? 0 : 1];
+        const auto label_iter = labels.find(blocks[block_index].text);
+
+        if (label_iter == labels.end())
+        {
+            continue;
+        }
+
+        // The blocks with this label are in reverse shader order.
+        auto& candidates = label_iter->second;
+
+        while (!candidates.empty() && candidates.back() < next_old_block)
+        {
+            candidates.pop_back();
+        }
+
+        if (!candidates.empty())
+        {
+            matches[block_index] = candidates.back();
+            next_old_block       = candidates.back() + 1;
 
-        if (kIsaSpecNameMap.find(architecture) != kIsaSpecNameMap.end())
+            candidates.pop_back();
+        }
+    }
+
+    // Edit blocks_ in shader order; rows before row are final, and the unmatched old blocks from old_block on follow them.
+
+    const int                           old_block_count = static_cast<int>(blocks_.size());
+    int                                 old_block       = 0;
+    int                                 row             = 0;
+    size_t                              parsed_count    = 0;
+    std::vector<std::shared_ptr<Block>> inserted_blocks;
+
+    for (size_t block_index = 0; block_index < blocks.size(); block_index++)
+    {
+        if (matches[block_index] == kNoMatch)
         {
-            const auto isa_spec_name = kIsaSpecNameMap.at(architecture);
+            inserted_blocks.push_back(MakeBlock(row + static_cast<int>(inserted_blocks.size()), blocks[block_index], source_hashes[block_index]));
+            parsed_count++;
+            continue;
+        }
 
-            std::filesystem::path isa_spec_path(isa_spec_dir_path);
+        const int matched_block = static_cast<int>(matches[block_index]);
 
-            isa_spec_path /= isa_spec_name;
+        RemoveBlocks(row, matched_block - old_block);
+        old_block = matched_block + 1;
 
-            isa_spec_path.make_preferred();
+        const int inserted_count = static_cast<int>(inserted_blocks.size());
 
-            xml_file_paths.emplace_back(isa_spec_path.string());
+        InsertBlocks(row, inserted_blocks);
+        row += inserted_count;
+
+        if (UpdateBlock(row, blocks[block_index], source_hashes[block_index]))
+        {
+            parsed_count++;
         }
 
-        is_decoder_initialized = decode_manager.Initialize(xml_file_paths, initialize_error_message);
+        row++;
+    }
+
+    RemoveBlocks(row, old_block_count - old_block);
+    InsertBlocks(row, inserted_blocks);
+
+    QTISAGUI_COUNT_ITEMS(kUpdateBlocks, parsed_count);
+
+    MapBlocksToBranchInstructions();
+    CacheSizeHints();
+
+    // Rows inserted and removed above the last block give the lines after them new line numbers, so metric values
+    // set by line number would color the wrong instructions.
+    ClearMetricValues();
+}
+
+std::shared_ptr<IsaItemModel::Block> IsaItemModel::MakeBlock(int position, const SourceBlock& source_block, uint64_t source_hash) const
+{
+    std::shared_ptr<Block> block;
+
+    if (source_block.row_type == RowType::kComment)
+    {
+        block = std::make_shared<CommentBlock>(position, source_block.line_number, source_block.text);
     }
+    else
+    {
+        block = std::make_shared<InstructionBlock>(position, source_block.line_number, source_block.text);
+    }
+
+    block->source_hash = source_hash;
+
+    MakeRows(source_block, block->instruction_lines);
+
+    return block;
+}
+
+void IsaItemModel::MakeRows(const SourceBlock& source_block, std::vector<std::shared_ptr<Row>>& rows) const
+{
+    rows.clear();
+    rows.reserve(source_block.rows.size());
+
+    for (const auto& source_row : source_block.rows)
+    {
+        if (source_row.row_type == RowType::kComment)
+        {
+            rows.push_back(std::make_shared<CommentRow>(source_row.line_number, source_row.text));
+            continue;
+        }
+
+        auto instruction = std::make_shared<InstructionRow>(source_row.line_number, source_row.text, source_row.pc_address, source_row.binary_representation);
+
+        instruction->enabled = source_row.enabled;
+
+        ParseSelectableTokens(source_row.text, instruction->op_code_token, source_row.operands, instruction->operand_tokens, fixed_font_character_width_);
+
+        rows.push_back(std::move(instruction));
+    }
+}
+
+void IsaItemModel::InsertBlocks(int first_row, std::vector<std::shared_ptr<Block>>& blocks)
+{
+    if (blocks.empty())
+    {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), first_row, first_row + static_cast<int>(blocks.size()) - 1);
+
+    blocks_.insert(blocks_.begin() + first_row, std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+    blocks.clear();
+
+    // Child indices find their parent row through the position of their block.
+    for (size_t block_index = static_cast<size_t>(first_row); block_index < blocks_.size(); block_index++)
+    {
+        blocks_[block_index]->position = static_cast<int>(block_index);
+    }
+
+    endInsertRows();
+}
+
+void IsaItemModel::RemoveBlocks(int first_row, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), first_row, first_row + count - 1);
+
+    // Keep the removed blocks alive until the views are done with the indices of their rows.
+    const std::vector<std::shared_ptr<Block>> removed_blocks(blocks_.begin() + first_row, blocks_.begin() + first_row + count);
+
+    blocks_.erase(blocks_.begin() + first_row, blocks_.begin() + first_row + count);
+
+    for (size_t block_index = static_cast<size_t>(first_row); block_index < blocks_.size(); block_index++)
+    {
+        blocks_[block_index]->position = static_cast<int>(block_index);
+    }
+
+    endRemoveRows();
+}
+
+bool IsaItemModel::UpdateBlock(int row, const SourceBlock& source_block, uint64_t source_hash)
+{
+    Block&            block        = *blocks_[row];
+    const QModelIndex block_index  = index(row, 0);
+    const int         last_column  = columnCount() - 1;
+    const bool        line_changed = block.line_number != source_block.line_number;
+
+    block.line_number = source_block.line_number;
+
+    if (line_changed)
+    {
+        emit dataChanged(block_index, block_index.siblingAtColumn(last_column));
+    }
+
+    auto& rows = block.instruction_lines;
+
+    if (block.source_hash == source_hash && rows.size() == source_block.rows.size())
+    {
+        // Same tokens; only the text that is not parsed may have moved.
+        int                   first_changed_row = -1;
+        int                   last_changed_row  = -1;
+        std::vector<uint32_t> source_words;
+
+        for (size_t row_index = 0; row_index < rows.size(); row_index++)
+        {
+            Row&             child_row  = *rows[row_index];
+            const SourceRow& source_row = source_block.rows[row_index];
+            bool             changed    = child_row.line_number != source_row.line_number;
+
+            child_row.line_number = source_row.line_number;
+
+            if (child_row.row_type == RowType::kCode)
+            {
+                auto& instruction = static_cast<InstructionRow&>(child_row);
+
+                source_words.clear();
+                const size_t number_words = IsaInstructionEncoding::Append(source_row.binary_representation, source_words);
+
+                changed = changed || instruction.pc_address != source_row.pc_address || instruction.words != source_words ||
+                          instruction.number_words != number_words || instruction.enabled != source_row.enabled;
+
+                instruction.pc_address = source_row.pc_address;
+                instruction.words.swap(source_words);
+                instruction.number_words = number_words;
+                instruction.enabled = source_row.enabled;
+            }
+
+            if (changed)
+            {
+                first_changed_row = (first_changed_row == -1) ? static_cast<int>(row_index) : first_changed_row;
+                last_changed_row  = static_cast<int>(row_index);
+            }
+        }
+
+        if (first_changed_row != -1)
+        {
+            emit dataChanged(index(first_changed_row, 0, block_index), index(last_changed_row, last_column, block_index));
+        }
+
+        return false;
+    }
+
+    block.source_hash = source_hash;
+
+    std::vector<std::shared_ptr<Row>> new_rows;
+    MakeRows(source_block, new_rows);
+
+    // Rows that exist before and after are changed in place, so views keep their selection; the rest are inserted or removed.
+    const int old_row_count = static_cast<int>(rows.size());
+    const int new_row_count = static_cast<int>(new_rows.size());
+    const int common_count  = std::min(old_row_count, new_row_count);
+
+    std::move(new_rows.begin(), new_rows.begin() + common_count, rows.begin());
+
+    if (common_count > 0)
+    {
+        emit dataChanged(index(0, 0, block_index), index(common_count - 1, last_column, block_index));
+    }
+
+    if (new_row_count > old_row_count)
+    {
+        beginInsertRows(block_index, old_row_count, new_row_count - 1);
+        rows.insert(rows.end(), std::make_move_iterator(new_rows.begin() + common_count), std::make_move_iterator(new_rows.end()));
+        endInsertRows();
+    }
+    else if (new_row_count < old_row_count)
+    {
+        beginRemoveRows(block_index, new_row_count, old_row_count - 1);
+        rows.erase(rows.begin() + new_row_count, rows.end());
+        endRemoveRows();
+    }
+
+    return true;
+}
+
+bool IsaItemModel::BeginVirtualUpdate(const QString& file_path)
+{
+    QTISAGUI_SCOPED_TIMER(kUpdateData);
+
+    CancelAsyncUpdate();
+
+    beginResetModel();
+
+    blocks_.clear();
+    ClearRowStorage(true);
+    line_number_corresponding_indices_.clear();
+    block_line_numbers_.clear();
+
+    storage_mode_ = StorageMode::kVirtual;
+
+    auto file = std::make_unique<QFile>(file_path);
+
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        endResetModel();
+        CacheSizeHints();
+
+        return false;
+    }
+
+    if (file->size() != 0)
+    {
+        const uchar* file_data = file->map(0, file->size());
+
+        if (file_data == nullptr)
+        {
+            endResetModel();
+            CacheSizeHints();
+
+            return false;
+        }
+
+        virtual_rows_.SetText(std::string_view(reinterpret_cast<const char*>(file_data), static_cast<size_t>(file->size())));
+        virtual_file_ = std::move(file);
+    }
+
+    // Index every line; only blocks are stored, rows are remembered by their offset in the file.
+
+    const std::string_view text        = virtual_rows_.GetText();
+    size_t                 offset      = 0;
+    uint32_t               line_number = 1;
+    std::string_view       block_text;
+
+    while (offset < text.size())
+    {
+        size_t end = text.find('\n', offset);
+
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+
+        std::string_view line = text.substr(offset, end - offset);
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+
+        const VirtualLineType line_type = ClassifyVirtualLine(line, block_text);
+
+        if (line_type == VirtualLineType::kCodeBlock || line_type == VirtualLineType::kCommentBlock)
+        {
+            IsaRowTokenizer::AppendBlock(row_storage_, line_type == VirtualLineType::kCommentBlock, line_number, block_text, fixed_font_character_width_);
+            virtual_rows_.AppendBlock();
+        }
+        else if (line_type != VirtualLineType::kSkip)
+        {
+            const bool is_comment = line_type == VirtualLineType::kComment;
+
+            if (virtual_rows_.GetBlockCount() == 0 && is_comment)
+            {
+                // The first shown line is not a block; a comment starts a comment block.
+                IsaRowTokenizer::AppendBlock(row_storage_, true, line_number, TrimView(line), fixed_font_character_width_);
+                virtual_rows_.AppendBlock();
+            }
+            else
+            {
+                if (virtual_rows_.GetBlockCount() == 0)
+                {
+                    // The first shown line is not a block; an instruction starts a code block without a label.
+                    IsaRowTokenizer::AppendBlock(row_storage_, false, line_number, std::string_view(), fixed_font_character_width_);
+                    virtual_rows_.AppendBlock();
+                }
+
+                virtual_rows_.AppendRow(offset, line_number, is_comment);
+            }
+        }
+
+        offset = end + 1;
+        line_number++;
+    }
+
+    // Views into the labels of the blocks, which do not move until the rows are replaced.
+    virtual_label_blocks_.reserve(row_storage_.GetBlockCount());
+
+    for (size_t block_index = 0; block_index < row_storage_.GetBlockCount(); block_index++)
+    {
+        const auto& block = row_storage_.GetBlock(block_index);
+
+        if (!block.is_comment)
+        {
+            virtual_label_blocks_[row_storage_.GetText(block.text)] = static_cast<int32_t>(block_index);
+        }
+    }
+
+    endResetModel();
+
+    MapBlocksToBranchInstructions();
+    CacheSizeHints();
+
+    return true;
+}
+
+IsaItemModel::VirtualLineType IsaItemModel::ClassifyVirtualLine(std::string_view line, std::string_view& text) const
+{
+    const std::string_view trimmed_line = TrimView(line);
+
+    if (trimmed_line.empty())
+    {
+        return VirtualLineType::kSkip;
+    }
+
+    if (trimmed_line.compare(0, 2, "//") == 0 || trimmed_line.front() == ';')
+    {
+        text = trimmed_line;
+
+        return VirtualLineType::kComment;
+    }
+
+    if (trimmed_line.back() == ':')
+    {
+        text = TrimView(trimmed_line.substr(0, trimmed_line.size() - 1));
+
+        return VirtualLineType::kCodeBlock;
+    }
+
+    return VirtualLineType::kInstruction;
+}
+
+bool IsaItemModel::ParseVirtualRow(std::string_view line, SourceRow& row) const
+{
+    std::string_view code = TrimView(line);
+
+    if (row.row_type == RowType::kComment)
+    {
+        row.text = std::string(code);
+
+        return true;
+    }
+
+    // Split off a trailing "// address: binary" comment.
+    const size_t comment_position = code.find("//");
+
+    if (comment_position != std::string_view::npos)
+    {
+        const std::string_view comment        = TrimView(code.substr(comment_position + 2));
+        const size_t           colon_position = comment.find(':');
+
+        if (colon_position != std::string_view::npos)
+        {
+            row.pc_address            = std::string(TrimView(comment.substr(0, colon_position)));
+            row.binary_representation = std::string(TrimView(comment.substr(colon_position + 1)));
+        }
+
+        code = TrimView(code.substr(0, comment_position));
+    }
+
+    const size_t op_code_end = code.find_first_of(" \t");
+
+    row.text = std::string(code.substr(0, op_code_end));
+
+    if (op_code_end != std::string_view::npos)
+    {
+        std::string_view operands = TrimView(code.substr(op_code_end));
+
+        while (!operands.empty())
+        {
+            const size_t delimiter_position = operands.find(',');
+
+            row.operands.emplace_back(TrimView(operands.substr(0, delimiter_position)));
+
+            if (delimiter_position == std::string_view::npos)
+            {
+                break;
+            }
+
+            operands.remove_prefix(delimiter_position + 1);
+        }
+    }
+
+    return !row.text.empty();
+}
+
+void IsaItemModel::SetVirtualCacheRowCount(size_t row_count)
+{
+    virtual_rows_.SetCacheRowCount(row_count);
+}
+
+void IsaItemModel::ClearBranchInstructionMapping()
+{
+    control_flow_graph_.Clear();
+
+    for (const auto& block : blocks_)
+    {
+        if (block->row_type == RowType::kCode)
+        {
+            static_cast<InstructionBlock*>(block.get())->mapped_branch_instructions.clear();
+        }
+    }
+}
+
+void IsaItemModel::MapBlocksToBranchInstructions()
+{
+    QTISAGUI_SCOPED_TIMER(kMapBlocksToBranchInstructions);
+
+    ClearBranchInstructionMapping();
+
+    if (storage_mode_ == StorageMode::kVirtual)
+    {
+        // Mapping every branch would parse every row; branches of virtual rows are resolved as the rows are parsed instead.
+        return;
+    }
+
+    const uint32_t block_count = static_cast<uint32_t>(rowCount());
+
+    if (block_count == 0)
+    {
+        return;
+    }
+
+    // Build map of code block label -> code block index; views into the labels avoid copying them.
+
+    std::unordered_map<std::string_view, uint32_t> label_to_index;
+    label_to_index.reserve(block_count);
+
+    for (uint32_t block_index = 0; block_index < block_count; block_index++)
+    {
+        if (GetRowType(-1, block_index) == RowType::kCode)
+        {
+            label_to_index[GetRowText(-1, block_index)] = block_index;
+        }
+    }
+
+    // Find the edges out of every code block in one pass, in shader order.
+    // A block falls through into the next code block unless its last instruction ends the flow.
+
+    std::vector<IsaControlFlowGraph::Edge> edges;
+    IsaControlFlowGraph::Edge              fall_through_edge = {};
+    bool                                   falls_through     = false;
+
+    // A shader has a few hundred distinct op codes; match each against the branch prefixes once, by symbol.
+    constexpr uint8_t    kUnknownBranchType = UINT8_MAX;
+    std::vector<uint8_t> branch_types;
+
+    for (uint32_t block_index = 0; block_index < block_count; block_index++)
+    {
+        if (GetRowType(-1, block_index) != RowType::kCode)
+        {
+            continue;
+        }
+
+        if (falls_through)
+        {
+            fall_through_edge.target_block = block_index;
+            edges.push_back(fall_through_edge);
+        }
+
+        const uint32_t                  row_count        = static_cast<uint32_t>(rowCount(index(block_index, 0)));
+        IsaControlFlowGraph::BranchType last_branch_type = IsaControlFlowGraph::BranchType::kNone;
+        uint32_t                        last_row         = IsaControlFlowGraph::kInvalidIndex;
+
+        for (uint32_t row_index = 0; row_index < row_count; row_index++)
+        {
+            if (GetRowType(block_index, row_index) != RowType::kCode)
+            {
+                continue;
+            }
+
+            const uint32_t op_code_symbol = GetOpCodeSymbol(block_index, row_index);
+
+            if (op_code_symbol == IsaSymbolTable::kInvalidSymbol)
+            {
+                last_branch_type = IsaControlFlowGraph::GetBranchType(GetRowText(block_index, row_index));
+            }
+            else
+            {
+                if (op_code_symbol >= branch_types.size())
+                {
+                    branch_types.resize(op_code_symbol + 1, kUnknownBranchType);
+                }
+
+                if (branch_types[op_code_symbol] == kUnknownBranchType)
+                {
+                    branch_types[op_code_symbol] = static_cast<uint8_t>(IsaControlFlowGraph::GetBranchType(GetRowText(block_index, row_index)));
+                }
+
+                last_branch_type = static_cast<IsaControlFlowGraph::BranchType>(branch_types[op_code_symbol]);
+            }
+
+            last_row = row_index;
+
+            if (last_branch_type == IsaControlFlowGraph::BranchType::kIndirectBranch)
+            {
+                edges.push_back({block_index, row_index, IsaControlFlowGraph::kInvalidIndex, IsaControlFlowGraph::EdgeKind::kIndirect});
+            }
+            else if (IsaControlFlowGraph::IsLabelBranch(last_branch_type))
+            {
+                // Assume branch target is first operand of first operand group.
+                const auto map_iter = label_to_index.find(GetBranchTargetLabel(block_index, row_index));
+
+                if (map_iter != label_to_index.end())
+                {
+                    const auto kind = (last_branch_type == IsaControlFlowGraph::BranchType::kBranch) ? IsaControlFlowGraph::EdgeKind::kBranch
+                                                                                                     : IsaControlFlowGraph::EdgeKind::kConditionalBranch;
+
+                    edges.push_back({block_index, row_index, map_iter->second, kind});
+
+                    // Branch instruction remembers which code block is its target.
+                    SetBranchTarget(block_index, row_index, static_cast<int>(map_iter->second));
+                }
+            }
+        }
+
+        switch (last_branch_type)
+        {
+        case IsaControlFlowGraph::BranchType::kBranch:
+        case IsaControlFlowGraph::BranchType::kIndirectBranch:
+        case IsaControlFlowGraph::BranchType::kEndProgram:
+            falls_through = false;
+            break;
+        case IsaControlFlowGraph::BranchType::kCall:
+            falls_through     = true;
+            fall_through_edge = {block_index, last_row, IsaControlFlowGraph::kInvalidIndex, IsaControlFlowGraph::EdgeKind::kCallReturn};
+            break;
+        default:
+            falls_through     = true;
+            fall_through_edge = {
+                block_index, IsaControlFlowGraph::kInvalidIndex, IsaControlFlowGraph::kInvalidIndex, IsaControlFlowGraph::EdgeKind::kFallThrough};
+            break;
+        }
+    }
+
+    control_flow_graph_.Build(block_count, edges);
+
+    if (storage_mode_ == StorageMode::kBlocks)
+    {
+        // Keep the deprecated per block lists filled for subclasses that still read them.
+        for (uint32_t block_index = 0; block_index < block_count; block_index++)
+        {
+            if (blocks_[block_index]->row_type != RowType::kCode)
+            {
+                continue;
+            }
+
+            auto& mapped_branch_instructions = static_cast<InstructionBlock*>(blocks_[block_index].get())->mapped_branch_instructions;
+
+            for (const auto& edge : control_flow_graph_.GetBranchPredecessors(block_index))
+            {
+                mapped_branch_instructions.emplace_back(edge.source_block, edge.source_row);
+            }
+        }
+    }
+}
+
+void IsaItemModel::ParseSelectableTokens(const std::string&                             op_code,
+                                         IsaItemModel::Token&                           op_code_token,
+                                         const std::vector<std::string>&                operands,
+                                         std::vector<std::vector<IsaItemModel::Token>>& selectable_tokens,
+                                         qreal                                          fixed_character_width) const
+{
+    SelectableTokenSink sink(*GetSymbolTable(), op_code_token, selectable_tokens);
+
+    IsaRowTokenizer::LayoutInstruction(op_code, operands, fixed_character_width, sink);
+}
+
+IsaItemModel::Row::Row(RowType type, uint32_t line)
+    : row_type(type)
+    , line_number(line)
+{
+}
+
+IsaItemModel::Row::~Row()
+{
+}
+
+IsaItemModel::CommentRow::CommentRow(uint32_t line, std::string comment)
+    : Row(RowType::kComment, line)
+    , text(comment)
+{
+}
+
+IsaItemModel::CommentRow::~CommentRow()
+{
+}
+
+IsaItemModel::InstructionRow::InstructionRow(uint32_t line, std::string op, std::string address, std::string representation)
+    : Row(RowType::kCode, line)
+    , pc_address(address)
+    , number_words(0)
+    , enabled(true)
+{
+    op_code_token.token_text = op;
+
+    number_words = IsaInstructionEncoding::Append(representation, words);
+}
+
+IsaItemModel::InstructionRow::~InstructionRow()
+{
+}
+
+std::string IsaItemModel::InstructionRow::GetBinaryRepresentation() const
+{
+    std::string text;
+
+    IsaInstructionEncoding::Format(words.data(), words.size(), text);
+
+    return text;
+}
+
+IsaItemModel::Block::Block(RowType type, int block_position, uint32_t shader_line_number)
+    : row_type(type)
+    , position(block_position)
+    , line_number(shader_line_number)
+    , source_hash(0)
+{
+}
+
+IsaItemModel::Block::~Block()
+{
+}
+
+IsaItemModel::CommentBlock::CommentBlock(int block_position, uint32_t shader_line_number, std::string comment_text)
+    : Block(RowType::kComment, block_position, shader_line_number)
+    , text(comment_text)
+{
+}
+
+IsaItemModel::CommentBlock::~CommentBlock()
+{
+}
+
+IsaItemModel::InstructionBlock::InstructionBlock(int block_position, uint32_t shader_line_number, std::string block_label)
+    : Block(RowType::kCode, block_position, shader_line_number)
+{
+    token.token_text       = block_label;
+    token.type             = IsaItemModel::TokenType::kLabelType;
+    token.color_class      = IsaColorCodingDictionaryInstance::GetColorClass(block_label);
+    token.x_position_start = 0;
+    token.x_position_end   = fixed_font_character_width * block_label.size();
+}
+
+IsaItemModel::InstructionBlock::~InstructionBlock()
+{
+}
+
+std::string IsaItemModel::GetIsaSpecPath(amdisa::GpuArchitecture architecture)
+{
+    const auto isa_spec_name_iter = kIsaSpecNameMap.find(architecture);
+
+    if (isa_spec_name_iter == kIsaSpecNameMap.end())
+    {
+        return std::string();
+    }
+
+    const std::string application_dir = qApp->applicationDirPath().toStdString();
+
+    std::filesystem::path isa_spec_dir_path(application_dir);
+    isa_spec_dir_path /= "utils";
+    isa_spec_dir_path /= "isa_spec";
+    isa_spec_dir_path.make_preferred();
+
+    if (!std::filesystem::exists(isa_spec_dir_path) || !std::filesystem::is_directory(isa_spec_dir_path))
+    {
+        return std::string();
+    }
+
+    std::filesystem::path isa_spec_path(isa_spec_dir_path);
+
+    isa_spec_path /= isa_spec_name_iter->second;
+
+    isa_spec_path.make_preferred();
+
+    return isa_spec_path.string();
+}
+
+IsaItemModel::Token IsaItemModel::MakeToken(const IsaRowStorage& row_storage, const IsaRowStorage::TokenRecord& token_record)
+{
+    Token token;
+
+    token.token_text           = std::string(row_storage.GetTokenText(token_record));
+    token.symbol               = token_record.symbol;
+    token.type                 = static_cast<TokenType>(token_record.type);
+    token.start_register_index = token_record.start_register_index;
+    token.end_register_index   = token_record.end_register_index;
+    token.x_position_start     = token_record.x_position_start;
+    token.x_position_end       = token_record.x_position_end;
+    token.is_selectable        = token_record.is_selectable;
+    token.color_class          = static_cast<IsaColorClass>(token_record.color_class);
+
+    return token;
+}
+
+IsaItemModel::TokenView IsaItemModel::MakeTokenView(const IsaRowStorage& row_storage, const IsaRowStorage::TokenRecord& token_record)
+{
+    TokenView token_view;
+
+    token_view.token_text           = row_storage.GetTokenText(token_record);
+    token_view.symbol               = token_record.symbol;
+    token_view.type                 = static_cast<TokenType>(token_record.type);
+    token_view.start_register_index = token_record.start_register_index;
+    token_view.end_register_index   = token_record.end_register_index;
+    token_view.x_position_start     = token_record.x_position_start;
+    token_view.x_position_end       = token_record.x_position_end;
+    token_view.is_selectable        = token_record.is_selectable;
+    token_view.color_class          = static_cast<IsaColorClass>(token_record.color_class);
+
+    return token_view;
+}
+
+IsaItemModel::TokenView IsaItemModel::MakeTokenView(const Token& token)
+{
+    TokenView token_view;
+
+    token_view.token_text           = token.token_text;
+    token_view.symbol               = token.symbol;
+    token_view.type                 = token.type;
+    token_view.start_register_index = token.start_register_index;
+    token_view.end_register_index   = token.end_register_index;
+    token_view.x_position_start     = token.x_position_start;
+    token_view.x_position_end       = token.x_position_end;
+    token_view.is_selectable        = token.is_selectable;
+    token_view.color_class          = token.color_class;
+
+    return token_view;
+}
+
+const IsaRowStorage::RowRecord& IsaItemModel::GetArenaRow(int parent_row, int row, const IsaRowStorage*& row_storage) const
+{
+    if (storage_mode_ != StorageMode::kVirtual)
+    {
+        row_storage = &row_storage_;
+
+        return row_storage_.GetRow(parent_row, row);
+    }
+
+    row_storage = virtual_rows_.FindParsedRow(parent_row, row);
+
+    if (row_storage != nullptr)
+    {
+        return row_storage->GetRow(0, 0);
+    }
+
+    // Parse the row into storage of its own, as row 0 of block 0.
+
+    IsaRowStorage& parsed_row_storage = virtual_rows_.InsertParsedRow(parent_row, row);
+
+    parsed_row_storage.SetSymbolTable(row_storage_.GetSymbolTable());
+
+    parsed_row_storage.AppendBlock(false, 0, std::string_view());
+
+    SourceRow              source_row;
+    const std::string_view line = virtual_rows_.GetLine(parent_row, row);
+
+    source_row.row_type    = virtual_rows_.IsComment(parent_row, row) ? RowType::kComment : RowType::kCode;
+    source_row.line_number = virtual_rows_.GetLineNumber(parent_row, row);
+
+    if (!ParseVirtualRow(line, source_row))
+    {
+        source_row.text = std::string(TrimView(line));
+        source_row.operands.clear();
+    }
+
+    if (source_row.row_type == RowType::kComment)
+    {
+        IsaRowTokenizer::AppendComment(parsed_row_storage, source_row.line_number, source_row.text);
+    }
+    else
+    {
+        IsaRowTokenizer::AppendInstruction(parsed_row_storage,
+                                           source_row.line_number,
+                                           source_row.text,
+                                           source_row.operands,
+                                           source_row.pc_address,
+                                           source_row.binary_representation,
+                                           source_row.enabled,
+                                           fixed_font_character_width_);
+
+        // Resolve the target of a branch, the way MapBlocksToBranchInstructions does for the other storage modes.
+        const auto& parsed_row = parsed_row_storage.GetRow(0, 0);
+
+        if (parsed_row.operand_count != 0)
+        {
+            const auto& operand = parsed_row_storage.GetOperand(parsed_row.first_operand);
+
+            if (operand.token_count != 0)
+            {
+                auto& token = parsed_row_storage.GetMutableToken(operand.first_token);
+
+                if (static_cast<TokenType>(token.type) == TokenType::kBranchLabelType)
+                {
+                    const auto label_iter = virtual_label_blocks_.find(parsed_row_storage.GetTokenText(token));
+
+                    if (label_iter != virtual_label_blocks_.end())
+                    {
+                        token.start_register_index = label_iter->second;
+                    }
+                }
+            }
+        }
+    }
+
+    row_storage = &parsed_row_storage;
+
+    return parsed_row_storage.GetRow(0, 0);
+}
+
+int IsaItemModel::GetParentRow(const QModelIndex& index) const
+{
+    if (UsesRowStorage())
+    {
+        return static_cast<int>(index.internalId()) - 1;
+    }
+
+    const QModelIndex parent_index = index.parent();
+
+    return parent_index.isValid() ? parent_index.row() : -1;
+}
+
+IsaItemModel::RowType IsaItemModel::GetRowType(int parent_row, int row) const
+{
+    if (storage_mode_ == StorageMode::kVirtual && parent_row != -1)
+    {
+        // Known without parsing the row.
+        return virtual_rows_.IsComment(parent_row, row) ? RowType::kComment : RowType::kCode;
+    }
+
+    if (UsesRowStorage())
+    {
+        const bool is_comment = (parent_row == -1) ? row_storage_.GetBlock(row).is_comment : row_storage_.GetRow(parent_row, row).is_comment;
+
+        return is_comment ? RowType::kComment : RowType::kCode;
+    }
+
+    if (parent_row == -1)
+    {
+        return blocks_.at(row)->row_type;
+    }
+
+    return blocks_.at(parent_row)->instruction_lines.at(row)->row_type;
+}
+
+uint32_t IsaItemModel::GetRowLineNumber(int parent_row, int row) const
+{
+    if (storage_mode_ == StorageMode::kVirtual && parent_row != -1)
+    {
+        // Known without parsing the row.
+        return virtual_rows_.GetLineNumber(parent_row, row);
+    }
+
+    if (UsesRowStorage())
+    {
+        return (parent_row == -1) ? row_storage_.GetBlock(row).line_number : row_storage_.GetRow(parent_row, row).line_number;
+    }
+
+    if (parent_row == -1)
+    {
+        return blocks_.at(row)->line_number;
+    }
+
+    return blocks_.at(parent_row)->instruction_lines.at(row)->line_number;
+}
+
+std::string_view IsaItemModel::GetRowText(int parent_row, int row) const
+{
+    if (UsesRowStorage())
+    {
+        if (parent_row == -1)
+        {
+            return row_storage_.GetText(row_storage_.GetBlock(row).text);
+        }
+
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        return row_storage->GetRowText(arena_row);
+    }
+
+    if (parent_row == -1)
+    {
+        const Block* block = blocks_.at(row).get();
+
+        if (block->row_type == RowType::kComment)
+        {
+            return static_cast<const CommentBlock*>(block)->text;
+        }
+        else if (block->row_type == RowType::kCode)
+        {
+            return static_cast<const InstructionBlock*>(block)->token.token_text;
+        }
+
+        return std::string_view();
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type == RowType::kCode)
+    {
+        return static_cast<const InstructionRow*>(child_row)->op_code_token.token_text;
+    }
+    else if (child_row->row_type == RowType::kComment)
+    {
+        return static_cast<const CommentRow*>(child_row)->text;
+    }
+
+    return std::string_view();
+}
+
+uint32_t IsaItemModel::GetOpCodeSymbol(int parent_row, int row) const
+{
+    if (parent_row == -1 || GetRowType(parent_row, row) != RowType::kCode)
+    {
+        return IsaSymbolTable::kInvalidSymbol;
+    }
+
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        return row_storage->GetToken(arena_row.op_code_token).symbol;
+    }
+
+    return static_cast<const InstructionRow*>(blocks_.at(parent_row)->instruction_lines.at(row).get())->op_code_token.symbol;
+}
+
+void IsaItemModel::SetSymbolTable(std::shared_ptr<IsaSymbolTable> symbol_table)
+{
+    if (symbol_table == nullptr)
+    {
+        symbol_table = IsaSymbolTable::GetGlobal();
+    }
+
+    if (symbol_table == row_storage_.GetSymbolTable())
+    {
+        return;
+    }
+
+    // Worker threads intern into the table they were started with.
+    CancelAsyncUpdate();
+
+    row_storage_.SetSymbolTable(symbol_table);
+    virtual_rows_.ClearParsedRows();
+
+    InternBlockTokens(true);
+}
+
+void IsaItemModel::InternBlockTokens(bool intern_all)
+{
+    IsaSymbolTable& symbol_table = *GetSymbolTable();
+
+    const auto intern = [&symbol_table, intern_all](Token& token) {
+        if (intern_all || token.symbol == IsaSymbolTable::kInvalidSymbol)
+        {
+            token.symbol = symbol_table.Intern(token.token_text);
+        }
+    };
+
+    for (auto& block : blocks_)
+    {
+        if (block->row_type == RowType::kCode)
+        {
+            intern(std::static_pointer_cast<InstructionBlock>(block)->token);
+        }
+
+        for (auto& child_row : block->instruction_lines)
+        {
+            if (child_row->row_type != RowType::kCode)
+            {
+                continue;
+            }
+
+            const auto instruction_row = std::static_pointer_cast<InstructionRow>(child_row);
+
+            intern(instruction_row->op_code_token);
+
+            for (auto& operand_tokens : instruction_row->operand_tokens)
+            {
+                for (auto& operand_token : operand_tokens)
+                {
+                    intern(operand_token);
+                }
+            }
+        }
+    }
+}
+
+std::string_view IsaItemModel::GetRowPcAddress(int parent_row, int row) const
+{
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        return row_storage->GetText(arena_row.pc_address);
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        return std::string_view();
+    }
+
+    return static_cast<const InstructionRow*>(child_row)->pc_address;
+}
+
+const uint32_t* IsaItemModel::GetRowWords(int parent_row, int row, size_t& word_count) const
+{
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        word_count = arena_row.word_count;
+
+        return row_storage->GetRowWords(arena_row);
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        word_count = 0;
+
+        return nullptr;
+    }
+
+    const auto& words = static_cast<const InstructionRow*>(child_row)->words;
+
+    word_count = words.size();
+
+    return words.data();
+}
+
+uint64_t IsaItemModel::GetRowDecoderEncoding(int parent_row, int row) const
+{
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        return row_storage->GetRowDecoderEncoding(arena_row);
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        return 0;
+    }
+
+    const auto* instruction = static_cast<const InstructionRow*>(child_row);
+
+    return IsaInstructionEncoding::GetDecoderEncoding(instruction->words.data(), instruction->number_words);
+}
+
+void IsaItemModel::GetRowOperandsText(int parent_row, int row, std::string& operands_text) const
+{
+    operands_text.clear();
+
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        for (uint32_t i = 0; i < arena_row.operand_count; i++)
+        {
+            const auto& operand = row_storage->GetOperand(arena_row.first_operand + i);
+
+            for (uint32_t j = 0; j < operand.token_count; j++)
+            {
+                operands_text += row_storage->GetTokenText(row_storage->GetToken(operand.first_token + j));
+
+                if (j != operand.token_count - 1)
+                {
+                    operands_text += kOperandTokenSpaceStdString;
+                }
+            }
+
+            if (i != arena_row.operand_count - 1)
+            {
+                operands_text += kOperandDelimiterStdString;
+            }
+        }
+
+        return;
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        return;
+    }
+
+    const auto& operand_token_groups = static_cast<const InstructionRow*>(child_row)->operand_tokens;
+
+    for (size_t i = 0; i < operand_token_groups.size(); i++)
+    {
+        const auto& operand_token_group = operand_token_groups.at(i);
+
+        for (size_t j = 0; j < operand_token_group.size(); j++)
+        {
+            operands_text += operand_token_group[j].token_text;
+
+            if (j != operand_token_group.size() - 1)
+            {
+                operands_text += kOperandTokenSpaceStdString;
+            }
+        }
+
+        if (i != operand_token_groups.size() - 1)
+        {
+            operands_text += kOperandDelimiterStdString;
+        }
+    }
+}
+
+bool IsaItemModel::GetRowEnabled(int parent_row, int row) const
+{
+    if (parent_row == -1)
+    {
+        return true;
+    }
+
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        return arena_row.is_comment || arena_row.enabled;
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        return true;
+    }
+
+    return static_cast<const InstructionRow*>(child_row)->enabled;
+}
+
+size_t IsaItemModel::GetBranchInstructionCount(int block_row) const
+{
+    if (block_row < 0)
+    {
+        return 0;
+    }
+
+    if (static_cast<size_t>(block_row) < control_flow_graph_.GetBlockCount())
+    {
+        const size_t branch_count = control_flow_graph_.GetBranchPredecessors(static_cast<uint32_t>(block_row)).size();
+
+        if (branch_count != 0)
+        {
+            return branch_count;
+        }
+    }
+
+    const auto* mapped_branch_instructions = GetMappedBranchInstructions(block_row);
+
+    return (mapped_branch_instructions != nullptr) ? mapped_branch_instructions->size() : 0;
+}
+
+std::pair<uint32_t, uint32_t> IsaItemModel::GetBranchInstruction(int block_row, size_t branch_index) const
+{
+    if (static_cast<size_t>(block_row) < control_flow_graph_.GetBlockCount())
+    {
+        const auto edges = control_flow_graph_.GetBranchPredecessors(static_cast<uint32_t>(block_row));
+
+        if (!edges.empty())
+        {
+            return std::make_pair(edges[branch_index].source_block, edges[branch_index].source_row);
+        }
+    }
+
+    return GetMappedBranchInstructions(block_row)->at(branch_index);
+}
+
+const std::vector<std::pair<uint32_t, uint32_t>>* IsaItemModel::GetMappedBranchInstructions(int block_row) const
+{
+    // Subclasses that override MapBlocksToBranchInstructions without calling it fill these lists instead of the graph.
+    if (storage_mode_ != StorageMode::kBlocks || block_row < 0 || static_cast<size_t>(block_row) >= blocks_.size() ||
+        blocks_[block_row]->row_type != RowType::kCode)
+    {
+        return nullptr;
+    }
+
+    return &static_cast<const InstructionBlock*>(blocks_[block_row].get())->mapped_branch_instructions;
+}
+
+int IsaItemModel::GetBranchTarget(int parent_row, int row) const
+{
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        if (arena_row.is_comment || arena_row.operand_count == 0)
+        {
+            return -1;
+        }
+
+        const auto& operand = row_storage->GetOperand(arena_row.first_operand);
+
+        if (operand.token_count == 0)
+        {
+            return -1;
+        }
+
+        const auto& token = row_storage->GetToken(operand.first_token);
+
+        if (static_cast<TokenType>(token.type) == TokenType::kBranchLabelType && token.start_register_index != -1)
+        {
+            return token.start_register_index;
+        }
+
+        return -1;
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        return -1;
+    }
+
+    const auto& operand_tokens = static_cast<const InstructionRow*>(child_row)->operand_tokens;
+
+    if (!operand_tokens.empty() && !operand_tokens.front().empty())
+    {
+        const auto& token = operand_tokens.front().front();
+
+        if (token.type == TokenType::kBranchLabelType && token.start_register_index != -1)
+        {
+            return token.start_register_index;
+        }
+    }
+
+    return -1;
+}
+
+std::string_view IsaItemModel::GetBranchTargetLabel(int parent_row, int row) const
+{
+    if (UsesRowStorage())
+    {
+        const IsaRowStorage* row_storage = nullptr;
+        const auto&          arena_row   = GetArenaRow(parent_row, row, row_storage);
+
+        if (arena_row.is_comment || arena_row.operand_count == 0)
+        {
+            return std::string_view();
+        }
+
+        const auto& operand = row_storage->GetOperand(arena_row.first_operand);
+
+        if (operand.token_count == 0)
+        {
+            return std::string_view();
+        }
+
+        return row_storage->GetTokenText(row_storage->GetToken(operand.first_token));
+    }
+
+    const Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        return std::string_view();
+    }
+
+    const auto& operand_tokens = static_cast<const InstructionRow*>(child_row)->operand_tokens;
+
+    if (operand_tokens.empty() || operand_tokens.front().empty())
+    {
+        return std::string_view();
+    }
+
+    return operand_tokens.front().front().token_text;
+}
+
+void IsaItemModel::SetBranchTarget(int parent_row, int row, int block_row)
+{
+    if (storage_mode_ == StorageMode::kVirtual)
+    {
+        // Branch targets of virtual rows are resolved when the rows are parsed; see GetArenaRow.
+        return;
+    }
+
+    if (storage_mode_ == StorageMode::kArena)
+    {
+        const auto& arena_row = row_storage_.GetRow(parent_row, row);
+
+        if (arena_row.is_comment || arena_row.operand_count == 0)
+        {
+            return;
+        }
+
+        const auto& operand = row_storage_.GetOperand(arena_row.first_operand);
+
+        if (operand.token_count != 0)
+        {
+            row_storage_.GetMutableToken(operand.first_token).start_register_index = static_cast<int32_t>(block_row);
+        }
+
+        return;
+    }
+
+    Row* child_row = blocks_.at(parent_row)->instruction_lines.at(row).get();
+
+    if (child_row->row_type != RowType::kCode)
+    {
+        return;
+    }
+
+    auto& operand_tokens = static_cast<InstructionRow*>(child_row)->operand_tokens;
+
+    if (!operand_tokens.empty() && !operand_tokens.front().empty())
+    {
+        operand_tokens.front().front().start_register_index = block_row;
+    }
+}
+
+bool IsaItemModel::ParseSourceBlocks(const std::vector<SourceBlock>& blocks,
+                                     size_t                          first_block,
+                                     size_t                          last_block,
+                                     qreal                           fixed_character_width,
+                                     const std::atomic<bool>&        canceled,
+                                     IsaRowStorage&                  row_storage)
+{
+    size_t row_count = 0;
+
+    for (size_t block_index = first_block; block_index < last_block; block_index++)
+    {
+        row_count += blocks[block_index].rows.size();
+    }
+
+    row_storage.Reserve(last_block - first_block, row_count, 0, 0);
+
+    for (size_t block_index = first_block; block_index < last_block; block_index++)
+    {
+        if (canceled)
+        {
+            return false;
+        }
+
+        const auto& block = blocks[block_index];
+
+        IsaRowTokenizer::AppendBlock(row_storage, block.row_type == RowType::kComment, block.line_number, block.text, fixed_character_width);
+
+        for (const auto& row : block.rows)
+        {
+            if (row.row_type == RowType::kComment)
+            {
+                IsaRowTokenizer::AppendComment(row_storage, row.line_number, row.text);
+            }
+            else
+            {
+                IsaRowTokenizer::AppendInstruction(
+                    row_storage, row.line_number, row.text, row.operands, row.pc_address, row.binary_representation, row.enabled, fixed_character_width);
+            }
+        }
+    }
+
+    return true;
+}
+
+void IsaItemModel::PublishAsyncUpdateBatch(uint64_t generation, size_t batch_index, std::shared_ptr<IsaRowStorage> batch)
+{
+    QTISAGUI_SCOPED_TIMER(kUpdateData);
+
+    if (generation != async_update_generation_ || async_update_threads_.empty())
+    {
+        // This batch belongs to an update that was canceled or replaced.
+        return;
+    }
+
+    async_update_pending_batches_[batch_index] = std::move(batch);
+
+    // Insert every batch that is next in line; later batches wait until the batches before them are done.
+
+    bool published = false;
+
+    auto pending_iter = async_update_pending_batches_.begin();
+
+    while (pending_iter != async_update_pending_batches_.end() && pending_iter->first == async_update_next_published_batch_)
+    {
+        const IsaRowStorage& pending_batch = *pending_iter->second;
+
+        const int first_row = static_cast<int>(row_storage_.GetBlockCount());
+        const int last_row  = first_row + static_cast<int>(pending_batch.GetBlockCount()) - 1;
+
+        beginInsertRows(QModelIndex(), first_row, last_row);
+        row_storage_.Append(pending_batch);
+        endInsertRows();
+
+        async_update_published_block_count_ += static_cast<int>(pending_batch.GetBlockCount());
+        async_update_next_published_batch_++;
+
+        pending_iter = async_update_pending_batches_.erase(pending_iter);
+
+        published = true;
+    }
+
+    if (!published)
+    {
+        return;
+    }
+
+    emit AsyncUpdateProgress(async_update_published_block_count_, static_cast<int>(async_update_batch_offsets_.back()));
+
+    if (async_update_next_published_batch_ + 1 < async_update_batch_offsets_.size())
+    {
+        return;
+    }
+
+    // Every batch is in; the worker threads are done or about to be.
+
+    StopAsyncUpdateThreads();
+
+    MapBlocksToBranchInstructions();
+    CacheSizeHints();
+
+    if (!model_cache_path_.isEmpty())
+    {
+        // The cache only saves time; a file that could not be written is parsed again the next time.
+        SaveModelCache(model_cache_path_, model_cache_key_);
+        model_cache_path_.clear();
+    }
+
+    // Branch targets were not known while the rows were being published.
+    emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+
+    emit AsyncUpdateFinished(false);
+}
+
+bool IsaItemModel::PrepareSearch(const QString&            text,
+                                 const std::vector<int>&   columns,
+                                 IsaSearchIndex::MatchMode mode,
+                                 IsaSearchIndex::Query&    query,
+                                 std::vector<size_t>&      search_columns)
+{
+    // Columns are indexed below, which must not happen while worker threads read the index.
+    CancelSearch();
+
+    search_text_.clear();
+    search_columns.clear();
+
+    const std::string query_text = text.toStdString();
+
+    // The index ignores ascii case only, and relies on the line numbers mapped by CacheSizeHints.
+    // Virtual models parse rows on demand, so indexing them would parse the whole file; they are not searched.
+    if (!IsaSearchIndex::IsAscii(query_text) || storage_mode_ == StorageMode::kVirtual || (line_number_corresponding_indices_.empty() && rowCount() > 0))
+    {
+        return false;
+    }
+
+    for (const int column : columns)
+    {
+        if (column <= kLineNumber || column >= kColumnCount)
+        {
+            return false;
+        }
+    }
+
+    if (!query.Compile(query_text, mode))
+    {
+        return false;
+    }
+
+    for (const int column : columns)
+    {
+        if (!search_index_.HasColumn(column))
+        {
+            BuildSearchIndexColumn(column);
+        }
+
+        search_columns.push_back(static_cast<size_t>(column));
+    }
+
+    std::sort(search_columns.begin(), search_columns.end());
+    search_columns.erase(std::unique(search_columns.begin(), search_columns.end()), search_columns.end());
+
+    return true;
+}
+
+bool IsaItemModel::LoadModelCache(const QString& file_path, uint64_t key)
+{
+    QTISAGUI_SCOPED_TIMER(kLoadModelCache);
+
+    QFile file(file_path);
+
+    if (!file.open(QIODevice::ReadOnly) || file.size() < static_cast<qint64>(sizeof(ModelCacheHeader)))
+    {
+        return false;
+    }
+
+    // The records are copied straight out of the mapped file; the file is unmapped when it is closed.
+    const uchar* data = file.map(0, file.size());
+
+    if (data == nullptr)
+    {
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(file.size());
+
+    ModelCacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, kModelCacheMagic, sizeof(kModelCacheMagic)) != 0 || header.version != kModelCacheVersion || header.key != key)
+    {
+        return false;
+    }
+
+    // What SaveModelCache kept of MapBlocksToBranchInstructions and CacheSizeHints, so neither has to look at every row again.
+
+    size_t                           offset           = sizeof(header);
+    std::array<double, kColumnCount> character_counts = {};
+    uint64_t                         edge_count       = 0;
+
+    if (!ReadModelCacheValues(data, size, offset, character_counts.size(), character_counts.data()) ||
+        !ReadModelCacheValues(data, size, offset, 1, &edge_count) || edge_count > (size - offset) / sizeof(ModelCacheEdge))
+    {
+        return false;
+    }
+
+    std::vector<ModelCacheEdge> cached_edges(static_cast<size_t>(edge_count));
+
+    if (!ReadModelCacheValues(data, size, offset, cached_edges.size(), cached_edges.data()))
+    {
+        return false;
+    }
+
+    for (const double character_count : character_counts)
+    {
+        if (!std::isfinite(character_count) || character_count < 0)
+        {
+            return false;
+        }
+    }
+
+    CancelAsyncUpdate();
+
+    beginResetModel();
+
+    blocks_.clear();
+    ClearRowStorage();
+    line_number_corresponding_indices_.clear();
+    block_line_numbers_.clear();
+
+    storage_mode_ = StorageMode::kArena;
+
+    bool loaded = row_storage_.Deserialize(reinterpret_cast<const char*>(data) + offset, size - offset);
+
+    // Every edge must refer to rows that exist, like every record of the storage.
+
+    const size_t                           block_count = row_storage_.GetBlockCount();
+    std::vector<IsaControlFlowGraph::Edge> edges;
+
+    edges.reserve(cached_edges.size());
+
+    for (size_t i = 0; loaded && i < cached_edges.size(); i++)
+    {
+        const ModelCacheEdge& edge = cached_edges[i];
+
+        loaded = edge.source_block < block_count && edge.kind <= static_cast<uint32_t>(IsaControlFlowGraph::EdgeKind::kIndirect) &&
+                 (edge.target_block == IsaControlFlowGraph::kInvalidIndex || edge.target_block < block_count) &&
+                 (edge.source_row == IsaControlFlowGraph::kInvalidIndex || edge.source_row < row_storage_.GetBlock(edge.source_block).row_count);
+
+        edges.push_back({edge.source_block, edge.source_row, edge.target_block, static_cast<IsaControlFlowGraph::EdgeKind>(edge.kind)});
+    }
+
+    if (!loaded)
+    {
+        ClearRowStorage();
+    }
+
+    endResetModel();
+
+    if (!loaded)
+    {
+        return false;
+    }
+
+    QTISAGUI_COUNT_ITEMS(kLoadModelCache, row_storage_.GetRowCount());
+
+    // Branch targets are part of the storage; only the graph has to be put back.
+    control_flow_graph_.Build(block_count, edges);
+
+    // Line numbers are mapped again; checking mapped line numbers read from the file against the rows would cost as much.
+    InvalidateDerivedState(false);
+
+    virtual_line_count_ = 0;
+
+    line_number_corresponding_indices_.reserve(block_count + row_storage_.GetRowCount());
+    block_line_numbers_.reserve(block_count);
+
+    for (uint32_t block_index = 0; block_index < block_count; block_index++)
+    {
+        const uint32_t row_count = row_storage_.GetBlock(block_index).row_count;
+
+        block_line_numbers_.push_back(static_cast<uint32_t>(line_number_corresponding_indices_.size()));
+        line_number_corresponding_indices_.emplace_back(-1, block_index);
+
+        for (uint32_t row_index = 0; row_index < row_count; row_index++)
+        {
+            line_number_corresponding_indices_.emplace_back(block_index, row_index);
+        }
+    }
+
+    for (int column = 0; column < kColumnCount; column++)
+    {
+        column_character_counts_[column] = static_cast<qreal>(character_counts[column]);
+    }
+
+    UpdateColumnWidths();
+
+    BuildRowIndices();
+
+    emit AsyncUpdateFinished(false);
+
+    return true;
+}
+
+bool IsaItemModel::SaveModelCache(const QString& file_path, uint64_t key) const
+{
+    QTISAGUI_SCOPED_TIMER(kSaveModelCache);
+
+    if (!QDir().mkpath(QFileInfo(file_path).absolutePath()))
+    {
+        return false;
+    }
+
+    // Written to a temporary file that replaces the cache file on commit, so a partial file is never mapped.
+    QSaveFile file(file_path);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    auto write = [&file](const void* data, size_t size) {
+        return file.write(reinterpret_cast<const char*>(data), static_cast<qint64>(size)) == static_cast<qint64>(size);
+    };
+
+    ModelCacheHeader header;
+
+    std::memcpy(header.magic, kModelCacheMagic, sizeof(kModelCacheMagic));
+    header.version  = kModelCacheVersion;
+    header.reserved = 0;
+    header.key      = key;
+
+    std::array<double, kColumnCount> character_counts = {};
+
+    for (int column = 0; column < kColumnCount; column++)
+    {
+        character_counts[column] = static_cast<double>(column_character_counts_[column]);
+    }
+
+    const auto&                 graph_edges = control_flow_graph_.GetEdges();
+    const uint64_t              edge_count  = graph_edges.size();
+    std::vector<ModelCacheEdge> edges;
+
+    edges.reserve(graph_edges.size());
+
+    for (const auto& edge : graph_edges)
+    {
+        edges.push_back({edge.source_block, edge.source_row, edge.target_block, static_cast<uint32_t>(edge.kind)});
+    }
+
+    const bool written = write(&header, sizeof(header)) && write(character_counts.data(), sizeof(character_counts)) &&
+                         write(&edge_count, sizeof(edge_count)) && write(edges.data(), edges.size() * sizeof(ModelCacheEdge)) &&
+                         row_storage_.Serialize([&write](const char* data, size_t size) { return write(data, size); });
+
+    if (!written)
+    {
+        file.cancelWriting();
+
+        return false;
+    }
+
+    return file.commit();
+}
+
+void IsaItemModel::PublishSearchResults(uint64_t generation, size_t chunk_index, std::shared_ptr<IsaSearchIndex::Results> results)
+{
+    if (generation != search_generation_)
+    {
+        return;
+    }
+
+    search_pending_results_.emplace(chunk_index, std::move(results));
+
+    bool published = false;
+
+    for (auto chunk_iter = search_pending_results_.begin();
+         chunk_iter != search_pending_results_.end() && chunk_iter->first == search_next_published_chunk_;
+         chunk_iter = search_pending_results_.erase(chunk_iter))
+    {
+        search_index_.AppendResults(*chunk_iter->second);
+
+        search_next_published_chunk_++;
+        published = true;
+    }
+
+    if (!published)
+    {
+        return;
+    }
+
+    const bool finished = search_next_published_chunk_ == search_chunk_count_;
+
+    if (finished)
+    {
+        // Every chunk is in; the worker threads are done or about to be.
+        StopSearchThreads();
+
+        search_index_.EndResults();
+    }
+
+    emit SearchUpdated(finished);
+}
+
+void IsaItemModel::BuildSearchIndexColumn(int column)
+{
+    search_index_.BeginColumn(column);
+
+    std::string buffer;
+
+    for (const auto& line : line_number_corresponding_indices_)
+    {
+        const int parent_row = (line.first == static_cast<uint32_t>(-1)) ? -1 : static_cast<int>(line.first);
+        const int row        = static_cast<int>(line.second);
+
+        search_index_.AppendLine(column, GetLineText(parent_row, row, column, buffer));
+    }
+}
+
+void IsaItemModel::BuildRegisterIndex()
+{
+    std::vector<IsaRegisterIndex::RegisterOperand> register_operands;
+    std::vector<TokenView>                         tokens;
+
+    for (size_t line = 0; line < line_number_corresponding_indices_.size(); line++)
+    {
+        const auto& line_indices = line_number_corresponding_indices_[line];
+
+        if (line_indices.first == static_cast<uint32_t>(-1))
+        {
+            // Blocks have no operands.
+            continue;
+        }
+
+        GetTokens(index(static_cast<int>(line_indices.second), kOperands, index(static_cast<int>(line_indices.first), 0)), tokens);
+
+        for (size_t token_index = 0; token_index < tokens.size(); token_index++)
+        {
+            const auto& token = tokens[token_index];
+
+            if ((token.type != TokenType::kScalarRegisterType && token.type != TokenType::kVectorRegisterType) || token.start_register_index == -1)
+            {
+                continue;
+            }
+
+            const bool is_scalar = token.type == TokenType::kScalarRegisterType;
+
+            IsaRegisterIndex::RegisterOperand register_operand;
+
+            register_operand.register_file         = is_scalar ? IsaRegisterIndex::RegisterFile::kScalar : IsaRegisterIndex::RegisterFile::kVector;
+            register_operand.start_register_index  = token.start_register_index;
+            register_operand.end_register_index    = token.end_register_index;
+            register_operand.reference.line_number = static_cast<uint32_t>(line);
+            register_operand.reference.token_index = static_cast<uint32_t>(token_index);
+
+            register_operands.push_back(register_operand);
+        }
+    }
+
+    register_index_.Build(register_operands);
+}
+
+std::string_view IsaItemModel::GetLineText(int parent_row, int row, int column, std::string& buffer) const
+{
+    if (column == kOpCode)
+    {
+        // Code block label, comment, or instruction op code.
+        return GetRowText(parent_row, row);
+    }
+
+    if (parent_row == -1 || GetRowType(parent_row, row) != RowType::kCode)
+    {
+        // Only instruction lines have text in the other columns.
+        return std::string_view();
+    }
+
+    if (column == kOperands)
+    {
+        GetRowOperandsText(parent_row, row, buffer);
+        return buffer;
+    }
+    else if (column == kPcAddress)
+    {
+        return GetRowPcAddress(parent_row, row);
+    }
+    else if (column == kBinaryRepresentation)
+    {
+        size_t          word_count = 0;
+        const uint32_t* words      = GetRowWords(parent_row, row, word_count);
+
+        IsaInstructionEncoding::Format(words, word_count, buffer);
+        return buffer;
+    }
+
+    return std::string_view();
+}
+
+void IsaItemModel::GetValidExportRanges(const std::vector<ExportRange>& ranges, std::vector<ExportRange>& valid_ranges) const
+{
+    valid_ranges.clear();
+    valid_ranges.reserve(ranges.size());
+
+    const int block_count = rowCount();
+
+    for (const auto& range : ranges)
+    {
+        if (range.parent_row < -1 || range.parent_row >= block_count)
+        {
+            continue;
+        }
+
+        const int row_count = (range.parent_row == -1) ? block_count : rowCount(index(range.parent_row, 0));
+
+        ExportRange valid_range;
+
+        valid_range.parent_row = range.parent_row;
+        valid_range.first_row  = std::max(range.first_row, 0);
+        valid_range.last_row   = std::min(range.last_row, row_count - 1);
+
+        if (valid_range.first_row <= valid_range.last_row)
+        {
+            valid_ranges.push_back(valid_range);
+        }
+    }
+}
+
+std::string_view IsaItemModel::GetExportText(int parent_row, int row, int column, ExportFormat format, std::string& buffer) const
+{
+    if (column == kLineNumber)
+    {
+        buffer = std::to_string(GetRowLineNumber(parent_row, row));
+        return buffer;
+    }
+
+    const std::string_view text = GetLineText(parent_row, row, column, buffer);
+
+    if (format == ExportFormat::kText && column == kOpCode && parent_row != -1 && GetRowType(parent_row, row) == RowType::kCode)
+    {
+        // The op code column text is a view of the row, never of the buffer.
+        buffer.assign(kExportOpCodeIndent);
+        buffer.append(text);
+        return buffer;
+    }
+
+    return text;
+}
+
+size_t IsaItemModel::MeasureExport(const std::vector<ExportRange>& ranges,
+                                   const std::vector<int>&         columns,
+                                   ExportFormat                    format,
+                                   std::vector<size_t>&            widths) const
+{
+    widths.assign(columns.size(), 0);
+
+    std::string buffer;
+    size_t      row_count = 0;
+    size_t      size      = 0;
+
+    for (const auto& range : ranges)
+    {
+        for (int row = range.first_row; row <= range.last_row; row++)
+        {
+            // Code block labels and comments span every column when shown, so they do not widen any column but the line numbers.
+            const bool is_instruction = range.parent_row != -1 && GetRowType(range.parent_row, row) == RowType::kCode;
+
+            for (size_t i = 0; i < columns.size(); i++)
+            {
+                const std::string_view text = GetExportText(range.parent_row, row, columns[i], format, buffer);
+
+                if (format == ExportFormat::kText)
+                {
+                    if (is_instruction || columns[i] == kLineNumber)
+                    {
+                        widths[i] = std::max(widths[i], GetCharacterCount(text));
+                    }
+                }
+                else
+                {
+                    // Quoted values also double their quotes.
+                    size += text.size() + (IsCsvQuoteNeeded(text) ? 2 + static_cast<size_t>(std::count(text.begin(), text.end(), '"')) : 0);
+                }
+            }
+
+            row_count++;
+        }
+    }
+
+    if (format == ExportFormat::kText)
+    {
+        // Every column is padded and followed by a tab and a space; rows are separated by a line break.
+        size_t row_size = 1;
+
+        for (const size_t width : widths)
+        {
+            row_size += width + 2;
+        }
+
+        return row_count * row_size;
+    }
+
+    // The header and a comma between columns and a line break after every row.
+    for (const int column : columns)
+    {
+        size += (column == kLineNumber) ? kExportLineNumberColumnName.size() : kColumnNames[column].size();
+    }
+
+    return size + (row_count + 1) * (columns.size() + 1);
+}
+
+bool IsaItemModel::WriteExport(const std::vector<ExportRange>&              ranges,
+                               const std::vector<int>&                      columns,
+                               ExportFormat                                 format,
+                               const std::vector<size_t>&                   widths,
+                               std::string&                                 output,
+                               const std::function<bool(std::string_view)>* write) const
+{
+    // Comments show their text right after their line number, wherever the op code column is; export them the same way.
+    std::vector<size_t> column_order;
+    std::vector<size_t> comment_column_order;
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        column_order.push_back(i);
+
+        if (columns[i] == kLineNumber)
+        {
+            comment_column_order.push_back(i);
+        }
+    }
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        if (columns[i] == kOpCode)
+        {
+            comment_column_order.push_back(i);
+        }
+    }
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        if (columns[i] != kLineNumber && columns[i] != kOpCode)
+        {
+            comment_column_order.push_back(i);
+        }
+    }
+
+    if (format == ExportFormat::kCsv)
+    {
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            if (i > 0)
+            {
+                output.push_back(',');
+            }
+
+            AppendCsvValue((columns[i] == kLineNumber) ? kExportLineNumberColumnName : kColumnNames[columns[i]], output);
+        }
+
+        output.append("\r\n");
+    }
+
+    std::string buffer;
+    bool        first_row = true;
+
+    for (const auto& range : ranges)
+    {
+        for (int row = range.first_row; row <= range.last_row; row++)
+        {
+            if (format == ExportFormat::kText)
+            {
+                const bool is_comment = GetRowType(range.parent_row, row) == RowType::kComment;
+
+                if (!first_row)
+                {
+                    output.push_back('\n');
+                }
+
+                for (const size_t i : (is_comment ? comment_column_order : column_order))
+                {
+                    const std::string_view text            = GetExportText(range.parent_row, row, columns[i], format, buffer);
+                    const size_t           character_count = GetCharacterCount(text);
+
+                    output.append(text);
+
+                    if (character_count < widths[i])
+                    {
+                        output.append(widths[i] - character_count, ' ');
+                    }
+
+                    output.append("\t ");
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < columns.size(); i++)
+                {
+                    if (i > 0)
+                    {
+                        output.push_back(',');
+                    }
+
+                    AppendCsvValue(GetExportText(range.parent_row, row, columns[i], format, buffer), output);
+                }
+
+                output.append("\r\n");
+            }
+
+            first_row = false;
+
+            if (write != nullptr && output.size() >= kExportChunkSize)
+            {
+                if (!(*write)(output))
+                {
+                    return false;
+                }
+
+                output.clear();
+            }
+        }
+    }
+
+    if (write != nullptr && !output.empty())
+    {
+        if (!(*write)(output))
+        {
+            return false;
+        }
+
+        output.clear();
+    }
+
+    return true;
+}
+
+void IsaItemModel::SetDisplayTextCacheEnabled(bool enabled)
+{
+    if (enabled == display_text_cache_enabled_)
+    {
+        return;
+    }
+
+    display_text_cache_enabled_ = enabled;
+
+    if (enabled)
+    {
+        BuildDisplayTextCache();
+    }
+    else
+    {
+        ClearDisplayTextCache();
+    }
+}
+
+void IsaItemModel::BuildDisplayTextCache()
+{
+    ClearDisplayTextCache();
+
+    // Line numbers are only mapped once the rows are in; see CacheSizeHints.
+    if (line_number_corresponding_indices_.empty())
+    {
+        return;
+    }
+
+    const size_t line_count = line_number_corresponding_indices_.size();
+
+    for (const int column : {kOpCode, kOperands, kPcAddress, kBinaryRepresentation})
+    {
+        display_text_cache_[column].reserve(line_count);
+    }
+
+    std::string buffer;
+
+    for (size_t line = 0; line < line_count; line++)
+    {
+        const auto& line_indices = line_number_corresponding_indices_[line];
+
+        const int parent_row = (line_indices.first == static_cast<uint32_t>(-1)) ? -1 : static_cast<int>(line_indices.first);
+        const int row        = static_cast<int>(line_indices.second);
+
+        for (const int column : {kOpCode, kOperands, kPcAddress, kBinaryRepresentation})
+        {
+            const std::string_view text = GetLineText(parent_row, row, column, buffer);
+
+            display_text_cache_[column].push_back(QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size())));
+        }
+    }
+}
+
+void IsaItemModel::ClearDisplayTextCache()
+{
+    for (auto& column_text : display_text_cache_)
+    {
+        column_text.clear();
+        column_text.shrink_to_fit();
+    }
+}
+
+void IsaItemModel::InvalidateDerivedState(bool model_reset)
+{
+    // Search threads read the index, so stop them first.
+    CancelSearch();
+    search_index_.Clear();
+
+    // The register index and the cached display text are rebuilt by CacheSizeHints once the new rows are in.
+    register_index_.Clear();
+    ClearDisplayTextCache();
+
+    // Metric values belong to the lines of the old rows. Rows appended by an asynchronous update keep the line numbers of
+    // the rows before them; UpdateBlocks, which renumbers lines, clears the values itself once the new line numbers are known.
+    if (model_reset)
+    {
+        metric_columns_.ClearValues();
+    }
+}
+
+bool IsaItemModel::GetCachedDisplayText(int parent_row, int row, int column, QString& text) const
+{
+    if (!display_text_cache_enabled_ || column < 0 || column >= kColumnCount)
+    {
+        return false;
+    }
+
+    const int line = GetLineNumber(parent_row, row);
+
+    const auto& column_text = display_text_cache_[column];
+
+    if (line == -1 || static_cast<size_t>(line) >= column_text.size())
+    {
+        return false;
+    }
+
+    text = column_text[line];
+
+    return true;
+}
+
+void IsaItemModel::StartPredecodeThread()
+{
+    StopPredecodeThread();
+
+    const std::shared_ptr<IsaArchitectureDecoder> decoder = isa_decoder_;
+
+    if (decoder == nullptr)
+    {
+        return;
+    }
+
+    // Gather the distinct encodings of every instruction; line numbers are mapped to rows by CacheSizeHints.
+    std::vector<uint64_t> encodings;
+
+    encodings.reserve(line_number_corresponding_indices_.size());
+
+    for (const auto& line : line_number_corresponding_indices_)
+    {
+        if (line.first == static_cast<uint32_t>(-1))
+        {
+            continue;
+        }
+
+        const int parent_row = static_cast<int>(line.first);
+        const int row        = static_cast<int>(line.second);
+
+        if (GetRowType(parent_row, row) == RowType::kCode)
+        {
+            encodings.push_back(GetRowDecoderEncoding(parent_row, row));
+        }
+    }
+
+    std::sort(encodings.begin(), encodings.end());
+    encodings.erase(std::unique(encodings.begin(), encodings.end()), encodings.end());
+
+    if (encodings.empty() && isa_decoder_announced_)
+    {
+        return;
+    }
+
+    predecode_canceled_ = false;
+
+    predecode_thread_ = std::thread([this, decoder, encodings = std::move(encodings)]() {
+        if (!decoder->WaitUntilLoaded(predecode_canceled_))
+        {
+            return;
+        }
+
+        // Announce the decoder on the gui thread, unless the architecture changed again in the meantime.
+        QMetaObject::invokeMethod(
+            this,
+            [this, decoder]() {
+                if (decoder == isa_decoder_ && !isa_decoder_announced_)
+                {
+                    isa_decoder_announced_ = true;
+
+                    emit ArchitectureChanged(decoder->HasDecoder());
+                }
+            },
+            Qt::QueuedConnection);
+
+        decoder->Predecode(encodings, predecode_canceled_);
+    });
+}
+
+void IsaItemModel::StopPredecodeThread()
+{
+    if (!predecode_thread_.joinable())
+    {
+        return;
+    }
+
+    predecode_canceled_ = true;
+
+    predecode_thread_.join();
+}
+
+void IsaItemModel::StopAsyncUpdateThreads()
+{
+    async_update_canceled_ = true;
+
+    for (auto& thread : async_update_threads_)
+    {
+        thread.join();
+    }
+
+    async_update_threads_.clear();
+    async_update_pending_batches_.clear();
+
+    // Batches still queued on the GUI thread are dropped when they arrive.
+    async_update_generation_++;
+}
+
+void IsaItemModel::StopSearchThreads()
+{
+    search_canceled_ = true;
+
+    for (auto& thread : search_threads_)
+    {
+        thread.join();
+    }
+
+    search_threads_.clear();
+    search_pending_results_.clear();
+
+    // Chunks still queued on the GUI thread are dropped when they arrive.
+    search_generation_++;
 }
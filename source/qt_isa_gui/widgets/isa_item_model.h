@@ -13,14 +13,31 @@
 #include <QFont>
 
 #include <array>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "amdisa/isa_decoder.h"
 
+#include "qt_isa_gui/core/isa_control_flow_graph.h"
+#include "qt_isa_gui/core/isa_metric_columns.h"
+#include "qt_isa_gui/core/isa_register_index.h"
+#include "qt_isa_gui/core/isa_row_storage.h"
+#include "qt_isa_gui/core/isa_search_index.h"
+#include "qt_isa_gui/core/isa_symbol_table.h"
+#include "qt_isa_gui/core/isa_virtual_row_source.h"
+#include "qt_isa_gui/utility/isa_dictionary.h"
+
+class IsaArchitectureDecoder;
 class IsaTreeView;
+class QFile;
 
 /// @brief IsaItemModel is an item model that stores shader isa and comments, intended to be displayed in a tree view.
 ///
@@ -73,27 +90,54 @@ public:
     };
 
     /// @brief Predefined types to assist formatting and user interaction with tokens.
-    enum class TokenType
-    {
-        kLabelType = 0,       ///< Code block label in op code column.
-        kBranchLabelType,     ///< Label targeted by a branch instruction in operands column.
-        kScalarRegisterType,  ///< Scalar operand.
-        kVectorRegisterType,  ///< Vector operand.
-        kConstantType,        ///< Constant operand.
-        kTypeCount
+    using TokenType = IsaTokenType;
+
+    /// @brief Predefined ways of storing the rows of this model.
+    enum class StorageMode
+    {
+        kBlocks = 0,  ///< Rows are individually allocated Block and Row objects in blocks_.
+        kArena,       ///< Rows, tokens and their text are stored contiguously in row_storage_; see AppendCodeBlock and friends.
+        kVirtual,     ///< Blocks are stored in row_storage_, rows stay in a memory mapped file until they are shown; see BeginVirtualUpdate.
+    };
+
+    /// @brief Predefined ways a line of a memory mapped shader is shown; see ClassifyVirtualLine.
+    enum class VirtualLineType
+    {
+        kSkip = 0,      ///< The line is not shown.
+        kCodeBlock,     ///< The line is the label of a new code block.
+        kCommentBlock,  ///< The line starts a new comment block.
+        kInstruction,   ///< The line is an instruction of the current block.
+        kComment,       ///< The line is a comment of the current block.
+    };
+
+    /// @brief Predefined formats rows can be exported in; see ExportRows.
+    enum class ExportFormat
+    {
+        kText = 0,  ///< Columns padded to their widest instruction text and separated by tabs, the way rows are copied to the clipboard.
+        kCsv,       ///< Comma separated values under a header of column names, quoted as in RFC 4180.
+    };
+
+    /// @brief Consecutive rows of the same parent to export.
+    struct ExportRange
+    {
+        int parent_row;  ///< The parent row, or -1 for parent blocks.
+        int first_row;   ///< The first row.
+        int last_row;    ///< The last row.
     };
 
     /// @brief Token is a convenience struct intended to act as a temporary representation of a single word of isa.
     ///        It assists color coding and user interaction, like selecting/highlighting.
     typedef struct Token
     {
-        std::string token_text;            ///< The token's isa text.
-        TokenType   type;                  ///< The type of this token.
-        int         start_register_index;  ///< The starting register index if this token represents a register.
-        int         end_register_index;    ///< The ending register index if this token represents a register.
-        qreal       x_position_start;      ///< The token's starting x view position.
-        qreal       x_position_end;        ///< The token's ending x view position.
-        bool        is_selectable;         ///< true if the token can be selected, false otherwise.
+        std::string   token_text;            ///< The token's isa text.
+        uint32_t      symbol;                ///< The id of token_text in the model's symbol table, or IsaSymbolTable::kInvalidSymbol.
+        TokenType     type;                  ///< The type of this token.
+        int           start_register_index;  ///< The starting register index if this token represents a register.
+        int           end_register_index;    ///< The ending register index if this token represents a register.
+        qreal         x_position_start;      ///< The token's starting x view position.
+        qreal         x_position_end;        ///< The token's ending x view position.
+        bool          is_selectable;         ///< true if the token can be selected, false otherwise.
+        IsaColorClass color_class;           ///< The color coding class of the token's text; resolved once when parsed.
 
         /// @brief Constructor; create an empty token.
         Token()
@@ -105,18 +149,77 @@ public:
         void Clear()
         {
             token_text           = "";
+            symbol               = IsaSymbolTable::kInvalidSymbol;
             type                 = TokenType::kTypeCount;
             start_register_index = -1;
             end_register_index   = -1;
             x_position_start     = -1;
             x_position_end       = -1;
             is_selectable        = false;
+            color_class          = IsaColorClass::kNone;
         }
     } Token;
 
+    /// @brief TokenView is a read only view of a token stored in this model.
+    ///        Its text refers to the model's storage instead of being copied, so a view is only valid until the rows of the model change.
+    struct TokenView
+    {
+        std::string_view token_text;            ///< The token's isa text.
+        uint32_t         symbol;                ///< The id of token_text in the model's symbol table, or IsaSymbolTable::kInvalidSymbol.
+        TokenType        type;                  ///< The type of this token.
+        int              start_register_index;  ///< The starting register index if this token represents a register.
+        int              end_register_index;    ///< The ending register index if this token represents a register.
+        qreal            x_position_start;      ///< The token's starting x view position.
+        qreal            x_position_end;        ///< The token's ending x view position.
+        bool             is_selectable;         ///< true if the token can be selected, false otherwise.
+        IsaColorClass    color_class;           ///< The color coding class of the token's text.
+
+        /// @brief Make a token that owns a copy of this view's text.
+        ///
+        /// @return The token.
+        Token ToToken() const
+        {
+            Token token;
+
+            token.token_text           = std::string(token_text);
+            token.symbol               = symbol;
+            token.type                 = type;
+            token.start_register_index = start_register_index;
+            token.end_register_index   = end_register_index;
+            token.x_position_start     = x_position_start;
+            token.x_position_end       = x_position_end;
+            token.is_selectable        = is_selectable;
+            token.color_class          = color_class;
+
+            return token;
+        }
+    };
+
+    /// @brief Unparsed text of a single child row, to be parsed by BeginAsyncUpdate.
+    struct SourceRow
+    {
+        RowType                  row_type    = RowType::kCode;  ///< The type of this row.
+        uint32_t                 line_number = 0;               ///< Line # relative to the entire shader.
+        std::string              text;                          ///< The op code text of an instruction, or the text of a comment.
+        std::vector<std::string> operands;                      ///< The operand strings of an instruction.
+        std::string              pc_address;                    ///< The pc address text of an instruction.
+        std::string              binary_representation;         ///< The binary representation text of an instruction.
+        bool                     enabled = true;                ///< true if this instruction should be color coded, false otherwise.
+    };
+
+    /// @brief Unparsed text of a single parent block and its rows, to be parsed by BeginAsyncUpdate.
+    struct SourceBlock
+    {
+        RowType                row_type    = RowType::kCode;  ///< The type of this block.
+        uint32_t               line_number = 0;               ///< Line # relative to the entire shader.
+        std::string            text;                          ///< The label of a code block, or the text of a comment block.
+        std::vector<SourceRow> rows;                          ///< All rows that belong to this block.
+    };
+
     /// @brief Constructor.
     ///
-    /// Allow clients to provide a pre-initialized pointer to the decode manager. If none is provided, this constructor will initialize one for the clients of this class.
+    /// Allow clients to provide a pre-initialized pointer to the decode manager. If none is provided, isa specs are loaded on a background thread
+    /// by SetArchitecture, and shared with every other model of the same architecture.
     ///
     /// @param [in] parent         The parent object.
     /// @param [in] decode_manager The optional handle to manager of all the architectures.
@@ -145,7 +248,8 @@ public:
     /// @brief Override index to generate the correct index for the given row, column, and parent index.
     ///
     /// Parent blocks are assigned an index with no internal data.
-    /// Child rows are assigned an index with internal data that is a pointer to their parent block.
+    /// Child rows are assigned an index with internal data that is a pointer to their parent block,
+    /// or the parent block's row + 1 when using StorageMode::kArena.
     ///
     /// @param [in] row    The row.
     /// @param [in] column The column.
@@ -206,16 +310,36 @@ public:
 
     /// @brief Cache the fixed font being used by attached trees. Use it to efficiently measure isa text from here on out.
     ///
+    /// Column widths are updated from the character counts cached by CacheSizeHints, without measuring the rows again.
+    ///
     /// @param [in] fixed_font The fixed font to use.
     /// @param [in] tree       The attached tree view; use it to achieve more accurate isa text measurement.
     void SetFixedFont(const QFont& fixed_font, IsaTreeView* tree);
 
     /// @brief Specify an architecture to be used by the decoder; used to provide op code tooltip.
     ///
+    /// ArchitectureChanged is emitted once the decoder is ready, which may be after this returns if its isa spec is still loading.
+    ///
     /// @param [in] architecture  The architecture version.
-    /// @param [in] load_isa_spec true to load the isa spec in the decoder.
+    /// @param [in] load_isa_spec true to load the isa spec in the decoder, false to only use a decoder some other model loaded already.
     void SetArchitecture(amdisa::GpuArchitecture architecture, bool load_isa_spec = true);
 
+    /// @brief Intern the text of tokens in a symbol table shared with other models, instead of the global table.
+    ///
+    /// Tokens of models that share a table have the same symbol for the same text. Tokens already in this model are interned
+    /// again in the new table. Cancels any asynchronous update.
+    ///
+    /// @param [in] symbol_table The symbol table, or nullptr for the global table; see IsaSymbolTable::GetGlobal.
+    void SetSymbolTable(std::shared_ptr<IsaSymbolTable> symbol_table);
+
+    /// @brief Get the symbol table the text of the tokens of this model is interned in.
+    ///
+    /// @return The symbol table.
+    inline const std::shared_ptr<IsaSymbolTable>& GetSymbolTable() const
+    {
+        return row_storage_.GetSymbolTable();
+    }
+
     /// @brief Get the source model index that corresponds to the provided line number.
     ///
     /// @param [in] line_number The line number.
@@ -223,12 +347,219 @@ public:
     /// @return The source model index that corresponds to the provided line number.
     QModelIndex GetLineNumberModelIndex(int line_number);
 
+    /// @brief Get the row type of a source model index without going through a QVariant.
+    ///
+    /// @param [in] index The source model index, in any column.
+    ///
+    /// @return The row type, or RowType::kCode if the index is not valid.
+    RowType GetRowType(const QModelIndex& index) const;
+
+    /// @brief Get the line number of a source model index; the reverse of GetLineNumberModelIndex.
+    ///
+    /// @param [in] index The source model index, in any column.
+    ///
+    /// @return The line number, or -1 if the index is not valid or line numbers are not mapped yet; see CacheSizeHints.
+    int GetLineNumber(const QModelIndex& index) const;
+
+    /// @brief Find the lines of this model whose text matches the search text in any of the given columns, ignoring case.
+    ///
+    /// Uses an index of the row text that is built the first time a column is searched, and kept until the rows of this model change.
+    /// Cancels any search started by BeginSearch.
+    ///
+    /// @param [in]  text         The text to search for, or the regular expression.
+    /// @param [in]  columns      The columns to search; only the shared columns after kLineNumber can be searched.
+    /// @param [out] line_numbers The line numbers of the matching lines in ascending order; see GetLineNumberModelIndex.
+    /// @param [in]  mode         How the text matches.
+    ///
+    /// @return true if the search was done, false if the text or columns cannot be searched with the index, or this model is virtual.
+    bool SearchLines(const QString&            text,
+                     const std::vector<int>&   columns,
+                     std::vector<int>&         line_numbers,
+                     IsaSearchIndex::MatchMode mode = IsaSearchIndex::MatchMode::kContains);
+
+    /// @brief Start searching the lines of this model on worker threads, like SearchLines; any search in progress is canceled first.
+    ///
+    /// The lines are searched in chunks, and the matches of every chunk are published on the GUI thread in line order,
+    /// emitting SearchUpdated each time; see GetSearchLines.
+    ///
+    /// @param [in] text         The text to search for, or the regular expression.
+    /// @param [in] columns      The columns to search; only the shared columns after kLineNumber can be searched.
+    /// @param [in] mode         How the text matches.
+    /// @param [in] thread_count The number of worker threads to use, or 0 to pick the number of threads based on the hardware.
+    ///
+    /// @return true if the search started, false if the text or columns cannot be searched with the index, or this model is virtual.
+    bool BeginSearch(const QString& text, const std::vector<int>& columns, IsaSearchIndex::MatchMode mode, int thread_count = 0);
+
+    /// @brief Stop a search started by BeginSearch; the lines found so far are kept.
+    ///
+    /// Blocks until all worker threads have stopped. Does nothing if no search is in progress.
+    void CancelSearch();
+
+    /// @brief Check if a search started by BeginSearch is still publishing matches.
+    ///
+    /// @return true if a search is in progress, false otherwise.
+    inline bool IsSearching() const
+    {
+        return !search_threads_.empty();
+    }
+
+    /// @brief Get the lines found by the last search so far.
+    ///
+    /// @return The line numbers of the matching lines in ascending order; see GetLineNumberModelIndex.
+    inline const std::vector<uint32_t>& GetSearchLines() const
+    {
+        return search_index_.GetLines();
+    }
+
+    /// @brief Get where the search text matches in a cell, as found by the last search, so delegates need not search the cell again.
+    ///
+    /// @param [in]  text          The search text.
+    /// @param [in]  line_number   The line number of the cell.
+    /// @param [in]  column        The column of the cell.
+    /// @param [out] match_starts  The character offset of the first match into the cell's display text; valid until the next search or update.
+    /// @param [out] match_lengths The length of the first match; valid as long as match_starts.
+    /// @param [out] match_count   The number of matches, possibly 0.
+    ///
+    /// @return true if the last search searched for text in the column, false if the caller has to find the matches itself.
+    bool GetSearchMatches(const QString&   text,
+                          int              line_number,
+                          int              column,
+                          const uint32_t*& match_starts,
+                          const uint32_t*& match_lengths,
+                          size_t&          match_count) const;
+
+    /// @brief Add a metric, like profiler sample counts or stall cycles, whose per line values are shown as a heatmap.
+    ///
+    /// @param [in] name The name of the metric.
+    ///
+    /// @return The metric, to pass to SetMetricValues.
+    int AddMetric(const QString& name);
+
+    /// @brief Remove every metric and its values.
+    void RemoveMetrics();
+
+    /// @brief Get the number of metrics.
+    ///
+    /// @return The number of metrics added with AddMetric.
+    inline int GetMetricCount() const
+    {
+        return static_cast<int>(metric_columns_.GetMetricCount());
+    }
+
+    /// @brief Get the name of a metric.
+    ///
+    /// @param [in] metric The metric.
+    ///
+    /// @return The name, or an empty string if there is no such metric.
+    QString GetMetricName(int metric) const;
+
+    /// @brief Replace the values of a metric for consecutive lines, as often as a profiler streams them.
+    ///
+    /// Emits dataChanged with Qt::BackgroundRole for the changed lines only, then MetricValuesChanged.
+    /// Values are kept until the model is reset; appending rows keeps the line numbers of existing rows valid.
+    ///
+    /// @param [in] metric            The metric.
+    /// @param [in] first_line_number The line number of the first value; see GetLineNumberModelIndex.
+    /// @param [in] values            The values of the lines from first_line_number on; NaN to unset the value of a line.
+    void SetMetricValues(int metric, int first_line_number, const std::vector<float>& values);
+
+    /// @brief Fix the range of values used to turn a metric into heatmap intensities, or let it grow to fit the values again.
+    ///
+    /// @param [in] metric  The metric.
+    /// @param [in] fixed   true to map [minimum, maximum] to intensities [0, 1], false to fit every value set from now on.
+    /// @param [in] minimum The value of intensity 0.
+    /// @param [in] maximum The value of intensity 1.
+    void SetMetricRange(int metric, bool fixed, float minimum = 0.0f, float maximum = 0.0f);
+
+    /// @brief Get the range of values used to turn a metric into heatmap intensities.
+    ///
+    /// @param [in]  metric  The metric.
+    /// @param [out] minimum The value of intensity 0.
+    /// @param [out] maximum The value of intensity 1.
+    void GetMetricRange(int metric, float& minimum, float& maximum) const;
+
+    /// @brief Get the value of a metric for a line.
+    ///
+    /// @param [in] metric      The metric.
+    /// @param [in] line_number The line number.
+    ///
+    /// @return The value, or NaN if the line has no value.
+    float GetMetricValue(int metric, int line_number) const;
+
+    /// @brief Get the largest value of a metric over a range of lines, like the lines a pixel of a scroll bar covers.
+    ///
+    /// @param [in] metric            The metric.
+    /// @param [in] first_line_number The first line number.
+    /// @param [in] end_line_number   The line number after the last line.
+    ///
+    /// @return The largest value, or NaN if none of the lines has a value.
+    float GetMetricMaximum(int metric, int first_line_number, int end_line_number) const;
+
+    /// @brief Turn a value of a metric into a heatmap intensity.
+    ///
+    /// @param [in] metric The metric.
+    /// @param [in] value  The value.
+    ///
+    /// @return The intensity in [0, 1], or -1 if the value is NaN.
+    float GetMetricIntensity(int metric, float value) const;
+
+    /// @brief Get views of the tokens of an index without copying them; a typed alternative to Qt::UserRole for delegates.
+    ///
+    /// Gives the label token of a code block, the op code token of an instruction in the op code column, and the tokens of
+    /// every operand of an instruction back to back in the operands column. Other indices have no tokens.
+    /// In StorageMode::kVirtual the views are valid until more rows are parsed than are kept; see SetVirtualCacheRowCount.
+    ///
+    /// @param [in]  index        The source model index.
+    /// @param [out] tokens       The tokens; cleared first, so the same vector can be reused between calls.
+    /// @param [out] operand_ends If not nullptr, the index in tokens one past the last token of every operand; cleared first.
+    void GetTokens(const QModelIndex& index, std::vector<TokenView>& tokens, std::vector<size_t>* operand_ends = nullptr) const;
+
+    /// @brief Export the text of rows straight from the rows of this model, without going through an index or a QVariant per cell.
+    ///
+    /// Rows are exported in the order of the ranges, so give the ranges in line order to export rows the way they are shown.
+    ///
+    /// @param [in]  ranges  The rows to export; ranges outside this model are skipped.
+    /// @param [in]  columns The source columns to export, each less than kColumnCount, in the order they are written.
+    /// @param [in]  format  The format of the text.
+    /// @param [out] text    The text, in utf8; reserved up front to about the size of the export.
+    void ExportRows(const std::vector<ExportRange>& ranges, const std::vector<int>& columns, ExportFormat format, std::string& text) const;
+
+    /// @brief Export the text of rows straight from the rows of this model, and stream it out in chunks; see ExportRows.
+    ///
+    /// @param [in] ranges  The rows to export; ranges outside this model are skipped.
+    /// @param [in] columns The source columns to export, each less than kColumnCount, in the order they are written.
+    /// @param [in] format  The format of the text.
+    /// @param [in] write   Called with every chunk of utf8 text in order; return false to stop the export.
+    ///
+    /// @return true if every chunk was written, false if write stopped the export.
+    bool ExportRows(const std::vector<ExportRange>&              ranges,
+                    const std::vector<int>&                      columns,
+                    ExportFormat                                 format,
+                    const std::function<bool(std::string_view)>& write) const;
+
+    /// @brief Turn the display text cache on or off.
+    ///
+    /// When on, CacheSizeHints converts the Qt::DisplayRole text of every line in the shared columns to a QString once,
+    /// and data() returns implicit copies of those strings instead of building new ones on every call.
+    /// This costs a QString per cell, so it is off by default.
+    ///
+    /// @param [in] enabled true to cache display text, false to build it on demand and release any cached text.
+    void SetDisplayTextCacheEnabled(bool enabled);
+
+    /// @brief Check if the display text cache is on.
+    ///
+    /// @return true if display text is cached, false otherwise.
+    inline bool DisplayTextCacheEnabled() const
+    {
+        return display_text_cache_enabled_;
+    }
+
     /// @brief Get the number of lines stored in this model; parent code blocks and child rows both count towards the line count.
     ///
     /// @return The number of lines in the model.
     inline int GetLineCount() const
     {
-        return static_cast<int>(line_number_corresponding_indices_.size());
+        return (storage_mode_ == StorageMode::kVirtual) ? virtual_line_count_ : static_cast<int>(line_number_corresponding_indices_.size());
     }
 
     /// @brief Toggles the line_numbers_visible_ variable true and false. Used to know if line numbers should be drawn.
@@ -237,6 +568,27 @@ public:
         line_numbers_visible_ = !line_numbers_visible_;
     }
 
+    /// @brief Check if an update started by BeginAsyncUpdate is still publishing rows to this model.
+    ///
+    /// @return true if an asynchronous update is in progress, false otherwise.
+    inline bool IsAsyncUpdateRunning() const
+    {
+        return !async_update_threads_.empty();
+    }
+
+    /// @brief Stop an update started by BeginAsyncUpdate; rows that were already published stay in this model.
+    ///
+    /// Blocks until all worker threads have stopped. Does nothing if no update is in progress.
+    void CancelAsyncUpdate();
+
+    /// @brief Get how the rows of this model are stored.
+    ///
+    /// @return The storage mode.
+    inline StorageMode GetStorageMode() const
+    {
+        return storage_mode_;
+    }
+
     /// @brief Gets whether line numbers are visible.
     ///
     /// @return true if line numbers are visible, false otherwise.
@@ -275,13 +627,201 @@ signals:
     /// @param [in] successful true if we were successful in getting the decoder for that architecutre, false otherwise.
     void ArchitectureChanged(bool successful);
 
+    /// @brief Signal to notify listeners that an asynchronous update published more blocks to this model.
+    ///
+    /// @param [in] published_block_count The number of blocks that are in this model so far.
+    /// @param [in] block_count           The number of blocks in the update.
+    void AsyncUpdateProgress(int published_block_count, int block_count);
+
+    /// @brief Signal to notify listeners that an asynchronous update is over.
+    ///
+    /// Emitted after branch instructions are mapped and size hints are cached, or when the update is canceled.
+    ///
+    /// @param [in] canceled true if the update was canceled before all blocks were published, false otherwise.
+    void AsyncUpdateFinished(bool canceled);
+
+    /// @brief Signal to notify listeners that the values of a metric changed; emitted after dataChanged.
+    ///
+    /// @param [in] metric            The metric, or -1 if every metric was removed.
+    /// @param [in] first_line_number The first line number whose value changed.
+    /// @param [in] last_line_number  The last line number whose value changed.
+    /// @param [in] range_changed     true if the range of the metric changed, which changes the intensity of every line.
+    void MetricValuesChanged(int metric, int first_line_number, int last_line_number, bool range_changed);
+
+    /// @brief Signal to notify listeners that a search started by BeginSearch found more lines; see GetSearchLines.
+    ///
+    /// @param [in] finished true if every line has been searched, false if more lines may follow.
+    void SearchUpdated(bool finished);
+
 protected:
+    /// @brief Change how the rows of this model are stored; removes all rows from this model.
+    ///
+    /// Subclasses using StorageMode::kArena fill this model with the Append* functions instead of blocks_.
+    ///
+    /// @param [in] storage_mode The new storage mode.
+    void SetStorageMode(StorageMode storage_mode);
+
+    /// @brief Remove all blocks and rows from the arena storage.
+    ///
+    /// @param [in] release_memory true to give the memory back, false to keep it for the next shader.
+    void ClearRowStorage(bool release_memory = false);
+
+    /// @brief Append a code block to the arena storage; rows appended from now on belong to this block.
+    ///
+    /// @param [in] line_number The line number of the block.
+    /// @param [in] label       The label of the block.
+    ///
+    /// @return The position of the new block.
+    int AppendCodeBlock(uint32_t line_number, std::string_view label);
+
+    /// @brief Append a comment block to the arena storage; rows appended from now on belong to this block.
+    ///
+    /// @param [in] line_number The line number of the block.
+    /// @param [in] text        The text of the block.
+    ///
+    /// @return The position of the new block.
+    int AppendCommentBlock(uint32_t line_number, std::string_view text);
+
+    /// @brief Append an instruction to the last block in the arena storage, and parse its selectable tokens.
+    ///
+    /// @param [in] line_number           The line number of the instruction.
+    /// @param [in] op_code               The op code text.
+    /// @param [in] operands              The operand strings.
+    /// @param [in] pc_address            The pc address text.
+    /// @param [in] binary_representation The binary representation text.
+    /// @param [in] enabled               true if the instruction should be color coded, false otherwise.
+    void AppendInstruction(uint32_t                        line_number,
+                           std::string_view                op_code,
+                           const std::vector<std::string>& operands,
+                           std::string_view                pc_address,
+                           std::string_view                binary_representation,
+                           bool                            enabled = true);
+
+    /// @brief Append a comment to the last block in the arena storage.
+    ///
+    /// @param [in] line_number The line number of the comment.
+    /// @param [in] text        The text of the comment.
+    void AppendComment(uint32_t line_number, std::string_view text);
+
+    /// @brief Replace all rows of this model by parsing the given blocks on worker threads.
+    ///
+    /// Switches this model to StorageMode::kArena and removes all rows. Blocks are parsed in batches and
+    /// published on the GUI thread, in shader order, as rows inserted at the end of this model.
+    /// Once every block is published branch instructions are mapped and size hints are cached.
+    /// Any update already in progress is canceled first.
+    ///
+    /// @param [in] blocks       The blocks to parse.
+    /// @param [in] thread_count The number of worker threads to use, or 0 to pick the number of threads based on the hardware.
+    void BeginAsyncUpdate(std::vector<SourceBlock> blocks, int thread_count = 0);
+
+    /// @brief Replace all rows of this model like BeginAsyncUpdate, reusing the rows parsed the last time the same shader was shown.
+    ///
+    /// The parsed rows of a shader are kept in a file in cache_directory named after a hash of the blocks, the architecture and
+    /// the width of the fixed font, which token positions depend on. If that file exists and was written by a build with the same
+    /// row layout, the rows are read from the memory mapped file instead of being parsed, and AsyncUpdateFinished is emitted
+    /// before this returns. Otherwise the blocks are parsed by BeginAsyncUpdate, and the file is written once the update finishes.
+    /// The file also keeps the control flow graph and the character counts of the columns, which are restored instead of mapping
+    /// branch instructions and caching size hints again; only the line numbers, the column widths, the register index and the
+    /// cached display text are rebuilt from the rows, which takes a fraction of the time parsing does.
+    ///
+    /// @param [in] blocks          The blocks to parse.
+    /// @param [in] architecture    The architecture of the shader.
+    /// @param [in] cache_directory The directory of the cache files; created when the first file is written.
+    /// @param [in] thread_count    The number of worker threads to use, or 0 to pick the number of threads based on the hardware.
+    ///
+    /// @return true if the rows were read from the cache file, false if the blocks are being parsed.
+    bool BeginCachedUpdate(std::vector<SourceBlock> blocks, amdisa::GpuArchitecture architecture, const QString& cache_directory, int thread_count = 0);
+
+    /// @brief Replace all rows of this model by the given blocks, parsing only the blocks that changed.
+    ///
+    /// Meant for showing the isa of a shader that was compiled again. Blocks are matched to the blocks of this model by their
+    /// type and label, in shader order; a matched block whose op codes, operands and comments are the same is kept as is,
+    /// and only its line numbers, pc addresses and binary representations are updated. Rows are inserted, removed and
+    /// changed instead of resetting this model, so views keep the expand state and selection of the blocks that were kept.
+    /// Switches this model to StorageMode::kBlocks first, which removes all rows if it used another storage mode.
+    /// Branch instructions are mapped and size hints are cached before this returns. Line numbers change, so the values of
+    /// every metric are cleared and MetricValuesChanged is emitted for every metric.
+    ///
+    /// @param [in] blocks The blocks of the shader.
+    void UpdateBlocks(const std::vector<SourceBlock>& blocks);
+
+    /// @brief Replace all rows of this model by the lines of a file that is memory mapped instead of read.
+    ///
+    /// Switches this model to StorageMode::kVirtual and removes all rows. Every line is classified once by ClassifyVirtualLine
+    /// to index the blocks and the offset of every row; rows are parsed by ParseVirtualRow only when they are needed, and
+    /// a bounded number of parsed rows is kept; see SetVirtualCacheRowCount. Branch instructions are mapped and size hints are
+    /// cached before this returns. Line numbers are the lines of the file, from 1.
+    ///
+    /// Work that needs every row is skipped for this storage mode: the control flow graph and the register index stay empty,
+    /// searches are not indexed, and the widths of the shared columns are measured from the first rows only.
+    ///
+    /// @param [in] file_path The path of the text file.
+    ///
+    /// @return true if the file was mapped, false if it could not be opened or mapped; this model has no rows then.
+    bool BeginVirtualUpdate(const QString& file_path);
+
+    /// @brief Classify a line of a file of a virtual update, to build the index of its blocks and rows; see BeginVirtualUpdate.
+    ///
+    /// Called for every line of the file, so it should not allocate. The default treats lines that end with a colon as
+    /// code block labels, lines that start with // or ; as comments, empty lines as skipped, and anything else as instructions.
+    ///
+    /// @param [in]  line The line, without its line break.
+    /// @param [out] text The label of a code block or the text of a comment block; may be a view of the line.
+    ///
+    /// @return How the line is shown. If the first shown line is not a block, a comment starts a comment block and an
+    ///         instruction starts a code block without a label.
+    virtual VirtualLineType ClassifyVirtualLine(std::string_view line, std::string_view& text) const;
+
+    /// @brief Parse a line of a file of a virtual update into a row, when the row is needed; see BeginVirtualUpdate.
+    ///
+    /// The default splits an instruction into its op code and comma separated operands, and takes the pc address and binary
+    /// representation from a trailing "// address: binary" comment, as disassemblers print them.
+    ///
+    /// @param [in]     line The line, without its line break.
+    /// @param [in,out] row  The row to fill in; the row type and line number are set already.
+    ///
+    /// @return true if the line was parsed, false to show the whole line as the op code or comment text instead.
+    virtual bool ParseVirtualRow(std::string_view line, SourceRow& row) const;
+
+    /// @brief Change the number of rows parsed by a virtual update that are kept; see BeginVirtualUpdate.
+    ///
+    /// @param [in] row_count The number of parsed rows; at least 1. IsaVirtualRowSource::kDefaultCacheRowCount by default.
+    void SetVirtualCacheRowCount(size_t row_count);
+
+    /// @brief Get the number of rows parsed by a virtual update that are kept.
+    ///
+    /// @return The number of parsed rows.
+    inline size_t GetVirtualCacheRowCount() const
+    {
+        return virtual_rows_.GetCacheRowCount();
+    }
+
     /// @brief Clear the existing branch instruction to label mapping for all blocks in this model.
     void ClearBranchInstructionMapping();
 
-    /// @brief Map code blocks indices to corresponding jump instruction indices.
+    /// @brief Map code blocks indices to corresponding jump instruction indices, and build the control flow graph.
     virtual void MapBlocksToBranchInstructions();
 
+    /// @brief Get the control flow graph between the blocks of this model.
+    ///
+    /// Blocks are the top level rows; the graph is empty until MapBlocksToBranchInstructions is called.
+    ///
+    /// @return The control flow graph.
+    inline const IsaControlFlowGraph& GetControlFlowGraph() const
+    {
+        return control_flow_graph_;
+    }
+
+    /// @brief Get the index of every register reference of this model.
+    ///
+    /// Token indices are among the tokens GetTokens gives for the kOperands column; the index is empty until CacheSizeHints is called.
+    ///
+    /// @return The register index.
+    inline const IsaRegisterIndex& GetRegisterIndex() const
+    {
+        return register_index_;
+    }
+
     /// @brief Helper function to parse an isa instruction to find which tokens can be selected/highlighted.
     ///
     /// @param [in]  op_code               The op code string.
@@ -337,17 +877,26 @@ protected:
         /// @param [in] line           The line number.
         /// @param [in] op             The op code text of this instruction.
         /// @param [in] address        The pc_address text of this instruction.
-        /// @param [in] representation The binary representation text of this instruction.
+        /// @param [in] representation The binary representation text of this instruction; parsed into words.
         InstructionRow(uint32_t line, std::string op, std::string address, std::string representation);
 
         /// @brief Destructor.
         virtual ~InstructionRow();
 
+        /// @brief Deprecated; use words. Get the binary representation text of this instruction, which used to be a member.
+        ///
+        /// The text is formatted from words by IsaInstructionEncoding::Format, as 8 upper case hex digits per word separated by
+        /// a space, like the kBinaryRepresentation column shows it; it is not the text given to the constructor.
+        ///
+        /// @return The binary representation text.
+        std::string GetBinaryRepresentation() const;
+
         Token                           op_code_token;   ///< This instruction's opcode's token.
         std::vector<std::vector<Token>> operand_tokens;  ///< This instruction's operands' tokens; tokens belonging to the same operand are grouped together.
         std::string                     pc_address;      ///< The pc address text of this instruction.
-        std::string                     binary_representation;  ///< The binary representation text of this instruction.
-        bool                            enabled;                ///< true if this instruction should be color coded, false otherwise.
+        std::vector<uint32_t>           words;           ///< The binary representation of this instruction; see IsaInstructionEncoding.
+        size_t                          number_words;    ///< The number of words of the first hex number; see IsaInstructionEncoding::GetDecoderEncoding.
+        bool                            enabled;         ///< true if this instruction should be color coded, false otherwise.
     };
 
     /// @brief Block is an abstract class intended to serve as the interface for a single parent block in this model.
@@ -374,6 +923,7 @@ protected:
         int                               position;           ///< This code block's index into this model's data structure.
         uint32_t                          line_number;        ///< Line # relative to the entire shader.
         std::vector<std::shared_ptr<Row>> instruction_lines;  ///< All instruction lines that belong to this code block.
+        uint64_t                          source_hash;        ///< Hash of the SourceBlock this block was parsed from by UpdateBlocks, or 0.
     };
 
     /// @brief CommentBlock is a convenience class meant to represent a block of comments.
@@ -425,29 +975,480 @@ protected:
 
         Token token;  ///< This block's label's token.
 
-        std::vector<std::pair<uint32_t, uint32_t>> mapped_branch_instructions;  ///< Map this block to corresponding jump instruction indices.
+        /// Deprecated; use GetControlFlowGraph. The branch instructions that target this block, as <parent row, child row>;
+        /// filled from the control flow graph by MapBlocksToBranchInstructions in StorageMode::kBlocks. Read by this model only
+        /// for blocks the graph has no branches into, so an override of MapBlocksToBranchInstructions may still fill it.
+        std::vector<std::pair<uint32_t, uint32_t>> mapped_branch_instructions;
     };
 
     std::vector<std::shared_ptr<Block>> blocks_;  ///< Isa stored in this model as a container of a convenience data structure.
 
-    std::unordered_map<std::string, int> code_block_label_to_index_;  ///< Map code block label names to their index into all blocks.
+    IsaRowStorage row_storage_;  ///< Isa stored in this model contiguously when using StorageMode::kArena.
+
+    /// Deprecated; use GetControlFlowGraph. Kept for subclasses that override MapBlocksToBranchInstructions; this model no longer
+    /// fills it, and it was always empty outside of MapBlocksToBranchInstructions.
+    std::unordered_map<std::string, int> code_block_label_to_index_;
 
     QFont fixed_font_;                  ///< A fixed font set by an application to assist caching size hints for columns.
     qreal fixed_font_character_width_;  ///< Cache the width of a single character of the fixed font.
     bool  line_numbers_visible_;        ///< Whether the line numbers are to be shown.
 
 private:
-    /// @brief Load isa spec file for a given architecture.
+    /// @brief Get the path of the isa spec file for a given architecture.
     ///
     /// @param [in] architecture The architecture enum for which the individual isa spec is to be loaded.
-    void LoadIsaSpec(amdisa::GpuArchitecture architecture = amdisa::GpuArchitecture::kUnknown);
+    ///
+    /// @return The path, or an empty string if there is no isa spec for the architecture.
+    static std::string GetIsaSpecPath(amdisa::GpuArchitecture architecture);
+
+    /// @brief Parse a range of blocks into an arena storage.
+    ///
+    /// Only touches the given storage so it may be used off of the GUI thread.
+    ///
+    /// @param [in]     blocks                The blocks to parse from.
+    /// @param [in]     first_block           The index of the first block to parse.
+    /// @param [in]     last_block            One past the index of the last block to parse.
+    /// @param [in]     fixed_character_width The width of a single character from the fixed font being used by this model and view.
+    /// @param [in]     canceled              Stop parsing as soon as this is true.
+    /// @param [in,out] row_storage           The storage to append to.
+    ///
+    /// @return true if all blocks were parsed, false if parsing was canceled.
+    static bool ParseSourceBlocks(const std::vector<SourceBlock>& blocks,
+                                  size_t                          first_block,
+                                  size_t                          last_block,
+                                  qreal                           fixed_character_width,
+                                  const std::atomic<bool>&        canceled,
+                                  IsaRowStorage&                  row_storage);
+
+    /// @brief Publish a batch of blocks parsed by an asynchronous update; batches are inserted in shader order.
+    ///
+    /// @param [in] generation  The update that parsed the batch; batches from canceled updates are dropped.
+    /// @param [in] batch_index The index of the batch.
+    /// @param [in] batch       The parsed blocks.
+    void PublishAsyncUpdateBatch(uint64_t generation, size_t batch_index, std::shared_ptr<IsaRowStorage> batch);
+
+    /// @brief Prepare a search of the search index; indexes the columns that are not indexed yet, and cancels any search in progress.
+    ///
+    /// @param [in]  text           The text to search for, or the regular expression.
+    /// @param [in]  columns        The columns to search.
+    /// @param [in]  mode           How the text matches.
+    /// @param [out] query          The compiled query.
+    /// @param [out] search_columns The index columns to search, sorted and without duplicates.
+    ///
+    /// @return true if the index can search for text in the columns, false otherwise.
+    bool PrepareSearch(const QString&            text,
+                       const std::vector<int>&   columns,
+                       IsaSearchIndex::MatchMode mode,
+                       IsaSearchIndex::Query&    query,
+                       std::vector<size_t>&      search_columns);
+
+    /// @brief Publish the matches of a chunk of lines searched by BeginSearch; chunks are published in line order.
+    ///
+    /// @param [in] generation  The search that searched the chunk; chunks from canceled searches are dropped.
+    /// @param [in] chunk_index The index of the chunk.
+    /// @param [in] results     The matches in the chunk.
+    void PublishSearchResults(uint64_t generation, size_t chunk_index, std::shared_ptr<IsaSearchIndex::Results> results);
+
+    /// @brief Replace all rows of this model by the rows of a cache file written by SaveModelCache; see BeginCachedUpdate.
+    ///
+    /// @param [in] file_path The path of the cache file.
+    /// @param [in] key       The key the file must have been written with.
+    ///
+    /// @return true if the rows were read, false if the file does not exist or is not valid; this model is unchanged or empty then.
+    bool LoadModelCache(const QString& file_path, uint64_t key);
+
+    /// @brief Write the rows of this model to a cache file that LoadModelCache reads; any existing file is replaced at once.
+    ///
+    /// The column character counts and the control flow graph are written too, so the file must only be written once they are up to date.
+    ///
+    /// @param [in] file_path The path of the cache file.
+    /// @param [in] key       The key to write the file with.
+    ///
+    /// @return true if the file was written, false otherwise.
+    bool SaveModelCache(const QString& file_path, uint64_t key) const;
+
+    /// @brief Add a column to the search index, using the text each line displays in that column.
+    ///
+    /// @param [in] column The column.
+    void BuildSearchIndexColumn(int column);
+
+    /// @brief Index the register operands of every line; line numbers must be mapped already, see CacheSizeHints.
+    void BuildRegisterIndex();
+
+    /// @brief Build the indices of the rows that are not kept in a cache file, and start decoding the instructions.
+    ///
+    /// The register index and the display text cache are built from the rows, and line numbers must be mapped already.
+    void BuildRowIndices();
+
+    /// @brief Convert the cached character counts of every column to widths in the current fixed font.
+    void UpdateColumnWidths();
+
+    /// @brief Get the text a line displays in a shared column, the same way for the search index and the display text cache.
+    ///
+    /// @param [in]     parent_row The parent row of the line, or -1 if the line is a parent block.
+    /// @param [in]     row        The row of the line.
+    /// @param [in]     column     The column; kOpCode, kOperands, kPcAddress or kBinaryRepresentation.
+    /// @param [in,out] buffer     Storage for text that has to be built; the result may refer to it.
+    ///
+    /// @return The text of the line in the column; empty if the line has no text in the column.
+    std::string_view GetLineText(int parent_row, int row, int column, std::string& buffer) const;
+
+    /// @brief Drop the parts of export ranges that are outside this model.
+    ///
+    /// @param [in]  ranges       The rows to export.
+    /// @param [out] valid_ranges The rows of the ranges that exist in this model; empty ranges are dropped.
+    void GetValidExportRanges(const std::vector<ExportRange>& ranges, std::vector<ExportRange>& valid_ranges) const;
+
+    /// @brief Get the text a row exports in a column; like GetLineText, with line numbers and op code indents.
+    ///
+    /// @param [in]     parent_row The parent row, or -1 for parent blocks.
+    /// @param [in]     row        The row.
+    /// @param [in]     column     The column.
+    /// @param [in]     format     The format of the export.
+    /// @param [in,out] buffer     Storage for text that has to be built; the result may refer to it.
+    ///
+    /// @return The text of the row in the column.
+    std::string_view GetExportText(int parent_row, int row, int column, ExportFormat format, std::string& buffer) const;
+
+    /// @brief Find the width of every exported column and the size of an export, without writing it.
+    ///
+    /// @param [in]  ranges  The rows to export.
+    /// @param [in]  columns The source columns to export.
+    /// @param [in]  format  The format of the export.
+    /// @param [out] widths  The number of characters of the widest instruction text of every exported column; used by ExportFormat::kText.
+    ///
+    /// @return About the number of bytes of the export.
+    size_t MeasureExport(const std::vector<ExportRange>& ranges, const std::vector<int>& columns, ExportFormat format, std::vector<size_t>& widths) const;
+
+    /// @brief Write an export measured by MeasureExport.
+    ///
+    /// @param [in]     ranges  The rows to export.
+    /// @param [in]     columns The source columns to export.
+    /// @param [in]     format  The format of the export.
+    /// @param [in]     widths  The widths of the exported columns; see MeasureExport.
+    /// @param [in,out] output  The text written so far; handed to write and cleared whenever a chunk is full.
+    /// @param [in]     write   Called with every chunk of text, or nullptr to keep all text in output.
+    ///
+    /// @return true if every chunk was written, false if write stopped the export.
+    bool WriteExport(const std::vector<ExportRange>&              ranges,
+                     const std::vector<int>&                      columns,
+                     ExportFormat                                 format,
+                     const std::vector<size_t>&                   widths,
+                     std::string&                                 output,
+                     const std::function<bool(std::string_view)>* write) const;
+
+    /// @brief Convert the display text of every line in the shared columns to QStrings; see SetDisplayTextCacheEnabled.
+    void BuildDisplayTextCache();
+
+    /// @brief Forget all cached display text.
+    void ClearDisplayTextCache();
+
+    /// @brief Forget the search index, the register index, the cached display text and the metric values of the old rows.
+    ///
+    /// Connected to modelReset, rowsInserted and rowsRemoved, and called by CacheSizeHints and LoadModelCache before they
+    /// map line numbers again, so everything derived from the rows is dropped in one place.
+    ///
+    /// @param [in] model_reset true if all rows were replaced, false if rows were inserted or removed.
+    void InvalidateDerivedState(bool model_reset);
+
+    /// @brief Unset the values of every metric, signalling every line; for changes that renumber lines without a reset.
+    void ClearMetricValues();
+
+    /// @brief Get the cached display text of a cell.
+    ///
+    /// @param [in]  parent_row The parent row of the cell, or -1 if the cell belongs to a parent block.
+    /// @param [in]  row        The row of the cell.
+    /// @param [in]  column     The column of the cell.
+    /// @param [out] text       The cached text, if any.
+    ///
+    /// @return true if the text of the cell is cached, false otherwise.
+    bool GetCachedDisplayText(int parent_row, int row, int column, QString& text) const;
+
+    /// @brief Stop and join the worker threads of an asynchronous update, and drop any batches that were not published yet.
+    void StopAsyncUpdateThreads();
+
+    /// @brief Stop and join the worker threads of a search, and drop any chunks that were not published yet.
+    void StopSearchThreads();
+
+    /// @brief Decode every distinct instruction of this model on a background thread, so op code tooltips are a cache lookup.
+    ///
+    /// Any pre-decode already running is stopped first.
+    void StartPredecodeThread();
+
+    /// @brief Stop and join the pre-decode thread, if it is running.
+    void StopPredecodeThread();
+
+    /// @brief Convert an arena token to a token.
+    ///
+    /// @param [in] row_storage  The storage of the token.
+    /// @param [in] token_record The arena token.
+    ///
+    /// @return The token.
+    static Token MakeToken(const IsaRowStorage& row_storage, const IsaRowStorage::TokenRecord& token_record);
+
+    /// @brief Make a view of an arena token.
+    ///
+    /// @param [in] row_storage  The storage of the token.
+    /// @param [in] token_record The arena token.
+    ///
+    /// @return The view of the token.
+    static TokenView MakeTokenView(const IsaRowStorage& row_storage, const IsaRowStorage::TokenRecord& token_record);
+
+    /// @brief Make a view of a token.
+    ///
+    /// @param [in] token The token.
+    ///
+    /// @return The view of the token.
+    static TokenView MakeTokenView(const Token& token);
+
+    /// @brief Check if the blocks of this model are stored in row_storage_.
+    ///
+    /// @return true for StorageMode::kArena and StorageMode::kVirtual, false otherwise.
+    inline bool UsesRowStorage() const
+    {
+        return storage_mode_ != StorageMode::kBlocks;
+    }
+
+    /// @brief Get an arena child row; in StorageMode::kVirtual the row is parsed first unless it is parsed already.
+    ///
+    /// @param [in]  parent_row  The parent row.
+    /// @param [in]  row         The row.
+    /// @param [out] row_storage The storage of the row, its operands, tokens and text.
+    ///
+    /// @return The row; for StorageMode::kVirtual, valid until IsaVirtualRowSource::GetCacheRowCount other rows are parsed.
+    const IsaRowStorage::RowRecord& GetArenaRow(int parent_row, int row, const IsaRowStorage*& row_storage) const;
+
+    /// @brief Get the row of the parent of an index without going through parent().
+    ///
+    /// @param [in] index The index.
+    ///
+    /// @return The parent row, or -1 for blocks.
+    int GetParentRow(const QModelIndex& index) const;
+
+    /// @brief Get the type of a block or row regardless of storage mode.
+    ///
+    /// @param [in] parent_row The parent row, or -1 for blocks.
+    /// @param [in] row        The row.
+    ///
+    /// @return The row type.
+    RowType GetRowType(int parent_row, int row) const;
+
+    /// @brief Get the line number of a block or row as used by GetLineNumberModelIndex.
+    ///
+    /// @param [in] parent_row The parent row, or -1 for blocks.
+    /// @param [in] row        The row.
+    ///
+    /// @return The line number, or -1 if the row is not mapped to a line.
+    int GetLineNumber(int parent_row, int row) const;
+
+    /// @brief Emit dataChanged with Qt::BackgroundRole for a range of lines, as one signal per block.
+    ///
+    /// @param [in] first_line_number The first line number.
+    /// @param [in] last_line_number  The last line number.
+    void EmitLineBackgroundChanged(int first_line_number, int last_line_number);
+
+    /// @brief Parse a block for blocks_.
+    ///
+    /// @param [in] position     The position of the block in blocks_.
+    /// @param [in] source_block The block to parse.
+    /// @param [in] source_hash  The hash of the block to parse.
+    ///
+    /// @return The block.
+    std::shared_ptr<Block> MakeBlock(int position, const SourceBlock& source_block, uint64_t source_hash) const;
+
+    /// @brief Parse the rows of a block for blocks_.
+    ///
+    /// @param [in]  source_block The block to parse.
+    /// @param [out] rows         The rows.
+    void MakeRows(const SourceBlock& source_block, std::vector<std::shared_ptr<Row>>& rows) const;
 
-    std::array<uint32_t, kColumnCount> column_widths_ = {0, 0, 0, 0, 0};  ///< Cached column widths.
+    /// @brief Insert blocks into blocks_, signalling the inserted rows.
+    ///
+    /// @param [in] first_row The row of the first block.
+    /// @param [in] blocks    The blocks; moved from.
+    void InsertBlocks(int first_row, std::vector<std::shared_ptr<Block>>& blocks);
+
+    /// @brief Remove blocks from blocks_, signalling the removed rows.
+    ///
+    /// @param [in] first_row The row of the first block.
+    /// @param [in] count     The number of blocks.
+    void RemoveBlocks(int first_row, int count);
+
+    /// @brief Update a block of blocks_ to a block matched to it by UpdateBlocks, signalling the rows that changed.
+    ///
+    /// @param [in] row          The row of the block.
+    /// @param [in] source_block The matched block.
+    /// @param [in] source_hash  The hash of the matched block.
+    ///
+    /// @return true if the block was parsed again, false if only its line numbers, pc addresses and binary representations were updated.
+    bool UpdateBlock(int row, const SourceBlock& source_block, uint64_t source_hash);
+
+    /// @brief Intern the text of the tokens of blocks_ in the symbol table.
+    ///
+    /// @param [in] intern_all true to intern every token again, after the symbol table changed; false to only intern tokens without a symbol.
+    void InternBlockTokens(bool intern_all);
+
+    /// @brief Get the symbol of the op code of an instruction.
+    ///
+    /// @param [in] parent_row The row of the block.
+    /// @param [in] row        The row of the instruction in the block.
+    ///
+    /// @return The symbol, or IsaSymbolTable::kInvalidSymbol if the row is not an instruction or its op code is not interned.
+    uint32_t GetOpCodeSymbol(int parent_row, int row) const;
+
+    /// @brief Get the line number of a block or row regardless of storage mode.
+    ///
+    /// @param [in] parent_row The parent row, or -1 for blocks.
+    /// @param [in] row        The row.
+    ///
+    /// @return The line number.
+    uint32_t GetRowLineNumber(int parent_row, int row) const;
+
+    /// @brief Get the op code column text of a block or row regardless of storage mode; a label, comment or op code.
+    ///
+    /// @param [in] parent_row The parent row, or -1 for blocks.
+    /// @param [in] row        The row.
+    ///
+    /// @return A view of the text, valid until this model changes.
+    std::string_view GetRowText(int parent_row, int row) const;
+
+    /// @brief Get the pc address text of an instruction regardless of storage mode.
+    ///
+    /// @param [in] parent_row The parent row.
+    /// @param [in] row        The row.
+    ///
+    /// @return A view of the text, empty if the row is not an instruction.
+    std::string_view GetRowPcAddress(int parent_row, int row) const;
+
+    /// @brief Get the binary representation words of an instruction regardless of storage mode.
+    ///
+    /// @param [in]  parent_row The parent row.
+    /// @param [in]  row        The row.
+    /// @param [out] word_count The number of words; 0 if the row is not an instruction.
+    ///
+    /// @return The first word, valid until the rows change.
+    const uint32_t* GetRowWords(int parent_row, int row, size_t& word_count) const;
+
+    /// @brief Get the encoding the isa decoder decodes for an instruction regardless of storage mode.
+    ///
+    /// @param [in] parent_row The parent row.
+    /// @param [in] row        The row.
+    ///
+    /// @return The encoding; see IsaInstructionEncoding::GetDecoderEncoding. 0 if the row is not an instruction.
+    uint64_t GetRowDecoderEncoding(int parent_row, int row) const;
+
+    /// @brief Build the operand column text of an instruction regardless of storage mode.
+    ///
+    /// @param [in]  parent_row    The parent row.
+    /// @param [in]  row           The row.
+    /// @param [out] operands_text The operands joined with their separators; empty if the row is not an instruction.
+    void GetRowOperandsText(int parent_row, int row, std::string& operands_text) const;
+
+    /// @brief Get whether an instruction should be color coded regardless of storage mode.
+    ///
+    /// @param [in] parent_row The parent row, or -1 for blocks.
+    /// @param [in] row        The row.
+    ///
+    /// @return true if the row is not an instruction or the instruction is enabled, false otherwise.
+    bool GetRowEnabled(int parent_row, int row) const;
+
+    /// @brief Get the number of branch instructions that target a code block regardless of storage mode.
+    ///
+    /// @param [in] block_row The row of the block.
+    ///
+    /// @return The number of branch instructions targeting the block.
+    size_t GetBranchInstructionCount(int block_row) const;
+
+    /// @brief Get a branch instruction that targets a code block regardless of storage mode.
+    ///
+    /// @param [in] block_row    The row of the block.
+    /// @param [in] branch_index The index of the branch instruction, less than GetBranchInstructionCount.
+    ///
+    /// @return The <parent row, child row> of the branch instruction.
+    std::pair<uint32_t, uint32_t> GetBranchInstruction(int block_row, size_t branch_index) const;
+
+    /// @brief Get the deprecated list of branch instructions that target a code block; see InstructionBlock::mapped_branch_instructions.
+    ///
+    /// @param [in] block_row The row of the block.
+    ///
+    /// @return The list, or nullptr if the block is not a code block of StorageMode::kBlocks.
+    const std::vector<std::pair<uint32_t, uint32_t>>* GetMappedBranchInstructions(int block_row) const;
+
+    /// @brief Get the block targeted by a branch instruction regardless of storage mode.
+    ///
+    /// @param [in] parent_row The parent row.
+    /// @param [in] row        The row.
+    ///
+    /// @return The row of the targeted block, or -1 if the row is not a mapped branch instruction.
+    int GetBranchTarget(int parent_row, int row) const;
+
+    /// @brief Get the label a branch instruction targets regardless of storage mode.
+    ///
+    /// @param [in] parent_row The parent row.
+    /// @param [in] row        The row.
+    ///
+    /// @return The text of the first token of the first operand, or an empty string if the row has no operands.
+    std::string_view GetBranchTargetLabel(int parent_row, int row) const;
+
+    /// @brief Remember the block a branch instruction targets regardless of storage mode; see GetBranchTarget.
+    ///
+    /// @param [in] parent_row The parent row.
+    /// @param [in] row        The row.
+    /// @param [in] block_row  The row of the targeted block.
+    void SetBranchTarget(int parent_row, int row, int block_row);
+
+    StorageMode storage_mode_;  ///< How the rows of this model are stored.
+
+    mutable IsaVirtualRowSource                   virtual_rows_;          ///< Rows of StorageMode::kVirtual, and the rows parsed from them.
+    std::unique_ptr<QFile>                        virtual_file_;          ///< The memory mapped file of the rows of StorageMode::kVirtual.
+    std::unordered_map<std::string_view, int32_t> virtual_label_blocks_;  ///< The code block of every label, to resolve branches as rows are parsed.
+    int                                           virtual_line_count_;    ///< The number of lines of StorageMode::kVirtual; see GetLineCount.
+
+    IsaControlFlowGraph control_flow_graph_;  ///< Edges between the blocks of this model; built by MapBlocksToBranchInstructions.
+
+    std::vector<std::thread>                         async_update_threads_;                ///< Worker threads of the asynchronous update.
+    std::atomic<bool>                                async_update_canceled_;               ///< true to tell worker threads to stop.
+    std::atomic<size_t>                              async_update_next_batch_;             ///< The next batch a worker thread should parse.
+    std::vector<size_t>                              async_update_batch_offsets_;          ///< First block of every batch, plus the block count.
+    std::map<size_t, std::shared_ptr<IsaRowStorage>> async_update_pending_batches_;        ///< Parsed batches waiting on earlier batches.
+    size_t                                           async_update_next_published_batch_;   ///< The next batch to insert into this model.
+    int                                              async_update_published_block_count_;  ///< The number of blocks inserted so far.
+    uint64_t                                         async_update_generation_;             ///< Incremented for every asynchronous update.
+
+    std::vector<std::thread>                                   search_threads_;               ///< Worker threads of the search.
+    std::atomic<bool>                                          search_canceled_;              ///< true to tell worker threads to stop.
+    std::atomic<size_t>                                        search_next_chunk_;            ///< The next chunk a worker thread should search.
+    size_t                                                     search_chunk_count_;           ///< The number of chunks of the search.
+    std::map<size_t, std::shared_ptr<IsaSearchIndex::Results>> search_pending_results_;       ///< Searched chunks waiting on earlier chunks.
+    size_t                                                     search_next_published_chunk_;  ///< The next chunk to publish.
+    uint64_t                                                   search_generation_;            ///< Incremented for every search.
+
+    QString  model_cache_path_;  ///< The cache file to write when the asynchronous update finishes; empty for none.
+    uint64_t model_cache_key_;   ///< The key of model_cache_path_.
+
+    std::thread       predecode_thread_;    ///< Decodes the instructions of this model in the background; see StartPredecodeThread.
+    std::atomic<bool> predecode_canceled_;  ///< true to tell the pre-decode thread to stop.
+
+    std::shared_ptr<IsaArchitectureDecoder> isa_decoder_;            ///< The decoder for the active architecture; may still be loading.
+    bool                                    isa_decoder_announced_;  ///< true once ArchitectureChanged was emitted for isa_decoder_.
+
+    IsaSearchIndex   search_index_;    ///< Index of the text of every line, built on demand by SearchLines and BeginSearch.
+    QString          search_text_;     ///< The text of the last search that used search_index_.
+    IsaRegisterIndex register_index_;  ///< Index of the register references of every line, built by CacheSizeHints.
+    IsaMetricColumns metric_columns_;  ///< The values of every metric per line; see AddMetric.
+
+    bool                                           display_text_cache_enabled_ = false;  ///< true to cache display text; see SetDisplayTextCacheEnabled.
+    std::array<std::vector<QString>, kColumnCount> display_text_cache_;                  ///< Display text of every line, per shared column.
+
+    std::array<uint32_t, kColumnCount> column_widths_           = {0, 0, 0, 0, 0};  ///< Cached column widths.
+    std::array<qreal, kColumnCount>    column_character_counts_ = {0, 0, 0, 0, 0};  ///< Padded character count of the widest text of every column.
 
     std::vector<std::pair<uint32_t, uint32_t>>
         line_number_corresponding_indices_;  ///< Map line numbers to their corresponding source model indices; Line number to <parent row, child row>.
 
-    amdisa::DecodeManager* decode_manager_;  ///< The handle to manager of all the architectures.
+    std::vector<uint32_t> block_line_numbers_;  ///< The line number of every parent block; the reverse of line_number_corresponding_indices_.
+
+    amdisa::DecodeManager* decode_manager_;  ///< The client's handle to manager of all the architectures; nullptr to use IsaDecoderRegistry.
 };
 
 Q_DECLARE_METATYPE(IsaItemModel::RowType);
@@ -11,57 +11,64 @@
 
 #include "isa_item_model.h"
 
-IsaProxyModel::IsaProxyModel(QObject* parent, std::vector<bool> columns_visiblity)
-    : QSortFilterProxyModel(parent)
+IsaColumnVisibility::IsaColumnVisibility(QAbstractProxyModel* proxy_model, const std::vector<bool>& columns_visiblity)
+    : proxy_model_(proxy_model)
 {
     Q_ASSERT(columns_visiblity.size() >= IsaItemModel::kColumnCount);
     for (int i = 0; i < IsaItemModel::kColumnCount; i++)
     {
         visible_columns_[i] = columns_visiblity[i];
 
+        viewing_options_checkboxes_[i] = nullptr;
+
         column_order_[i] = i;
     }
 }
 
-IsaProxyModel::~IsaProxyModel()
+IsaColumnVisibility::~IsaColumnVisibility()
+{
+}
+
+QAbstractProxyModel* IsaColumnVisibility::GetProxyModel() const
 {
+    return proxy_model_;
 }
 
-void IsaProxyModel::SetColumnVisibility(uint32_t column, bool visibility, QHeaderView* header)
+void IsaColumnVisibility::SetColumnVisibility(uint32_t column, bool visibility, QHeaderView* header)
 {
-    if (column >= visible_columns_.size())
+    if (column >= visible_columns_.size() || visible_columns_[column] == visibility)
     {
         return;
     }
 
-    visible_columns_[column] = visibility;
-
     if (!visibility && header != nullptr)
     {
-        int proxy_column = mapFromSource(sourceModel()->index(0, column)).column();
+        int proxy_column = proxy_model_->mapFromSource(proxy_model_->sourceModel()->index(0, column)).column();
         int visual_index = header->visualIndex(proxy_column);
 
         column_order_[column] = visual_index;
     }
 
-    invalidateFilter();
+    visible_columns_[column] = visibility;
+
+    ApplyColumnVisibility(column, visibility);
 
     if (visibility && header != nullptr)
     {
-        int proxy_column = mapFromSource(sourceModel()->index(0, column)).column();
-        if (column_order_[column] >= columnCount())
+        int proxy_column = proxy_model_->mapFromSource(proxy_model_->sourceModel()->index(0, column)).column();
+        if (column_order_[column] >= proxy_model_->columnCount())
         {
-            column_order_[column] = columnCount() - 1;
+            column_order_[column] = proxy_model_->columnCount() - 1;
         }
         header->moveSection(proxy_column, column_order_[column]);
     }
 }
 
-void IsaProxyModel::CreateViewingOptionsCheckbox(uint32_t column, QWidget* parent)
+void IsaColumnVisibility::CreateViewingOptionsCheckbox(uint32_t column, QWidget* parent)
 {
     if (column > IsaItemModel::kLineNumber && column < IsaItemModel::kColumnCount)
     {
-        auto source_model = sourceModel();
+        auto source_model = proxy_model_->sourceModel();
         if (source_model)
         {
             QString column_name                 = source_model->headerData(column, Qt::Horizontal, Qt::DisplayRole).toString();
@@ -105,7 +112,7 @@ void IsaProxyModel::CreateViewingOptionsCheckbox(uint32_t column, QWidget* paren
     }
 }
 
-const QCheckBox* IsaProxyModel::GetViewingOptionsCheckbox(uint32_t column)
+const QCheckBox* IsaColumnVisibility::GetViewingOptionsCheckbox(uint32_t column)
 {
     if (column < IsaItemModel::kColumnCount)
     {
@@ -114,7 +121,7 @@ const QCheckBox* IsaProxyModel::GetViewingOptionsCheckbox(uint32_t column)
     return nullptr;
 }
 
-uint32_t IsaProxyModel::GetSourceColumnIndex(const QCheckBox* checkbox)
+uint32_t IsaColumnVisibility::GetSourceColumnIndex(const QCheckBox* checkbox)
 {
     uint32_t source_column_index = IsaItemModel::kColumnCount;
 
@@ -129,11 +136,21 @@ uint32_t IsaProxyModel::GetSourceColumnIndex(const QCheckBox* checkbox)
     return source_column_index;
 }
 
-uint32_t IsaProxyModel::GetNumberOfViewingOptions()
+uint32_t IsaColumnVisibility::GetNumberOfViewingOptions()
 {
     return IsaItemModel::kColumnCount;
 }
 
+IsaProxyModel::IsaProxyModel(QObject* parent, std::vector<bool> columns_visiblity)
+    : QSortFilterProxyModel(parent)
+    , IsaColumnVisibility(this, columns_visiblity)
+{
+}
+
+IsaProxyModel::~IsaProxyModel()
+{
+}
+
 bool IsaProxyModel::filterAcceptsColumn(int source_column, const QModelIndex& source_parent) const
 {
     Q_UNUSED(source_parent);
@@ -144,4 +161,12 @@ bool IsaProxyModel::filterAcceptsColumn(int source_column, const QModelIndex& so
     }
 
     return visible_columns_[source_column];
-}
\ No newline at end of file
+}
+
+void IsaProxyModel::ApplyColumnVisibility(uint32_t column, bool visibility)
+{
+    Q_UNUSED(column);
+    Q_UNUSED(visibility);
+
+    invalidateFilter();
+}
@@ -9,34 +9,41 @@
 #define QTISAGUI_ISA_PROXY_MODEL_H_
 
 #include <array>
+#include <cstdint>
+#include <vector>
 
+#include <QAbstractProxyModel>
 #include <QCheckBox>
 #include <QHeaderView>
 #include <QSortFilterProxyModel>
 
 #include "isa_item_model.h"
 
-/// @brief IsaProxyModel is a filter model meant to filter default columns for an IsaItemModel.
+/// @brief IsaColumnVisibility hides IsaItemModel columns of a proxy model, and owns the checkboxes that toggle them.
 ///
-/// It filters out IsaItemModel columns set to be invisible via the gui.
-class IsaProxyModel : public QSortFilterProxyModel
+/// Shared by IsaProxyModel and IsaColumnProxyModel, so either can be given to IsaWidget.
+class IsaColumnVisibility
 {
-    Q_OBJECT
-
 public:
-    /// @brief Constructor; default all columns to visible.
+    /// @brief Constructor.
     ///
-    /// @param [in] parent The parent object.
-    /// @param [in] columns_visiblity Vector to specify column visibilty. kPcAddress and kBinaryRepresentation are hidden by default.
-    explicit IsaProxyModel(QObject* parent = nullptr, std::vector<bool> columns_visiblity = {true, false, true, true, false});
+    /// @param [in] proxy_model       The proxy model whose columns are hidden; this object must be a base of it.
+    /// @param [in] columns_visiblity Vector to specify column visibilty.
+    IsaColumnVisibility(QAbstractProxyModel* proxy_model, const std::vector<bool>& columns_visiblity);
 
     /// @brief Destructor.
-    virtual ~IsaProxyModel();
+    virtual ~IsaColumnVisibility();
+
+    /// @brief Get the proxy model whose columns are hidden.
+    ///
+    /// @return The proxy model.
+    QAbstractProxyModel* GetProxyModel() const;
 
-    /// @brief Change the visibility of a column and invalidate this model.
+    /// @brief Change the visibility of a column and update the proxy model.
     ///
     /// @param [in] column     The IsaItemModel column to change.
     /// @param [in] visibility true to make the column visible, false to make it invisible.
+    /// @param [in] header     If set, the header to move the column back to where it was when it was hidden.
     virtual void SetColumnVisibility(uint32_t column, bool visibility, QHeaderView* header = nullptr);
 
     // @brief Create the visibility checkbox related to a column.
@@ -64,6 +71,39 @@ public:
     /// @return Total number of columns in this model.
     virtual uint32_t GetNumberOfViewingOptions();
 
+protected:
+    /// @brief Update the proxy model after the visibility of a column changed.
+    ///
+    /// @param [in] column     The IsaItemModel column that changed.
+    /// @param [in] visibility true if the column was made visible, false if it was made invisible.
+    virtual void ApplyColumnVisibility(uint32_t column, bool visibility) = 0;
+
+    std::array<bool, IsaItemModel::kColumnCount> visible_columns_;  ///< Keep track of which columns should be visible.
+
+private:
+    QAbstractProxyModel*                               proxy_model_;                 ///< The proxy model whose columns are hidden.
+    std::array<QCheckBox*, IsaItemModel::kColumnCount> viewing_options_checkboxes_;  ///< Corresponding checkboxes to each column.
+    int column_order_[IsaItemModel::kColumnCount];  ///< Keep track of where a hidden column should be placed when it is reshown.
+};
+
+/// @brief IsaProxyModel is a filter model meant to filter default columns for an IsaItemModel.
+///
+/// It filters out IsaItemModel columns set to be invisible via the gui. Applications that neither sort nor filter rows
+/// should prefer IsaColumnProxyModel, which hides columns without mapping tables.
+class IsaProxyModel : public QSortFilterProxyModel, public IsaColumnVisibility
+{
+    Q_OBJECT
+
+public:
+    /// @brief Constructor; default all columns to visible.
+    ///
+    /// @param [in] parent The parent object.
+    /// @param [in] columns_visiblity Vector to specify column visibilty. kPcAddress and kBinaryRepresentation are hidden by default.
+    explicit IsaProxyModel(QObject* parent = nullptr, std::vector<bool> columns_visiblity = {true, false, true, true, false});
+
+    /// @brief Destructor.
+    virtual ~IsaProxyModel();
+
 protected:
     /// @brief Override filterAcceptsColumn to filter columns set to be invisible.
     ///
@@ -73,10 +113,11 @@ protected:
     /// @return true if the column is marked as visible, false otherwise.
     virtual bool filterAcceptsColumn(int source_column, const QModelIndex& source_parent) const Q_DECL_OVERRIDE;
 
-private:
-    std::array<bool, IsaItemModel::kColumnCount>       visible_columns_;             ///< Keep track of which columns should be visible.
-    std::array<QCheckBox*, IsaItemModel::kColumnCount> viewing_options_checkboxes_;  ///< Corresponding checkboxes to each column.
-    int column_order_[IsaItemModel::kColumnCount];  ///< Keep track of where a hidden column should be placed when it is reshown.
+    /// @brief Invalidate the filter after the visibility of a column changed.
+    ///
+    /// @param [in] column     The IsaItemModel column that changed.
+    /// @param [in] visibility true if the column was made visible, false if it was made invisible.
+    virtual void ApplyColumnVisibility(uint32_t column, bool visibility) Q_DECL_OVERRIDE;
 };
 
 #endif  // QTISAGUI_ISA_PROXY_MODEL_H_
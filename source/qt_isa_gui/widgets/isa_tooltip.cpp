@@ -10,6 +10,8 @@
 #include <QSizePolicy>
 #include <QString>
 
+#include <utility>
+
 #include "qt_common/utils/qt_util.h"
 
 #include "qt_isa_gui/utility/isa_dictionary.h"
@@ -27,7 +29,11 @@ IsaTooltip::IsaTooltip(QWidget* parent, QWidget* container_widget)
     , description_(nullptr)
     , encodings_(nullptr)
     , layout_(nullptr)
+    , shown_content_(nullptr)
 {
+    // The op code is color coded with the colors of the theme.
+    connect(&QtCommon::QtUtils::ColorTheme::Get(), &QtCommon::QtUtils::ColorTheme::ColorThemeUpdated, this, &IsaTooltip::ClearCache);
+
     layout_ = new QGridLayout;
     layout_->setContentsMargins(TooltipWidget::kTooltipMargin, TooltipWidget::kTooltipMargin, TooltipWidget::kTooltipMargin, TooltipWidget::kTooltipMargin);
     background_widget_->setLayout(layout_);
@@ -72,6 +78,55 @@ IsaTooltip::~IsaTooltip()
 
 void IsaTooltip::UpdateText(const amdisa::InstructionInfo& decoded_info)
 {
+    const Content& content = GetContent(decoded_info);
+
+    if (&content == shown_content_)
+    {
+        // Sweeping the mouse over the same op code; the labels and size are already set.
+        return;
+    }
+
+    shown_content_ = &content;
+
+    instruction_->setText(content.rich_text_op_code);
+
+    description_->setText(content.description);
+    description_->setWordWrap(content.word_wrap);
+    description_->setFixedWidth(content.fixed_width);
+
+    background_widget_->setFixedWidth(content.background_width);
+
+    encodings_->setText(content.encodings);
+
+    background_widget_->adjustSize();
+    adjustSize();
+}
+
+void IsaTooltip::Prefetch(const amdisa::InstructionInfo& decoded_info)
+{
+    GetContent(decoded_info);
+}
+
+void IsaTooltip::ClearCache()
+{
+    content_cache_.clear();
+    shown_content_ = nullptr;
+}
+
+const IsaTooltip::Content& IsaTooltip::GetContent(const amdisa::InstructionInfo& decoded_info)
+{
+    // The encoding is part of the key; the same op code name can decode from more than one encoding.
+    std::string key = decoded_info.instruction_name;
+    key += '\n';
+    key += decoded_info.encoding_name;
+
+    auto content_iter = content_cache_.find(key);
+
+    if (content_iter != content_cache_.end())
+    {
+        return content_iter->second;
+    }
+
     const auto    op_code               = QString(decoded_info.instruction_name.c_str()).toLower().toStdString();
     const auto    functional_group      = decoded_info.functional_group_subgroup_info.IsaFunctionalGroup;
     const QString functional_group_name = amdisa::kFunctionalGroupName[static_cast<int>(functional_group)];
@@ -101,16 +156,13 @@ void IsaTooltip::UpdateText(const amdisa::InstructionInfo& decoded_info)
 
     background_width += word_wrap ? kMaxTooltipWidth : largest_width;
 
-    instruction_->setText(rich_text_op_code);
-
-    description_->setText(description);
-    description_->setWordWrap(word_wrap);
-    description_->setFixedWidth(fixed_width);
-
-    background_widget_->setFixedWidth(background_width);
+    Content content;
+    content.rich_text_op_code = rich_text_op_code;
+    content.description       = description;
+    content.encodings         = encodings;
+    content.word_wrap         = word_wrap;
+    content.fixed_width       = fixed_width;
+    content.background_width  = background_width;
 
-    encodings_->setText(encodings);
-
-    background_widget_->adjustSize();
-    adjustSize();
+    return content_cache_.emplace(std::move(key), std::move(content)).first->second;
 }
\ No newline at end of file
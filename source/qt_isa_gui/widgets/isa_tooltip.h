@@ -10,8 +10,12 @@
 
 #include <QGridLayout>
 #include <QLabel>
+#include <QString>
 #include <QWidget>
 
+#include <string>
+#include <unordered_map>
+
 #include "qt_common/custom_widgets/tooltip_widget.h"
 
 #include "amdisa/isa_decoder.h"
@@ -34,15 +38,46 @@ public:
 
     /// @brief Update the text shown in this tooltip.
     ///
+    /// The text and size only depend on the op code and encoding, so they are prepared once and kept until ClearCache.
+    ///
     /// @param [in] decoded_info The decoder's instruction info to use to update this tooltip.
     void UpdateText(const amdisa::InstructionInfo& decoded_info);
 
+    /// @brief Prepare the text and size of this tooltip for an instruction without showing it, so UpdateText only looks them up.
+    ///
+    /// @param [in] decoded_info The decoder's instruction info.
+    void Prefetch(const amdisa::InstructionInfo& decoded_info);
+
+    /// @brief Forget the prepared text of every instruction; call when the architecture of the instructions changes.
+    void ClearCache();
+
 private:
+    /// @brief The prepared text and size of this tooltip for one op code and encoding.
+    struct Content
+    {
+        QString rich_text_op_code;  ///< Color coded op code name and its functional group.
+        QString description;        ///< Op code description.
+        QString encodings;          ///< Op code encodings.
+        bool    word_wrap;          ///< true if the description is wrapped to the maximum width.
+        int     fixed_width;        ///< The width of the description.
+        int     background_width;   ///< The width of the background widget.
+    };
+
+    /// @brief Get the prepared text and size of this tooltip for an instruction, preparing them if needed.
+    ///
+    /// @param [in] decoded_info The decoder's instruction info.
+    ///
+    /// @return The prepared content; valid until ClearCache.
+    const Content& GetContent(const amdisa::InstructionInfo& decoded_info);
+
     QLabel*      instruction_;        ///< Color coded op code name and its functional group.
     QLabel*      description_label_;  ///< "Description" label.
     QLabel*      description_;        ///< Op code description.
     QLabel*      encodings_;          ///< Op code encodings.
     QGridLayout* layout_;             ///< The tooltip's layout.
+
+    std::unordered_map<std::string, Content> content_cache_;  ///< Prepared content, by op code name and encoding name.
+    const Content*                           shown_content_;  ///< The content shown now, or nullptr; points into content_cache_.
 };
 
 #endif  // QTISAGUI_ISA_TOOLTIP_H_
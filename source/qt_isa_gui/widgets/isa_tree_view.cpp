@@ -7,8 +7,10 @@
 
 #include "isa_tree_view.h"
 
+#include <QAbstractProxyModel>
 #include <QApplication>
 #include <QClipboard>
+#include <QFile>
 #include <QFontDatabase>
 #include <QItemSelectionModel>
 #include <QKeyEvent>
@@ -17,60 +19,19 @@
 #include <QScrollBar>
 #include <QSortFilterProxyModel>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 
 #include "qt_common/custom_widgets/scaled_tree_view.h"
 #include "qt_common/utils/common_definitions.h"
 #include "qt_common/utils/qt_util.h"
 
+#include "qt_isa_gui/core/isa_instrumentation.h"
+
 #include "isa_item_delegate.h"
 #include "isa_widget.h"
 
-/// struct containing info needed to sort model indices.
-/// The y position is used for sorting the indices vertically by rows, and the visual column for sorting indices horizontally.
-/// If the index is a comment it needs to be placed before all other columns except for line number.
-struct CompareIndexInfo
-{
-    QModelIndex source_index;   ///< The source model index.
-    int         visual_column;  ///< The order that the index's column appears visually on the table.
-    int         y_pos;          ///< The y pixel coordinate of the index.
-};
-
-/// @brief Compare function that sorts model indices by y position and visual column index order.
-///
-/// Also makes sure comments always come before all other columns except for line number.
-///
-/// @param lhs The compare info for the left hand side index.
-/// @param rhs The compare info for the right hand side model index.
-///
-/// @return true if the left model index is less than the right model index, false otherwise.
-static bool CompareModelIndices(const CompareIndexInfo& lhs, const CompareIndexInfo& rhs)
-{
-    if (lhs.y_pos == rhs.y_pos)
-    {
-        const QModelIndex lhs_index = lhs.source_index;
-        const QModelIndex rhs_index = rhs.source_index;
-
-        // Put comments in the first row.
-        if (lhs_index.data(IsaItemModel::kRowTypeRole).value<IsaItemModel::RowType>() == IsaItemModel::RowType::kComment)
-        {
-            // Put the opcode column before all other columns except for line number for comments rows.
-            if (lhs_index.column() == IsaItemModel::Columns::kOpCode)
-            {
-                return rhs_index.column() != IsaItemModel::Columns::kLineNumber;
-            }
-            else if (rhs_index.column() == IsaItemModel::Columns::kOpCode)
-            {
-                return lhs_index.column() == IsaItemModel::Columns::kLineNumber;
-            }
-        }
-
-        return lhs.visual_column < rhs.visual_column;
-    }
-
-    return lhs.y_pos < rhs.y_pos;
-}
-
 IsaTreeView::IsaTreeView(QWidget* parent)
     : QTreeView(parent)
     , isa_scroll_bar_(nullptr)
@@ -78,6 +39,11 @@ IsaTreeView::IsaTreeView(QWidget* parent)
     , copy_line_numbers_(true)
     , last_pinned_row_(std::pair<int, int>(-1, -1))
     , paint_column_separators_(true)
+    , visible_line_index_valid_(false)
+    , size_columns_from_model_(true)
+    , heatmap_metric_(-1)
+    , heatmap_line_count_(0)
+    , heatmap_rows_in_order_(false)
 {
     setObjectName("isa_tree_view_");
 
@@ -140,6 +106,18 @@ IsaTreeView::IsaTreeView(QWidget* parent)
 
     connect(this, &QTreeView::expanded, this, &IsaTreeView::IndexExpandedOrCollapsed);
     connect(this, &QTreeView::collapsed, this, &IsaTreeView::IndexExpandedOrCollapsed);
+
+    // Keep the visible line counts up to date before any other listener asks for line numbers.
+    connect(this, &QTreeView::expanded, this, [this](const QModelIndex& index) { UpdateVisibleLineCount(index, true); });
+    connect(this, &QTreeView::collapsed, this, [this](const QModelIndex& index) { UpdateVisibleLineCount(index, false); });
+
+    // Register references move in the scroll bar when code blocks above them are expanded or collapsed.
+    connect(this, &QTreeView::expanded, this, [this]() { UpdateRegisterReferenceMarkers(); });
+    connect(this, &QTreeView::collapsed, this, [this]() { UpdateRegisterReferenceMarkers(); });
+
+    // So do the lines every heatmap bucket of the scroll bar covers.
+    connect(this, &QTreeView::expanded, this, [this]() { BuildHeatmap(); });
+    connect(this, &QTreeView::collapsed, this, [this]() { BuildHeatmap(); });
 }
 
 IsaTreeView::~IsaTreeView()
@@ -151,6 +129,11 @@ void IsaTreeView::ReplaceDelegate(IsaItemDelegate* delegate)
     setItemDelegate(delegate);
 
     isa_item_delegate_.reset(delegate);
+
+    if (delegate != nullptr)
+    {
+        delegate->SetHeatmapMetric(heatmap_metric_);
+    }
 }
 
 void IsaTreeView::RegisterScrollAreas(std::vector<QScrollArea*> container_scroll_areas)
@@ -165,9 +148,9 @@ void IsaTreeView::RegisterScrollAreas(std::vector<QScrollArea*> container_scroll
 
 void IsaTreeView::SetHotSpotLineNumbers(const std::set<QModelIndex>& source_indices)
 {
-    std::set<int> line_numbers;
+    std::vector<int> line_numbers;
 
-    const QSortFilterProxyModel* proxy_model = qobject_cast<QSortFilterProxyModel*>(model());
+    const QAbstractProxyModel* proxy_model = qobject_cast<QAbstractProxyModel*>(model());
 
     for (const auto& source_index : source_indices)
     {
@@ -187,36 +170,20 @@ void IsaTreeView::SetHotSpotLineNumbers(const std::set<QModelIndex>& source_indi
             const QModelIndex instruction_proxy_index = proxy_model->mapFromSource(source_index);
             const QModelIndex code_block_proxy_index  = proxy_model->mapFromSource(source_index.parent());
 
-            for (int i = 0; i < code_block_proxy_index.row(); i++)
-            {
-                line_number++;  // +1 for previous code block's line number.
-
-                const QModelIndex next_code_block_index = proxy_model->index(i, IsaItemModel::Columns::kLineNumber);
-
-                // Add previous code block instruction count if previous code block is expanded.
-                if (isExpanded(next_code_block_index))
-                {
-                    line_number += proxy_model->rowCount(next_code_block_index);
-                }
-            }
-
-            line_number++;  // +1 for hot spot code block's line number.
-
-            // Add the hot spot instruction's index if its code block is expanded.
-            if (isExpanded(code_block_proxy_index))
-            {
-                line_number += instruction_proxy_index.row();
-            }
+            line_number = GetVisibleLineNumber(code_block_proxy_index, instruction_proxy_index.row());
 
-            line_numbers.emplace(line_number);
+            line_numbers.push_back(line_number);
         }
     }
 
-    isa_scroll_bar_->SetHotSpotLineNumbers(line_numbers);
+    isa_scroll_bar_->SetHotSpotLineNumbers(std::move(line_numbers));
 }
 
 void IsaTreeView::SetSearchMatchLineNumbers(const QString search_text, const std::set<QModelIndex>& source_indices)
 {
+    QTISAGUI_SCOPED_TIMER(kSetSearchMatchLineNumbers);
+    QTISAGUI_COUNT_ITEMS(kSetSearchMatchLineNumbers, source_indices.size());
+
     auto* delegate = qobject_cast<IsaItemDelegate*>(itemDelegate());
 
     if (delegate != nullptr)
@@ -224,9 +191,9 @@ void IsaTreeView::SetSearchMatchLineNumbers(const QString search_text, const std
         delegate->SetSearchText(search_text);
     }
 
-    std::set<int> line_numbers;
+    std::vector<int> line_numbers;
 
-    const QSortFilterProxyModel* proxy_model = qobject_cast<QSortFilterProxyModel*>(model());
+    const QAbstractProxyModel* proxy_model = qobject_cast<QAbstractProxyModel*>(model());
 
     for (const auto& source_index : source_indices)
     {
@@ -242,50 +209,245 @@ void IsaTreeView::SetSearchMatchLineNumbers(const QString search_text, const std
         {
             proxy_index = proxy_model->mapFromSource(proxy_index);
 
-            int row = 0;
-
             if (proxy_index_parent.isValid())
             {
                 // Search match matches an instruction.
 
                 proxy_index_parent = proxy_model->mapFromSource(proxy_index_parent);
 
-                row = proxy_index_parent.row();
+                line_number = GetVisibleLineNumber(proxy_index_parent, proxy_index.row());
             }
             else
             {
                 // Search match matches a code block.
 
-                row = proxy_index.row();
+                line_number = GetVisibleLineNumber(proxy_index, -1);
             }
 
-            for (int i = 0; i < row; i++)
-            {
-                line_number++;  // +1 for previous code block's line number.
+            line_numbers.push_back(line_number);
+        }
+    }
 
-                const QModelIndex next_code_block_index = proxy_model->index(i, IsaItemModel::Columns::kLineNumber);
+    isa_scroll_bar_->SetSearchMatchLineNumbers(std::move(line_numbers));
+}
 
-                // Add previous code block instruction count if previous code block is expanded.
-                if (isExpanded(next_code_block_index))
-                {
-                    line_number += proxy_model->rowCount(next_code_block_index);
-                }
-            }
+void IsaTreeView::SetRegisterReferenceLineNumbers(std::vector<int> line_numbers)
+{
+    register_reference_lines_ = std::move(line_numbers);
+
+    UpdateRegisterReferenceMarkers();
+}
 
-            line_number++;  // +1 for search match code block's line number.
+bool IsaTreeView::ScrollToRegisterReference(bool forward)
+{
+    const QAbstractProxyModel* proxy_model  = qobject_cast<QAbstractProxyModel*>(model());
+    IsaItemModel*              source_model = (proxy_model != nullptr) ? qobject_cast<IsaItemModel*>(proxy_model->sourceModel()) : nullptr;
 
-            // If a search match matches an instruction (not a code block), and its parent code block is expanded,
-            // add the instruction's index too.
-            if (proxy_index_parent.isValid() && isExpanded(proxy_index_parent))
-            {
-                line_number += proxy_index.row();
-            }
+    if (source_model == nullptr || register_reference_lines_.empty())
+    {
+        return false;
+    }
+
+    const int current_line = currentIndex().isValid() ? source_model->GetLineNumber(proxy_model->mapToSource(currentIndex())) : -1;
+
+    int line_number = 0;
+
+    if (forward)
+    {
+        const auto next_iter = std::upper_bound(register_reference_lines_.begin(), register_reference_lines_.end(), current_line);
+
+        line_number = (next_iter != register_reference_lines_.end()) ? *next_iter : register_reference_lines_.front();
+    }
+    else
+    {
+        const auto previous_iter = std::lower_bound(register_reference_lines_.begin(), register_reference_lines_.end(), current_line);
+
+        line_number = (previous_iter != register_reference_lines_.begin()) ? *(previous_iter - 1) : register_reference_lines_.back();
+    }
+
+    const QModelIndex source_index = source_model->GetLineNumberModelIndex(line_number);
+
+    if (!source_index.isValid())
+    {
+        return false;
+    }
+
+    ScrollToIndex(source_index, false, true, true);
+
+    return true;
+}
+
+void IsaTreeView::SetHeatmapMetric(int metric)
+{
+    disconnect(heatmap_connection_);
 
-            line_numbers.emplace(line_number);
+    heatmap_metric_ = metric;
+
+    IsaItemModel* source_model = GetSourceModel();
+
+    if (source_model != nullptr && heatmap_metric_ >= 0)
+    {
+        heatmap_connection_ = connect(source_model, &IsaItemModel::MetricValuesChanged, this, &IsaTreeView::HeatmapMetricValuesChanged);
+    }
+
+    IsaItemDelegate* isa_item_delegate = qobject_cast<IsaItemDelegate*>(itemDelegate());
+
+    if (isa_item_delegate != nullptr)
+    {
+        isa_item_delegate->SetHeatmapMetric(heatmap_metric_);
+    }
+
+    BuildHeatmap();
+
+    viewport()->update();
+}
+
+QBitArray IsaTreeView::GetExpandedBlocks() const
+{
+    const QAbstractItemModel* tree_model = model();
+
+    if (tree_model == nullptr)
+    {
+        return QBitArray();
+    }
+
+    const int code_block_count = tree_model->rowCount();
+
+    QBitArray expanded_blocks(code_block_count);
+
+    for (int code_block_row = 0; code_block_row < code_block_count; code_block_row++)
+    {
+        if (isExpanded(tree_model->index(code_block_row, 0)))
+        {
+            expanded_blocks.setBit(code_block_row);
+        }
+    }
+
+    return expanded_blocks;
+}
+
+void IsaTreeView::SetExpandedBlocks(const QBitArray& expanded_blocks)
+{
+    const QAbstractItemModel* tree_model = model();
+
+    if (tree_model == nullptr || expanded_blocks.size() != tree_model->rowCount())
+    {
+        return;
+    }
+
+    const bool updates_enabled = updatesEnabled();
+    const bool signals_blocked = blockSignals(true);
+
+    setUpdatesEnabled(false);
+
+    // While a layout is pending QTreeView only records the expand state of a code block, rather than inserting or removing its rows right away.
+    scheduleDelayedItemsLayout();
+
+    for (int code_block_row = 0; code_block_row < expanded_blocks.size(); code_block_row++)
+    {
+        const QModelIndex code_block_index = tree_model->index(code_block_row, 0);
+        const bool        expand           = expanded_blocks.testBit(code_block_row);
+
+        if (isExpanded(code_block_index) != expand)
+        {
+            setExpanded(code_block_index, expand);
         }
     }
 
-    isa_scroll_bar_->SetSearchMatchLineNumbers(line_numbers);
+    executeDelayedItemsLayout();
+
+    setUpdatesEnabled(updates_enabled);
+    blockSignals(signals_blocked);
+
+    InvalidateVisibleLineCounts();
+}
+
+void IsaTreeView::InvalidateVisibleLineCounts()
+{
+    visible_line_index_valid_ = false;
+
+    // Called after expandAll or collapseAll, which move every register reference and heatmap bucket.
+    UpdateRegisterReferenceMarkers();
+    BuildHeatmap();
+}
+
+void IsaTreeView::reset()
+{
+    QTreeView::reset();
+
+    InvalidateVisibleLineCounts();
+}
+
+bool IsaTreeView::IsRowSpanned(int row, const QModelIndex& parent) const
+{
+    // Code blocks and comments at the top level.
+    if (!parent.isValid())
+    {
+        return true;
+    }
+
+    if (parent.row() == last_pinned_row_.first && row == last_pinned_row_.second)
+    {
+        return true;
+    }
+
+    if (isFirstColumnSpanned(row, parent))
+    {
+        return true;
+    }
+
+    const QAbstractProxyModel* proxy_model  = qobject_cast<const QAbstractProxyModel*>(model());
+    const IsaItemModel*        source_model = nullptr;
+    QModelIndex                source_index = model() != nullptr ? model()->index(row, 0, parent) : QModelIndex();
+
+    if (proxy_model != nullptr)
+    {
+        source_model = qobject_cast<const IsaItemModel*>(proxy_model->sourceModel());
+        source_index = proxy_model->mapToSource(source_index);
+    }
+    else
+    {
+        source_model = qobject_cast<const IsaItemModel*>(model());
+    }
+
+    // Child comments.
+    return source_model != nullptr && source_model->GetRowType(source_index) == IsaItemModel::RowType::kComment;
+}
+
+QModelIndex IsaTreeView::indexAt(const QPoint& point) const
+{
+    const QModelIndex index = QTreeView::indexAt(point);
+
+    // Spanned rows are a single cell, as far as the delegate is concerned.
+    if (index.isValid() && index.column() != 0 && IsRowSpanned(index.row(), index.parent()))
+    {
+        return index.siblingAtColumn(0);
+    }
+
+    return index;
+}
+
+QRect IsaTreeView::visualRect(const QModelIndex& index) const
+{
+    QRect rectangle = QTreeView::visualRect(index);
+
+    if (!index.isValid() || index.column() != 0 || rectangle.isEmpty() || isFirstColumnSpanned(index.row(), index.parent()) ||
+        !IsRowSpanned(index.row(), index.parent()))
+    {
+        return rectangle;
+    }
+
+    int first_section = -1;
+    int last_section  = -1;
+
+    GetVisibleSectionRange(first_section, last_section);
+
+    if (last_section != -1)
+    {
+        rectangle.setRight(columnViewportPosition(last_section) + header()->sectionSize(last_section) - 1);
+    }
+
+    return rectangle;
 }
 
 void IsaTreeView::ShowBranchInstructionsMenu(QVector<QModelIndex> source_indices, QPoint global_position)
@@ -319,7 +481,7 @@ void IsaTreeView::ShowBranchInstructionsMenu(QVector<QModelIndex> source_indices
 
 void IsaTreeView::ScrollToIndex(const QModelIndex source_index, bool record, bool select_row, bool notify_listener)
 {
-    const QSortFilterProxyModel* isa_tree_proxy_model = qobject_cast<const QSortFilterProxyModel*>(this->model());
+    const QAbstractProxyModel* isa_tree_proxy_model = qobject_cast<const QAbstractProxyModel*>(this->model());
 
     QModelIndex isa_tree_view_index = source_index;
 
@@ -417,7 +579,14 @@ void IsaTreeView::drawRow(QPainter* painter, const QStyleOptionViewItem& option,
     }
 
     // Paint the rest of the rows contents on top of the background.
-    QTreeView::drawRow(painter, option, index);
+    if (!isFirstColumnSpanned(index.row(), index.parent()) && IsRowSpanned(index.row(), index.parent()))
+    {
+        DrawSpannedRow(painter, option, index);
+    }
+    else
+    {
+        QTreeView::drawRow(painter, option, index);
+    }
 }
 
 void IsaTreeView::keyPressEvent(QKeyEvent* event)
@@ -445,6 +614,16 @@ void IsaTreeView::keyPressEvent(QKeyEvent* event)
         set_auto_scroll_object.EnableAutoScroll();
     }
 
+    // Alt+Down/Alt+Up step through the references of the selected register.
+    if ((event->key() == Qt::Key_Down || event->key() == Qt::Key_Up) && (event->modifiers() & Qt::AltModifier))
+    {
+        if (ScrollToRegisterReference(event->key() == Qt::Key_Down))
+        {
+            event->accept();
+            event_handled = true;
+        }
+    }
+
     // The isa_widget will handle Ctrl+Right/Ctrl+Left to expand/collapse code blocks, so ignore the event and pass it back up to the widget.
     if ((event->key() == Qt::Key_Left || event->key() == Qt::Key_Right) && (event->modifiers() & Qt::ControlModifier))
     {
@@ -458,6 +637,13 @@ void IsaTreeView::keyPressEvent(QKeyEvent* event)
     }
 }
 
+void IsaTreeView::paintEvent(QPaintEvent* event)
+{
+    QTISAGUI_SCOPED_TIMER(kPaintFrame);
+
+    QTreeView::paintEvent(event);
+}
+
 void IsaTreeView::ToggleCopyLineNumbers()
 {
     copy_line_numbers_ = !copy_line_numbers_;
@@ -470,105 +656,236 @@ void IsaTreeView::CopyRowsToClipboard()
     // Copy/Paste.
     if (selection_model != nullptr && selection_model->hasSelection())
     {
-        QString clipboard_text = "";
+        std::vector<IsaItemModel::ExportRange> ranges;
+        std::vector<int>                       columns;
+
+        const IsaItemModel* source_model = GetExportRows(true, ranges, columns);
 
-        QModelIndexList selection = selection_model->selectedIndexes();
+        if (source_model == nullptr)
+        {
+            return;
+        }
 
-        std::vector<CompareIndexInfo> view_sorted_selection;
+        // Rows are written straight from the isa model in line order, instead of sorting and formatting every selected index.
+        std::string clipboard_text;
 
-        std::map<int, int> column_max_widths;
+        source_model->ExportRows(ranges, columns, IsaItemModel::ExportFormat::kText, clipboard_text);
 
-        for (const QModelIndex& index : selection)
+        if (!clipboard_text.empty())
         {
-            CompareIndexInfo compare_index_info;
-            compare_index_info.source_index = index;
+            QClipboard* clipboard = QApplication::clipboard();
+            clipboard->setText(QString::fromUtf8(clipboard_text.data(), static_cast<qsizetype>(clipboard_text.size())));
+        }
+    }
+}
 
-            IsaProxyModel* proxy_model = qobject_cast<IsaProxyModel*>(model());
-            if (proxy_model != nullptr)
-            {
-                compare_index_info.source_index = proxy_model->mapToSource(index);
-            }
+bool IsaTreeView::ExportRowsToFile(const QString& file_path, IsaItemModel::ExportFormat format, bool selected_rows_only) const
+{
+    std::vector<IsaItemModel::ExportRange> ranges;
+    std::vector<int>                       columns;
+
+    const IsaItemModel* source_model = GetExportRows(selected_rows_only, ranges, columns);
+
+    if (source_model == nullptr)
+    {
+        return false;
+    }
+
+    QFile file(file_path);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    const bool written = source_model->ExportRows(ranges, columns, format, [&file](std::string_view chunk) {
+        return file.write(chunk.data(), static_cast<qint64>(chunk.size())) == static_cast<qint64>(chunk.size());
+    });
+
+    file.close();
+
+    return written && file.error() == QFileDevice::NoError;
+}
+
+const IsaItemModel* IsaTreeView::GetExportRows(bool selected_rows_only, std::vector<IsaItemModel::ExportRange>& ranges, std::vector<int>& columns) const
+{
+    ranges.clear();
+    columns.clear();
+
+    const QAbstractItemModel*  view_model   = model();
+    const QAbstractProxyModel* proxy_model  = qobject_cast<const QAbstractProxyModel*>(view_model);
+    const IsaItemModel*        source_model = qobject_cast<const IsaItemModel*>((proxy_model != nullptr) ? proxy_model->sourceModel() : view_model);
+
+    if (source_model == nullptr)
+    {
+        return nullptr;
+    }
+
+    for (int visual_index = 0; visual_index < header()->count() && view_model->rowCount() > 0; visual_index++)
+    {
+        const int logical_index = header()->logicalIndex(visual_index);
+
+        if (header()->isSectionHidden(logical_index))
+        {
+            continue;
+        }
+
+        const QModelIndex view_index    = view_model->index(0, logical_index);
+        const int         source_column = (proxy_model != nullptr) ? proxy_model->mapToSource(view_index).column() : view_index.column();
+
+        if (source_column < 0 || source_column >= IsaItemModel::kColumnCount || (source_column == IsaItemModel::kLineNumber && !copy_line_numbers_))
+        {
+            continue;
+        }
+
+        columns.push_back(source_column);
+    }
+
+    // Take the rows as ranges of source rows, then put the rows of every code block right after it.
 
-            const int column_index = index.column();
+    std::vector<IsaItemModel::ExportRange> block_ranges;
+    std::vector<IsaItemModel::ExportRange> child_ranges;
 
-            compare_index_info.visual_column = header()->visualIndex(column_index);
-            compare_index_info.y_pos         = visualRect(index).y();
+    // A proxy model that sorts or filters rows does not keep the source rows, so view rows are mapped one by one.
+    const auto add_view_rows = [&](const QModelIndex& view_parent, int first_row, int last_row) {
+        auto& row_ranges = view_parent.isValid() ? child_ranges : block_ranges;
 
-            // Check whether line numbers should be included.
-            if (column_index == IsaItemModel::kLineNumber && !copy_line_numbers_)
+        if (proxy_model == nullptr)
+        {
+            row_ranges.push_back({view_parent.isValid() ? view_parent.row() : -1, first_row, last_row});
+            return;
+        }
+
+        for (int row = first_row; row <= last_row; row++)
+        {
+            const QModelIndex source_index = proxy_model->mapToSource(view_model->index(row, 0, view_parent));
+
+            if (!source_index.isValid())
             {
                 continue;
             }
 
-            view_sorted_selection.push_back(compare_index_info);
+            const int source_parent_row = source_index.parent().isValid() ? source_index.parent().row() : -1;
 
-            // Ignore the column widths of comments and code blocks.
-            if (column_index != IsaItemModel::kLineNumber && isFirstColumnSpanned(index.row(), index.parent()))
+            if (!row_ranges.empty() && row_ranges.back().parent_row == source_parent_row && row_ranges.back().last_row + 1 == source_index.row())
             {
-                continue;
+                row_ranges.back().last_row = source_index.row();
+            }
+            else
+            {
+                row_ranges.push_back({source_parent_row, source_index.row(), source_index.row()});
             }
+        }
+    };
+
+    if (!selected_rows_only)
+    {
+        const int block_count = view_model->rowCount();
+
+        if (block_count > 0)
+        {
+            add_view_rows(QModelIndex(), 0, block_count - 1);
+        }
+
+        for (int block = 0; block < block_count; block++)
+        {
+            const QModelIndex block_index = view_model->index(block, 0);
+            const int         child_count = isExpanded(block_index) ? view_model->rowCount(block_index) : 0;
 
-            QString text = index.data(Qt::DisplayRole).toString();
+            if (child_count > 0)
+            {
+                add_view_rows(block_index, 0, child_count - 1);
+            }
+        }
+    }
+    else if (selectionModel() != nullptr)
+    {
+        for (const QItemSelectionRange& selection_range : selectionModel()->selection())
+        {
+            const QModelIndex parent = selection_range.parent();
 
-            // Indent opcodes.
-            if (compare_index_info.source_index.column() == IsaItemModel::kOpCode && compare_index_info.source_index.parent().isValid() &&
-                compare_index_info.source_index.data(IsaItemModel::kRowTypeRole).value<IsaItemModel::RowType>() == IsaItemModel::RowType::kCode)
+            if (!parent.isValid() || isExpanded(parent))
             {
-                text = QString("    " + text);
+                add_view_rows(parent, selection_range.top(), selection_range.bottom());
             }
+        }
+    }
+
+    // Column ranges of the same rows overlap, and mapped rows come in view order, so sort and merge them.
+    const auto sort_and_merge = [](std::vector<IsaItemModel::ExportRange>& row_ranges) {
+        std::sort(row_ranges.begin(), row_ranges.end(), [](const IsaItemModel::ExportRange& lhs, const IsaItemModel::ExportRange& rhs) {
+            return lhs.parent_row < rhs.parent_row || (lhs.parent_row == rhs.parent_row && lhs.first_row < rhs.first_row);
+        });
 
-            const int text_length = text.length();
+        size_t merged_count = 0;
 
-            if (column_max_widths.find(compare_index_info.visual_column) != column_max_widths.end())
+        for (size_t i = 0; i < row_ranges.size(); i++)
+        {
+            if (merged_count > 0)
             {
-                const int old_max_width = column_max_widths.at(compare_index_info.visual_column);
+                IsaItemModel::ExportRange& last_range = row_ranges[merged_count - 1];
 
-                if (text_length > old_max_width)
+                if (last_range.parent_row == row_ranges[i].parent_row && row_ranges[i].first_row <= last_range.last_row + 1)
                 {
-                    column_max_widths[compare_index_info.visual_column] = text_length;
+                    last_range.last_row = std::max(last_range.last_row, row_ranges[i].last_row);
+                    continue;
                 }
             }
-            else
-            {
-                column_max_widths[compare_index_info.visual_column] = text_length;
-            }
+
+            row_ranges[merged_count++] = row_ranges[i];
         }
 
-        // The selected items returned by the selection item model are not guaranteed to be sorted; sort them so
-        // they are pasted in the same order that they appear on screen.
-        std::sort(view_sorted_selection.begin(), view_sorted_selection.end(), CompareModelIndices);
+        row_ranges.resize(merged_count);
+    };
+
+    sort_and_merge(block_ranges);
+    sort_and_merge(child_ranges);
 
-        int y_pos = view_sorted_selection.front().y_pos;
+    size_t child_range_index = 0;
 
-        for (const CompareIndexInfo& compare_index_info : view_sorted_selection)
+    for (const auto& block_range : block_ranges)
+    {
+        int first_block = block_range.first_row;
+
+        while (first_block <= block_range.last_row)
         {
-            if (compare_index_info.y_pos > y_pos)
+            // Selected children of earlier code blocks come first.
+            while (child_range_index < child_ranges.size() && child_ranges[child_range_index].parent_row < first_block)
             {
-                clipboard_text.append("\n");
-                y_pos = compare_index_info.y_pos;
+                ranges.push_back(child_ranges[child_range_index++]);
             }
 
-            QString text = compare_index_info.source_index.data(Qt::DisplayRole).toString();
+            // Then the code blocks up to the next one with selected children.
+            int last_block = block_range.last_row;
 
-            // Indent opcodes.
-            if (compare_index_info.source_index.column() == IsaItemModel::kOpCode && compare_index_info.source_index.parent().isValid() &&
-                compare_index_info.source_index.data(IsaItemModel::kRowTypeRole).value<IsaItemModel::RowType>() == IsaItemModel::RowType::kCode)
+            if (child_range_index < child_ranges.size() && child_ranges[child_range_index].parent_row < last_block)
             {
-                text = QString("    " + text);
+                last_block = child_ranges[child_range_index].parent_row;
             }
 
-            QString formatted_text = QString("%1\t").arg(text, -column_max_widths[compare_index_info.visual_column]);
-
-            clipboard_text.append(formatted_text);
-            clipboard_text.append(" ");
-        }
+            ranges.push_back({-1, first_block, last_block});
 
-        if (!clipboard_text.isEmpty())
-        {
-            QClipboard* clipboard = QApplication::clipboard();
-            clipboard->setText(clipboard_text);
+            first_block = last_block + 1;
         }
     }
+
+    ranges.insert(ranges.end(), child_ranges.begin() + child_range_index, child_ranges.end());
+
+    return source_model;
+}
+
+void IsaTreeView::rowsInserted(const QModelIndex& parent, int start, int end)
+{
+    QTreeView::rowsInserted(parent, start, end);
+
+    InvalidateVisibleLineCounts();
+}
+
+void IsaTreeView::rowsAboutToBeRemoved(const QModelIndex& parent, int start, int end)
+{
+    QTreeView::rowsAboutToBeRemoved(parent, start, end);
+
+    InvalidateVisibleLineCounts();
 }
 
 void IsaTreeView::IndexExpandedOrCollapsed(const QModelIndex index)
@@ -594,24 +911,506 @@ void IsaTreeView::ScrollBarScrolled(int value)
     {
         const QModelIndex top_left = indexAt(QPoint(0, 0));
 
-        const QModelIndex last_pinned_parent_index = model->index(last_pinned_row_.first, 0, QModelIndex());
-        const QModelIndex last_pinned_index        = model->index(last_pinned_row_.second, 0, last_pinned_parent_index);
+        // The row at the top shows its code block label across every column; see IsRowSpanned.
+        ClearLastPinnedndex();
 
-        if (last_pinned_index.isValid() && last_pinned_index.model() == model)
+        if (top_left.isValid() && !IsRowSpanned(top_left.row(), top_left.parent()))
         {
-            setFirstColumnSpanned(last_pinned_index.row(), last_pinned_index.parent(), false);
+            last_pinned_row_ = std::pair<int, int>(top_left.parent().row(), top_left.row());
         }
-        if (!isFirstColumnSpanned(top_left.row(), top_left.parent()))
+    }
+
+    // Notify the viewport to refresh.
+    viewport()->update();
+}
+
+void IsaTreeView::GetVisibleSectionRange(int& first_section, int& last_section) const
+{
+    first_section = -1;
+    last_section  = -1;
+
+    for (int visual_index = 0; visual_index < header()->count(); visual_index++)
+    {
+        const int logical_index = header()->logicalIndex(visual_index);
+
+        if (header()->isSectionHidden(logical_index))
         {
-            setFirstColumnSpanned(top_left.row(), top_left.parent(), true);
-            last_pinned_row_ = std::pair<int, int>(top_left.parent().row(), top_left.row());
+            continue;
+        }
+
+        if (first_section == -1)
+        {
+            first_section = logical_index;
+        }
+
+        last_section = logical_index;
+    }
+}
+
+void IsaTreeView::DrawSpannedRow(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    int first_section = -1;
+    int last_section  = -1;
+
+    GetVisibleSectionRange(first_section, last_section);
+
+    if (first_section == -1 || itemDelegate() == nullptr)
+    {
+        return;
+    }
+
+    const QModelIndex cell_index = index.siblingAtColumn(0);
+
+    QStyleOptionViewItem cell_option = option;
+    cell_option.rect.setLeft(columnViewportPosition(first_section));
+    cell_option.rect.setRight(columnViewportPosition(last_section) + header()->sectionSize(last_section) - 1);
+
+    if (selectionModel() != nullptr && selectionModel()->isSelected(cell_index))
+    {
+        cell_option.state |= QStyle::State_Selected;
+    }
+
+    if (hasFocus() && currentIndex() == cell_index)
+    {
+        cell_option.state |= QStyle::State_HasFocus;
+    }
+
+    // The tree column starts with the indentation and expand arrow of the row.
+    const int tree_section = (treePosition() >= 0) ? treePosition() : header()->logicalIndex(0);
+
+    if (tree_section == first_section)
+    {
+        const int   level       = index.parent().isValid() ? 1 : 0;
+        const int   indentation = (level + (rootIsDecorated() ? 1 : 0)) * this->indentation();
+        const QRect branch_rectangle(cell_option.rect.left(), cell_option.rect.top(), indentation, cell_option.rect.height());
+
+        drawBranches(painter, branch_rectangle, index);
+
+        cell_option.rect.setLeft(cell_option.rect.left() + indentation);
+    }
+
+    itemDelegate()->paint(painter, cell_option, cell_index);
+}
+
+void IsaTreeView::UpdateVisibleLineCount(const QModelIndex& index, bool expanded)
+{
+    const QAbstractItemModel* tree_model = model();
+
+    if (!visible_line_index_valid_ || tree_model == nullptr || index.parent().isValid())
+    {
+        return;
+    }
+
+    if (index.row() < 0 || static_cast<size_t>(index.row()) >= visible_line_index_.GetBlockCount() ||
+        visible_line_index_.GetBlockCount() != static_cast<size_t>(tree_model->rowCount()))
+    {
+        InvalidateVisibleLineCounts();
+        return;
+    }
+
+    const QModelIndex code_block_index = index.siblingAtColumn(IsaItemModel::Columns::kLineNumber);
+
+    // +1 for the code block's line number, plus its instruction count if it is expanded.
+    visible_line_index_.SetLineCount(index.row(), 1 + (expanded ? tree_model->rowCount(code_block_index) : 0));
+}
+
+void IsaTreeView::BuildVisibleLineCounts()
+{
+    std::vector<int> line_counts;
+
+    const QAbstractItemModel* tree_model = model();
+
+    if (tree_model != nullptr)
+    {
+        const int code_block_count = tree_model->rowCount();
+
+        line_counts.reserve(code_block_count);
+
+        for (int i = 0; i < code_block_count; i++)
+        {
+            const QModelIndex code_block_index = tree_model->index(i, IsaItemModel::Columns::kLineNumber);
+
+            // +1 for the code block's line number, plus its instruction count if it is expanded.
+            line_counts.push_back(1 + (isExpanded(code_block_index) ? tree_model->rowCount(code_block_index) : 0));
+        }
+    }
+
+    visible_line_index_.Build(line_counts);
+
+    visible_line_index_valid_ = true;
+}
+
+void IsaTreeView::UpdateRegisterReferenceMarkers()
+{
+    std::vector<int> line_numbers;
+
+    const QAbstractProxyModel* proxy_model  = qobject_cast<QAbstractProxyModel*>(model());
+    IsaItemModel*              source_model = (proxy_model != nullptr) ? qobject_cast<IsaItemModel*>(proxy_model->sourceModel()) : nullptr;
+
+    if (source_model != nullptr)
+    {
+        line_numbers.reserve(register_reference_lines_.size());
+
+        for (const int reference_line : register_reference_lines_)
+        {
+            const QModelIndex source_index = source_model->GetLineNumberModelIndex(reference_line);
+
+            // References are only ever made by instructions.
+            if (!source_index.isValid() || !source_index.parent().isValid())
+            {
+                continue;
+            }
+
+            const QModelIndex instruction_proxy_index = proxy_model->mapFromSource(source_index);
+            const QModelIndex code_block_proxy_index  = proxy_model->mapFromSource(source_index.parent());
+
+            line_numbers.push_back(GetVisibleLineNumber(code_block_proxy_index, instruction_proxy_index.row()));
+        }
+    }
+
+    isa_scroll_bar_->SetRegisterReferenceLineNumbers(std::move(line_numbers));
+}
+
+int IsaTreeView::GetVisibleLineNumber(const QModelIndex& code_block_index, int child_row)
+{
+    const QAbstractItemModel* tree_model = model();
+
+    if (!visible_line_index_valid_ || (tree_model != nullptr && visible_line_index_.GetBlockCount() != static_cast<size_t>(tree_model->rowCount())))
+    {
+        BuildVisibleLineCounts();
+    }
+
+    int line_number = 0;
+
+    // Lines of all previous code blocks.
+    if (code_block_index.row() > 0)
+    {
+        line_number += visible_line_index_.GetLinesBefore(std::min(static_cast<size_t>(code_block_index.row()), visible_line_index_.GetBlockCount()));
+    }
+
+    line_number++;  // +1 for the code block's line number.
+
+    // Add the row's index too if its code block is expanded.
+    if (child_row >= 0 && isExpanded(code_block_index))
+    {
+        line_number += child_row;
+    }
+
+    return line_number;
+}
+
+IsaItemModel* IsaTreeView::GetSourceModel() const
+{
+    const QAbstractProxyModel* proxy_model = qobject_cast<QAbstractProxyModel*>(model());
+
+    return (proxy_model != nullptr) ? qobject_cast<IsaItemModel*>(proxy_model->sourceModel()) : nullptr;
+}
+
+void IsaTreeView::HeatmapMetricValuesChanged(int metric, int first_line_number, int last_line_number, bool range_changed)
+{
+    if (metric == -1)
+    {
+        // Every metric was removed.
+        SetHeatmapMetric(-1);
+        return;
+    }
+
+    IsaItemModel* source_model = GetSourceModel();
+
+    if (metric != heatmap_metric_ || source_model == nullptr)
+    {
+        return;
+    }
+
+    if (!visible_line_index_valid_ || heatmap_bucket_values_.empty() || visible_line_index_.GetBlockCount() != static_cast<size_t>(model()->rowCount()))
+    {
+        // Rows were added since the buckets were split.
+        BuildHeatmap();
+        viewport()->update();
+        return;
+    }
+
+    if (!heatmap_rows_in_order_)
+    {
+        // The changed lines can be shown anywhere.
+        UpdateHeatmapBuckets(0, heatmap_bucket_values_.size());
+        viewport()->update();
+        return;
+    }
+
+    // Find the visible lines of the changed lines; rows of a collapsed code block are shown by the code block.
+    const QAbstractProxyModel* proxy_model = qobject_cast<QAbstractProxyModel*>(model());
+
+    int visible_lines[2] = {0, 0};
+
+    const int source_lines[2] = {std::max(first_line_number, 0), std::min(last_line_number, source_model->GetLineCount() - 1)};
+
+    for (int i = 0; i < 2; i++)
+    {
+        const QModelIndex view_index = proxy_model->mapFromSource(source_model->GetLineNumberModelIndex(source_lines[i]));
+
+        if (!view_index.isValid())
+        {
+            visible_lines[i] = (i == 0) ? 0 : heatmap_line_count_ - 1;
+        }
+        else if (view_index.parent().isValid())
+        {
+            visible_lines[i] = GetVisibleLineNumber(view_index.parent().siblingAtColumn(0), view_index.row()) - 1;
         }
         else
         {
-            ClearLastPinnedndex();
+            visible_lines[i] = GetVisibleLineNumber(view_index.siblingAtColumn(0), -1) - 1;
         }
     }
 
-    // Notify the viewport to refresh.
-    viewport()->update();
+    const size_t bucket_count = heatmap_bucket_values_.size();
+    const size_t first_bucket = static_cast<size_t>((static_cast<uint64_t>(std::max(visible_lines[0], 0)) * bucket_count) / heatmap_line_count_);
+    const size_t last_bucket  = static_cast<size_t>((static_cast<uint64_t>(std::max(visible_lines[1], 0)) * bucket_count) / heatmap_line_count_);
+
+    UpdateHeatmapBuckets(std::min(first_bucket, bucket_count), std::min(last_bucket + 1, bucket_count));
+
+    if (range_changed)
+    {
+        // Every intensity changed, but not the values of the other buckets.
+        UpdateHeatmapIntensities(0, bucket_count);
+        viewport()->update();
+    }
+}
+
+void IsaTreeView::BuildHeatmap()
+{
+    heatmap_bucket_values_.clear();
+    heatmap_line_count_ = 0;
+
+    const IsaItemModel* source_model = GetSourceModel();
+
+    if (heatmap_metric_ < 0 || source_model == nullptr)
+    {
+        isa_scroll_bar_->SetHeatmapBucketCount(0, 0);
+        return;
+    }
+
+    if (!visible_line_index_valid_ || visible_line_index_.GetBlockCount() != static_cast<size_t>(model()->rowCount()))
+    {
+        BuildVisibleLineCounts();
+    }
+
+    heatmap_line_count_    = visible_line_index_.GetLinesBefore(visible_line_index_.GetBlockCount());
+    heatmap_rows_in_order_ = AreRowsInSourceOrder();
+
+    // Every bucket covers at least one line.
+    const size_t bucket_count = std::min(kMaxHeatmapBuckets, static_cast<size_t>(heatmap_line_count_));
+
+    heatmap_bucket_values_.assign(bucket_count, std::numeric_limits<float>::quiet_NaN());
+
+    isa_scroll_bar_->SetHeatmapBucketCount(static_cast<int>(bucket_count), heatmap_line_count_);
+
+    UpdateHeatmapBuckets(0, bucket_count);
+}
+
+void IsaTreeView::UpdateHeatmapBuckets(size_t first_bucket, size_t end_bucket)
+{
+    const IsaItemModel* source_model = GetSourceModel();
+
+    if (source_model == nullptr)
+    {
+        return;
+    }
+
+    for (size_t bucket = first_bucket; bucket < end_bucket; bucket++)
+    {
+        if (!heatmap_rows_in_order_)
+        {
+            // Visible lines of a sorted or filtered model cover scattered source lines, so every visible line is looked up.
+            float maximum = std::numeric_limits<float>::quiet_NaN();
+
+            for (int line = GetHeatmapBucketLine(bucket); line < GetHeatmapBucketLine(bucket + 1); line++)
+            {
+                maximum = std::fmax(maximum, GetHeatmapLineMaximum(line));
+            }
+
+            heatmap_bucket_values_[bucket] = maximum;
+            continue;
+        }
+
+        // Visible lines are in source order, and only rows of collapsed code blocks are left out, so a bucket covers a contiguous range of source lines.
+        const int first_line = GetHeatmapSourceLine(GetHeatmapBucketLine(bucket), false);
+        const int end_line   = GetHeatmapSourceLine(GetHeatmapBucketLine(bucket + 1) - 1, true);
+
+        heatmap_bucket_values_[bucket] = source_model->GetMetricMaximum(heatmap_metric_, first_line, end_line);
+    }
+
+    UpdateHeatmapIntensities(first_bucket, end_bucket);
+}
+
+void IsaTreeView::UpdateHeatmapIntensities(size_t first_bucket, size_t end_bucket)
+{
+    const IsaItemModel* source_model = GetSourceModel();
+
+    if (source_model == nullptr || first_bucket >= end_bucket)
+    {
+        return;
+    }
+
+    std::vector<float> intensities;
+    intensities.reserve(end_bucket - first_bucket);
+
+    for (size_t bucket = first_bucket; bucket < end_bucket; bucket++)
+    {
+        intensities.push_back(source_model->GetMetricIntensity(heatmap_metric_, heatmap_bucket_values_[bucket]));
+    }
+
+    isa_scroll_bar_->SetHeatmapIntensities(static_cast<int>(first_bucket), intensities);
+}
+
+int IsaTreeView::GetHeatmapBucketLine(size_t bucket) const
+{
+    const uint64_t bucket_count = heatmap_bucket_values_.size();
+
+    // Round up, so a line belongs to bucket line * bucket_count / line_count.
+    return static_cast<int>((static_cast<uint64_t>(bucket) * heatmap_line_count_ + bucket_count - 1) / bucket_count);
+}
+
+int IsaTreeView::GetHeatmapSourceLine(int visible_line, bool end) const
+{
+    const QAbstractProxyModel* proxy_model  = qobject_cast<QAbstractProxyModel*>(model());
+    const IsaItemModel*        source_model = GetSourceModel();
+    const size_t               block        = visible_line_index_.FindBlock(visible_line);
+
+    if (source_model == nullptr || block >= visible_line_index_.GetBlockCount())
+    {
+        return (source_model != nullptr) ? source_model->GetLineCount() : -1;
+    }
+
+    const int block_line_number = source_model->GetLineNumber(proxy_model->mapToSource(model()->index(static_cast<int>(block), 0)));
+    const int row_line          = visible_line - visible_line_index_.GetLinesBefore(block);
+
+    if (block_line_number < 0 || !end)
+    {
+        return (block_line_number < 0) ? -1 : block_line_number + row_line;
+    }
+
+    if (visible_line_index_.GetLineCount(block) == 1)
+    {
+        // A collapsed code block shows its rows too; they end where the next code block starts.
+        const int next_block_line_number = source_model->GetLineNumber(proxy_model->mapToSource(model()->index(static_cast<int>(block) + 1, 0)));
+
+        return (next_block_line_number < 0) ? source_model->GetLineCount() : next_block_line_number;
+    }
+
+    return block_line_number + row_line + 1;
+}
+
+float IsaTreeView::GetHeatmapLineMaximum(int visible_line) const
+{
+    const QAbstractProxyModel* proxy_model  = qobject_cast<QAbstractProxyModel*>(model());
+    const IsaItemModel*        source_model = GetSourceModel();
+    const size_t               block        = visible_line_index_.FindBlock(visible_line);
+
+    float maximum = std::numeric_limits<float>::quiet_NaN();
+
+    if (source_model == nullptr || block >= visible_line_index_.GetBlockCount())
+    {
+        return maximum;
+    }
+
+    const auto add_row = [&](const QModelIndex& view_index) {
+        const int line_number = source_model->GetLineNumber(proxy_model->mapToSource(view_index));
+
+        maximum = std::fmax(maximum, source_model->GetMetricMaximum(heatmap_metric_, line_number, line_number + 1));
+    };
+
+    const QModelIndex block_index = model()->index(static_cast<int>(block), 0);
+    const int         row_line    = visible_line - visible_line_index_.GetLinesBefore(block);
+
+    if (row_line > 0)
+    {
+        add_row(model()->index(row_line - 1, 0, block_index));
+        return maximum;
+    }
+
+    add_row(block_index);
+
+    if (visible_line_index_.GetLineCount(block) == 1)
+    {
+        // A collapsed code block shows the rows the proxy model keeps.
+        const int child_count = model()->rowCount(block_index);
+
+        for (int row = 0; row < child_count; row++)
+        {
+            add_row(model()->index(row, 0, block_index));
+        }
+    }
+
+    return maximum;
+}
+
+bool IsaTreeView::AreRowsInSourceOrder() const
+{
+    const QAbstractItemModel*    view_model        = model();
+    const QAbstractProxyModel*   proxy_model       = qobject_cast<const QAbstractProxyModel*>(view_model);
+    const QSortFilterProxyModel* sort_filter_model = qobject_cast<const QSortFilterProxyModel*>(view_model);
+    const QAbstractItemModel*    source_model      = (proxy_model != nullptr) ? proxy_model->sourceModel() : nullptr;
+
+    // Only a sort filter proxy model that does not sort is known to keep the order of rows; the isa proxy model is one.
+    if (source_model == nullptr || sort_filter_model == nullptr || sort_filter_model->sortColumn() >= 0 || view_model->rowCount() != source_model->rowCount())
+    {
+        return false;
+    }
+
+    // A filtered code block shows fewer rows than its source block.
+    for (int block = 0; block < view_model->rowCount(); block++)
+    {
+        const QModelIndex block_index        = view_model->index(block, 0);
+        const QModelIndex source_block_index = proxy_model->mapToSource(block_index);
+
+        if (source_block_index.row() != block || view_model->rowCount(block_index) != source_model->rowCount(source_block_index))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int IsaTreeView::sizeHintForColumn(int column) const
+{
+    const QAbstractItemModel*  view_model   = model();
+    const QAbstractProxyModel* proxy_model  = qobject_cast<const QAbstractProxyModel*>(view_model);
+    const IsaItemModel*        source_model = qobject_cast<const IsaItemModel*>((proxy_model != nullptr) ? proxy_model->sourceModel() : view_model);
+
+    if (!size_columns_from_model_ || source_model == nullptr || view_model->rowCount() == 0)
+    {
+        return QTreeView::sizeHintForColumn(column);
+    }
+
+    const QModelIndex index        = view_model->index(0, column);
+    const QModelIndex source_index = (proxy_model != nullptr) ? proxy_model->mapToSource(index) : index;
+
+    // Columns added by the application can hold anything, so they still have to be measured row by row.
+    if (!source_index.isValid() || source_index.column() >= IsaItemModel::kColumnCount)
+    {
+        return QTreeView::sizeHintForColumn(column);
+    }
+
+    QAbstractItemDelegate* delegate = itemDelegateForIndex(index);
+
+    if (delegate == nullptr)
+    {
+        return QTreeView::sizeHintForColumn(column);
+    }
+
+    // The delegate gives the same width, the model's widest text in the column, for every index of a shared column.
+    QStyleOptionViewItem option;
+    initViewItemOption(&option);
+
+    int width = delegate->sizeHint(option, index).width();
+
+    // Leave room for the indentation of child rows in the column that shows the tree, whether or not any are expanded.
+    if (column == treePosition() || (treePosition() < 0 && header()->visualIndex(column) == 0))
+    {
+        width += (rootIsDecorated() ? 2 : 1) * indentation();
+    }
+
+    return width;
 }
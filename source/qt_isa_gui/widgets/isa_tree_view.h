@@ -9,7 +9,9 @@
 #define QTISAGUI_ISA_TREE_VIEW_H_
 
 #include <memory>
+#include <vector>
 
+#include <QBitArray>
 #include <QKeyEvent>
 #include <QScrollArea>
 #include <QTreeView>
@@ -17,6 +19,7 @@
 
 #include "isa_item_model.h"
 #include "isa_vertical_scroll_bar.h"
+#include "isa_visible_line_index.h"
 
 // Forward declaration to prevent a circular dependency.
 class IsaWidget;
@@ -63,6 +66,81 @@ public:
     /// @param [in] source_indices The source indices of the text search matches.
     void SetSearchMatchLineNumbers(const QString search_text, const std::set<QModelIndex>& source_indices);
 
+    /// @brief Set the lines that reference the selected register, to paint in the scroll bar and to step through with ScrollToRegisterReference.
+    ///
+    /// @param [in] line_numbers The source model line numbers of the references, in ascending order; see IsaItemModel::GetLineNumberModelIndex.
+    void SetRegisterReferenceLineNumbers(std::vector<int> line_numbers);
+
+    /// @brief Scroll to and select the next or previous line that references the selected register, wrapping around at either end.
+    ///
+    /// @param [in] forward true to go to the next reference after the current index, false to go to the previous one.
+    ///
+    /// @return true if there was a reference to scroll to, false otherwise.
+    bool ScrollToRegisterReference(bool forward);
+
+    /// @brief Paint the values of a metric of the source model as a heatmap behind every line, and as an intensity strip in the scroll bar.
+    ///
+    /// Follows IsaItemModel::MetricValuesChanged of the source model attached at the time of the call; a streamed update
+    /// repaints the changed lines and recomputes only the scroll bar buckets that cover them.
+    ///
+    /// @param [in] metric The metric of the source model, or -1 to paint no heatmap; see IsaItemModel::AddMetric.
+    void SetHeatmapMetric(int metric);
+
+    /// @brief Get the metric painted as a heatmap.
+    ///
+    /// @return The metric, or -1 if no heatmap is painted.
+    inline int GetHeatmapMetric() const
+    {
+        return heatmap_metric_;
+    }
+
+    /// @brief Get the expand state of every code block.
+    ///
+    /// @return One bit per code block row of the attached model, set if the code block is expanded.
+    QBitArray GetExpandedBlocks() const;
+
+    /// @brief Expand and collapse every code block at once.
+    ///
+    /// The tree is laid out once after all code blocks are changed, instead of once per code block, and the
+    /// visible line counts are rebuilt once. Like expandAll, this does not emit expanded or collapsed.
+    ///
+    /// @param [in] expanded_blocks One bit per code block row of the attached model, set to expand the code block; ignored if the size does not match.
+    void SetExpandedBlocks(const QBitArray& expanded_blocks);
+
+    /// @brief Rebuild the number of visible lines of every code block the next time they are needed.
+    ///
+    /// Expanding or collapsing a single code block keeps the line counts up to date by itself. Call this after expandAll or collapseAll,
+    /// which change the expand state of every code block without emitting expanded or collapsed.
+    void InvalidateVisibleLineCounts();
+
+    /// @brief Override reset to rebuild the number of visible lines of every code block.
+    virtual void reset() Q_DECL_OVERRIDE;
+
+    /// @brief Check if a row is painted as a single cell across every column.
+    ///
+    /// Code blocks, comments and the row a code block label is pinned to are spanned. This is decided from the row type when
+    /// painting and hit testing, so no span state is kept per row; rows spanned with setFirstColumnSpanned are spanned too.
+    ///
+    /// @param [in] row    The view row.
+    /// @param [in] parent The view index of the parent of the row.
+    ///
+    /// @return true if the row spans every column, false otherwise.
+    bool IsRowSpanned(int row, const QModelIndex& parent) const;
+
+    /// @brief Override indexAt to give the first column of rows that span every column, wherever they are hit; see IsRowSpanned.
+    ///
+    /// @param [in] point The point in viewport coordinates.
+    ///
+    /// @return The view index at the point.
+    virtual QModelIndex indexAt(const QPoint& point) const Q_DECL_OVERRIDE;
+
+    /// @brief Override visualRect to cover every column for the first column of rows that span every column; see IsRowSpanned.
+    ///
+    /// @param [in] index The view index.
+    ///
+    /// @return The rectangle of the index in viewport coordinates.
+    virtual QRect visualRect(const QModelIndex& index) const Q_DECL_OVERRIDE;
+
     /// @brief Show a popup menu that scrolls to a branch label instruction after pressing a menu action.
     ///
     /// @param source_indices  [in] Source model indices of branch instructions.
@@ -83,6 +161,18 @@ public:
     /// @brief Toggles the copy_line_numbers_ variable true and false. Used to know if line number text should be included when copying isa text.
     void ToggleCopyLineNumbers();
 
+    /// @brief Export the text of rows, in the order and with the columns they are shown, straight to a file.
+    ///
+    /// Rows are streamed from the isa model in line order; children of collapsed code blocks are not shown, so they are not exported.
+    /// Line numbers are exported if they are copied too; see ToggleCopyLineNumbers.
+    ///
+    /// @param [in] file_path          The path of the file to write; replaced if it exists.
+    /// @param [in] format             The format of the text.
+    /// @param [in] selected_rows_only true to export the selected rows only, false to export every row that is shown.
+    ///
+    /// @return true if the file was written, false otherwise.
+    bool ExportRowsToFile(const QString& file_path, IsaItemModel::ExportFormat format, bool selected_rows_only) const;
+
     /// @brief Invalidates the index that keeps track of the last row to have a code block pinned to it when switching events, shader stages, or profiles.
     void ClearLastPinnedndex()
     {
@@ -97,6 +187,17 @@ public:
         paint_column_separators_ = paint;
     }
 
+    /// @brief Turns on or off sizing the shared columns from the widths cached by the isa model.
+    ///
+    /// When on, resizing a shared column to its contents asks the delegate for the size of a single index, instead of every row.
+    /// This is exact because the isa model measures the widest text of every shared column when its rows are ingested.
+    ///
+    /// @param [in] size_from_model true to use the model's column widths, false to let Qt measure every row.
+    void SizeColumnsFromModel(bool size_from_model)
+    {
+        size_columns_from_model_ = size_from_model;
+    }
+
 public slots:
 
     /// @brief Scroll to a branch or label but do not re-record the entry into history.
@@ -129,9 +230,36 @@ protected:
     /// @param [in] event The key event.
     virtual void keyPressEvent(QKeyEvent* event) Q_DECL_OVERRIDE;
 
+    /// @brief Override paintEvent to time painting a frame; see IsaInstrumentation.
+    ///
+    /// @param [in] event The paint event.
+    virtual void paintEvent(QPaintEvent* event) Q_DECL_OVERRIDE;
+
+    /// @brief Override sizeHintForColumn to take the width of shared columns from the isa model; see SizeColumnsFromModel.
+    ///
+    /// @param [in] column The view column.
+    ///
+    /// @return The width needed to show the contents of every row in the column.
+    virtual int sizeHintForColumn(int column) const Q_DECL_OVERRIDE;
+
     /// @brief Copy selected rows to clipboard.
     void CopyRowsToClipboard();
 
+protected slots:
+    /// @brief Override rowsInserted to rebuild the number of visible lines of every code block.
+    ///
+    /// @param [in] parent The parent index of the new rows.
+    /// @param [in] start  The first new row.
+    /// @param [in] end    The last new row.
+    virtual void rowsInserted(const QModelIndex& parent, int start, int end) Q_DECL_OVERRIDE;
+
+    /// @brief Override rowsAboutToBeRemoved to rebuild the number of visible lines of every code block.
+    ///
+    /// @param [in] parent The parent index of the rows.
+    /// @param [in] start  The first row to be removed.
+    /// @param [in] end    The last row to be removed.
+    virtual void rowsAboutToBeRemoved(const QModelIndex& parent, int start, int end) Q_DECL_OVERRIDE;
+
 private slots:
 
     /// @brief Force hide the tooltip when any index is expanded or collapsed.
@@ -192,11 +320,119 @@ private:
     /// @param [in] value The new value of the scroll bar.
     void ScrollBarScrolled(int value);
 
-    IsaVerticalScrollBar*            isa_scroll_bar_;           ///< Scroll bar to paint red and purple rectangles for hot spots and text search matches.
-    std::unique_ptr<IsaItemDelegate> isa_item_delegate_;        ///< Delegate attached to this tree.
-    bool                             copy_line_numbers_;        ///< Whether the line number text is to be included when copying isa text. True by default.
-    std::pair<int, int>              last_pinned_row_;          ///< The code block and instruction rows of the last index that was pinned.
-    bool                             paint_column_separators_;  ///< Whether or not to paint the the column separators.
+    /// @brief Find the rows and source columns to export, in the order they are shown.
+    ///
+    /// @param [in]  selected_rows_only true to find the selected rows only, false to find every row that is shown.
+    /// @param [out] ranges             The rows, in line order.
+    /// @param [out] columns            The source columns of the visible sections, in visual order.
+    ///
+    /// @return The isa model to export from, or nullptr if this view does not show an isa model.
+    const IsaItemModel* GetExportRows(bool selected_rows_only, std::vector<IsaItemModel::ExportRange>& ranges, std::vector<int>& columns) const;
+
+    /// @brief Get the visible sections at either end of the header.
+    ///
+    /// @param [out] first_section The logical index of the leftmost visible section, or -1 if there is none.
+    /// @param [out] last_section  The logical index of the rightmost visible section, or -1 if there is none.
+    void GetVisibleSectionRange(int& first_section, int& last_section) const;
+
+    /// @brief Paint a row that spans every column as a single cell of its first column, the way QTreeView paints spanned rows.
+    ///
+    /// @param [in] painter The painter.
+    /// @param [in] option  The style options of the row.
+    /// @param [in] index   The view index of the row.
+    void DrawSpannedRow(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
+
+    /// @brief Update the number of visible lines of a code block that was expanded or collapsed.
+    ///
+    /// @param [in] index    The view index of the code block.
+    /// @param [in] expanded true if the code block was expanded, false if it was collapsed.
+    void UpdateVisibleLineCount(const QModelIndex& index, bool expanded);
+
+    /// @brief Map the register reference lines to the lines they are shown on, and give those to the scroll bar.
+    void UpdateRegisterReferenceMarkers();
+
+    /// @brief Count the number of visible lines of every code block in the attached model.
+    void BuildVisibleLineCounts();
+
+    /// @brief Get the line a code block, or a row in it, is shown on, accounting for the expand state of previous code blocks.
+    ///
+    /// @param [in] code_block_index The view index of the code block.
+    /// @param [in] child_row        The row inside the code block, or -1 for the code block itself.
+    ///
+    /// @return The line number, where the first code block is on line 1.
+    int GetVisibleLineNumber(const QModelIndex& code_block_index, int child_row);
+
+    /// @brief Get the source model of the attached proxy model.
+    ///
+    /// @return The source model, or nullptr if this view does not show an isa model through a proxy model.
+    IsaItemModel* GetSourceModel() const;
+
+    /// @brief Update the heatmap after values of a metric of the source model changed.
+    ///
+    /// @param [in] metric            The metric, or -1 if every metric was removed.
+    /// @param [in] first_line_number The first source model line number whose value changed.
+    /// @param [in] last_line_number  The last source model line number whose value changed.
+    /// @param [in] range_changed     true if the range of the metric changed, which changes the intensity of every line.
+    void HeatmapMetricValuesChanged(int metric, int first_line_number, int last_line_number, bool range_changed);
+
+    /// @brief Split the visible lines into heatmap buckets, and compute every bucket; after the model or the expand state changed.
+    void BuildHeatmap();
+
+    /// @brief Recompute the largest metric value of a range of heatmap buckets and give their intensities to the scroll bar.
+    ///
+    /// @param [in] first_bucket The first bucket.
+    /// @param [in] end_bucket   The bucket after the last bucket.
+    void UpdateHeatmapBuckets(size_t first_bucket, size_t end_bucket);
+
+    /// @brief Give the intensities of a range of heatmap buckets to the scroll bar, from the values computed by UpdateHeatmapBuckets.
+    ///
+    /// @param [in] first_bucket The first bucket.
+    /// @param [in] end_bucket   The bucket after the last bucket.
+    void UpdateHeatmapIntensities(size_t first_bucket, size_t end_bucket);
+
+    /// @brief Get the first visible line of a heatmap bucket.
+    ///
+    /// @param [in] bucket The bucket; may be equal to the bucket count to get the line count.
+    ///
+    /// @return The visible line, counting from 0.
+    int GetHeatmapBucketLine(size_t bucket) const;
+
+    /// @brief Get the source model line number of a visible line.
+    ///
+    /// @param [in] visible_line The visible line, counting from 0.
+    /// @param [in] end          true to get the line number after the lines shown on the visible line; a collapsed code block shows all of its rows.
+    ///
+    /// @return The source model line number, or -1 if lines are not mapped yet.
+    int GetHeatmapSourceLine(int visible_line, bool end) const;
+
+    /// @brief Get the largest metric value of the source lines shown on a visible line; a collapsed code block shows all of its rows.
+    ///
+    /// @param [in] visible_line The visible line, counting from 0.
+    ///
+    /// @return The largest value, or NaN if none of the lines has a value.
+    float GetHeatmapLineMaximum(int visible_line) const;
+
+    /// @brief Check if the proxy model keeps every source row in source order, so visible lines cover contiguous ranges of source lines.
+    ///
+    /// @return true if the proxy model neither sorts nor filters rows, false otherwise.
+    bool AreRowsInSourceOrder() const;
+
+    static constexpr size_t kMaxHeatmapBuckets = 1024;  ///< The most buckets the visible lines are split into for the scroll bar heatmap.
+
+    IsaVerticalScrollBar*            isa_scroll_bar_;            ///< Scroll bar to paint red and purple rectangles for hot spots and text search matches.
+    std::unique_ptr<IsaItemDelegate> isa_item_delegate_;         ///< Delegate attached to this tree.
+    bool                             copy_line_numbers_;         ///< Whether the line number text is to be included when copying isa text. True by default.
+    std::pair<int, int>              last_pinned_row_;           ///< The code block and instruction rows of the last index that was pinned.
+    bool                             paint_column_separators_;   ///< Whether or not to paint the the column separators.
+    IsaVisibleLineIndex              visible_line_index_;        ///< The number of visible lines of every code block.
+    bool                             visible_line_index_valid_;  ///< Whether visible_line_index_ matches the model and expand state.
+    bool                             size_columns_from_model_;   ///< Whether the shared columns are sized from the model's cached column widths.
+    std::vector<int>                 register_reference_lines_;  ///< Source model line numbers of the references of the selected register.
+    int                              heatmap_metric_;            ///< The source model metric painted as a heatmap; -1 for none.
+    std::vector<float>               heatmap_bucket_values_;     ///< The largest metric value of the lines of every scroll bar bucket.
+    int                              heatmap_line_count_;        ///< The number of visible lines the heatmap buckets cover.
+    bool                             heatmap_rows_in_order_;     ///< Whether heatmap buckets cover contiguous source lines; see AreRowsInSourceOrder.
+    QMetaObject::Connection          heatmap_connection_;        ///< Connection to the MetricValuesChanged of the source model.
 };
 
 #endif  // QTISAGUI_ISA_TREE_VIEW_H_
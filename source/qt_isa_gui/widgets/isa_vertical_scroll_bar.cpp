@@ -10,12 +10,26 @@
 #include <QPainter>
 #include <QStyleOptionSlider>
 
+#include <algorithm>
+#include <utility>
+
 #include "qt_common/utils/qt_util.h"
 
+#include "qt_isa_gui/utility/isa_dictionary.h"
+
 #include "isa_tree_view.h"
 
+/// @brief The alpha of a heatmap bucket of intensity 1; markers on top of the heatmap stay readable.
+static const int kHeatmapMaximumAlpha = 160;
+
 IsaVerticalScrollBar::IsaVerticalScrollBar(QWidget* parent)
     : QScrollBar(parent)
+    , marker_image_valid_(false)
+    , marker_image_button_height_(0)
+    , marker_image_scroll_height_(0)
+    , marker_image_line_count_(0)
+    , marker_image_device_pixel_ratio_(0)
+    , heatmap_line_count_(0)
 {
 }
 
@@ -25,14 +39,82 @@ IsaVerticalScrollBar::~IsaVerticalScrollBar()
 
 void IsaVerticalScrollBar::SetHotSpotLineNumbers(const std::set<int>& line_numbers)
 {
-    hot_spot_line_numbers_ = line_numbers;
+    SetHotSpotLineNumbers(std::vector<int>(line_numbers.begin(), line_numbers.end()));
+}
+
+void IsaVerticalScrollBar::SetHotSpotLineNumbers(std::vector<int> line_numbers)
+{
+    std::sort(line_numbers.begin(), line_numbers.end());
+    line_numbers.erase(std::unique(line_numbers.begin(), line_numbers.end()), line_numbers.end());
+
+    hot_spot_line_numbers_ = std::move(line_numbers);
+    marker_image_valid_    = false;
 
     update();
 }
 
 void IsaVerticalScrollBar::SetSearchMatchLineNumbers(const std::set<int>& line_numbers)
 {
-    search_match_line_numbers_ = line_numbers;
+    SetSearchMatchLineNumbers(std::vector<int>(line_numbers.begin(), line_numbers.end()));
+}
+
+void IsaVerticalScrollBar::SetSearchMatchLineNumbers(std::vector<int> line_numbers)
+{
+    std::sort(line_numbers.begin(), line_numbers.end());
+    line_numbers.erase(std::unique(line_numbers.begin(), line_numbers.end()), line_numbers.end());
+
+    search_match_line_numbers_ = std::move(line_numbers);
+    marker_image_valid_        = false;
+
+    update();
+}
+
+void IsaVerticalScrollBar::SetRegisterReferenceLineNumbers(std::vector<int> line_numbers)
+{
+    std::sort(line_numbers.begin(), line_numbers.end());
+    line_numbers.erase(std::unique(line_numbers.begin(), line_numbers.end()), line_numbers.end());
+
+    register_reference_line_numbers_ = std::move(line_numbers);
+    marker_image_valid_              = false;
+
+    update();
+}
+
+void IsaVerticalScrollBar::SetHeatmapBucketCount(int bucket_count, int line_count)
+{
+    heatmap_line_count_ = line_count;
+
+    if (bucket_count <= 0 || line_count <= 0)
+    {
+        heatmap_image_ = QImage();
+    }
+    else
+    {
+        heatmap_image_ = QImage(1, bucket_count, QImage::Format_ARGB32);
+        heatmap_image_.fill(Qt::transparent);
+    }
+
+    update();
+}
+
+void IsaVerticalScrollBar::SetHeatmapIntensities(int first_bucket, const std::vector<float>& intensities)
+{
+    if (heatmap_image_.isNull() || first_bucket < 0)
+    {
+        return;
+    }
+
+    const int end_bucket = std::min(first_bucket + static_cast<int>(intensities.size()), heatmap_image_.height());
+
+    QColor color = Qt::red;
+
+    for (int bucket = first_bucket; bucket < end_bucket; bucket++)
+    {
+        const float intensity = intensities[bucket - first_bucket];
+
+        color.setAlpha((intensity > 0.0f) ? static_cast<int>(intensity * kHeatmapMaximumAlpha) : 0);
+        heatmap_image_.setPixelColor(0, bucket, color);
+    }
 
     update();
 }
@@ -42,7 +124,7 @@ void IsaVerticalScrollBar::paintEvent(QPaintEvent* event)
     // Let Qt paint entire scrollbar first.
     QScrollBar::paintEvent(event);
 
-    if (search_match_line_numbers_.empty() && hot_spot_line_numbers_.empty())
+    if (search_match_line_numbers_.empty() && hot_spot_line_numbers_.empty() && register_reference_line_numbers_.empty() && heatmap_image_.isNull())
     {
         return;
     }
@@ -61,12 +143,58 @@ void IsaVerticalScrollBar::paintEvent(QPaintEvent* event)
     // Get the # of lines of isa.
     const qreal number_lines = maximum() - minimum() + pageStep();
 
+    const QColor search_match_row_color = QtCommon::QtUtils::ColorTheme::Get().GetCurrentThemeColors().isa_search_match_row_color;
+
+    // Only repaint the markers if they, the geometry, or the theme changed; scrolling and hovering just draw the cached image.
+    if (!marker_image_valid_ || marker_image_rect_ != option.rect || marker_image_button_height_ != button_pixel_height ||
+        marker_image_scroll_height_ != scroll_bar_pixel_height || marker_image_line_count_ != number_lines ||
+        marker_image_device_pixel_ratio_ != devicePixelRatioF() || marker_image_search_match_color_ != search_match_row_color)
+    {
+        marker_image_rect_               = option.rect;
+        marker_image_button_height_      = button_pixel_height;
+        marker_image_scroll_height_      = scroll_bar_pixel_height;
+        marker_image_line_count_         = number_lines;
+        marker_image_device_pixel_ratio_ = devicePixelRatioF();
+        marker_image_search_match_color_ = search_match_row_color;
+
+        PaintMarkerImage(option);
+    }
+
+    QPainter painter(this);
+
+    if (!heatmap_image_.isNull() && number_lines > 0)
+    {
+        // Stretch the buckets over the lines they cover, without smoothing, so neighboring buckets stay apart.
+        const QRectF heatmap_rectangle(option.rect.left() + 1,
+                                       button_pixel_height,
+                                       option.rect.width() - 2,
+                                       (scroll_bar_pixel_height * std::min<qreal>(heatmap_line_count_, number_lines)) / number_lines);
+
+        painter.drawImage(heatmap_rectangle, heatmap_image_);
+    }
+
+    painter.drawImage(0, 0, marker_image_);
+}
+
+void IsaVerticalScrollBar::PaintMarkerImage(const QStyleOptionSlider& option)
+{
+    marker_image_ = QImage(size() * marker_image_device_pixel_ratio_, QImage::Format_ARGB32_Premultiplied);
+    marker_image_.setDevicePixelRatio(marker_image_device_pixel_ratio_);
+    marker_image_.fill(Qt::transparent);
+
+    marker_image_valid_ = true;
+
+    if (marker_image_line_count_ <= 0)
+    {
+        return;
+    }
+
     // Get the pixel height of a single row mapped to the inside of the scroll bar; round up to 1 pixel.
-    qreal row_in_scroll_bar_pixel_height = (scroll_bar_pixel_height * 1) / number_lines;
+    qreal row_in_scroll_bar_pixel_height = (marker_image_scroll_height_ * 1) / marker_image_line_count_;
     row_in_scroll_bar_pixel_height       = (row_in_scroll_bar_pixel_height < 1.0) ? 1.0 : row_in_scroll_bar_pixel_height;
 
     // Turn on AA and paint using floats to try and help improve accuracy.
-    QPainter painter(this);
+    QPainter painter(&marker_image_);
     painter.setRenderHint(QPainter::Antialiasing);
 
     // Get the width and height of the rectangle(s) we want to paint inside this scroll bar.
@@ -75,34 +203,53 @@ void IsaVerticalScrollBar::paintEvent(QPaintEvent* event)
     scroll_bar_rectangle.adjust(1, 0, -1, 0);
     scroll_bar_rectangle.setHeight(row_in_scroll_bar_pixel_height);
 
-    if (!search_match_line_numbers_.empty())
+    // Paint the search match rectangles on top and to the right, over the references of the selected register.
+    QRectF search_match_rectangle = scroll_bar_rectangle;
+    search_match_rectangle.adjust(scroll_bar_half_width, 0, 0, 0);
+    PaintMarkers(painter, register_reference_line_numbers_, search_match_rectangle, kIsaLightThemeColorLightPink);
+    PaintMarkers(painter, search_match_line_numbers_, search_match_rectangle, marker_image_search_match_color_);
+
+    // Paint hot spot rectangles on top and to the left.
+    QRectF hot_spot_rectangle = scroll_bar_rectangle;
+    hot_spot_rectangle.adjust(0, 0, -scroll_bar_half_width, 0);
+    PaintMarkers(painter, hot_spot_line_numbers_, hot_spot_rectangle, Qt::red);
+}
+
+void IsaVerticalScrollBar::PaintMarkers(QPainter& painter, const std::vector<int>& line_numbers, const QRectF& marker_rectangle, const QColor& color) const
+{
+    if (line_numbers.empty())
     {
-        for (const auto& search_match_line_number : search_match_line_numbers_)
-        {
-            // Normalize the y pixel position of the search match line number(s).
-            const qreal qreal_search_match_line_number = search_match_line_number;
-            const qreal search_match_y_pixel_position  = ((scroll_bar_pixel_height * qreal_search_match_line_number) / number_lines) + button_pixel_height;
-
-            // Paint the search match rectangle on top and to the right.
-            QRectF search_match_rectangle = scroll_bar_rectangle;
-            search_match_rectangle.adjust(scroll_bar_half_width, search_match_y_pixel_position, 0, search_match_y_pixel_position);
-            QColor search_match_row_color = QtCommon::QtUtils::ColorTheme::Get().GetCurrentThemeColors().isa_search_match_row_color;
-            painter.fillRect(search_match_rectangle, search_match_row_color);
-        }
+        return;
     }
 
-    if (!hot_spot_line_numbers_.empty())
+    // Markers of lines that are close together overlap in the scroll bar; paint each run of overlapping markers as one rectangle.
+
+    qreal run_top    = 0;
+    qreal run_bottom = 0;
+    bool  in_run     = false;
+
+    for (const int line_number : line_numbers)
     {
-        for (const auto& hot_spot_line_number : hot_spot_line_numbers_)
+        // Normalize the y pixel position of the line number.
+        const qreal line_y_pixel_position = ((marker_image_scroll_height_ * line_number) / marker_image_line_count_) + marker_image_button_height_;
+        const qreal top                   = marker_rectangle.top() + line_y_pixel_position;
+        const qreal bottom                = top + marker_rectangle.height();
+
+        if (in_run && top <= run_bottom)
         {
-            // Normalize the y pixel position of the hot spot line number.
-            const qreal qreal_hot_spot_line_number = hot_spot_line_number;
-            const qreal hot_spot_y_pixel_position  = ((scroll_bar_pixel_height * qreal_hot_spot_line_number) / number_lines) + button_pixel_height;
-
-            // Paint hot spot rectangle on top and to the left.
-            QRectF hot_spot_rectangle = scroll_bar_rectangle;
-            hot_spot_rectangle.adjust(0, hot_spot_y_pixel_position, -scroll_bar_half_width, hot_spot_y_pixel_position);
-            painter.fillRect(hot_spot_rectangle, Qt::red);
+            run_bottom = std::max(run_bottom, bottom);
+            continue;
         }
+
+        if (in_run)
+        {
+            painter.fillRect(QRectF(marker_rectangle.left(), run_top, marker_rectangle.width(), run_bottom - run_top), color);
+        }
+
+        run_top    = top;
+        run_bottom = bottom;
+        in_run     = true;
     }
-}
\ No newline at end of file
+
+    painter.fillRect(QRectF(marker_rectangle.left(), run_top, marker_rectangle.width(), run_bottom - run_top), color);
+}
@@ -8,12 +8,20 @@
 #ifndef QTISAGUI_ISA_VERTICAL_SCROLL_BAR_H_
 #define QTISAGUI_ISA_VERTICAL_SCROLL_BAR_H_
 
+#include <QColor>
+#include <QImage>
+#include <QRect>
 #include <QScrollBar>
 
 #include <set>
+#include <vector>
 
-/// @brief IsaVerticalScrollBar is a scroll bar that custom paints the relative position
-///        of hot spots and text search matches as red and purple rectangles, inside of the scroll bar.
+class QPainter;
+class QStyleOptionSlider;
+
+/// @brief IsaVerticalScrollBar is a scroll bar that custom paints the relative position of hot spots, text search matches
+///        and references of the selected register as red, purple and pink rectangles, inside of the scroll bar.
+///        Under those it may paint a heatmap strip of a metric, downsampled to a fixed number of buckets of lines.
 class IsaVerticalScrollBar final : public QScrollBar
 {
     Q_OBJECT
@@ -32,19 +40,73 @@ public:
     /// @param [in] line_number The line #(s) of the hot spots.
     void SetHotSpotLineNumbers(const std::set<int>& line_numbers);
 
+    /// @brief Set the line #(s) of hot spots to paint a red rectangle.
+    ///
+    /// @param [in] line_numbers The line #(s) of the hot spots, in any order.
+    void SetHotSpotLineNumbers(std::vector<int> line_numbers);
+
     /// @brief Set the line #(s) of text search matches to paint a purple rectangle(s).
     ///
     /// @param [in] line_numbers The line #(s) of the text search matches.
     void SetSearchMatchLineNumbers(const std::set<int>& line_numbers);
 
+    /// @brief Set the line #(s) of text search matches to paint a purple rectangle(s).
+    ///
+    /// @param [in] line_numbers The line #(s) of the text search matches, in any order.
+    void SetSearchMatchLineNumbers(std::vector<int> line_numbers);
+
+    /// @brief Set the line #(s) that reference the selected register to paint pink rectangle(s), under any text search matches.
+    ///
+    /// @param [in] line_numbers The line #(s) of the register references, in any order.
+    void SetRegisterReferenceLineNumbers(std::vector<int> line_numbers);
+
+    /// @brief Set the number of buckets of the heatmap strip; every bucket is unset until given an intensity.
+    ///
+    /// @param [in] bucket_count The number of buckets, each covering about the same number of lines; 0 to paint no heatmap.
+    /// @param [in] line_count   The number of lines the buckets cover, from the first line on.
+    void SetHeatmapBucketCount(int bucket_count, int line_count);
+
+    /// @brief Set the intensities of consecutive buckets of the heatmap strip; only those buckets are repainted.
+    ///
+    /// @param [in] first_bucket The first bucket.
+    /// @param [in] intensities  The intensity in [0, 1] of every bucket from first_bucket on, or less than 0 to unset a bucket.
+    void SetHeatmapIntensities(int first_bucket, const std::vector<float>& intensities);
+
 protected:
-    /// @brief Override paint to paint red hot spots and purple text search matches.
+    /// @brief Override paint to paint the heatmap strip, then red hot spots, purple text search matches and pink register references.
     ///
     /// @param [in] The paint event.
     void paintEvent(QPaintEvent* event) Q_DECL_OVERRIDE;
 
-    std::set<int> hot_spot_line_numbers_;      ///< Line number(s) of hot spots.
-    std::set<int> search_match_line_numbers_;  ///< Line number(s) of text search matches.
+    std::vector<int> hot_spot_line_numbers_;            ///< Sorted line number(s) of hot spots.
+    std::vector<int> search_match_line_numbers_;        ///< Sorted line number(s) of text search matches.
+    std::vector<int> register_reference_line_numbers_;  ///< Sorted line number(s) that reference the selected register.
+
+private:
+    /// @brief Paint every marker into marker_image_, merging markers that overlap on screen.
+    ///
+    /// @param [in] option The style options of this scroll bar.
+    void PaintMarkerImage(const QStyleOptionSlider& option);
+
+    /// @brief Paint the markers of one kind into the marker image.
+    ///
+    /// @param [in] painter          The painter of the marker image.
+    /// @param [in] line_numbers     The sorted line numbers of the markers.
+    /// @param [in] marker_rectangle The rectangle of a marker on line 0.
+    /// @param [in] color            The color of the markers.
+    void PaintMarkers(QPainter& painter, const std::vector<int>& line_numbers, const QRectF& marker_rectangle, const QColor& color) const;
+
+    QImage marker_image_;                     ///< The markers, painted once and drawn on top of the scroll bar on every paint.
+    bool   marker_image_valid_;               ///< false if the markers changed since marker_image_ was painted.
+    QRect  marker_image_rect_;                ///< The scroll bar rectangle marker_image_ was painted for.
+    qreal  marker_image_button_height_;       ///< The scroll bar button height marker_image_ was painted for.
+    qreal  marker_image_scroll_height_;       ///< The scrollable pixel height marker_image_ was painted for.
+    qreal  marker_image_line_count_;          ///< The number of lines marker_image_ was painted for.
+    qreal  marker_image_device_pixel_ratio_;  ///< The device pixel ratio marker_image_ was painted for.
+    QColor marker_image_search_match_color_;  ///< The search match color marker_image_ was painted with; changes with the theme.
+
+    QImage heatmap_image_;       ///< One pixel per heatmap bucket, top to bottom; scaled over the lines it covers on every paint.
+    int    heatmap_line_count_;  ///< The number of lines the heatmap buckets cover.
 };
 
 #endif  // QTISAGUI_ISA_VERTICAL_SCROLL_BAR_H_
@@ -0,0 +1,108 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for an index of the number of visible lines of every code block.
+//=============================================================================
+
+#include "isa_visible_line_index.h"
+
+#include <cassert>
+
+IsaVisibleLineIndex::IsaVisibleLineIndex()
+{
+}
+
+IsaVisibleLineIndex::~IsaVisibleLineIndex()
+{
+}
+
+void IsaVisibleLineIndex::Build(const std::vector<int>& line_counts)
+{
+    line_counts_ = line_counts;
+
+    const size_t block_count = line_counts_.size();
+
+    tree_.assign(block_count + 1, 0);
+
+    // Fill every node with its own value, then push each node's sum up to its parent once.
+    for (size_t node = 1; node <= block_count; node++)
+    {
+        tree_[node] += line_counts_[node - 1];
+
+        const size_t parent = node + (node & (~node + 1));
+
+        if (parent <= block_count)
+        {
+            tree_[parent] += tree_[node];
+        }
+    }
+}
+
+void IsaVisibleLineIndex::Clear()
+{
+    line_counts_.clear();
+    tree_.clear();
+}
+
+void IsaVisibleLineIndex::SetLineCount(size_t block, int line_count)
+{
+    assert(block < line_counts_.size());
+
+    const int delta = line_count - line_counts_[block];
+
+    if (delta == 0)
+    {
+        return;
+    }
+
+    line_counts_[block] = line_count;
+
+    for (size_t node = block + 1; node < tree_.size(); node += node & (~node + 1))
+    {
+        tree_[node] += delta;
+    }
+}
+
+int IsaVisibleLineIndex::GetLinesBefore(size_t block) const
+{
+    assert(block <= line_counts_.size());
+
+    int lines = 0;
+
+    for (size_t node = block; node > 0; node -= node & (~node + 1))
+    {
+        lines += tree_[node];
+    }
+
+    return lines;
+}
+
+size_t IsaVisibleLineIndex::FindBlock(int line) const
+{
+    if (line < 0)
+    {
+        return 0;
+    }
+
+    size_t step = 1;
+
+    while (step * 2 < tree_.size())
+    {
+        step *= 2;
+    }
+
+    // Descend the tree to the last node whose prefix sum is not past the line; the block after it holds the line.
+    size_t node = 0;
+
+    for (; step > 0; step /= 2)
+    {
+        if (node + step < tree_.size() && tree_[node + step] <= line)
+        {
+            node += step;
+            line -= tree_[node];
+        }
+    }
+
+    return node;
+}
@@ -0,0 +1,78 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for an index of the number of visible lines of every code block.
+//=============================================================================
+
+#ifndef QTISAGUI_ISA_VISIBLE_LINE_INDEX_H_
+#define QTISAGUI_ISA_VISIBLE_LINE_INDEX_H_
+
+#include <cstddef>
+#include <vector>
+
+/// @brief IsaVisibleLineIndex keeps the number of lines every code block takes up in a tree, and their prefix sums.
+///
+/// Backed by a Fenwick tree, so changing the line count of one block and finding the number of lines before a block
+/// are both O(log n) in the number of blocks.
+class IsaVisibleLineIndex
+{
+public:
+    /// @brief Constructor; create an empty index.
+    IsaVisibleLineIndex();
+
+    /// @brief Destructor.
+    ~IsaVisibleLineIndex();
+
+    /// @brief Replace all line counts at once, in O(n).
+    ///
+    /// @param [in] line_counts The number of lines of every block.
+    void Build(const std::vector<int>& line_counts);
+
+    /// @brief Remove all blocks.
+    void Clear();
+
+    /// @brief Get the number of blocks.
+    ///
+    /// @return The number of blocks.
+    inline size_t GetBlockCount() const
+    {
+        return line_counts_.size();
+    }
+
+    /// @brief Get the number of lines of a block.
+    ///
+    /// @param [in] block The block.
+    ///
+    /// @return The number of lines of the block.
+    inline int GetLineCount(size_t block) const
+    {
+        return line_counts_[block];
+    }
+
+    /// @brief Change the number of lines of a block.
+    ///
+    /// @param [in] block      The block.
+    /// @param [in] line_count The new number of lines.
+    void SetLineCount(size_t block, int line_count);
+
+    /// @brief Get the number of lines of all blocks before a block.
+    ///
+    /// @param [in] block The block; may be equal to the block count to get the total line count.
+    ///
+    /// @return The sum of the line counts of blocks [0, block).
+    int GetLinesBefore(size_t block) const;
+
+    /// @brief Find the block a line falls in; the reverse of GetLinesBefore, in O(log n).
+    ///
+    /// @param [in] line The line, counting the lines of every block before it.
+    ///
+    /// @return The block, or the block count if the line is past the last line.
+    size_t FindBlock(int line) const;
+
+private:
+    std::vector<int> line_counts_;  ///< The number of lines of every block.
+    std::vector<int> tree_;         ///< The Fenwick tree of line counts; 1 based.
+};
+
+#endif  // QTISAGUI_ISA_VISIBLE_LINE_INDEX_H_
@@ -11,14 +11,29 @@
 #include <QCheckBox>
 #include <QLayoutItem>
 #include <QLineEdit>
+#include <QRegularExpression>
 #include <QVBoxLayout>
 #include <QWidget>
 
+#include "qt_isa_gui/core/isa_instrumentation.h"
 #include "qt_isa_gui/widgets/isa_branch_label_navigation_widget.h"
 #include "qt_isa_gui/widgets/isa_item_delegate.h"
 
 static const int kSearchTimeout = 150;
 
+// Time between updates of the search results and scroll bar markers while the source model is still searching.
+static const int kSearchUpdateInterval = 100;
+
+/// @brief Check if a character can be part of a word, the same as the source model's search index does.
+///
+/// @param [in] character The character.
+///
+/// @return true if the character is an ascii letter, digit or underscore.
+static bool IsWordCharacter(QChar character)
+{
+    return character.unicode() < 128 && (character.isLetterOrNumber() || character == QChar('_'));
+}
+
 /// @brief Compare 2 model indices in the ISA model; compare indices by their line # (row # but relative to entire shader, not just code block).
 ///
 /// @param [in] lhs The left hand side model index.
@@ -36,11 +51,15 @@ static bool CompareModelIndices(const QModelIndex& lhs, const QModelIndex& rhs)
 IsaWidget::IsaWidget(QWidget* parent)
     : QWidget(parent)
     , ui_(std::make_unique<Ui::IsaWidget>())
+    , column_visibility_(nullptr)
     , proxy_model_(nullptr)
     , go_to_line_validator_(nullptr)
     , viewing_options_visible_(false)
+    , search_line_count_(0)
+    , search_notify_listener_(false)
     , show_event_completed_(false)
     , search_all_columns_(false)
+    , search_mode_(IsaSearchIndex::MatchMode::kContains)
 {
     ui_->setupUi(this);
 
@@ -88,7 +107,7 @@ IsaWidget::~IsaWidget()
 {
 }
 
-void IsaWidget::SetModelAndView(QWidget* navigation_widget_parent, IsaItemModel* isa_item_model, IsaTreeView* isa_view, IsaProxyModel* proxy_model)
+void IsaWidget::SetModelAndView(QWidget* navigation_widget_parent, IsaItemModel* isa_item_model, IsaTreeView* isa_view, IsaColumnVisibility* proxy_model)
 {
     if (isa_view != nullptr)
     {
@@ -122,20 +141,22 @@ void IsaWidget::SetModelAndView(QWidget* navigation_widget_parent, IsaItemModel*
     // Attach a client's proxy or make the default one instead.
     if (proxy_model != nullptr)
     {
-        proxy_model_.reset(proxy_model);
+        column_visibility_.reset(proxy_model);
     }
     else
     {
-        proxy_model_.reset(new IsaProxyModel);
+        column_visibility_.reset(new IsaColumnProxyModel);
     }
 
+    proxy_model_ = column_visibility_->GetProxyModel();
+
     proxy_model_->setSourceModel(isa_item_model);
-    ui_->isa_tree_view_->setModel(proxy_model_.get());
+    ui_->isa_tree_view_->setModel(proxy_model_);
 
-    for (uint32_t column = IsaItemModel::kPcAddress; column < proxy_model_->GetNumberOfViewingOptions(); column++)
+    for (uint32_t column = IsaItemModel::kPcAddress; column < column_visibility_->GetNumberOfViewingOptions(); column++)
     {
-        proxy_model_->CreateViewingOptionsCheckbox(column, ui_->viewing_options_checkboxes_widget_);
-        auto checkbox = proxy_model_->GetViewingOptionsCheckbox(column);
+        column_visibility_->CreateViewingOptionsCheckbox(column, ui_->viewing_options_checkboxes_widget_);
+        auto checkbox = column_visibility_->GetViewingOptionsCheckbox(column);
         if (checkbox != nullptr)
         {
             connect(checkbox, &QAbstractButton::clicked, this, &IsaWidget::ShowHideColumnClicked);
@@ -152,6 +173,9 @@ void IsaWidget::SetModelAndView(QWidget* navigation_widget_parent, IsaItemModel*
         connect(isa_item_model, &IsaItemModel::ArchitectureChanged, isa_delegate, &IsaItemDelegate::ConnectTooltipTimerCallback);
     }
 
+    // Listen to the source model's search to show its matches as they are found.
+    connect(isa_item_model, &IsaItemModel::SearchUpdated, this, &IsaWidget::SearchUpdated, Qt::UniqueConnection);
+
     // Connect the tree view to the nav widget to assist recording navigation history.
 
     connect(
@@ -181,10 +205,6 @@ void IsaWidget::RegisterScrollAreas(std::vector<QScrollArea*> container_scroll_a
 
 void IsaWidget::ExpandCollapseAll(bool expand, bool resize_contents, std::deque<bool>* collapsed_blocks)
 {
-    // Disconnect to prevent duplicate updates.
-    disconnect(ui_->isa_tree_view_, &QTreeView::collapsed, this, &IsaWidget::RefreshSearchMatchLineNumbers);
-    disconnect(ui_->isa_tree_view_, &QTreeView::expanded, this, &IsaWidget::RefreshSearchMatchLineNumbers);
-
     ui_->isa_tree_view_->HideTooltip();
 
     if (expand)
@@ -192,33 +212,20 @@ void IsaWidget::ExpandCollapseAll(bool expand, bool resize_contents, std::deque<
         if (collapsed_blocks == nullptr)
         {
             ui_->isa_tree_view_->expandAll();
+            ui_->isa_tree_view_->InvalidateVisibleLineCounts();
         }
         else
         {
-            IsaItemModel* source_model = nullptr;
+            QBitArray expanded_blocks = ui_->isa_tree_view_->GetExpandedBlocks();
 
-            if (proxy_model_ != nullptr)
-            {
-                source_model = qobject_cast<IsaItemModel*>(proxy_model_->sourceModel());
-            }
-            else
-            {
-                source_model = qobject_cast<IsaItemModel*>(ui_->isa_tree_view_->model());
-            }
+            expanded_blocks.fill(true);
 
-            if (source_model != nullptr)
+            for (int i = 0; i < expanded_blocks.size() && static_cast<size_t>(i) < collapsed_blocks->size(); i++)
             {
-                for (int i = 0; i < source_model->rowCount(); i++)
-                {
-                    const QModelIndex code_block_source_index = source_model->index(i, IsaItemModel::kLineNumber);
-                    const QModelIndex code_block_proxy_index =
-                        proxy_model_ != nullptr ? proxy_model_->mapFromSource(code_block_source_index) : code_block_source_index;
-
-                    const bool is_block_collapsed = collapsed_blocks->at(i);
-
-                    ui_->isa_tree_view_->setExpanded(code_block_proxy_index, !is_block_collapsed);
-                }
+                expanded_blocks.setBit(i, !collapsed_blocks->at(i));
             }
+
+            ui_->isa_tree_view_->SetExpandedBlocks(expanded_blocks);
         }
 
         const QAbstractItemModel* model = ui_->isa_tree_view_->model();
@@ -233,35 +240,22 @@ void IsaWidget::ExpandCollapseAll(bool expand, bool resize_contents, std::deque<
     else
     {
         ui_->isa_tree_view_->collapseAll();
+        ui_->isa_tree_view_->InvalidateVisibleLineCounts();
     }
 
+    // None of the above emit expanded or collapsed, so refresh the search matches once here.
     RefreshSearchMatchLineNumbers(QModelIndex());
-
-    // Reconnect to resume normal updates.
-    connect(ui_->isa_tree_view_, &QTreeView::collapsed, this, &IsaWidget::RefreshSearchMatchLineNumbers);
-    connect(ui_->isa_tree_view_, &QTreeView::expanded, this, &IsaWidget::RefreshSearchMatchLineNumbers);
 }
 
 IsaWidget::ExpandCollapseState IsaWidget::SaveExpandState()
 {
     ExpandCollapseState expand_collapse_state;
 
-    if (proxy_model_ == nullptr)
-    {
-        return expand_collapse_state;
-    }
-
-    const IsaItemModel* source_model       = qobject_cast<IsaItemModel*>(proxy_model_->sourceModel());
-    const int           number_code_blocks = source_model->rowCount();
+    const QBitArray expanded_blocks = SaveExpandedBlocks();
 
-    for (int i = 0; i < number_code_blocks; i++)
+    for (int i = 0; i < expanded_blocks.size(); i++)
     {
-        const QModelIndex code_block_line_number_source_index = source_model->index(i, IsaItemModel::kLineNumber);
-        const QModelIndex code_block_line_number_proxy_index  = proxy_model_->mapFromSource(code_block_line_number_source_index);
-
-        const bool is_code_block_expanded = ui_->isa_tree_view_->isExpanded(code_block_line_number_proxy_index);
-
-        expand_collapse_state.emplace_back(is_code_block_expanded);
+        expand_collapse_state.emplace_back(expanded_blocks.testBit(i));
     }
 
     return expand_collapse_state;
@@ -269,78 +263,53 @@ IsaWidget::ExpandCollapseState IsaWidget::SaveExpandState()
 
 void IsaWidget::RestoreExpandState(ExpandCollapseState expand_collapse_state)
 {
-    if (proxy_model_ == nullptr)
-    {
-        return;
-    }
-
-    const IsaItemModel* source_model       = qobject_cast<IsaItemModel*>(proxy_model_->sourceModel());
-    const int           number_code_blocks = source_model->rowCount();
-
-    if (number_code_blocks != static_cast<int>(expand_collapse_state.size()))
-    {
-        return;
-    }
-
-    // Disconnect to prevent duplicate updates.
-    disconnect(ui_->isa_tree_view_, &QTreeView::collapsed, this, &IsaWidget::RefreshSearchMatchLineNumbers);
-    disconnect(ui_->isa_tree_view_, &QTreeView::expanded, this, &IsaWidget::RefreshSearchMatchLineNumbers);
+    QBitArray expanded_blocks(static_cast<int>(expand_collapse_state.size()));
 
     int code_block_row = 0;
 
     for (const bool is_code_block_expanded : expand_collapse_state)
     {
-        const QModelIndex code_block_line_number_source_index = source_model->index(code_block_row, IsaItemModel::kLineNumber);
-        const QModelIndex code_block_line_number_proxy_index  = proxy_model_->mapFromSource(code_block_line_number_source_index);
-
-        ui_->isa_tree_view_->setExpanded(code_block_line_number_proxy_index, is_code_block_expanded);
-
-        code_block_row++;
+        expanded_blocks.setBit(code_block_row++, is_code_block_expanded);
     }
 
-    RefreshSearchMatchLineNumbers(QModelIndex());
-
-    // Reconnect to resume normal updates.
-    connect(ui_->isa_tree_view_, &QTreeView::collapsed, this, &IsaWidget::RefreshSearchMatchLineNumbers);
-    connect(ui_->isa_tree_view_, &QTreeView::expanded, this, &IsaWidget::RefreshSearchMatchLineNumbers);
+    RestoreExpandedBlocks(expanded_blocks);
 }
 
-void IsaWidget::UpdateSpannedColumns()
+QBitArray IsaWidget::SaveExpandedBlocks() const
 {
     if (proxy_model_ == nullptr)
     {
-        return;
+        return QBitArray();
     }
 
-    const QAbstractItemModel* source_model = proxy_model_->sourceModel();
+    return ui_->isa_tree_view_->GetExpandedBlocks();
+}
 
-    for (int i = 0; i < source_model->rowCount(); i++)
+void IsaWidget::RestoreExpandedBlocks(const QBitArray& expanded_blocks)
+{
+    if (proxy_model_ == nullptr || proxy_model_->sourceModel() == nullptr)
     {
-        const int proxy_row = proxy_model_->mapFromSource(source_model->index(i, IsaItemModel::kOpCode)).row();
-
-        // All parent labels (code blocks or comments) should span across columns.
-        ui_->isa_tree_view_->setFirstColumnSpanned(proxy_row, QModelIndex(), true);
+        return;
+    }
 
-        const QModelIndex source_parent_index = source_model->index(i, IsaItemModel::kLineNumber);
+    if (proxy_model_->sourceModel()->rowCount() != expanded_blocks.size())
+    {
+        return;
+    }
 
-        for (int j = 0; j < source_model->rowCount(source_parent_index); j++)
-        {
-            QModelIndex source_child_index = source_model->index(j, IsaItemModel::kOpCode, source_parent_index);
-            const auto  row_type           = qvariant_cast<IsaItemModel::RowType>(source_child_index.data(IsaItemModel::kRowTypeRole));
-            bool        spanned            = false;
+    ui_->isa_tree_view_->HideTooltip();
+    ui_->isa_tree_view_->SetExpandedBlocks(expanded_blocks);
 
-            if (row_type == IsaItemModel::RowType::kComment)
-            {
-                spanned = true;
-            }
+    RefreshSearchMatchLineNumbers(QModelIndex());
+}
 
-            const int proxy_child_row = proxy_model_->mapFromSource(source_child_index).row();
+void IsaWidget::UpdateSpannedColumns()
+{
+    QTISAGUI_SCOPED_TIMER(kUpdateSpannedColumns);
 
-            // Child comments should span across columns.
-            ui_->isa_tree_view_->setFirstColumnSpanned(proxy_child_row, proxy_model_->mapFromSource(source_parent_index), spanned);
-        }
-    }
+    // Which rows span is decided from their row type when they are painted or hit; see IsaTreeView::IsRowSpanned.
     ui_->isa_tree_view_->ClearLastPinnedndex();
+    ui_->isa_tree_view_->viewport()->update();
 }
 
 void IsaWidget::ClearHistory()
@@ -370,6 +339,10 @@ void IsaWidget::SetGoToLineValidatorLineCount(int line_count)
 
 void IsaWidget::Search()
 {
+    QTISAGUI_SCOPED_TIMER(kSearch);
+
+    search_timer_.stop();
+
     if (proxy_model_ == nullptr)
     {
         return;
@@ -378,78 +351,249 @@ void IsaWidget::Search()
     ui_->search_results_->setText("No results");
 
     matches_.clear();
+    column_matches_.clear();
+    search_line_count_ = 0;
 
     const auto text = ui_->search_->text();
 
     std::set<QModelIndex> match_source_indices;
     ui_->isa_tree_view_->SetSearchMatchLineNumbers(text, match_source_indices);
 
-    if (!text.isEmpty())
+    auto* delegate = qobject_cast<IsaItemDelegate*>(ui_->isa_tree_view_->itemDelegate());
+
+    if (delegate != nullptr)
     {
-        ui_->isa_tree_view_->selectionModel()->clearSelection();
+        delegate->SetSearchMode(search_mode_);
+    }
 
-        IsaItemModel* source_model = qobject_cast<IsaItemModel*>(proxy_model_->sourceModel());
+    IsaItemModel* source_model = qobject_cast<IsaItemModel*>(proxy_model_->sourceModel());
 
-        if (source_model != nullptr)
+    if (source_model != nullptr)
+    {
+        // Stop finding matches for the previous text.
+        source_model->CancelSearch();
+    }
+
+    if (!text.isEmpty() && source_model != nullptr)
+    {
+        ui_->isa_tree_view_->selectionModel()->clearSelection();
+
+        if (search_mode_ == IsaSearchIndex::MatchMode::kRegularExpression && !QRegularExpression(text).isValid())
         {
-            // Search by searching each column; don't search the line number column.
-            for (int col = (int)IsaItemModel::kLineNumber + 1; col < proxy_model_->columnCount(); col++)
-            {
-                QModelIndex     column_index   = proxy_model_->index(0, col);
-                QModelIndexList column_matches = proxy_model_->match(column_index, Qt::DisplayRole, text, -1, Qt::MatchContains | Qt::MatchRecursive);
+            ui_->search_results_->setText("Invalid regular expression");
+        }
+        else if (source_model->GetStorageMode() == IsaItemModel::StorageMode::kVirtual)
+        {
+            // Virtual models only parse the lines that are shown; matching every index would parse the whole file on this thread.
+            ui_->search_results_->setText("Search is not available for this file");
+        }
+        else
+        {
+            // Search the shared columns with the source model's search index; don't search the line number column.
+            // Columns added by the application, or text the index can't search, fall back to matching every index of a column.
+            std::vector<int> index_columns;
+            std::vector<int> match_columns;
 
-                for (QModelIndex index : column_matches)
+            if (proxy_model_->rowCount() > 0)
+            {
+                for (int col = (int)IsaItemModel::kLineNumber + 1; col < proxy_model_->columnCount(); col++)
                 {
-                    const auto source_index = proxy_model_->mapToSource(index);
+                    const int source_column = proxy_model_->mapToSource(proxy_model_->index(0, col)).column();
 
-                    // Always count the match if it is a column from the IsaItemModel, otherwise count it if the application requested searching all columns.
-                    if (source_index.column() < IsaItemModel::kColumnCount || search_all_columns_)
+                    if (source_column < IsaItemModel::kColumnCount)
                     {
-                        // Store into matches_; use the first column to avoid matching more than 1 index from any given row.
-                        matches_ += index.siblingAtColumn(IsaItemModel::kLineNumber);
+                        index_columns.push_back(source_column);
+                    }
+                    else if (search_all_columns_)
+                    {
+                        // Only count matches from columns outside of the IsaItemModel if the application requested searching all columns.
+                        match_columns.push_back(col);
                     }
                 }
             }
 
-            // Sort and uniquify.
-            std::sort(matches_.begin(), matches_.end(), CompareModelIndices);
-            matches_.erase(std::unique(matches_.begin(), matches_.end()), matches_.end());
+            const QObject* sender = this->sender();
+
+            search_notify_listener_ = qobject_cast<const QTimer*>(sender) != nullptr;
+            search_update_timer_.start();
 
-            if (!matches_.isEmpty())
+            // The source model searches on worker threads, and reports the lines it finds through SearchUpdated.
+            if (!source_model->BeginSearch(text, index_columns, search_mode_))
             {
-                find_index_ = 0;
+                for (const int source_column : index_columns)
+                {
+                    match_columns.push_back(proxy_model_->mapFromSource(source_model->index(0, source_column)).column());
+                }
+            }
 
-                ui_->search_results_->setText(QString("%1 of %2").arg(find_index_ + 1).arg(matches_.size()));
+            // Match the search index's modes; a whole word only needs a boundary at the ends that are word characters.
+            QVariant           match_value = text;
+            Qt::MatchFlags     match_flags = Qt::MatchContains | Qt::MatchRecursive;
+            QRegularExpression whole_word_expression;
 
-                const QModelIndex& view_index   = matches_.at(find_index_);
-                const QModelIndex  source_index = proxy_model_->mapToSource(view_index);
-                auto*              delegate     = qobject_cast<IsaItemDelegate*>(ui_->isa_tree_view_->itemDelegate());
+            if (search_mode_ == IsaSearchIndex::MatchMode::kWholeWord)
+            {
+                QString pattern = QRegularExpression::escape(text);
 
-                if (delegate != nullptr)
+                if (IsWordCharacter(text.front()))
                 {
-                    delegate->SetSearchIndex(source_index);
+                    pattern.prepend("(?<![A-Za-z0-9_])");
                 }
 
-                const QObject* sender = this->sender();
+                if (IsWordCharacter(text.back()))
+                {
+                    pattern.append("(?![A-Za-z0-9_])");
+                }
 
-                bool notify_listener = qobject_cast<const QTimer*>(sender) != nullptr;
+                match_value = QRegularExpression(pattern, QRegularExpression::CaseInsensitiveOption);
+                match_flags = Qt::MatchRegularExpression | Qt::MatchRecursive;
+            }
+            else if (search_mode_ == IsaSearchIndex::MatchMode::kRegularExpression)
+            {
+                match_flags = Qt::MatchRegularExpression | Qt::MatchRecursive;
+            }
 
-                ui_->isa_tree_view_->ScrollToIndex(source_index, false, false, notify_listener);
+            for (int col : match_columns)
+            {
+                QModelIndex     column_index   = proxy_model_->index(0, col);
+                QModelIndexList column_matches = proxy_model_->match(column_index, Qt::DisplayRole, match_value, -1, match_flags);
 
-                emit SearchMatchLineChanged(source_index);
+                for (QModelIndex index : column_matches)
+                {
+                    // Store into column_matches_; use the first column to avoid matching more than 1 index from any given row.
+                    column_matches_ += index.siblingAtColumn(IsaItemModel::kLineNumber);
+                }
             }
 
-            for (const QModelIndex& match_view_index : matches_)
+            if (!column_matches_.isEmpty())
             {
-                QModelIndex match_source_index = proxy_model_->mapToSource(match_view_index);
-                match_source_indices.emplace(match_source_index);
+                // Sort and uniquify; search index results are merged into them as they arrive.
+                std::sort(column_matches_.begin(), column_matches_.end(), CompareModelIndices);
+                column_matches_.erase(std::unique(column_matches_.begin(), column_matches_.end()), column_matches_.end());
+
+                matches_ = column_matches_;
             }
 
-            ui_->isa_tree_view_->SetSearchMatchLineNumbers(text, match_source_indices);
+            UpdateSearchMatches(!source_model->IsSearching());
+
+            return;
         }
     }
 
-    search_timer_.stop();
+    // Update the isa tree and its scroll bar.
+    ui_->isa_tree_view_->viewport()->update();
+    ui_->isa_tree_view_->verticalScrollBar()->update();
+}
+
+void IsaWidget::SetSearchMode(IsaSearchIndex::MatchMode search_mode)
+{
+    search_mode_ = search_mode;
+
+    if (!ui_->search_->text().isEmpty())
+    {
+        Search();
+    }
+}
+
+void IsaWidget::SearchUpdated(bool finished)
+{
+    if (proxy_model_ == nullptr || sender() != proxy_model_->sourceModel())
+    {
+        return;
+    }
+
+    UpdateSearchMatches(finished);
+}
+
+void IsaWidget::UpdateSearchMatches(bool finished)
+{
+    IsaItemModel* source_model = qobject_cast<IsaItemModel*>(proxy_model_->sourceModel());
+
+    if (source_model == nullptr)
+    {
+        return;
+    }
+
+    const std::vector<uint32_t>& lines     = source_model->GetSearchLines();
+    const bool                   had_match = !matches_.isEmpty();
+
+    if (search_line_count_ < lines.size())
+    {
+        const int first_source_column = proxy_model_->mapToSource(proxy_model_->index(0, IsaItemModel::kLineNumber)).column();
+
+        for (size_t i = search_line_count_; i < lines.size(); i++)
+        {
+            const QModelIndex source_index = source_model->GetLineNumberModelIndex(static_cast<int>(lines[i])).siblingAtColumn(first_source_column);
+            const QModelIndex view_index   = proxy_model_->mapFromSource(source_index);
+
+            if (view_index.isValid())
+            {
+                // Store into matches_; use the first column to avoid matching more than 1 index from any given row.
+                matches_ += view_index;
+            }
+        }
+
+        search_line_count_ = lines.size();
+
+        if (!column_matches_.isEmpty())
+        {
+            // Lines arrive in order, but may fall in between the matches of other columns.
+            std::sort(matches_.begin(), matches_.end(), CompareModelIndices);
+            matches_.erase(std::unique(matches_.begin(), matches_.end()), matches_.end());
+        }
+    }
+
+    if (!had_match && !matches_.isEmpty())
+    {
+        // Go to the first match as soon as there is one.
+        find_index_ = 0;
+
+        const QModelIndex source_index = proxy_model_->mapToSource(matches_.at(find_index_));
+        auto*             delegate     = qobject_cast<IsaItemDelegate*>(ui_->isa_tree_view_->itemDelegate());
+
+        if (delegate != nullptr)
+        {
+            delegate->SetSearchIndex(source_index);
+        }
+
+        ui_->isa_tree_view_->ScrollToIndex(source_index, false, false, search_notify_listener_);
+
+        emit SearchMatchLineChanged(source_index);
+    }
+    else if (!finished && search_update_timer_.elapsed() < kSearchUpdateInterval)
+    {
+        // Mapping every match to a marker again is not worth doing for every chunk of lines.
+        return;
+    }
+
+    search_update_timer_.start();
+
+    if (finished)
+    {
+        QTISAGUI_COUNT_ITEMS(kSearch, matches_.size());
+    }
+
+    // Trail the results with an ellipsis while more matches may follow.
+    const QString searching_suffix = finished ? QString() : QString("...");
+
+    if (!matches_.isEmpty())
+    {
+        ui_->search_results_->setText(QString("%1 of %2%3").arg(find_index_ + 1).arg(matches_.size()).arg(searching_suffix));
+    }
+    else
+    {
+        ui_->search_results_->setText(finished ? QString("No results") : QString("Searching..."));
+    }
+
+    std::set<QModelIndex> match_source_indices;
+
+    for (const QModelIndex& match_view_index : matches_)
+    {
+        QModelIndex match_source_index = proxy_model_->mapToSource(match_view_index);
+        match_source_indices.emplace(match_source_index);
+    }
+
+    ui_->isa_tree_view_->SetSearchMatchLineNumbers(ui_->search_->text(), match_source_indices);
 
     // Update the isa tree and its scroll bar.
     ui_->isa_tree_view_->viewport()->update();
@@ -536,14 +680,14 @@ void IsaWidget::ShowHideColumnClicked(bool checked)
 
     if ((sender != nullptr) && (header != nullptr))
     {
-        uint32_t source_column_index = proxy_model_->GetSourceColumnIndex(static_cast<const QCheckBox*>(sender));
+        uint32_t source_column_index = column_visibility_->GetSourceColumnIndex(static_cast<const QCheckBox*>(sender));
 
-        if (source_column_index != proxy_model_->GetNumberOfViewingOptions())
+        if (source_column_index != column_visibility_->GetNumberOfViewingOptions())
         {
             int proxy_index  = proxy_model_->mapFromSource(proxy_model_->sourceModel()->index(0, source_column_index)).column();
             int visual_index = header->visualIndex(proxy_index);
 
-            proxy_model_->SetColumnVisibility(source_column_index, checked, header);
+            column_visibility_->SetColumnVisibility(source_column_index, checked, header);
 
             if (checked)
             {
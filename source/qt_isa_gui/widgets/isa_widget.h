@@ -12,12 +12,15 @@
 #include <list>
 #include <memory>
 
+#include <QBitArray>
+#include <QElapsedTimer>
 #include <QModelIndex>
 #include <QScrollArea>
 #include <QTimer>
 #include <QValidator>
 #include <QWidget>
 
+#include "isa_column_proxy_model.h"
 #include "isa_item_model.h"
 #include "isa_proxy_model.h"
 #include "isa_tree_view.h"
@@ -51,11 +54,11 @@ public:
     /// @param [in] navigation_widget_parent The widget to set as the parent of the navigation widget combo box.
     /// @param [in] isa_model                The isa item model.
     /// @param [in] isa_view                 The optional isa tree view.
-    /// @param [in] proxy_model              The optional proxy model.
-    void SetModelAndView(QWidget*       navigation_widget_parent,
-                         IsaItemModel*  isa_model,
-                         IsaTreeView*   isa_view    = nullptr,
-                         IsaProxyModel* proxy_model = nullptr);
+    /// @param [in] proxy_model              The optional proxy model; an IsaProxyModel, or an IsaColumnProxyModel if rows are never sorted or filtered.
+    void SetModelAndView(QWidget*             navigation_widget_parent,
+                         IsaItemModel*        isa_model,
+                         IsaTreeView*         isa_view    = nullptr,
+                         IsaColumnVisibility* proxy_model = nullptr);
 
     /// @brief Remember any scroll areas that should affect the isa tooltip's visibility.
     ///
@@ -85,7 +88,19 @@ public:
     /// @param expand_collapse_state The true/false expand state of every code block currently in the model/view.
     void RestoreExpandState(ExpandCollapseState expand_collapse_state);
 
+    /// @brief Save the expand state of all code block nodes currently in the attached model, one bit per code block.
+    ///
+    /// @return One bit per code block row, set if the code block is expanded.
+    QBitArray SaveExpandedBlocks() const;
+
+    /// @brief Restore the expand state of all code block rows in the Isa tree view at once; see IsaTreeView::SetExpandedBlocks.
+    ///
+    /// @param [in] expanded_blocks One bit per code block row currently in the model, set to expand the code block.
+    void RestoreExpandedBlocks(const QBitArray& expanded_blocks);
+
     /// @brief Updates which rows in the view have their first column spanned whenever the data in the isa model changes.
+    ///
+    /// No per row state is registered; code blocks and comments are spanned on demand, see IsaTreeView::IsRowSpanned.
     void UpdateSpannedColumns();
 
     /// @brief Clear the history of the branch label navigation widget.
@@ -128,6 +143,11 @@ public:
         search_all_columns_ = search_all_columns;
     }
 
+    /// @brief Change how the text in the search line edit matches; searches again if there is any search text.
+    ///
+    /// @param [in] search_mode Match the text anywhere, only as a whole word, or as a regular expression.
+    void SetSearchMode(IsaSearchIndex::MatchMode search_mode);
+
 signals:
 
     /// @brief Notify listeners that the current search results match line has changed.
@@ -177,6 +197,20 @@ private slots:
     /// @param [in] index The view index of the code block that was expanded or collapsed.
     void RefreshSearchMatchLineNumbers(const QModelIndex& index);
 
+    /// @brief Respond to the source model finding more lines of the search started by Search.
+    ///
+    /// @param [in] finished true if every line has been searched, false if more lines may follow.
+    void SearchUpdated(bool finished);
+
+private:
+    /// @brief Add the lines the source model's search found since the last call to the matches, and show them.
+    ///
+    /// The first match is scrolled to as soon as it is found; the results and scroll bar markers are only updated
+    /// every kSearchUpdateInterval milliseconds until the search is finished.
+    ///
+    /// @param [in] finished true if every line has been searched, false if more lines may follow.
+    void UpdateSearchMatches(bool finished);
+
 private:
 signals:
 
@@ -256,16 +290,22 @@ private:
         int line_count_;  ///< Line count cache.
     };
 
-    std::unique_ptr<Ui::IsaWidget> ui_;                    ///< The Qt ui form.
-    std::unique_ptr<IsaProxyModel> proxy_model_;           ///< Internal proxy model to assist hiding columns.
-    std::unique_ptr<LineValidator> go_to_line_validator_;  ///< Validate input to the 'Go To Line' line edit.
+    std::unique_ptr<Ui::IsaWidget>       ui_;                    ///< The Qt ui form.
+    std::unique_ptr<IsaColumnVisibility> column_visibility_;     ///< Internal proxy model to assist hiding columns; owns proxy_model_.
+    QAbstractProxyModel*                 proxy_model_;           ///< The proxy model of column_visibility_.
+    std::unique_ptr<LineValidator>       go_to_line_validator_;  ///< Validate input to the 'Go To Line' line edit.
 
     QTimer          search_timer_;             ///< Search delay timer.
     QModelIndexList matches_;                  ///< Cache of list of matches from find query.
+    QModelIndexList column_matches_;           ///< Matches from columns the source model's search index can't search.
+    size_t          search_line_count_;        ///< The number of lines found by the source model's search so far that are in matches_.
+    QElapsedTimer   search_update_timer_;      ///< Time since the search results and markers were last updated.
+    bool            search_notify_listener_;   ///< true if scrolling to the first match should notify listeners.
     int             find_index_;               ///< Cache of current find selection index.
     bool            viewing_options_visible_;  ///< Visibilty state of the Viewing Options widget.
     bool            show_event_completed_;     ///< Track if this widget has been shown for the first time to help force some widgets to be the same size.
     bool            search_all_columns_;  ///< Track whether to search all columns in the model attached to this widget or to only search IsaItemModel columns.
+    IsaSearchIndex::MatchMode search_mode_;  ///< How the text in the search line edit matches.
 };
 
 #endif  // QTISAGUI_ISA_WIDGET_H_
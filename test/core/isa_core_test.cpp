@@ -0,0 +1,70 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the tests of the core library.
+//=============================================================================
+
+#include "isa_core_test.h"
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /// @brief Get every test, in the order they were added.
+    ///
+    /// @return The name and function of every test.
+    std::vector<std::pair<const char*, IsaCoreTest::TestFunction>>& GetTests()
+    {
+        static std::vector<std::pair<const char*, IsaCoreTest::TestFunction>> tests;
+
+        return tests;
+    }
+
+    // The number of checks that failed in the test that is running.
+    int failed_check_count = 0;
+}  // namespace
+
+bool IsaCoreTest::Register(const char* name, TestFunction function)
+{
+    GetTests().emplace_back(name, function);
+
+    return true;
+}
+
+void IsaCoreTest::Fail(const char* file, int line, const char* condition)
+{
+    std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, condition);
+
+    failed_check_count++;
+}
+
+int IsaCoreTest::RunAll()
+{
+    int failed_test_count = 0;
+
+    for (const auto& test : GetTests())
+    {
+        failed_check_count = 0;
+
+        test.second();
+
+        std::printf("%s %s\n", (failed_check_count == 0) ? "[ PASSED ]" : "[ FAILED ]", test.first);
+
+        if (failed_check_count != 0)
+        {
+            failed_test_count++;
+        }
+    }
+
+    std::printf("%d of %d tests failed\n", failed_test_count, static_cast<int>(GetTests().size()));
+
+    return failed_test_count;
+}
+
+int main()
+{
+    return (IsaCoreTest::RunAll() == 0) ? 0 : 1;
+}
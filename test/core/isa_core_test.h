@@ -0,0 +1,55 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Declaration for the tests of the core library.
+//=============================================================================
+
+#ifndef QTISAGUI_TEST_ISA_CORE_TEST_H_
+#define QTISAGUI_TEST_ISA_CORE_TEST_H_
+
+/// @brief IsaCoreTest runs every test of the core library, and counts the checks that failed.
+class IsaCoreTest
+{
+public:
+    /// @brief A single test.
+    using TestFunction = void (*)();
+
+    /// @brief Add a test; use QTISAGUI_TEST instead.
+    ///
+    /// @param [in] name     The name of the test.
+    /// @param [in] function The test.
+    ///
+    /// @return true, so the test can be added when a static variable is initialized.
+    static bool Register(const char* name, TestFunction function);
+
+    /// @brief Report a check that failed; use QTISAGUI_CHECK instead.
+    ///
+    /// @param [in] file      The file of the check.
+    /// @param [in] line      The line of the check.
+    /// @param [in] condition The text of the condition that was false.
+    static void Fail(const char* file, int line, const char* condition);
+
+    /// @brief Run every test.
+    ///
+    /// @return The number of tests that failed.
+    static int RunAll();
+};
+
+/// @brief Define a test; the body follows the macro.
+#define QTISAGUI_TEST(name)                                                               \
+    static void                  name();                                                  \
+    [[maybe_unused]] static bool name##_registered = IsaCoreTest::Register(#name, name); \
+    static void                  name()
+
+/// @brief Check a condition; a test goes on after a failed check, so every failure of a test is reported.
+#define QTISAGUI_CHECK(condition)                                 \
+    do                                                            \
+    {                                                             \
+        if (!(condition))                                         \
+        {                                                         \
+            IsaCoreTest::Fail(__FILE__, __LINE__, #condition);    \
+        }                                                         \
+    } while (false)
+
+#endif  // QTISAGUI_TEST_ISA_CORE_TEST_H_
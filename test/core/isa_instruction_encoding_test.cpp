@@ -0,0 +1,97 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Tests of converting the binary representation text of isa instructions to words and back.
+//=============================================================================
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "qt_isa_gui/core/isa_instruction_encoding.h"
+
+#include "isa_core_test.h"
+
+namespace
+{
+    /// @brief Parse text into words and format them again.
+    ///
+    /// @param [in] binary_representation The binary representation text.
+    ///
+    /// @return The formatted text.
+    std::string RoundTrip(const std::string& binary_representation)
+    {
+        std::vector<uint32_t> words;
+        std::string           text;
+
+        IsaInstructionEncoding::Append(binary_representation, words);
+        IsaInstructionEncoding::Format(words.data(), words.size(), text);
+
+        return text;
+    }
+
+    /// @brief Get the encoding the isa decoder decodes for binary representation text.
+    ///
+    /// @param [in] binary_representation The binary representation text.
+    ///
+    /// @return The encoding.
+    uint64_t GetDecoderEncoding(const std::string& binary_representation)
+    {
+        std::vector<uint32_t> words;
+
+        const size_t number_words = IsaInstructionEncoding::Append(binary_representation, words);
+
+        return IsaInstructionEncoding::GetDecoderEncoding(words.data(), number_words);
+    }
+}  // namespace
+
+QTISAGUI_TEST(EncodingRoundTrip)
+{
+    QTISAGUI_CHECK(RoundTrip("D7610002 00000001") == "D7610002 00000001");
+    QTISAGUI_CHECK(RoundTrip("BF8C0070") == "BF8C0070");
+
+    // Case, width, "0x" and extra whitespace are not kept.
+    QTISAGUI_CHECK(RoundTrip("0xd7610002  1") == "D7610002 00000001");
+    QTISAGUI_CHECK(RoundTrip("\tabc\r\n") == "00000ABC");
+
+    // A number wider than a word is split, most significant word first; leading zeros do not make words.
+    QTISAGUI_CHECK(RoundTrip("D76100020000001F") == "D7610002 0000001F");
+    QTISAGUI_CHECK(RoundTrip("000000000000000000ABCDEF") == "00ABCDEF");
+
+    // Parsing stops at the first text that is not a hex number.
+    QTISAGUI_CHECK(RoundTrip("12 zz 34") == "00000012");
+    QTISAGUI_CHECK(RoundTrip("12zz") == "00000012");
+    QTISAGUI_CHECK(RoundTrip("zz").empty());
+    QTISAGUI_CHECK(RoundTrip("").empty());
+}
+
+QTISAGUI_TEST(EncodingAppendKeepsPool)
+{
+    std::vector<uint32_t> words = {7};
+
+    QTISAGUI_CHECK(IsaInstructionEncoding::Append("1 2", words) == 1);
+    QTISAGUI_CHECK((words == std::vector<uint32_t>{7, 1, 2}));
+
+    QTISAGUI_CHECK(IsaInstructionEncoding::Append("", words) == 0);
+    QTISAGUI_CHECK(words.size() == 3);
+}
+
+QTISAGUI_TEST(EncodingFormattedLength)
+{
+    QTISAGUI_CHECK(IsaInstructionEncoding::GetFormattedLength(0) == 0);
+    QTISAGUI_CHECK(IsaInstructionEncoding::GetFormattedLength(1) == 8);
+    QTISAGUI_CHECK(IsaInstructionEncoding::GetFormattedLength(2) == RoundTrip("1 2").size());
+}
+
+QTISAGUI_TEST(EncodingDecoderEncoding)
+{
+    // The first hex number, read the way strtoull reads the text.
+    QTISAGUI_CHECK(GetDecoderEncoding("D7610002 00000001") == 0xD7610002ULL);
+    QTISAGUI_CHECK(GetDecoderEncoding("D76100020000001F") == 0xD76100020000001FULL);
+    QTISAGUI_CHECK(GetDecoderEncoding("0x1f 2") == 0x1FULL);
+    QTISAGUI_CHECK(GetDecoderEncoding("000000000000000000ABCDEF") == 0xABCDEFULL);
+    QTISAGUI_CHECK(GetDecoderEncoding("1D76100020000001F") == UINT64_MAX);
+    QTISAGUI_CHECK(GetDecoderEncoding("") == 0);
+    QTISAGUI_CHECK(GetDecoderEncoding("zz") == 0);
+}
@@ -0,0 +1,169 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Tests of the single pass lexer of isa operand tokens.
+//=============================================================================
+
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "qt_isa_gui/core/isa_operand_lexer.h"
+
+#include "isa_core_test.h"
+
+namespace
+{
+    /// @brief Classify a token the way the regular expressions the lexer replaced did.
+    ///
+    /// @param [in] token The token text.
+    ///
+    /// @return The classification of the token.
+    IsaOperandLexer::Operand LexWithRegexCascade(const std::string& token)
+    {
+        // Single registers, the start of a pair and the end of a pair; match negative value or absolute value too.
+        static const std::regex kScalarRegisterExpression("(-?)(\\|?)(s[0-9]+)(\\2)");
+        static const std::regex kVectorRegisterExpression("(-?)(\\|?)(v[0-9]+)(\\2)");
+        static const std::regex kScalarPairStartRegisterExpression("\\[(-?)(\\|?)(s[0-9]+)(\\2)");
+        static const std::regex kVectorPairStartRegisterExpression("\\[(-?)(\\|?)(v[0-9]+)(\\2)");
+        static const std::regex kScalarPairEndRegisterExpression("(-?)(\\|?)(s[0-9]+)(\\2)\\]");
+        static const std::regex kVectorPairEndRegisterExpression("(-?)(\\|?)(v[0-9]+)(\\2)\\]");
+
+        // Register ranges and constants.
+        static const std::regex kScalarRegisterRangeExpression("s\\[([0-9]+):([0-9]+)\\]");
+        static const std::regex kVectorRegisterRangeExpression("v\\[([0-9]+):([0-9]+)\\]");
+        static const std::regex kConstantExpression("-?[0-9].*");
+
+        IsaOperandLexer::Operand operand;
+        std::smatch              match;
+
+        const bool is_scalar_register = std::regex_match(token, kScalarRegisterExpression) || std::regex_match(token, kScalarPairStartRegisterExpression) ||
+                                        std::regex_match(token, kScalarPairEndRegisterExpression);
+        const bool is_vector_register = std::regex_match(token, kVectorRegisterExpression) || std::regex_match(token, kVectorPairStartRegisterExpression) ||
+                                        std::regex_match(token, kVectorPairEndRegisterExpression);
+
+        if (is_scalar_register || is_vector_register)
+        {
+            // The index follows the first 's' or 'v'.
+            operand.kind                 = is_scalar_register ? IsaOperandLexer::Kind::kScalarRegister : IsaOperandLexer::Kind::kVectorRegister;
+            operand.start_register_index = std::stoi(token.substr(token.find(is_scalar_register ? 's' : 'v') + 1));
+        }
+        else if (std::regex_match(token, match, kScalarRegisterRangeExpression) || std::regex_match(token, match, kVectorRegisterRangeExpression))
+        {
+            operand.kind                 = (token[0] == 's') ? IsaOperandLexer::Kind::kScalarRegister : IsaOperandLexer::Kind::kVectorRegister;
+            operand.start_register_index = std::stoi(match[1].str());
+            operand.end_register_index   = std::stoi(match[2].str());
+        }
+        else if (std::regex_match(token, kConstantExpression))
+        {
+            operand.kind = IsaOperandLexer::Kind::kConstant;
+        }
+
+        return operand;
+    }
+
+    /// @brief Split an operand the way IsaItemModel::Split does; split at every space and trim every piece.
+    ///
+    /// @param [in] operand The operand text.
+    ///
+    /// @return The tokens.
+    std::vector<std::string> SplitWithStrings(std::string operand)
+    {
+        static const char* kWhitespace = " \t\n\r\f\v";
+
+        auto trim = [](std::string text) {
+            text.erase(text.find_last_not_of(kWhitespace) + 1);
+            text.erase(0, text.find_first_not_of(kWhitespace));
+            return text;
+        };
+
+        std::vector<std::string> tokens;
+        size_t                   position = 0;
+
+        while ((position = operand.find(' ')) != std::string::npos)
+        {
+            tokens.push_back(trim(operand.substr(0, position)));
+            operand.erase(0, position + 1);
+        }
+
+        tokens.push_back(trim(operand));
+
+        return tokens;
+    }
+}  // namespace
+
+QTISAGUI_TEST(LexMatchesRegexCascade)
+{
+    const std::vector<std::string> tokens = {
+        // Single registers, with and without modifiers.
+        "s0", "s12", "v0", "v255", "-s3", "-v3", "|s4|", "|v4|", "-|s5|", "-|v5|",
+        // Halves of a pair.
+        "[s0", "[v2", "[-s4", "[|v6|", "s1]", "v3]", "-s1]", "|s6|]",
+        // Ranges.
+        "s[0:1]", "v[2:5]", "s[10:11]", "v[0:0]",
+        // Constants.
+        "0", "-1", "1.0", "0x01", "4e-3", "-0.5", "7abc",
+        // Single modifiers and empty tokens.
+        "-", "|", "", "[", "]", "-|", "||",
+        // Things that are none of the above.
+        "s", "v", "sx", "s-1", "[s", "s]", "|s0", "s0|", "[s0]", "||s0||", "-v", "-s[0:1]", "s[0:]", "s[:1]", "s[0:1", "v[1:2]x", "vcc", "exec",
+        "m0", "off", "ttmp[0:1]", "label_1", "s_nop", "offset:16", "glc", "[[s0", "s0]]", "S0", "V1"};
+
+    for (const auto& token : tokens)
+    {
+        const IsaOperandLexer::Operand expected = LexWithRegexCascade(token);
+        const IsaOperandLexer::Operand operand  = IsaOperandLexer::Lex(token);
+
+        if (operand.kind != expected.kind || operand.start_register_index != expected.start_register_index ||
+            operand.end_register_index != expected.end_register_index)
+        {
+            IsaCoreTest::Fail(__FILE__, __LINE__, token.c_str());
+        }
+    }
+}
+
+QTISAGUI_TEST(LexRegisterIndices)
+{
+    const IsaOperandLexer::Operand pair_start = IsaOperandLexer::Lex("[s12");
+    QTISAGUI_CHECK(pair_start.kind == IsaOperandLexer::Kind::kScalarRegister);
+    QTISAGUI_CHECK(pair_start.start_register_index == 12 && pair_start.end_register_index == -1);
+
+    const IsaOperandLexer::Operand pair_end = IsaOperandLexer::Lex("v13]");
+    QTISAGUI_CHECK(pair_end.kind == IsaOperandLexer::Kind::kVectorRegister);
+    QTISAGUI_CHECK(pair_end.start_register_index == 13 && pair_end.end_register_index == -1);
+
+    const IsaOperandLexer::Operand range = IsaOperandLexer::Lex("s[4:7]");
+    QTISAGUI_CHECK(range.kind == IsaOperandLexer::Kind::kScalarRegister);
+    QTISAGUI_CHECK(range.start_register_index == 4 && range.end_register_index == 7);
+
+    // The regular expressions threw on an index that does not fit in an int; the lexer does not select it.
+    QTISAGUI_CHECK(IsaOperandLexer::Lex("s99999999999").kind == IsaOperandLexer::Kind::kUnknown);
+}
+
+QTISAGUI_TEST(SplitOperandMatchesSplit)
+{
+    const std::vector<std::string> operands = {"", " ", "  ", "s0", "s0 s1", "s0  s1", " s0 ", "a\tb c", "offset:16 glc", "s0 ", "\t"};
+
+    std::vector<std::string_view> tokens;
+
+    for (const auto& operand : operands)
+    {
+        const std::vector<std::string> expected = SplitWithStrings(operand);
+
+        IsaOperandLexer::SplitOperand(operand, tokens);
+
+        bool same = tokens.size() == expected.size();
+
+        for (size_t i = 0; same && i < tokens.size(); i++)
+        {
+            same = tokens[i] == expected[i];
+        }
+
+        if (!same)
+        {
+            IsaCoreTest::Fail(__FILE__, __LINE__, operand.c_str());
+        }
+    }
+}
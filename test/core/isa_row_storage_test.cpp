@@ -0,0 +1,230 @@
+//=============================================================================
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Tests of the flat storage of isa rows and its serialization.
+//=============================================================================
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "qt_isa_gui/core/isa_row_storage.h"
+#include "qt_isa_gui/core/isa_row_tokenizer.h"
+#include "qt_isa_gui/core/isa_symbol_table.h"
+
+#include "isa_core_test.h"
+
+namespace
+{
+    // Width of a character of the fixed font the test rows are laid out for.
+    constexpr double kCharacterWidth = 7.0;
+
+    /// @brief Fill a storage with a comment block and a code block of a comment and two instructions.
+    ///
+    /// @param [in,out] row_storage The storage.
+    void FillRowStorage(IsaRowStorage& row_storage)
+    {
+        IsaRowTokenizer::AppendBlock(row_storage, true, 0, "// shader", kCharacterWidth);
+        IsaRowTokenizer::AppendBlock(row_storage, false, 1, "label_basic_block_1:", kCharacterWidth);
+        IsaRowTokenizer::AppendComment(row_storage, 2, "// comment");
+        IsaRowTokenizer::AppendInstruction(row_storage, 3, "v_add_f32", {"v0", "-s[0:1]", "0x1 v2"}, "0x000000", "D76100020000001F", true, kCharacterWidth);
+        IsaRowTokenizer::AppendInstruction(row_storage, 4, "s_branch", {"label_basic_block_1"}, "0x000008", "BF820000", false, kCharacterWidth);
+    }
+
+    /// @brief Serialize a storage.
+    ///
+    /// @param [in] row_storage The storage.
+    ///
+    /// @return The serialized data.
+    std::string Serialize(const IsaRowStorage& row_storage)
+    {
+        std::string data;
+
+        row_storage.Serialize([&data](const char* piece, size_t size) {
+            data.append(piece, size);
+            return true;
+        });
+
+        return data;
+    }
+
+    /// @brief Check if two tokens are the same, comparing their text instead of their symbol.
+    ///
+    /// @param [in] storage       The storage of the first token.
+    /// @param [in] token         The first token.
+    /// @param [in] other_storage The storage of the second token.
+    /// @param [in] other_token   The second token.
+    ///
+    /// @return true if the tokens are the same.
+    bool IsSameToken(const IsaRowStorage&              storage,
+                     const IsaRowStorage::TokenRecord& token,
+                     const IsaRowStorage&              other_storage,
+                     const IsaRowStorage::TokenRecord& other_token)
+    {
+        return storage.GetTokenText(token) == other_storage.GetTokenText(other_token) && token.type == other_token.type &&
+               token.color_class == other_token.color_class && token.is_selectable == other_token.is_selectable &&
+               token.start_register_index == other_token.start_register_index && token.end_register_index == other_token.end_register_index &&
+               token.x_position_start == other_token.x_position_start && token.x_position_end == other_token.x_position_end;
+    }
+
+    /// @brief Check if two storages hold the same blocks, rows and tokens.
+    ///
+    /// @param [in] storage       The first storage.
+    /// @param [in] other_storage The second storage.
+    ///
+    /// @return true if the storages are the same.
+    bool IsSameStorage(const IsaRowStorage& storage, const IsaRowStorage& other_storage)
+    {
+        if (storage.GetBlockCount() != other_storage.GetBlockCount() || storage.GetRowCount() != other_storage.GetRowCount() ||
+            storage.GetTokenCount() != other_storage.GetTokenCount())
+        {
+            return false;
+        }
+
+        for (size_t block_index = 0; block_index < storage.GetBlockCount(); block_index++)
+        {
+            const auto& block       = storage.GetBlock(block_index);
+            const auto& other_block = other_storage.GetBlock(block_index);
+
+            if (block.is_comment != other_block.is_comment || block.line_number != other_block.line_number ||
+                storage.GetText(block.text) != other_storage.GetText(other_block.text) || block.row_count != other_block.row_count)
+            {
+                return false;
+            }
+
+            for (size_t row_index = 0; row_index < block.row_count; row_index++)
+            {
+                const auto& row       = storage.GetRow(block_index, row_index);
+                const auto& other_row = other_storage.GetRow(block_index, row_index);
+
+                if (row.is_comment != other_row.is_comment || row.enabled != other_row.enabled || row.line_number != other_row.line_number ||
+                    storage.GetRowText(row) != other_storage.GetRowText(other_row) ||
+                    storage.GetText(row.pc_address) != other_storage.GetText(other_row.pc_address) || row.word_count != other_row.word_count ||
+                    std::memcmp(storage.GetRowWords(row), other_storage.GetRowWords(other_row), row.word_count * sizeof(uint32_t)) != 0 ||
+                    storage.GetRowDecoderEncoding(row) != other_storage.GetRowDecoderEncoding(other_row) || row.operand_count != other_row.operand_count)
+                {
+                    return false;
+                }
+
+                if (row.is_comment)
+                {
+                    continue;
+                }
+
+                if (!IsSameToken(storage, storage.GetToken(row.op_code_token), other_storage, other_storage.GetToken(other_row.op_code_token)))
+                {
+                    return false;
+                }
+
+                for (uint32_t i = 0; i < row.operand_count; i++)
+                {
+                    const auto& operand       = storage.GetOperand(row.first_operand + i);
+                    const auto& other_operand = other_storage.GetOperand(other_row.first_operand + i);
+
+                    if (operand.token_count != other_operand.token_count)
+                    {
+                        return false;
+                    }
+
+                    for (uint32_t j = 0; j < operand.token_count; j++)
+                    {
+                        const auto& token       = storage.GetToken(operand.first_token + j);
+                        const auto& other_token = other_storage.GetToken(other_operand.first_token + j);
+
+                        if (!IsSameToken(storage, token, other_storage, other_token))
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+}  // namespace
+
+QTISAGUI_TEST(RowStorageRoundTrip)
+{
+    IsaRowStorage row_storage;
+    FillRowStorage(row_storage);
+
+    const std::string data = Serialize(row_storage);
+
+    // Read into a storage with a symbol table of its own, so symbols have to be mapped to that table.
+    IsaRowStorage loaded_row_storage;
+    loaded_row_storage.SetSymbolTable(std::make_shared<IsaSymbolTable>());
+
+    QTISAGUI_CHECK(loaded_row_storage.Deserialize(data.data(), data.size()));
+    QTISAGUI_CHECK(IsSameStorage(row_storage, loaded_row_storage));
+
+    const auto& instruction = loaded_row_storage.GetRow(1, 1);
+
+    QTISAGUI_CHECK(loaded_row_storage.GetRowText(instruction) == "v_add_f32");
+    QTISAGUI_CHECK(loaded_row_storage.GetRowDecoderEncoding(instruction) == 0xD76100020000001FULL);
+    QTISAGUI_CHECK(loaded_row_storage.GetSymbolTable()->GetText(loaded_row_storage.GetToken(instruction.op_code_token).symbol) == "v_add_f32");
+
+    // Serializing what was read gives the same storage again.
+    IsaRowStorage reloaded_row_storage;
+    const auto    reloaded_data = Serialize(loaded_row_storage);
+
+    QTISAGUI_CHECK(reloaded_row_storage.Deserialize(reloaded_data.data(), reloaded_data.size()));
+    QTISAGUI_CHECK(IsSameStorage(row_storage, reloaded_row_storage));
+}
+
+QTISAGUI_TEST(RowStorageRoundTripEmpty)
+{
+    IsaRowStorage row_storage;
+    IsaRowStorage loaded_row_storage;
+    FillRowStorage(loaded_row_storage);
+
+    const std::string data = Serialize(row_storage);
+
+    QTISAGUI_CHECK(loaded_row_storage.Deserialize(data.data(), data.size()));
+    QTISAGUI_CHECK(loaded_row_storage.GetBlockCount() == 0 && loaded_row_storage.GetRowCount() == 0);
+}
+
+QTISAGUI_TEST(RowStorageRejectsTruncatedData)
+{
+    IsaRowStorage row_storage;
+    FillRowStorage(row_storage);
+
+    const std::string data = Serialize(row_storage);
+
+    // Every prefix of the data is rejected, and leaves the storage it was read into as it was.
+    IsaRowStorage loaded_row_storage;
+    IsaRowTokenizer::AppendBlock(loaded_row_storage, true, 0, "// unchanged", kCharacterWidth);
+
+    for (size_t size = 0; size < data.size(); size++)
+    {
+        if (loaded_row_storage.Deserialize(data.data(), size))
+        {
+            IsaCoreTest::Fail(__FILE__, __LINE__, std::to_string(size).c_str());
+        }
+    }
+
+    QTISAGUI_CHECK(loaded_row_storage.GetBlockCount() == 1);
+    QTISAGUI_CHECK(loaded_row_storage.GetText(loaded_row_storage.GetBlock(0).text) == "// unchanged");
+
+    // So is data with anything after it.
+    const std::string padded_data = data + '\0';
+
+    QTISAGUI_CHECK(!loaded_row_storage.Deserialize(padded_data.data(), padded_data.size()));
+}
+
+QTISAGUI_TEST(RowStorageRejectsOtherVersions)
+{
+    IsaRowStorage row_storage;
+    FillRowStorage(row_storage);
+
+    std::string data = Serialize(row_storage);
+
+    // The version follows the magic value at the start of the data.
+    IsaRowStorage loaded_row_storage;
+    data[sizeof(uint32_t)] ^= 0x7F;
+
+    QTISAGUI_CHECK(!loaded_row_storage.Deserialize(data.data(), data.size()));
+    QTISAGUI_CHECK(loaded_row_storage.GetBlockCount() == 0);
+}